@@ -0,0 +1,31 @@
+# File: OneBayFrame_MockServer.tcl (use with OneBayFrame_Local.tcl)
+# Units: [kip,in.]
+#
+# $Revision$
+# $Date$
+# $URL$
+#
+# Written: agent
+# Created: 10/26
+# Revision: A
+#
+# Purpose: this file contains the tcl input to start a mock
+# NEES LabVIEW plugin server, which replaces the lab for
+# regression tests of the LabVIEW controller. The mock
+# specimen is linear with stiffness k in lab units, and
+# k = 5.6*(18/7)/0.003 = 4800 reproduces the right column
+# of OneBayFrame_Local.tcl (Elastic material 2). The
+# recorded responses of OneBayFrame_Local.tcl with the
+# LabVIEW controller must therefore match the ones with
+# expControl SimUniaxialMaterials 2 2 to the print precision.
+
+
+# ------------------------------
+# Start the server process
+# ------------------------------
+# startLabVIEWMockServer $ipPort <-stiff $k>
+startLabVIEWMockServer 11997 -stiff 4800.0
+exit
+# --------------------------------
+# End of server process
+# --------------------------------
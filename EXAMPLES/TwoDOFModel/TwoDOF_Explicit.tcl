@@ -0,0 +1,122 @@
+# File: TwoDOF_Explicit.tcl
+#
+# $Revision$
+# $Date$
+# $URL$
+#
+# Written: agent
+# Created: 10/26
+# Revision: A
+#
+# Purpose: this file contains the tcl input to perform
+# a local hybrid simulation of a two degree of freedom
+# system with two experimental two node link elements
+# in the standalone OpenFresco interpreter.
+# The free vibration from an initial velocity is run once
+# with each of the explicit integrators NewmarkExplicit,
+# AlphaOS and KRAlphaExplicit through the integrator and
+# analyze commands.
+# The specimens are simulated using the SimUniaxialMaterials
+# controller.
+
+
+# ------------------------------
+# Start of model generation
+# ------------------------------
+proc buildModel {} {
+    # create ModelBuilder (with one-dimension and 1 DOF/node)
+    model BasicBuilder -ndm 1 -ndf 1
+
+    # Define geometry for model
+    # -------------------------
+    set mass1 130000.;  # [kg]
+    set mass2 240000.;  # [kg]
+    set vel0 0.1;       # [m/s], initial velocity of the top mass
+    # node $tag $xCrd <-mass $mass> <-vel $vel>
+    node  1     0.0
+    node  2     0.0  -mass $mass1
+    node  3     0.0  -mass $mass2  -vel $vel0
+
+    # set the boundary conditions
+    # fix $tag $DX
+    fix 1   1
+
+    # Define materials
+    # ----------------
+    set E1 35.E6;    # [N/m], Stiffness of the column
+    set E2 50.E6;    # [N/m], Stiffness of two isolators
+    set Fy2 250.E3;  # [N], Yield strength of two isolators
+
+    # uniaxialMaterial Steel01 $matTag $Fy $E $b
+    uniaxialMaterial Elastic 1 $E1
+    uniaxialMaterial Steel01 2 $Fy2 $E2 0.1
+
+    # Define experimental control
+    # ---------------------------
+    # expControl SimUniaxialMaterials $tag $matTags
+    expControl SimUniaxialMaterials 1 1
+    expControl SimUniaxialMaterials 2 2
+
+    # Define experimental setup
+    # -------------------------
+    # expSetup OneActuator $tag <-control $ctrlTag> $dir -sizeTrialOut $t $o
+    expSetup OneActuator 1 -control 1 1 -sizeTrialOut 1 1
+    expSetup OneActuator 2 -control 2 1 -sizeTrialOut 1 1
+
+    # Define experimental site
+    # ------------------------
+    # expSite LocalSite $tag $setupTag
+    expSite LocalSite 1 1
+    expSite LocalSite 2 2
+
+    # Define experimental elements
+    # ----------------------------
+    # expElement twoNodeLink $eleTag $iNode $jNode -dof $dofs -site $siteTag -initStif $Kij
+    expElement twoNodeLink 1 1 2 -dof 1 -site 1 -initStif $E1
+    expElement twoNodeLink 2 2 3 -dof 1 -site 2 -initStif $E2
+
+    # set the rayleigh damping
+    # rayleigh $alphaM $betaK $betaKinit $betaKcomm
+    rayleigh 0.0 0.0 0.004751 0.0
+}
+# ------------------------------
+# End of model generation
+# ------------------------------
+
+
+# ------------------------------
+# Finally perform the analyses
+# ------------------------------
+set dt 0.01
+set numSteps 500
+
+foreach integrator {{NewmarkExplicit 0.5} {AlphaOS 1.0} {KRAlphaExplicit 0.9}} {
+    set name [lindex $integrator 0]
+
+    # start from a new model for every integrator
+    wipeExp
+    buildModel
+
+    # create the integration scheme
+    integrator {*}$integrator
+
+    # create the recorder objects
+    expRecorder Site -file Site_trialDsp_$name.out -time -site 1 2 trialDisp
+    expRecorder Site -file Site_outFrc_$name.out -time -site 1 2 outForce
+
+    # perform the transient analysis
+    set tTot [time {
+        set ok [analyze $numSteps $dt]
+    }]
+    if {$ok != 0} {
+        puts "\n$name analysis failed"
+    } else {
+        puts "\n$name: $numSteps steps, elapsed time = $tTot"
+    }
+}
+
+wipeExp
+exit
+# --------------------------------
+# End of analysis
+# --------------------------------
@@ -77,6 +77,7 @@ static const int OF_RemoteTest_getInitialStiff  = 12;
 static const int OF_RemoteTest_getTangentStiff  = 13;
 static const int OF_RemoteTest_getDamp          = 14;
 static const int OF_RemoteTest_getMass          = 15;
+static const int OF_RemoteTest_setTrialGetForce = 16;
 static const int OF_RemoteTest_shutdown         = 98;
 static const int OF_RemoteTest_DIE              = 99;
 
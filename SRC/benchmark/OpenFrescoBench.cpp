@@ -0,0 +1,853 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the micro-benchmark program for
+// the hot paths of OpenFresco. Each benchmark is calibrated to run
+// for a minimum time per sample, several samples are taken and the
+// time per operation is written as JSON, so that the results can be
+// compared between builds.
+//
+// Usage: OpenFrescoBench <-o fileName> <-filter string>
+//            <-samples n> <-time ms> <-port ipPort> <-list>
+
+#include <FrescoGlobals.h>
+#include <StandardStream.h>
+
+#include <ID.h>
+#include <Vector.h>
+#include <Matrix.h>
+#include <Node.h>
+#include <Domain.h>
+#include <UniaxialMaterial.h>
+#include <TCP_Socket.h>
+
+#include <ESAggregator.h>
+#include <ESFourActuators3d.h>
+#include <ESInvertedVBrace2d.h>
+#include <ESInvertedVBraceJntOff2d.h>
+#include <ESNoTransformation.h>
+#include <ESOneActuator.h>
+#include <ESThreeActuators2d.h>
+#include <ESThreeActuatorsJntOff2d.h>
+#include <ESTwoActuators2d.h>
+
+#include <ESFErrorSimRandomGauss.h>
+#include <ESFErrorSimUndershoot.h>
+#include <ESFKrylovForceConverter.h>
+#include <ESFTangForceConverter.h>
+
+#include <ETBfgs.h>
+#include <ETBroyden.h>
+#include <ETTranspose.h>
+
+#include <ECSimUniaxialMaterials.h>
+#include <LocalExpSite.h>
+#include <ShadowExpSite.h>
+#include <ActorExpSite.h>
+#include <EEGeneric.h>
+#include <EETwoNodeLink.h>
+#include <ExpSparseMatrix.h>
+
+#include <Simulink/HybridSimToolbox/PredictorCorrector.hpp>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+StandardStream sserr;
+OPS_Stream *opserrPtr = &sserr;
+
+// benchmark options
+static int numSamples = 5;
+static double sampleTime = 0.05;
+static const char *filter = 0;
+static bool listOnly = false;
+static unsigned int ipPort = 8190;
+
+// sink for results that must not be optimized away
+static volatile double sink = 0.0;
+
+struct BenchResult  {
+    std::string group;
+    std::string name;
+    long iterations;
+    double nsMin, nsMedian, nsMean, nsMax;
+};
+static std::vector<BenchResult> results;
+
+
+// elastic-perfectly plastic material used as simulated specimen
+class BenchMaterial : public UniaxialMaterial
+{
+public:
+    BenchMaterial(int tag, double e, double fy)
+        : UniaxialMaterial(tag, 0), E(e), Fy(fy),
+        trialStrain(0.0), trialStress(0.0), trialTangent(e),
+        commitStrain(0.0), commitStress(0.0)
+    { }
+
+    int setTrialStrain(double strain, double strainRate = 0.0)
+    {
+        trialStrain = strain;
+        trialStress = commitStress + E*(strain - commitStrain);
+        trialTangent = E;
+        if (trialStress > Fy)  {
+            trialStress = Fy;
+            trialTangent = 0.0;
+        } else if (trialStress < -Fy)  {
+            trialStress = -Fy;
+            trialTangent = 0.0;
+        }
+        return 0;
+    }
+    double getStrain() {return trialStrain;}
+    double getStress() {return trialStress;}
+    double getTangent() {return trialTangent;}
+    double getInitialTangent() {return E;}
+
+    int commitState()
+    {
+        commitStrain = trialStrain;
+        commitStress = trialStress;
+        return 0;
+    }
+    int revertToLastCommit()
+    {
+        trialStrain = commitStrain;
+        trialStress = commitStress;
+        return 0;
+    }
+    int revertToStart()
+    {
+        trialStrain = commitStrain = 0.0;
+        trialStress = commitStress = 0.0;
+        trialTangent = E;
+        return 0;
+    }
+    UniaxialMaterial *getCopy()
+    {
+        BenchMaterial *theCopy = new BenchMaterial(this->getTag(), E, Fy);
+        theCopy->commitStrain = commitStrain;
+        theCopy->commitStress = commitStress;
+        return theCopy;
+    }
+
+    int sendSelf(int commitTag, Channel &theChannel) {return -1;}
+    int recvSelf(int commitTag, Channel &theChannel,
+        FEM_ObjectBroker &theBroker) {return -1;}
+    void Print(OPS_Stream &s, int flag = 0)
+    {
+        s << "BenchMaterial: " << this->getTag() << endln;
+    }
+
+private:
+    double E, Fy;
+    double trialStrain, trialStress, trialTangent;
+    double commitStrain, commitStress;
+};
+
+
+static bool isSelected(const std::string &group, const std::string &name)
+{
+    if (filter == 0)
+        return true;
+
+    std::string fullName = group + "/" + name;
+    return fullName.find(filter) != std::string::npos;
+}
+
+
+// run op in batches of numIter calls, calibrate the batch size so that
+// one sample takes at least sampleTime and store the ns per call
+template <class Op>
+static void measure(const std::string &group, const std::string &name, Op op)
+{
+    typedef std::chrono::steady_clock Clock;
+
+    if (!isSelected(group, name))
+        return;
+    if (listOnly)  {
+        fprintf(stdout, "%s/%s\n", group.c_str(), name.c_str());
+        return;
+    }
+
+    // calibrate the number of iterations per sample
+    long numIter = 1;
+    double elapsed = 0.0;
+    while (true)  {
+        Clock::time_point t0 = Clock::now();
+        for (long i=0; i<numIter; i++)
+            op();
+        elapsed = std::chrono::duration<double>(Clock::now() - t0).count();
+        if (elapsed >= 0.1*sampleTime || numIter >= (1L << 30))
+            break;
+        numIter *= 2;
+    }
+    if (elapsed > 0.0 && elapsed < sampleTime)  {
+        numIter = (long)ceil(numIter*sampleTime/elapsed);
+    }
+
+    // take the samples
+    std::vector<double> ns(numSamples);
+    for (int j=0; j<numSamples; j++)  {
+        Clock::time_point t0 = Clock::now();
+        for (long i=0; i<numIter; i++)
+            op();
+        std::chrono::duration<double, std::nano> dt = Clock::now() - t0;
+        ns[j] = dt.count()/numIter;
+    }
+    std::sort(ns.begin(), ns.end());
+
+    BenchResult r;
+    r.group = group;
+    r.name = name;
+    r.iterations = numIter;
+    r.nsMin = ns.front();
+    r.nsMax = ns.back();
+    r.nsMedian = (numSamples%2 == 1) ? ns[numSamples/2] :
+        0.5*(ns[numSamples/2-1] + ns[numSamples/2]);
+    r.nsMean = 0.0;
+    for (int j=0; j<numSamples; j++)
+        r.nsMean += ns[j]/numSamples;
+    results.push_back(r);
+
+    opserr << group.c_str() << "/" << name.c_str() << ": "
+        << r.nsMedian << " ns/op\n";
+}
+
+
+// transformations of the experimental setups
+static void benchSetup(const std::string &name, ExperimentalSetup *theSetup)
+{
+    Vector *trial[OF_Resp_All], *out[OF_Resp_All], *daq[OF_Resp_All];
+    for (int i=0; i<OF_Resp_All; i++)  {
+        int szT = theSetup->getTrialSize(i);
+        int szO = theSetup->getOutSize(i);
+        int szD = theSetup->getDaqSize(i);
+        trial[i] = (szT > 0) ? new Vector(szT) : 0;
+        out[i] = (szO > 0) ? new Vector(szO) : 0;
+        daq[i] = (szD > 0) ? new Vector(szD) : 0;
+        for (int j=0; j<szT; j++)
+            (*trial[i])(j) = 0.1*(j+1);
+        for (int j=0; j<szD; j++)
+            (*daq[i])(j) = 0.1*(j+1);
+    }
+
+    int k = 0;
+    measure("setup", name + "/transfTrialResponse", [&]() {
+        if (trial[OF_Resp_Disp] != 0)
+            (*trial[OF_Resp_Disp])(0) = 1.0E-3*(k++ & 1023);
+        theSetup->transfTrialResponse(trial[0], trial[1],
+            trial[2], trial[3], trial[4]);
+    });
+
+    k = 0;
+    measure("setup", name + "/transfDaqResponse", [&]() {
+        if (daq[OF_Resp_Disp] != 0)
+            (*daq[OF_Resp_Disp])(0) = 1.0E-3*(k++ & 1023);
+        theSetup->setDaqResponse(daq[0], daq[1], daq[2], daq[3], daq[4]);
+        theSetup->transfDaqResponse(out[0], out[1], out[2], out[3], out[4]);
+        if (out[OF_Resp_Force] != 0)
+            sink += (*out[OF_Resp_Force])(0);
+    });
+
+    for (int i=0; i<OF_Resp_All; i++)  {
+        if (trial[i] != 0)
+            delete trial[i];
+        if (out[i] != 0)
+            delete out[i];
+        if (daq[i] != 0)
+            delete daq[i];
+    }
+}
+
+
+static void benchSetups()
+{
+    ID dof(3);
+    dof(0) = 0;  dof(1) = 1;  dof(2) = 2;
+
+    ESNoTransformation esNoTrans(1, dof, 3, 3);
+    benchSetup("ESNoTransformation", &esNoTrans);
+
+    ESOneActuator esOneAct(2, 0, 1, 1);
+    benchSetup("ESOneActuator", &esOneAct);
+
+    for (int nlGeom=0; nlGeom<2; nlGeom++)  {
+        std::string opt = (nlGeom == 0) ? "/linear" : "/nlGeom";
+
+        ESTwoActuators2d esTwoAct(3, 54.0, 54.0, 36.0, 0, nlGeom);
+        benchSetup("ESTwoActuators2d" + opt, &esTwoAct);
+
+        ESThreeActuators2d esThreeAct(4, 54.0, 54.0, 54.0,
+            36.0, 12.0, 0, nlGeom);
+        benchSetup("ESThreeActuators2d" + opt, &esThreeAct);
+
+        ESThreeActuatorsJntOff2d esThreeActJntOff(5, 54.0, 54.0, 54.0,
+            12.0, 36.0, 36.0, 12.0, 12.0, 12.0, 0, nlGeom);
+        benchSetup("ESThreeActuatorsJntOff2d" + opt, &esThreeActJntOff);
+
+        ESInvertedVBrace2d esInvVBrace(6, 54.0, 54.0, 54.0,
+            36.0, 36.0, 0, nlGeom);
+        benchSetup("ESInvertedVBrace2d" + opt, &esInvVBrace);
+
+        ESInvertedVBraceJntOff2d esInvVBraceJntOff(7, 54.0, 54.0, 54.0,
+            12.0, 36.0, 36.0, 12.0, 12.0, 12.0, 0, nlGeom);
+        benchSetup("ESInvertedVBraceJntOff2d" + opt, &esInvVBraceJntOff);
+
+        ESFourActuators3d esFourAct(8, 60.0, 60.0, 60.0, 60.0,
+            20.0, 20.0, 20.0, 20.0, 12.0, 6.0, 6.0, 4.0, 4.0,
+            30.0, 30.0, 8.0, 0, nlGeom);
+        benchSetup("ESFourActuators3d" + opt, &esFourAct);
+    }
+
+    ExperimentalSetup *theSetups[2];
+    theSetups[0] = new ESOneActuator(10, 0, 1, 1);
+    theSetups[1] = new ESTwoActuators2d(11, 54.0, 54.0, 36.0);
+    ESAggregator esAggregator(9, 2, theSetups);
+    benchSetup("ESAggregator", &esAggregator);
+    delete theSetups[0];
+    delete theSetups[1];
+}
+
+
+// signal filters and force converters
+static void benchSignalFilters()
+{
+    const int size = 6;
+
+    ESFErrorSimRandomGauss esfGauss(1, 0.0, 0.01);
+    int k = 0;
+    measure("signalFilter", "ESFErrorSimRandomGauss/filtering", [&]() {
+        sink += esfGauss.filtering(1.0E-3*(k++ & 1023));
+    });
+
+    ESFErrorSimUndershoot esfUndershoot(2, 0.01);
+    k = 0;
+    measure("signalFilter", "ESFErrorSimUndershoot/filtering", [&]() {
+        sink += esfUndershoot.filtering(1.0E-3*(k++ & 1023));
+    });
+
+    Matrix kInit(size, size);
+    for (int i=0; i<size; i++)  {
+        kInit(i,i) = 4.0;
+        if (i > 0)
+            kInit(i,i-1) = kInit(i-1,i) = -1.0;
+    }
+    Vector dDisp(size), dForce(size), tDisp(size);
+
+    ESFKrylovForceConverter esfKrylov(3, 3, kInit);
+    esfKrylov.setSize(size);
+    k = 0;
+    measure("signalFilter", "ESFKrylovForceConverter/converting", [&]() {
+        double x = 1.0E-2*(k++ & 1023);
+        for (int i=0; i<size; i++)  {
+            dDisp(i) = sin(x + i);
+            dForce(i) = 3.0*sin(x + i) + 0.1*cos(2.0*x + i);
+            tDisp(i) = sin(x + i + 0.01);
+        }
+        esfKrylov.converting(&dDisp, &dForce);
+        sink += esfKrylov.converting(&tDisp)(0);
+    });
+
+    // the converter takes ownership of the tangent stiffness
+    ESFTangForceConverter esfTang(5, kInit, new ETBroyden(4));
+    esfTang.setSize(size);
+    k = 0;
+    measure("signalFilter", "ESFTangForceConverter/converting", [&]() {
+        double x = 1.0E-2*(k++ & 1023);
+        for (int i=0; i<size; i++)  {
+            dDisp(i) = sin(x + i);
+            dForce(i) = 3.0*sin(x + i) + 0.1*cos(2.0*x + i);
+            tDisp(i) = sin(x + i + 0.01);
+        }
+        esfTang.converting(&dDisp, &dForce);
+        sink += esfTang.converting(&tDisp)(0);
+    });
+}
+
+
+// tangent stiffness updates
+static void benchTangentStiff()
+{
+    const int size = 6;
+
+    Matrix kInit(size, size), kPrev(size, size);
+    for (int i=0; i<size; i++)  {
+        kInit(i,i) = 4.0;
+        if (i > 0)
+            kInit(i,i-1) = kInit(i-1,i) = -1.0;
+    }
+    Vector incrDisp(size), incrForce(size);
+
+    ExperimentalTangentStiff *theTangStiffs[3];
+    theTangStiffs[0] = new ETBroyden(1);
+    theTangStiffs[1] = new ETBfgs(2);
+    theTangStiffs[2] = new ETTranspose(3, size+2);
+
+    for (int j=0; j<3; j++)  {
+        ExperimentalTangentStiff *theTangStiff = theTangStiffs[j];
+        kPrev = kInit;
+        int k = 0;
+        measure("tangentStiff",
+            std::string(theTangStiff->getClassType()) + "/updateTangentStiff",
+            [&]() {
+            double x = 1.0E-2*(k++ & 1023);
+            for (int i=0; i<size; i++)  {
+                incrDisp(i) = 1.0E-2*sin(x + 1.3*i);
+                incrForce(i) = 4.0E-2*sin(x + 1.3*i) + 1.0E-3*cos(x + i);
+            }
+            kPrev = theTangStiff->updateTangentStiff(&incrDisp, 0, 0,
+                &incrForce, 0, &kInit, &kPrev);
+            // keep the matrix bounded
+            if ((k & 63) == 0)
+                kPrev = kInit;
+            sink += kPrev(0,0);
+        });
+        delete theTangStiff;
+    }
+}
+
+
+// simulated control with uniaxial materials
+static void benchSimUniaxialMaterials()
+{
+    const int numMats = 16;
+
+    unsigned int maxThreads = std::thread::hardware_concurrency();
+    if (maxThreads < 1)
+        maxThreads = 1;
+
+    UniaxialMaterial *theMats[numMats];
+    for (int i=0; i<numMats; i++)
+        theMats[i] = new BenchMaterial(i+1, 100.0, 1.0 + 0.1*i);
+
+    for (unsigned int numThreads=1; numThreads<=4; numThreads*=2)  {
+        if (numThreads > 1 && numThreads > maxThreads)
+            break;
+
+        ECSimUniaxialMaterials theControl(1, numMats, theMats, numThreads);
+        ID sizeT(OF_Resp_All), sizeO(OF_Resp_All);
+        sizeT(OF_Resp_Disp) = sizeT(OF_Resp_Vel) = numMats;
+        sizeO(OF_Resp_Disp) = sizeO(OF_Resp_Vel) = numMats;
+        sizeO(OF_Resp_Force) = numMats;
+        theControl.setSize(sizeT, sizeO);
+        theControl.setup();
+
+        Vector disp(numMats), vel(numMats), force(numMats);
+        char name[80];
+        sprintf(name, "ECSimUniaxialMaterials/numThreads=%u/step", numThreads);
+        int k = 0;
+        measure("control", name, [&]() {
+            double x = 1.0E-2*(k++ & 1023);
+            for (int i=0; i<numMats; i++)  {
+                disp(i) = 0.05*sin(x + i);
+                vel(i) = 0.05*cos(x + i);
+            }
+            theControl.setTrialResponse(&disp, &vel, 0, 0, 0);
+            theControl.getDaqResponse(&disp, &vel, 0, &force, 0);
+            theControl.commitState();
+            sink += force(0);
+        });
+    }
+
+    for (int i=0; i<numMats; i++)
+        delete theMats[i];
+}
+
+
+// predictor-corrector substeps of the real-time control
+static void benchPredictorCorrector()
+{
+    const int nDOF = 6;
+    double sig[nDOF];
+
+    PredictorCorrector thePC;
+    thePC.initData(nDOF, 1.0E-3, 1.0E-2, 1.0E-2);
+    for (int k=0; k<6; k++)  {
+        for (int j=0; j<nDOF; j++)
+            sig[j] = sin(0.3*k + j) + 0.1*j;
+        thePC.setNewSig(sig);
+    }
+    for (int j=0; j<nDOF; j++)
+        sig[j] = cos(1.0*j);
+    thePC.setCurSig(sig, 0.4);
+
+    int k = 0;
+    measure("control", "PredictorCorrector/predictD3+correctD3", [&]() {
+        double x = 0.45 + 1.0E-4*(k++ & 1023);
+        thePC.predictD3(sig, x);
+        thePC.correctD3(sig, x + 0.1);
+        sink += sig[0];
+    });
+    thePC.freeData();
+}
+
+
+// elements with a local site and a simulated control
+static void benchElements()
+{
+    const int numBasicDOF = 2;
+
+    ID sizeT(OF_Resp_All), sizeO(OF_Resp_All);
+    ID dof(numBasicDOF);
+    for (int i=0; i<numBasicDOF; i++)
+        dof(i) = i;
+
+    // EEGeneric with one dof at each of two nodes
+    {
+        UniaxialMaterial *theMats[numBasicDOF];
+        for (int i=0; i<numBasicDOF; i++)
+            theMats[i] = new BenchMaterial(i+1, 100.0, 1.0);
+        ECSimUniaxialMaterials *theControl =
+            new ECSimUniaxialMaterials(1, numBasicDOF, theMats);
+        ESNoTransformation *theSetup =
+            new ESNoTransformation(1, dof, numBasicDOF, numBasicDOF, theControl);
+        LocalExpSite *theSite = new LocalExpSite(1, theSetup);
+
+        Domain theDomain;
+        Node *theNodes[2];
+        theNodes[0] = new Node(1, 1, 0.0);
+        theNodes[1] = new Node(2, 1, 1.0);
+        theDomain.addNode(theNodes[0]);
+        theDomain.addNode(theNodes[1]);
+
+        ID nodes(2);
+        nodes(0) = 1;  nodes(1) = 2;
+        ID eleDOF[2];
+        eleDOF[0] = ID(1);  eleDOF[1] = ID(1);
+        EEGeneric *theEle = new EEGeneric(1, nodes, eleDOF, theSite);
+        theDomain.addElement(theEle);
+
+        Vector u(1);
+        int k = 0;
+        measure("element", "EEGeneric/LocalExpSite/update+getResistingForce",
+            [&]() {
+            double x = 1.0E-2*(k++ & 1023);
+            for (int i=0; i<2; i++)  {
+                u(0) = 0.02*sin(x + i);
+                theNodes[i]->setTrialDisp(u);
+            }
+            theEle->update();
+            sink += theEle->getResistingForce()(0);
+        });
+
+        theDomain.clearAll();
+        delete theSite;
+        delete theSetup;
+        delete theControl;
+        for (int i=0; i<numBasicDOF; i++)
+            delete theMats[i];
+    }
+
+    // EETwoNodeLink in 2D with two basic dof
+    {
+        UniaxialMaterial *theMats[numBasicDOF];
+        for (int i=0; i<numBasicDOF; i++)
+            theMats[i] = new BenchMaterial(i+1, 100.0, 1.0);
+        ECSimUniaxialMaterials *theControl =
+            new ECSimUniaxialMaterials(2, numBasicDOF, theMats);
+        ESNoTransformation *theSetup =
+            new ESNoTransformation(2, dof, numBasicDOF, numBasicDOF, theControl);
+        LocalExpSite *theSite = new LocalExpSite(2, theSetup);
+
+        Domain theDomain;
+        Node *theNodes[2];
+        theNodes[0] = new Node(1, 3, 0.0, 0.0);
+        theNodes[1] = new Node(2, 3, 0.0, 1.0);
+        theDomain.addNode(theNodes[0]);
+        theDomain.addNode(theNodes[1]);
+
+        EETwoNodeLink *theEle = new EETwoNodeLink(2, 2, 1, 2, dof, theSite);
+        theDomain.addElement(theEle);
+
+        Vector u(3);
+        int k = 0;
+        measure("element", "EETwoNodeLink/LocalExpSite/update+getResistingForce",
+            [&]() {
+            double x = 1.0E-2*(k++ & 1023);
+            u(0) = 0.02*sin(x);
+            u(1) = 0.01*cos(x);
+            theNodes[1]->setTrialDisp(u);
+            theEle->update();
+            sink += theEle->getResistingForce()(0);
+        });
+
+        theDomain.clearAll();
+        delete theSite;
+        delete theSetup;
+        delete theControl;
+        for (int i=0; i<numBasicDOF; i++)
+            delete theMats[i];
+    }
+}
+
+
+// sparse versus dense stiffness of a banded superelement
+static void benchSparseMatrix()
+{
+    const int size = 300;
+    const int halfBand = 3;
+
+    Matrix K(size, size);
+    for (int i=0; i<size; i++)  {
+        K(i,i) = 2.0*halfBand + 1.0;
+        for (int j=1; j<=halfBand && i+j<size; j++)
+            K(i,i+j) = K(i+j,i) = -1.0/j;
+    }
+    ExpSparseMatrix Ks(K);
+
+    Vector x(size), y(size);
+    for (int i=0; i<size; i++)
+        x(i) = sin(0.1*i);
+
+    measure("sparseMatrix", "Matrix/addMatrixVector/300", [&]() {
+        y.addMatrixVector(0.0, K, x, 1.0);
+        sink += y(0);
+    });
+    measure("sparseMatrix", "ExpSparseMatrix/addMatrixVector/300", [&]() {
+        y.Zero();
+        Ks.addMatrixVector(y, x);
+        sink += y(0);
+    });
+
+    // scatter into an element matrix with an unused dof per node
+    Matrix A(2*size, 2*size);
+    ID dofs(size);
+    for (int i=0; i<size; i++)
+        dofs(i) = 2*i;
+    measure("sparseMatrix", "Matrix/Assemble/300", [&]() {
+        A.Zero();
+        A.Assemble(K, dofs, dofs);
+        sink += A(0,0);
+    });
+    measure("sparseMatrix", "ExpSparseMatrix/assemble/300", [&]() {
+        A.Zero();
+        Ks.assemble(A, dofs, dofs);
+        sink += A(0,0);
+    });
+
+    // read the matrix back from a MatrixMarket file
+    const char *fileName = "OpenFrescoBench.mtx";
+    if (!listOnly && isSelected("sparseMatrix", "ExpSparseMatrix/read/300"))  {
+        FILE *theFile = fopen(fileName, "w");
+        if (theFile == 0)
+            return;
+        fprintf(theFile, "%%%%MatrixMarket matrix coordinate real symmetric\n");
+        fprintf(theFile, "%d %d %d\n", size, size,
+            size*(halfBand+1) - halfBand*(halfBand+1)/2);
+        for (int j=0; j<size; j++)
+            for (int i=j; i<=j+halfBand && i<size; i++)
+                fprintf(theFile, "%d %d %.17g\n", i+1, j+1, K(i,j));
+        fclose(theFile);
+    }
+    ExpSparseMatrix Kr;
+    measure("sparseMatrix", "ExpSparseMatrix/read/300", [&]() {
+        Kr.read(fileName, size, size);
+        sink += Kr.getNumNonZeros();
+    });
+    remove(fileName);
+}
+
+
+// round trip between a shadow and an actor site over a loopback socket
+static void benchShadowActor(int noDelay)
+{
+    const int numDOF = 2;
+
+    std::string name = "ShadowExpSite-ActorExpSite/TCP";
+    if (noDelay)
+        name += "/noDelay";
+    name += "/step";
+    if (!isSelected("site", name))
+        return;
+    if (listOnly)  {
+        fprintf(stdout, "site/%s\n", name.c_str());
+        return;
+    }
+
+    // use a separate port for each run
+    unsigned int port = ipPort + noDelay;
+
+    // the actor side runs in its own thread
+    std::atomic<bool> actorReady(false);
+    std::thread actor([&actorReady, port, noDelay]() {
+        ID dof(numDOF);
+        for (int i=0; i<numDOF; i++)
+            dof(i) = i;
+        UniaxialMaterial *theMats[numDOF];
+        for (int i=0; i<numDOF; i++)
+            theMats[i] = new BenchMaterial(i+1, 100.0, 1.0);
+        ECSimUniaxialMaterials *theControl =
+            new ECSimUniaxialMaterials(1, numDOF, theMats);
+        ESNoTransformation *theSetup =
+            new ESNoTransformation(1, dof, numDOF, numDOF, theControl);
+
+        TCP_Socket theChannel(port, true, noDelay);
+        actorReady = true;
+        ActorExpSite theSite(1, theSetup, theChannel);
+        theSite.run();
+
+        delete theSetup;
+        delete theControl;
+        for (int i=0; i<numDOF; i++)
+            delete theMats[i];
+    });
+
+    // the socket does not retry to connect, so give the actor
+    // some time to start listening
+    while (!actorReady)
+        std::this_thread::yield();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    {
+        TCP_Socket theChannel(port, "127.0.0.1", true, noDelay);
+        ShadowExpSite theSite(2, theChannel);
+
+        ID sizeT(OF_Resp_All), sizeO(OF_Resp_All);
+        for (int i=0; i<OF_Resp_Time; i++)  {
+            sizeT(i) = numDOF;
+            sizeO(i) = numDOF;
+        }
+        sizeT(OF_Resp_Force) = 0;
+        sizeT(OF_Resp_Time) = sizeO(OF_Resp_Time) = 1;
+        theSite.setSize(sizeT, sizeO);
+
+        Vector disp(numDOF), vel(numDOF), accel(numDOF), time(1);
+        int k = 0;
+        measure("site", name, [&]() {
+            double x = 1.0E-2*(k++ & 1023);
+            for (int i=0; i<numDOF; i++)  {
+                disp(i) = 0.02*sin(x + i);
+                vel(i) = 0.02*cos(x + i);
+            }
+            time(0) = x;
+            theSite.setTrialResponse(&disp, &vel, &accel, 0, &time);
+            sink += theSite.getForce()(0);
+            theSite.commitState();
+        });
+    }
+
+    actor.join();
+}
+
+
+static void writeJSON(FILE *fp)
+{
+    char date[32];
+    time_t now = time(0);
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+
+    fprintf(fp, "{\n");
+    fprintf(fp, "  \"program\": \"OpenFrescoBench\",\n");
+    fprintf(fp, "  \"version\": \"%s\",\n", OPF_VERSION);
+    fprintf(fp, "  \"date\": \"%s\",\n", date);
+    fprintf(fp, "  \"samples\": %d,\n", numSamples);
+    fprintf(fp, "  \"sampleTime\": %g,\n", sampleTime);
+    fprintf(fp, "  \"hardwareThreads\": %u,\n",
+        std::thread::hardware_concurrency());
+    fprintf(fp, "  \"results\": [");
+    for (size_t i=0; i<results.size(); i++)  {
+        const BenchResult &r = results[i];
+        fprintf(fp, "%s\n    {\"group\": \"%s\", \"name\": \"%s\", "
+            "\"iterations\": %ld, \"ns_per_op\": {\"min\": %.3f, "
+            "\"median\": %.3f, \"mean\": %.3f, \"max\": %.3f}}",
+            (i > 0) ? "," : "", r.group.c_str(), r.name.c_str(),
+            r.iterations, r.nsMin, r.nsMedian, r.nsMean, r.nsMax);
+    }
+    fprintf(fp, "\n  ]\n}\n");
+}
+
+
+int main(int argc, char **argv)
+{
+    const char *fileName = 0;
+
+    for (int i=1; i<argc; i++)  {
+        if (strcmp(argv[i], "-o") == 0 && i+1 < argc)  {
+            fileName = argv[++i];
+        }
+        else if (strcmp(argv[i], "-filter") == 0 && i+1 < argc)  {
+            filter = argv[++i];
+        }
+        else if (strcmp(argv[i], "-samples") == 0 && i+1 < argc)  {
+            numSamples = atoi(argv[++i]);
+            if (numSamples < 1)
+                numSamples = 1;
+        }
+        else if (strcmp(argv[i], "-time") == 0 && i+1 < argc)  {
+            sampleTime = 1.0E-3*atof(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-port") == 0 && i+1 < argc)  {
+            ipPort = (unsigned int)atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-list") == 0)  {
+            listOnly = true;
+        }
+        else  {
+            opserr << "WARNING unknown option: " << argv[i] << endln;
+            opserr << "Want: OpenFrescoBench <-o fileName> <-filter string> "
+                << "<-samples n> <-time ms> <-port ipPort> <-list>\n";
+            return -1;
+        }
+    }
+
+    benchSetups();
+    benchSignalFilters();
+    benchTangentStiff();
+    benchSimUniaxialMaterials();
+    benchPredictorCorrector();
+    benchElements();
+    benchSparseMatrix();
+    benchShadowActor(0);
+    benchShadowActor(1);
+
+    if (listOnly)
+        return 0;
+
+    FILE *fp = stdout;
+    if (fileName != 0)  {
+        fp = fopen(fileName, "w");
+        if (fp == 0)  {
+            opserr << "OpenFrescoBench - could not open file "
+                << fileName << endln;
+            return -1;
+        }
+    }
+    writeJSON(fp);
+    if (fp != stdout)
+        fclose(fp);
+
+    return 0;
+}
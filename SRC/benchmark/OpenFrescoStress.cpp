@@ -0,0 +1,288 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the thread stress test for the
+// experimental setups. Every thread creates its own instance of each
+// ES* setup and steps it through the same trial/daq sequence with a
+// loop-back of the ctrl response into the daq response. The checksums
+// of the ctrl and output responses of all threads must be identical to
+// the ones of a serial reference run. The test is meant to be built
+// with -fsanitize=thread (see make stress), which also reports races
+// that do not change the results.
+//
+// Usage: OpenFrescoStress <-threads n> <-steps n>
+
+#include <FrescoGlobals.h>
+#include <StandardStream.h>
+
+#include <ID.h>
+#include <Vector.h>
+
+#include <ESAggregator.h>
+#include <ESFourActuators3d.h>
+#include <ESInvertedVBrace2d.h>
+#include <ESInvertedVBraceJntOff2d.h>
+#include <ESNoTransformation.h>
+#include <ESOneActuator.h>
+#include <ESThreeActuators.h>
+#include <ESThreeActuators2d.h>
+#include <ESThreeActuatorsJntOff.h>
+#include <ESThreeActuatorsJntOff2d.h>
+#include <ESTwoActuators2d.h>
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+StandardStream sserr;
+OPS_Stream *opserrPtr = &sserr;
+
+// stress test options
+static int numThreads = 8;
+static int numSteps = 2000;
+
+
+// creates one instance of every experimental setup, the
+// nonlinear geometry variants are created as separate setups
+static void createSetups(std::vector<ExperimentalSetup*> &theSetups,
+    std::vector<std::string> &names)
+{
+    ID dof(3);
+    dof(0) = 0;  dof(1) = 1;  dof(2) = 2;
+    int tag = 1;
+
+    theSetups.push_back(new ESNoTransformation(tag++, dof, 3, 3));
+    names.push_back("ESNoTransformation");
+
+    theSetups.push_back(new ESOneActuator(tag++, 0, 1, 1));
+    names.push_back("ESOneActuator");
+
+    for (int nlGeom=0; nlGeom<2; nlGeom++)  {
+        std::string opt = (nlGeom == 0) ? "/linear" : "/nlGeom";
+
+        theSetups.push_back(new ESTwoActuators2d(tag++,
+            54.0, 54.0, 36.0, 0, nlGeom));
+        names.push_back("ESTwoActuators2d" + opt);
+
+        theSetups.push_back(new ESThreeActuators(tag++, dof, 3, 3,
+            54.0, 54.0, 54.0, 36.0, 12.0, 12.0, 0, nlGeom));
+        names.push_back("ESThreeActuators" + opt);
+
+        theSetups.push_back(new ESThreeActuators2d(tag++,
+            54.0, 54.0, 54.0, 36.0, 12.0, 0, nlGeom));
+        names.push_back("ESThreeActuators2d" + opt);
+
+        theSetups.push_back(new ESThreeActuatorsJntOff(tag++, dof, 3, 3,
+            54.0, 54.0, 54.0, 12.0, 36.0, 36.0, 12.0, 12.0, 12.0, 12.0,
+            0, nlGeom));
+        names.push_back("ESThreeActuatorsJntOff" + opt);
+
+        theSetups.push_back(new ESThreeActuatorsJntOff2d(tag++,
+            54.0, 54.0, 54.0, 12.0, 36.0, 36.0, 12.0, 12.0, 12.0,
+            0, nlGeom));
+        names.push_back("ESThreeActuatorsJntOff2d" + opt);
+
+        theSetups.push_back(new ESInvertedVBrace2d(tag++,
+            54.0, 54.0, 54.0, 36.0, 36.0, 0, nlGeom));
+        names.push_back("ESInvertedVBrace2d" + opt);
+
+        theSetups.push_back(new ESInvertedVBraceJntOff2d(tag++,
+            54.0, 54.0, 54.0, 12.0, 36.0, 36.0, 12.0, 12.0, 12.0,
+            0, nlGeom));
+        names.push_back("ESInvertedVBraceJntOff2d" + opt);
+
+        theSetups.push_back(new ESFourActuators3d(tag++,
+            60.0, 60.0, 60.0, 60.0, 20.0, 20.0, 20.0, 20.0,
+            12.0, 6.0, 6.0, 4.0, 4.0, 30.0, 30.0, 8.0, 0, nlGeom));
+        names.push_back("ESFourActuators3d" + opt);
+    }
+
+    // the aggregator copies the setups it aggregates
+    ExperimentalSetup *aggSetups[2];
+    aggSetups[0] = new ESOneActuator(tag++, 0, 1, 1);
+    aggSetups[1] = new ESTwoActuators2d(tag++, 54.0, 54.0, 36.0, 0, 1);
+    theSetups.push_back(new ESAggregator(tag++, 2, aggSetups));
+    names.push_back("ESAggregator");
+    delete aggSetups[0];
+    delete aggSetups[1];
+}
+
+
+// steps the setup through the trial/daq sequence and
+// returns the checksum of the ctrl and output responses
+static double stepSetup(ExperimentalSetup *theSetup)
+{
+    Vector *trial[OF_Resp_All], *ctrl[OF_Resp_All];
+    Vector *daq[OF_Resp_All], *out[OF_Resp_All];
+    for (int i=0; i<OF_Resp_All; i++)  {
+        int szT = theSetup->getTrialSize(i);
+        int szC = theSetup->getCtrlSize(i);
+        int szD = theSetup->getDaqSize(i);
+        int szO = theSetup->getOutSize(i);
+        trial[i] = (szT > 0) ? new Vector(szT) : 0;
+        ctrl[i] = (szC > 0) ? new Vector(szC) : 0;
+        daq[i] = (szD > 0) ? new Vector(szD) : 0;
+        out[i] = (szO > 0) ? new Vector(szO) : 0;
+    }
+
+    double checksum = 0.0;
+    for (int step=0; step<numSteps; step++)  {
+        // trial response along a smooth path of moderate amplitude
+        double t = 1.0E-2*step;
+        for (int i=0; i<OF_Resp_All; i++)  {
+            if (trial[i] == 0)
+                continue;
+            for (int j=0; j<trial[i]->Size(); j++)
+                (*trial[i])(j) = 0.1*sin(t + 0.7*j + 1.3*i)/(i+1);
+        }
+        theSetup->transfTrialResponse(trial[0], trial[1],
+            trial[2], trial[3], trial[4]);
+        theSetup->getTrialResponse(ctrl[0], ctrl[1],
+            ctrl[2], ctrl[3], ctrl[4]);
+
+        // loop-back of the ctrl displacements into the daq response
+        for (int i=0; i<OF_Resp_All; i++)  {
+            if (daq[i] == 0)
+                continue;
+            Vector *src = (ctrl[i] != 0) ? ctrl[i] : ctrl[OF_Resp_Disp];
+            for (int j=0; j<daq[i]->Size(); j++)  {
+                if (src != 0)
+                    (*daq[i])(j) = (i+1)*(*src)(j % src->Size());
+                else
+                    (*daq[i])(j) = 0.1*cos(t + j);
+            }
+        }
+        theSetup->setDaqResponse(daq[0], daq[1], daq[2], daq[3], daq[4]);
+        theSetup->transfDaqResponse(out[0], out[1], out[2], out[3], out[4]);
+        theSetup->commitState();
+
+        for (int i=0; i<OF_Resp_All; i++)  {
+            if (ctrl[i] != 0)
+                for (int j=0; j<ctrl[i]->Size(); j++)
+                    checksum += (j+1)*(*ctrl[i])(j);
+            if (out[i] != 0)
+                for (int j=0; j<out[i]->Size(); j++)
+                    checksum += (j+2)*(*out[i])(j);
+        }
+    }
+
+    for (int i=0; i<OF_Resp_All; i++)  {
+        if (trial[i] != 0)
+            delete trial[i];
+        if (ctrl[i] != 0)
+            delete ctrl[i];
+        if (daq[i] != 0)
+            delete daq[i];
+        if (out[i] != 0)
+            delete out[i];
+    }
+
+    return checksum;
+}
+
+
+// creates and steps all the setups of one thread
+static void runSetups(std::vector<double> &checksums)
+{
+    std::vector<ExperimentalSetup*> theSetups;
+    std::vector<std::string> names;
+    createSetups(theSetups, names);
+
+    checksums.resize(theSetups.size());
+    for (size_t k=0; k<theSetups.size(); k++)
+        checksums[k] = stepSetup(theSetups[k]);
+
+    for (size_t k=0; k<theSetups.size(); k++)
+        delete theSetups[k];
+}
+
+
+int main(int argc, char **argv)
+{
+    for (int i=1; i<argc; i++)  {
+        if (strcmp(argv[i], "-threads") == 0 && i+1 < argc)  {
+            numThreads = atoi(argv[++i]);
+            if (numThreads < 1)
+                numThreads = 1;
+        }
+        else if (strcmp(argv[i], "-steps") == 0 && i+1 < argc)  {
+            numSteps = atoi(argv[++i]);
+            if (numSteps < 1)
+                numSteps = 1;
+        }
+        else  {
+            opserr << "WARNING unknown option: " << argv[i] << endln;
+            opserr << "Want: OpenFrescoStress <-threads n> <-steps n>\n";
+            return -1;
+        }
+    }
+
+    // serial reference run
+    std::vector<std::string> names;
+    {
+        std::vector<ExperimentalSetup*> theSetups;
+        createSetups(theSetups, names);
+        for (size_t k=0; k<theSetups.size(); k++)
+            delete theSetups[k];
+    }
+    std::vector<double> reference;
+    runSetups(reference);
+
+    // all threads step their own setups at the same time
+    std::vector<std::vector<double> > checksums(numThreads);
+    std::vector<std::thread> workers;
+    for (int i=0; i<numThreads; i++)
+        workers.push_back(std::thread(runSetups, std::ref(checksums[i])));
+    for (int i=0; i<numThreads; i++)
+        workers[i].join();
+
+    int numFailed = 0;
+    for (size_t k=0; k<names.size(); k++)  {
+        int numDiff = 0;
+        for (int i=0; i<numThreads; i++)
+            if (checksums[i][k] != reference[k])
+                numDiff++;
+        if (numDiff > 0)  {
+            opserr << "FAILED " << names[k].c_str() << ": " << numDiff
+                << " of " << numThreads << " threads differ from the "
+                << "serial run\n";
+            numFailed++;
+        }
+    }
+
+    opserr << "OpenFrescoStress - " << (int)names.size() << " setups, "
+        << numThreads << " threads, " << numSteps << " steps: ";
+    if (numFailed > 0)  {
+        opserr << numFailed << " setups FAILED\n";
+        return 1;
+    }
+    opserr << "passed\n";
+
+    return 0;
+}
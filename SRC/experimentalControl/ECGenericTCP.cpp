@@ -131,6 +131,11 @@ void* OPF_ECGenericTCP()
         else if (strcmp(type, "-udp") == 0) {
             udp = 1; ssl = 0;
         }
+        else {
+            // move current arg back by one
+            OPS_ResetCurrentInputArg(-1);
+            break;
+        }
     }
     
     // parsing was successful, allocate the control
@@ -27,6 +27,7 @@
 // ECLabVIEW class.
 
 #include "ECLabVIEW.h"
+#include "LabVIEWMessage.h"
 #include <ExperimentalCP.h>
 
 #include <Message.h>
@@ -186,7 +187,7 @@ ECLabVIEW::ECLabVIEW(int tag, int nTrialCPs, ExperimentalCP** trialcps,
     : ExperimentalControl(tag),
     numTrialCPs(nTrialCPs), trialCPs(0), numOutCPs(nOutCPs), outCPs(0),
     ipAddress(ipaddress), ipPort(ipport),
-    theSocket(0), sData(0), sendData(0), rData(0), recvData(0),
+    theSocket(0), sendMsg(0), sendData(0), recvMsg(0), recvData(0),
     numCtrlSignals(0), numDaqSignals(0),
     ctrlDisp(0), ctrlForce(0), daqDisp(0), daqForce(0),
     trialSigOffset(0), ctrlSigOffset(0), daqSigOffset(0),
@@ -219,8 +220,9 @@ ECLabVIEW::ECLabVIEW(int tag, int nTrialCPs, ExperimentalCP** trialcps,
         numDaqSignals += numSignals;
     }
     
-    // setup the connection
-    theSocket = new TCP_Socket(ipPort, ipAddress);
+    // setup the connection (without Nagle's algorithm since
+    // the protocol only exchanges short request/reply messages)
+    theSocket = new TCP_Socket(ipPort, ipAddress, false, 1);
     if (theSocket->setUpConnection() != 0) {
         opserr << "ECLabVIEW::ECLabVIEW() - "
             << "failed to setup TCP connection to LabVIEW.\n";
@@ -234,43 +236,30 @@ ECLabVIEW::ECLabVIEW(int tag, int nTrialCPs, ExperimentalCP** trialcps,
     opserr << "****************************************************************\n";
     opserr << endln;
     
-    // allocate memory for the send messages
-    const int dataSize = 512;
-    sData = new char[dataSize];
-    sendData = new Message(sData, dataSize);
-    
-    // allocate memory for the receive messages
-    rData = new char[dataSize];
-    recvData = new Message(rData, dataSize);
+    // allocate memory for the send and receive messages
+    this->allocateMessages();
     
     // open a session with LabVIEW
-    sprintf(sData, "open-session\tOpenFresco\n");
-    fprintf(logFile, "%s", sData);
-    delete sendData;  sendData = new Message(sData, (int)strlen(sData));  // needed because of bug in LabVIEW-plugin
-    theSocket->sendMsg(0, 0, *sendData, 0);
-    theSocket->recvMsgUnknownSize(0, 0, *recvData, 0);
-    fprintf(logFile, "%s", rData);
-    
-    if (strcmp(strtok(rData, "\t"), "OK") != 0) {
+    sendMsg->clear();
+    sendMsg->append("open-session").append("OpenFresco").end();
+    this->sendCommand();
+    if (this->recvReply() != 0) {
         opserr << "ECLabVIEW::ECLabVIEW() - "
             << "failed to open a session with LabVIEW.\n";
-        opserr << rData << endln;
+        opserr << recvMsg->getToken(0) << endln;
         delete theSocket;
         exit(OF_ReturnType_failed);
     }
     
     // send parameters (needed for NEES-SAM & MiniMost -> remove later)
-    sprintf(sData, "set-parameter\tOPFTransaction\tnstep\t1\n");
-    fprintf(logFile, "%s", sData);
-    delete sendData;  sendData = new Message(sData, (int)strlen(sData));  // needed because of bug in LabVIEW-plugin
-    theSocket->sendMsg(0, 0, *sendData, 0);
-    theSocket->recvMsgUnknownSize(0, 0, *recvData, 0);
-    fprintf(logFile, "%s", rData);
-    
-    if (strcmp(strtok(rData, "\t"), "OK") != 0) {
+    sendMsg->clear();
+    sendMsg->append("set-parameter").append("OPFTransaction");
+    sendMsg->append("nstep").append("1").end();
+    this->sendCommand();
+    if (this->recvReply() != 0) {
         opserr << "ECLabVIEW::ECLabVIEW() - "
             << "failed to set parameter with LabVIEW.\n";
-        opserr << rData << endln;
+        opserr << recvMsg->getToken(0) << endln;
         delete theSocket;
         exit(OF_ReturnType_failed);
     }
@@ -279,7 +268,7 @@ ECLabVIEW::ECLabVIEW(int tag, int nTrialCPs, ExperimentalCP** trialcps,
 
 ECLabVIEW::ECLabVIEW(const ECLabVIEW& ec)
     : ExperimentalControl(ec),
-    theSocket(0), sData(0), sendData(0), rData(0), recvData(0),
+    theSocket(0), sendMsg(0), sendData(0), recvMsg(0), recvData(0),
     numCtrlSignals(0), numDaqSignals(0),
     ctrlDisp(0), ctrlForce(0), daqDisp(0), daqForce(0),
     trialSigOffset(0), ctrlSigOffset(0), daqSigOffset(0),
@@ -297,17 +286,12 @@ ECLabVIEW::ECLabVIEW(const ECLabVIEW& ec)
     ipPort = ec.ipPort;
     theSocket = ec.theSocket;
     
-    // allocate memory for the send messages
-    const int dataSize = 512;
-    sData = new char[dataSize];
-    sendData = new Message(sData, dataSize);
-    
-    // allocate memory for the receive messages
-    rData = new char[dataSize];
-    recvData = new Message(rData, dataSize);
-    
     numCtrlSignals = ec.numCtrlSignals;
     numDaqSignals = ec.numDaqSignals;
+    
+    // allocate memory for the send and receive messages
+    this->allocateMessages();
+    
     gotRelativeTrial = ec.gotRelativeTrial;
 }
 
@@ -331,28 +315,22 @@ ECLabVIEW::~ECLabVIEW()
         delete[] ipAddress;
     
     // close the session with LabVIEW
-    sprintf(sData, "close-session\tOpenFresco\n");
-    fprintf(logFile, "%s", sData);
-    delete sendData;  sendData = new Message(sData, (int)strlen(sData));  // needed because of bug in LabVIEW-plugin
-    theSocket->sendMsg(0, 0, *sendData, 0);
-    theSocket->recvMsgUnknownSize(0, 0, *recvData, 0);
-    fprintf(logFile, "%s", rData);
-    
-    if (strcmp(strtok(rData, "\t"), "OK") != 0) {
+    this->closeSession();
+    if (this->recvReply() != 0) {
         opserr << "ECLabVIEW::~ECLabVIEW() - "
             << "failed to close the current session with LabVIEW.\n";
-        opserr << rData << endln;
+        opserr << recvMsg->getToken(0) << endln;
     }
     
     // close connection by destroying theSocket
     if (sendData != 0)
         delete sendData;
-    if (sData != 0)
-        delete[] sData;
+    if (sendMsg != 0)
+        delete sendMsg;
     if (recvData != 0)
         delete recvData;
-    if (rData != 0)
-        delete[] rData;
+    if (recvMsg != 0)
+        delete recvMsg;
     if (theSocket != 0)
         delete theSocket;
     
@@ -436,10 +414,7 @@ int ECLabVIEW::setup()
     int c = getchar();
     if (c == 'c') {
         getchar();
-        sprintf(sData, "close-session\tOpenFresco\n");
-        fprintf(logFile, "%s", sData);
-        delete sendData;  sendData = new Message(sData, (int)strlen(sData));  // needed because of bug in LabVIEW-plugin
-        theSocket->sendMsg(0, 0, *sendData, 0);
+        this->closeSession();
         delete theSocket;
         exit(OF_ReturnType_failed);
     }
@@ -469,10 +444,7 @@ int ECLabVIEW::setup()
         c = getchar();
         if (c == 'c') {
             getchar();
-            sprintf(sData, "close-session\tOpenFresco\n");
-            fprintf(logFile, "%s", sData);
-            delete sendData;  sendData = new Message(sData, (int)strlen(sData));  // needed because of bug in LabVIEW-plugin
-            theSocket->sendMsg(0, 0, *sendData, 0);
+            this->closeSession();
             delete theSocket;
             exit(OF_ReturnType_failed);
         }
@@ -514,9 +486,7 @@ int ECLabVIEW::setSize(ID sizeT, ID sizeO)
         (sizeOForce != 0 && sizeOForce != sizeO(OF_Resp_Force))) {
         opserr << "ECLabVIEW::setSize() - wrong sizeTrial/Out\n";
         opserr << "see User Manual.\n";
-        sprintf(sData, "close-session\tOpenFresco\n");
-        delete sendData;  sendData = new Message(sData, (int)strlen(sData));  // needed because of bug in LabVIEW-plugin
-        theSocket->sendMsg(0, 0, *sendData, 0);
+        this->closeSession();
         delete theSocket;
         exit(OF_ReturnType_failed);
     }
@@ -726,78 +696,79 @@ int ECLabVIEW::control()
     
     // propose ctrl values
     int dID = 0, fID = 0;
-    sprintf(sData, "propose\t%s", OPFTransactionID);
+    sendMsg->clear();
+    sendMsg->append("propose").append(OPFTransactionID);
     
     // loop through all the trial control points
     for (int i = 0; i < numTrialCPs; i++) {
         // append trial control point name
         if (i == 0)
-            sprintf(sData, "%s\tMDL-00-01", sData);
-        //sprintf(sData,"%s\tCPNode%02d",sData,trialCPs[i]->getNodeTag());
+            sendMsg->append("MDL-00-01");
+        //sendMsg->append("CPNode", trialCPs[i]->getNodeTag());
         else
-            sprintf(sData, "%s\tcontrol-point\tCPNode%02d", sData, trialCPs[i]->getNodeTag());
+            sendMsg->append("control-point").append("CPNode", trialCPs[i]->getNodeTag());
         
         // get trial control point parameters
         int ndm = trialCPs[i]->getNodeNDM();
         int numSignals = trialCPs[i]->getNumSignal();
-        ID dof = trialCPs[i]->getDOF();
-        ID rsp = trialCPs[i]->getRspType();
-        Vector fact = trialCPs[i]->getFactor();
+        const ID& dof = trialCPs[i]->getDOF();
+        const ID& rsp = trialCPs[i]->getRspType();
+        const Vector& fact = trialCPs[i]->getFactor();
+        bool checkLimits = trialCPs[i]->hasLimits();
         
-        if (trialCPs[i]->hasLimits()) {
-            // loop through all the trial control point parameters
-            // and check if commands are within given limits
-            double parameter; int c;
-            for (int j = 0; j < numSignals; j++) {
-                // append GeomType
-                if (dof(j) == 0 || dof(j) == 3) {
-                    sprintf(sData, "%s\tx", sData);
-                }
-                else if (dof(j) == 1 || dof(j) == 4) {
-                    sprintf(sData, "%s\ty", sData);
-                }
-                else if (dof(j) == 2 || dof(j) == 5) {
-                    sprintf(sData, "%s\tz", sData);
-                }
-                else {
-                    opserr << "ECLabVIEW::control() - "
-                        << "requested dof is not supported.\n";
-                    exit(OF_ReturnType_failed);
-                }
-                // append ParameterType
-                if (dof(j) < ndm && rsp(j) == OF_Resp_Disp) {
-                    parameter = fact(j) * (*ctrlDisp)(dID);
-                    sprintf(sData, "%s\tdisplacement", sData);
-                    dID++;
-                }
-                else if (dof(j) < ndm && rsp(j) == OF_Resp_Force) {
-                    parameter = fact(j) * (*ctrlForce)(fID);
-                    sprintf(sData, "%s\tforce", sData);
-                    fID++;
-                }
-                else if (dof(j) >= ndm && rsp(j) == OF_Resp_Disp) {
-                    parameter = fact(j) * (*ctrlDisp)(dID);
-                    sprintf(sData, "%s\trotation", sData);
-                    dID++;
-                }
-                else if (dof(j) >= ndm && rsp(j) == OF_Resp_Force) {
-                    parameter = fact(j) * (*ctrlForce)(fID);
-                    sprintf(sData, "%s\tmoment", sData);
-                    fID++;
-                }
-                else {
-                    opserr << "ECLabVIEW::control() - "
-                        << "requested response type is not supported.\n";
-                    exit(OF_ReturnType_failed);
-                }
-                // check if parameter is within limits and append
-                Vector lowerLim = trialCPs[i]->getLowerLimit();
-                Vector upperLim = trialCPs[i]->getUpperLimit();
-                if (parameter < lowerLim(j) || parameter > upperLim(j)) {
+        // loop through all the trial control point parameters
+        double parameter; int c;
+        for (int j = 0; j < numSignals; j++) {
+            // append GeomType
+            if (dof(j) == 0 || dof(j) == 3) {
+                sendMsg->append("x");
+            }
+            else if (dof(j) == 1 || dof(j) == 4) {
+                sendMsg->append("y");
+            }
+            else if (dof(j) == 2 || dof(j) == 5) {
+                sendMsg->append("z");
+            }
+            else {
+                opserr << "ECLabVIEW::control() - "
+                    << "requested dof is not supported.\n";
+                exit(OF_ReturnType_failed);
+            }
+            // append ParameterType
+            if (dof(j) < ndm && rsp(j) == OF_Resp_Disp) {
+                parameter = fact(j) * (*ctrlDisp)(dID);
+                sendMsg->append("displacement");
+                dID++;
+            }
+            else if (dof(j) < ndm && rsp(j) == OF_Resp_Force) {
+                parameter = fact(j) * (*ctrlForce)(fID);
+                sendMsg->append("force");
+                fID++;
+            }
+            else if (dof(j) >= ndm && rsp(j) == OF_Resp_Disp) {
+                parameter = fact(j) * (*ctrlDisp)(dID);
+                sendMsg->append("rotation");
+                dID++;
+            }
+            else if (dof(j) >= ndm && rsp(j) == OF_Resp_Force) {
+                parameter = fact(j) * (*ctrlForce)(fID);
+                sendMsg->append("moment");
+                fID++;
+            }
+            else {
+                opserr << "ECLabVIEW::control() - "
+                    << "requested response type is not supported.\n";
+                exit(OF_ReturnType_failed);
+            }
+            // check if parameter is within limits
+            if (checkLimits) {
+                double lowerLim = trialCPs[i]->getLowerLimit(j);
+                double upperLim = trialCPs[i]->getUpperLimit(j);
+                if (parameter < lowerLim || parameter > upperLim) {
                     opserr << "****************************************************************\n";
                     opserr << "* WARNING - Control command exceeds the limits:\n";
                     opserr << "*\n";
-                    opserr << "* Limits = [" << lowerLim(j) << "," << upperLim(j) << "]";
+                    opserr << "* Limits = [" << lowerLim << "," << upperLim << "]";
                     opserr << " -> Command = " << parameter << endln;
                     opserr << "*\n";
                     opserr << "* Press 'Enter' to continue the test or\n";
@@ -808,89 +779,37 @@ int ECLabVIEW::control()
                     c = getchar();
                     if (c == 'c') {
                         getchar();
-                        sprintf(sData, "close-session\tOpenFresco\n");
-                        fprintf(logFile, "%s", sData);
-                        delete sendData;  sendData = new Message(sData, (int)strlen(sData));  // needed because of bug in LabVIEW-plugin
-                        theSocket->sendMsg(0, 0, *sendData, 0);
+                        this->closeSession();
                         delete theSocket;
                         exit(OF_ReturnType_failed);
                     }
                     else if (c == 's') {
                         getchar();
-                        parameter = (parameter < lowerLim(j)) ? lowerLim(j) : upperLim(j);
+                        parameter = (parameter < lowerLim) ? lowerLim : upperLim;
                     }
                 }
-                sprintf(sData, "%s\t%.10E", sData, parameter);
-            }
-        }
-        else {
-            // loop through all the trial control point parameters
-            // without checking if commands are within limits
-            for (int j = 0; j < numSignals; j++) {
-                // append GeomType
-                if (dof(j) == 0 || dof(j) == 3) {
-                    sprintf(sData, "%s\tx", sData);
-                }
-                else if (dof(j) == 1 || dof(j) == 4) {
-                    sprintf(sData, "%s\ty", sData);
-                }
-                else if (dof(j) == 2 || dof(j) == 5) {
-                    sprintf(sData, "%s\tz", sData);
-                }
-                else {
-                    opserr << "ECLabVIEW::control() - "
-                        << "requested dof is not supported.\n";
-                    exit(OF_ReturnType_failed);
-                }
-                // append ParameterType and Parameter
-                if (dof(j) < ndm && rsp(j) == OF_Resp_Disp) {
-                    sprintf(sData, "%s\tdisplacement\t%.10E", sData, fact(j) * (*ctrlDisp)(dID));
-                    dID++;
-                }
-                else if (dof(j) < ndm && rsp(j) == OF_Resp_Force) {
-                    sprintf(sData, "%s\tforce\t%.10E", sData, fact(j) * (*ctrlForce)(fID));
-                    fID++;
-                }
-                else if (dof(j) >= ndm && rsp(j) == OF_Resp_Disp) {
-                    sprintf(sData, "%s\trotation\t%.10E", sData, fact(j) * (*ctrlDisp)(dID));
-                    dID++;
-                }
-                else if (dof(j) >= ndm && rsp(j) == OF_Resp_Force) {
-                    sprintf(sData, "%s\tmoment\t%.10E", sData, fact(j) * (*ctrlForce)(fID));
-                    fID++;
-                }
-                else {
-                    opserr << "ECLabVIEW::control() - "
-                        << "requested response type is not supported.\n";
-                    exit(OF_ReturnType_failed);
-                }
             }
+            // append Parameter
+            sendMsg->append(parameter);
         }
     }
-    sprintf(sData, "%s\n", sData);
-    fprintf(logFile, "%s", sData);
-    delete sendData;  sendData = new Message(sData, (int)strlen(sData));  // needed because of bug in LabVIEW-plugin
-    theSocket->sendMsg(0, 0, *sendData, 0);
-    theSocket->recvMsgUnknownSize(0, 0, *recvData, 0);
-    fprintf(logFile, "%s", rData);
-    if (strcmp(strtok(rData, "\t"), "OK") != 0) {
+    sendMsg->end();
+    this->sendCommand();
+    if (this->recvReply() != 0) {
         opserr << "ECLabVIEW::control() - "
             << "proposed control values were not accepted.\n";
-        opserr << rData << endln;
+        opserr << recvMsg->getToken(0) << endln;
         exit(OF_ReturnType_failed);
     }
     
     // execute ctrl values
-    sprintf(sData, "execute\t%s\n", OPFTransactionID);
-    fprintf(logFile, "%s", sData);
-    delete sendData;  sendData = new Message(sData, (int)strlen(sData));  // needed because of bug in LabVIEW-plugin
-    theSocket->sendMsg(0, 0, *sendData, 0);
-    theSocket->recvMsgUnknownSize(0, 0, *recvData, 0);
-    fprintf(logFile, "%s", rData);
-    if (strcmp(strtok(rData, "\t"), "OK") != 0) {
+    sendMsg->clear();
+    sendMsg->append("execute").append(OPFTransactionID).end();
+    this->sendCommand();
+    if (this->recvReply() != 0) {
         opserr << "ECLabVIEW::control() - "
             << "failed to execute proposed control values.\n";
-        opserr << rData << endln;
+        opserr << recvMsg->getToken(0) << endln;
         exit(OF_ReturnType_failed);
     }
     
@@ -900,126 +819,94 @@ int ECLabVIEW::control()
 
 int ECLabVIEW::acquire()
 {
-    char* tokenPtr;
-    char cpName[17];
-    char GeomType[2];
-    char ParamType[13];
-    double Parameter;
-    
     // send acquisition request
-    sprintf(sData, "get-control-point\t%s", OPFTransactionID);
+    sendMsg->clear();
+    sendMsg->append("get-control-point").append(OPFTransactionID);
     for (int i = 0; i < numOutCPs; i++) {
         // append output control point name
-        sprintf(sData, "%s\tMDL-00-01", sData);
-        //sprintf(sData,"%s\tCPNode%02d",sData,outCPs[i]->getNodeTag());
+        sendMsg->append("MDL-00-01");
+        //sendMsg->append("CPNode", outCPs[i]->getNodeTag());
     }
-    sprintf(sData, "%s\n", sData);
-    fprintf(logFile, "%s", sData);
-    delete sendData;  sendData = new Message(sData, (int)strlen(sData));  // needed because of bug in LabVIEW-plugin
-    theSocket->sendMsg(0, 0, *sendData, 0);
+    sendMsg->end();
+    this->sendCommand();
     
     // receive output control point daq values
-    int direction = 0, response = 0;
     int dID = 0, fID = 0;
     for (int i = 0; i < numOutCPs; i++) {
         // disaggregate received data
-        theSocket->recvMsgUnknownSize(0, 0, *recvData, 0);
-        fprintf(logFile, "%s", rData);
-        if (strcmp(strtok(rData, "\t"), "OK") != 0) {
+        if (this->recvReply() != 0) {
             opserr << "ECLabVIEW::acquire() - "
                 << "failed to acquire control-point "
                 << outCPs[i]->getTag() << " values.\n";
-            opserr << rData << endln;
+            opserr << recvMsg->getToken(0) << endln;
             exit(OF_ReturnType_failed);
         }
-        tokenPtr = strtok(NULL, "\t");
-        tokenPtr = strtok(NULL, "\t");
-        if (strcmp(tokenPtr, OPFTransactionID) != 0) {
+        int numTokens = recvMsg->getNumTokens();
+        if (numTokens < 4 ||
+            strcmp(recvMsg->getToken(2), OPFTransactionID) != 0) {
             opserr << "ECLabVIEW::acquire() - "
                 << "received wrong OPFTransactionID\n"
                 << " want: " << OPFTransactionID
-                << " but got: " << tokenPtr << endln;
+                << " but got: " << (numTokens > 2 ? recvMsg->getToken(2) : "")
+                << endln;
             exit(OF_ReturnType_failed);
         }
-        tokenPtr = strtok(NULL, "\t");
-        sprintf(cpName, "MDL-00-01");
+        const char* cpName = "MDL-00-01";
         //sprintf(cpName,"CPNode%02d",outCPs[i]->getNodeTag());
-        if (strcmp(tokenPtr, cpName) != 0) {
+        if (strcmp(recvMsg->getToken(3), cpName) != 0) {
             opserr << "ECLabVIEW::acquire() - "
                 << "received wrong control-point\n"
                 << " want: " << cpName
-                << " but got: " << tokenPtr << endln;
+                << " but got: " << recvMsg->getToken(3) << endln;
             exit(OF_ReturnType_failed);
         }
-        tokenPtr = strtok(NULL, "\t");
         
         // get output control point parameters
-        int ndf = trialCPs[i]->getNodeNDF();
+        int ndf = outCPs[i]->getNodeNDF();
         int numSignals = outCPs[i]->getNumSignal();
-        ID dof = outCPs[i]->getDOF();
-        ID rsp = outCPs[i]->getRspType();
-        Vector fact = outCPs[i]->getFactor();
-        ID sizeRespType = outCPs[i]->getSizeRspType();
+        const ID& dof = outCPs[i]->getDOF();
+        const ID& rsp = outCPs[i]->getRspType();
+        const Vector& fact = outCPs[i]->getFactor();
+        const ID& sizeRespType = outCPs[i]->getSizeRspType();
         int sizeDisp = 0, sizeForce = 0;
         
-        while (tokenPtr != NULL) {
-            strcpy(GeomType, tokenPtr);
-            strcpy(ParamType, strtok(NULL, "\t"));
-            Parameter = atof(strtok(NULL, "\t"));
-            if (strcmp(GeomType, "x") == 0) {
-                if (strcmp(ParamType, "displacement") == 0) {
-                    direction = 0;
-                    response = OF_Resp_Disp;
-                }
-                else if (strcmp(ParamType, "force") == 0) {
-                    direction = 0;
-                    response = OF_Resp_Force;
-                }
-                else if (strcmp(ParamType, "rotation") == 0) {
-                    direction = 3;
-                    response = OF_Resp_Disp;
-                }
-                else if (strcmp(ParamType, "moment") == 0) {
-                    direction = 3;
-                    response = OF_Resp_Force;
-                }
-            }
-            else if (strcmp(GeomType, "y") == 0) {
-                if (strcmp(ParamType, "displacement") == 0) {
-                    direction = 1;
-                    response = OF_Resp_Disp;
-                }
-                else if (strcmp(ParamType, "force") == 0) {
-                    direction = 1;
-                    response = OF_Resp_Force;
-                }
-                else if (strcmp(ParamType, "rotation") == 0) {
-                    direction = 4;
-                    response = OF_Resp_Disp;
-                }
-                else if (strcmp(ParamType, "moment") == 0) {
-                    direction = 4;
-                    response = OF_Resp_Force;
-                }
-            }
-            else if (strcmp(GeomType, "z") == 0) {
-                if (strcmp(ParamType, "displacement") == 0) {
-                    direction = 2;
-                    response = OF_Resp_Disp;
-                }
-                else if (strcmp(ParamType, "force") == 0) {
-                    direction = 2;
-                    response = OF_Resp_Force;
-                }
-                else if (strcmp(ParamType, "rotation") == 0) {
-                    direction = ndf - 1;
-                    response = OF_Resp_Disp;
-                }
-                else if (strcmp(ParamType, "moment") == 0) {
-                    direction = ndf - 1;
-                    response = OF_Resp_Force;
-                }
+        // loop through the GeomType, ParameterType, Parameter triplets
+        for (int k = 4; k + 2 < numTokens; k += 3) {
+            const char* geomType = recvMsg->getToken(k);
+            const char* paramType = recvMsg->getToken(k + 1);
+            double parameter = strtod(recvMsg->getToken(k + 2), 0);
+            
+            int axis = geomType[0] - 'x';
+            if (axis < 0 || axis > 2 || geomType[1] != '\0')
+                continue;
+            int direction, response;
+            const char* paramName;
+            switch (paramType[0]) {
+            case 'd':
+                paramName = "displacement";
+                direction = axis;
+                response = OF_Resp_Disp;
+                break;
+            case 'f':
+                paramName = "force";
+                direction = axis;
+                response = OF_Resp_Force;
+                break;
+            case 'r':
+                paramName = "rotation";
+                direction = (axis == 2) ? ndf - 1 : axis + 3;
+                response = OF_Resp_Disp;
+                break;
+            case 'm':
+                paramName = "moment";
+                direction = (axis == 2) ? ndf - 1 : axis + 3;
+                response = OF_Resp_Force;
+                break;
+            default:
+                continue;
             }
+            if (strcmp(paramType, paramName) != 0)
+                continue;
             if (direction > ndf) {
                 opserr << "ECLabVIEW::acquire() - "
                     << "received wrong direction\n"
@@ -1034,7 +921,7 @@ int ECLabVIEW::acquire()
                 for (int j = 0; j < numSignals; j++) {
                     if (rsp(j) == response) {
                         if (dof(j) == direction) {
-                            (*daqDisp)(id) = fact(j) * Parameter;
+                            (*daqDisp)(id) = fact(j) * parameter;
                             sizeDisp++;
                         }
                         id++;
@@ -1046,14 +933,13 @@ int ECLabVIEW::acquire()
                 for (int j = 0; j < numSignals; j++) {
                     if (rsp(j) == response) {
                         if (dof(j) == direction) {
-                            (*daqForce)(id) = fact(j) * Parameter;
+                            (*daqForce)(id) = fact(j) * parameter;
                             sizeForce++;
                         }
                         id++;
                     }
                 }
             }
-            tokenPtr = strtok(NULL, "\t");
         }
         
         // check if received number of parameters is correct
@@ -1070,3 +956,55 @@ int ECLabVIEW::acquire()
     
     return OF_ReturnType_completed;
 }
+
+
+void ECLabVIEW::allocateMessages()
+{
+    // size the buffers for the number of signals, so that
+    // they do not need to grow while the test is running
+    sendMsg = new LabVIEWMessage(512 + 64 * numCtrlSignals);
+    sendData = new Message(sendMsg->getData(), 0);
+    
+    recvMsg = new LabVIEWMessage(4096 + 128 * (numCtrlSignals + numDaqSignals));
+    recvData = new Message(recvMsg->getData(), recvMsg->getCapacity());
+}
+
+
+int ECLabVIEW::sendCommand()
+{
+    fprintf(logFile, "%s", sendMsg->getData());
+    
+    // only send the characters of the message
+    // (needed because of bug in LabVIEW-plugin)
+    sendData->setData(sendMsg->getData(), sendMsg->getSize());
+    
+    return theSocket->sendMsg(0, 0, *sendData, 0);
+}
+
+
+int ECLabVIEW::recvReply()
+{
+    // LabVIEW might send the replies for several control points
+    // at once, so only receive if no reply is left in the buffer
+    if (!recvMsg->hasNextLine()) {
+        recvMsg->clear();
+        recvData->setData(recvMsg->getData(), recvMsg->getCapacity());
+        theSocket->recvMsgUnknownSize(0, 0, *recvData, 0);
+        fprintf(logFile, "%s", recvMsg->getData());
+    }
+    
+    // split reply into tokens and check if it is OK
+    recvMsg->tokenize();
+    if (strcmp(recvMsg->getToken(0), "OK") != 0)
+        return -1;
+    
+    return 0;
+}
+
+
+void ECLabVIEW::closeSession()
+{
+    sendMsg->clear();
+    sendMsg->append("close-session").append("OpenFresco").end();
+    this->sendCommand();
+}
@@ -37,6 +37,7 @@
 class ExperimentalCP;
 class TCP_Socket;
 class Message;
+class LabVIEWMessage;
 
 class ECLabVIEW : public ExperimentalControl
 {
@@ -89,6 +90,11 @@ protected:
     virtual int acquire();
 
 private:
+    void allocateMessages();
+    int sendCommand();
+    int recvReply();
+    void closeSession();
+    
     int numTrialCPs;            // number of trial control points
     ExperimentalCP** trialCPs;  // trial control points
     int numOutCPs;              // number of output control points
@@ -96,11 +102,11 @@ private:
     char* ipAddress;            // ip address
     int ipPort;                 // ip port
     
-    TCP_Socket* theSocket;  // tcp/ip socket
-    char* sData;            // send data array
-    Message* sendData;      // send vector
-    char* rData;            // receive data array
-    Message* recvData;      // receive vector
+    TCP_Socket* theSocket;      // tcp/ip socket
+    LabVIEWMessage* sendMsg;    // send message buffer
+    Message* sendData;          // send message
+    LabVIEWMessage* recvMsg;    // receive message buffer
+    Message* recvData;          // receive message
     
     int numCtrlSignals, numDaqSignals;   // number of signals
     Vector* ctrlDisp, * ctrlForce;       // control vectors
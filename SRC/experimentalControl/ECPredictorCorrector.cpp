@@ -0,0 +1,1007 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation of the
+// ECPredictorCorrector class.
+
+#include "ECPredictorCorrector.h"
+#include "Simulink/HybridSimToolbox/PredictorCorrector.hpp"
+
+#include <elementAPI.h>
+
+#include <chrono>
+#include <errno.h>
+
+#if defined(_LINUX)
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <time.h>
+#elif defined(_WIN32)
+#include <windows.h>
+#endif
+
+
+void* OPF_ECPredictorCorrector()
+{
+    // pointer to experimental control that will be returned
+    ExperimentalControl* theControl = 0;
+    
+    if (OPS_GetNumRemainingInputArgs() < 3) {
+        opserr << "WARNING invalid number of arguments\n";
+        opserr << "Want: expControl PredictorCorrector tag ctrlTag dtSim "
+            << "<-rate rate> <-order order> <-predMax xMax> "
+            << "<-priority prio> <-cpu cpuID> "
+            << "<-ctrlFilters (5 filterTag)> <-daqFilters (5 filterTag)>\n";
+        return 0;
+    }
+    
+    // control tag
+    int tag;
+    int numdata = 1;
+    if (OPS_GetIntInput(&numdata, &tag) != 0) {
+        opserr << "WARNING invalid expControl PredictorCorrector tag\n";
+        return 0;
+    }
+    
+    // wrapped control
+    int ctrlTag;
+    numdata = 1;
+    if (OPS_GetIntInput(&numdata, &ctrlTag) != 0) {
+        opserr << "WARNING invalid ctrlTag\n";
+        opserr << "expControl PredictorCorrector " << tag << endln;
+        return 0;
+    }
+    ExperimentalControl* theCtrl = OPF_getExperimentalControl(ctrlTag);
+    if (theCtrl == 0) {
+        opserr << "WARNING experimental control not found\n";
+        opserr << "expControl " << ctrlTag << endln;
+        opserr << "expControl PredictorCorrector " << tag << endln;
+        return 0;
+    }
+    
+    // simulation time step size
+    double dtSim;
+    numdata = 1;
+    if (OPS_GetDoubleInput(&numdata, &dtSim) != 0 || dtSim <= 0.0) {
+        opserr << "WARNING invalid dtSim\n";
+        opserr << "expControl PredictorCorrector " << tag << endln;
+        return 0;
+    }
+    
+    // optional parameters
+    double rate = 1024.0;
+    int order = 3;
+    double predMax = 0.6;
+    int priority = 0;
+    int cpuID = -1;
+    while (OPS_GetNumRemainingInputArgs() > 0) {
+        const char* type = OPS_GetString();
+        if (strcmp(type, "-rate") == 0) {
+            numdata = 1;
+            if (OPS_GetDoubleInput(&numdata, &rate) != 0 || rate <= 0.0) {
+                opserr << "WARNING invalid rate\n";
+                opserr << "expControl PredictorCorrector " << tag << endln;
+                return 0;
+            }
+        }
+        else if (strcmp(type, "-order") == 0) {
+            numdata = 1;
+            if (OPS_GetIntInput(&numdata, &order) != 0 ||
+                order < 1 || order > 3) {
+                opserr << "WARNING invalid order, want 1, 2 or 3\n";
+                opserr << "expControl PredictorCorrector " << tag << endln;
+                return 0;
+            }
+        }
+        else if (strcmp(type, "-predMax") == 0) {
+            numdata = 1;
+            if (OPS_GetDoubleInput(&numdata, &predMax) != 0 ||
+                predMax < 0.0 || predMax >= 1.0) {
+                opserr << "WARNING invalid predMax, want 0 <= predMax < 1\n";
+                opserr << "expControl PredictorCorrector " << tag << endln;
+                return 0;
+            }
+        }
+        else if (strcmp(type, "-priority") == 0) {
+            numdata = 1;
+            if (OPS_GetIntInput(&numdata, &priority) != 0 || priority < 0) {
+                opserr << "WARNING invalid priority\n";
+                opserr << "expControl PredictorCorrector " << tag << endln;
+                return 0;
+            }
+        }
+        else if (strcmp(type, "-cpu") == 0) {
+            numdata = 1;
+            if (OPS_GetIntInput(&numdata, &cpuID) != 0 || cpuID < 0) {
+                opserr << "WARNING invalid cpuID\n";
+                opserr << "expControl PredictorCorrector " << tag << endln;
+                return 0;
+            }
+        }
+        else {
+            // move current arg back by one
+            OPS_ResetCurrentInputArg(-1);
+            break;
+        }
+    }
+    if (dtSim*rate < 1.0) {
+        opserr << "WARNING dtSim*rate < 1, "
+            << "need at least one controller tick per step\n";
+        opserr << "expControl PredictorCorrector " << tag << endln;
+        return 0;
+    }
+    
+    // parsing was successful, allocate the control
+    theControl = new ECPredictorCorrector(tag, theCtrl, dtSim, rate,
+        order, predMax, priority, cpuID);
+    if (theControl == 0) {
+        opserr << "WARNING could not create experimental control of type PredictorCorrector\n";
+        return 0;
+    }
+    
+    return theControl;
+}
+
+
+// monotonic clock in nanoseconds
+static long long rtClock()
+{
+#if defined(_LINUX)
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec*1000000000LL + ts.tv_nsec;
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+
+// sleep until absolute time t of the monotonic clock
+static void rtSleepUntil(long long t)
+{
+#if defined(_LINUX)
+    struct timespec ts;
+    ts.tv_sec = t/1000000000LL;
+    ts.tv_nsec = t%1000000000LL;
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, 0) == EINTR);
+#else
+    std::this_thread::sleep_until(std::chrono::steady_clock::time_point(
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::nanoseconds(t))));
+#endif
+}
+
+
+ECPredictorCorrector::ECPredictorCorrector(int tag,
+    ExperimentalControl *control, double dtsim, double rt,
+    int ord, double predmax, int prio, int cpuid)
+    : ExperimentalControl(tag),
+    theControl(0), thePC(0),
+    dtSim(dtsim), rate(rt), order(ord), predMax(predmax),
+    priority(prio), cpuID(cpuid),
+    dx(1.0/(dtsim*rt)), x(0.0), correcting(false),
+    ctrlDisp(0), ctrlVel(0), ctrlAccel(0), ctrlForce(0), ctrlTime(0),
+    daqDisp(0), daqVel(0), daqAccel(0), daqForce(0), daqTime(0),
+    cmdSig(0), cmdSigDot(0), cmdSigDotDot(0), tgtSig(0),
+    cmdDisp(0), cmdVel(0), cmdAccel(0), cmdForce(0), cmdTime(0),
+    running(false), newTarget(false), numTargets(0), numReached(0),
+    rtStatus(OF_ReturnType_completed),
+    numTicks(0), numOverruns(0), numHoldTicks(0),
+    maxLatency(0.0), sumLatency(0.0), maxExecTime(0.0), rtStats(0)
+{
+    if (control == 0)  {
+        opserr << "ECPredictorCorrector::ECPredictorCorrector() - "
+            << "null control pointer passed.\n";
+        exit(OF_ReturnType_failed);
+    }
+    
+    // get a copy of the wrapped control
+    theControl = control->getCopy();
+    if (theControl == 0)  {
+        opserr << "ECPredictorCorrector::ECPredictorCorrector() - "
+            << "failed to get a copy of the wrapped control.\n";
+        exit(OF_ReturnType_failed);
+    }
+    
+    thePC = new PredictorCorrector();
+    rtStats = new Vector(6);
+}
+
+
+ECPredictorCorrector::ECPredictorCorrector(const ECPredictorCorrector& ec)
+    : ExperimentalControl(ec),
+    theControl(0), thePC(0),
+    dtSim(ec.dtSim), rate(ec.rate), order(ec.order), predMax(ec.predMax),
+    priority(ec.priority), cpuID(ec.cpuID),
+    dx(ec.dx), x(0.0), correcting(false),
+    ctrlDisp(0), ctrlVel(0), ctrlAccel(0), ctrlForce(0), ctrlTime(0),
+    daqDisp(0), daqVel(0), daqAccel(0), daqForce(0), daqTime(0),
+    cmdSig(0), cmdSigDot(0), cmdSigDotDot(0), tgtSig(0),
+    cmdDisp(0), cmdVel(0), cmdAccel(0), cmdForce(0), cmdTime(0),
+    running(false), newTarget(false), numTargets(0), numReached(0),
+    rtStatus(OF_ReturnType_completed),
+    numTicks(0), numOverruns(0), numHoldTicks(0),
+    maxLatency(0.0), sumLatency(0.0), maxExecTime(0.0), rtStats(0)
+{
+    theControl = ec.theControl->getCopy();
+    if (theControl == 0)  {
+        opserr << "ECPredictorCorrector::ECPredictorCorrector() - "
+            << "failed to get a copy of the wrapped control.\n";
+        exit(OF_ReturnType_failed);
+    }
+    
+    thePC = new PredictorCorrector();
+    rtStats = new Vector(6);
+}
+
+
+ECPredictorCorrector::~ECPredictorCorrector()
+{
+    // stop the real-time thread
+    this->stopThread();
+    
+    if (theControl != 0)
+        delete theControl;
+    if (thePC != 0)
+        delete thePC;
+    
+    // delete memory of ctrl vectors
+    if (ctrlDisp != 0)
+        delete ctrlDisp;
+    if (ctrlVel != 0)
+        delete ctrlVel;
+    if (ctrlAccel != 0)
+        delete ctrlAccel;
+    if (ctrlForce != 0)
+        delete ctrlForce;
+    if (ctrlTime != 0)
+        delete ctrlTime;
+    
+    // delete memory of daq vectors
+    if (daqDisp != 0)
+        delete daqDisp;
+    if (daqVel != 0)
+        delete daqVel;
+    if (daqAccel != 0)
+        delete daqAccel;
+    if (daqForce != 0)
+        delete daqForce;
+    if (daqTime != 0)
+        delete daqTime;
+    
+    // delete memory of command vectors
+    if (cmdDisp != 0)
+        delete cmdDisp;
+    if (cmdVel != 0)
+        delete cmdVel;
+    if (cmdAccel != 0)
+        delete cmdAccel;
+    if (cmdForce != 0)
+        delete cmdForce;
+    if (cmdTime != 0)
+        delete cmdTime;
+    if (cmdSig != 0)
+        delete [] cmdSig;
+    if (cmdSigDot != 0)
+        delete [] cmdSigDot;
+    if (cmdSigDotDot != 0)
+        delete [] cmdSigDotDot;
+    if (tgtSig != 0)
+        delete [] tgtSig;
+    
+    if (rtStats != 0)
+        delete rtStats;
+}
+
+
+int ECPredictorCorrector::setup()
+{
+    int rValue = 0;
+    
+    // the loop must not run while the vectors are reallocated
+    this->stopThread();
+    
+    if (ctrlDisp != 0)
+        delete ctrlDisp;
+    if (ctrlVel != 0)
+        delete ctrlVel;
+    if (ctrlAccel != 0)
+        delete ctrlAccel;
+    if (ctrlForce != 0)
+        delete ctrlForce;
+    if (ctrlTime != 0)
+        delete ctrlTime;
+    ctrlDisp = ctrlVel = ctrlAccel = ctrlForce = ctrlTime = 0;
+    
+    if ((*sizeCtrl)(OF_Resp_Disp) != 0)  {
+        ctrlDisp = new Vector((*sizeCtrl)(OF_Resp_Disp));
+        ctrlDisp->Zero();
+    }
+    if ((*sizeCtrl)(OF_Resp_Vel) != 0)  {
+        ctrlVel = new Vector((*sizeCtrl)(OF_Resp_Vel));
+        ctrlVel->Zero();
+    }
+    if ((*sizeCtrl)(OF_Resp_Accel) != 0)  {
+        ctrlAccel = new Vector((*sizeCtrl)(OF_Resp_Accel));
+        ctrlAccel->Zero();
+    }
+    if ((*sizeCtrl)(OF_Resp_Force) != 0)  {
+        ctrlForce = new Vector((*sizeCtrl)(OF_Resp_Force));
+        ctrlForce->Zero();
+    }
+    if ((*sizeCtrl)(OF_Resp_Time) != 0)  {
+        ctrlTime = new Vector((*sizeCtrl)(OF_Resp_Time));
+        ctrlTime->Zero();
+    }
+    
+    if (daqDisp != 0)
+        delete daqDisp;
+    if (daqVel != 0)
+        delete daqVel;
+    if (daqAccel != 0)
+        delete daqAccel;
+    if (daqForce != 0)
+        delete daqForce;
+    if (daqTime != 0)
+        delete daqTime;
+    daqDisp = daqVel = daqAccel = daqForce = daqTime = 0;
+    
+    if ((*sizeDaq)(OF_Resp_Disp) != 0)  {
+        daqDisp = new Vector((*sizeDaq)(OF_Resp_Disp));
+        daqDisp->Zero();
+    }
+    if ((*sizeDaq)(OF_Resp_Vel) != 0)  {
+        daqVel = new Vector((*sizeDaq)(OF_Resp_Vel));
+        daqVel->Zero();
+    }
+    if ((*sizeDaq)(OF_Resp_Accel) != 0)  {
+        daqAccel = new Vector((*sizeDaq)(OF_Resp_Accel));
+        daqAccel->Zero();
+    }
+    if ((*sizeDaq)(OF_Resp_Force) != 0)  {
+        daqForce = new Vector((*sizeDaq)(OF_Resp_Force));
+        daqForce->Zero();
+    }
+    if ((*sizeDaq)(OF_Resp_Time) != 0)  {
+        daqTime = new Vector((*sizeDaq)(OF_Resp_Time));
+        daqTime->Zero();
+    }
+    
+    // the commands wrap the signal arrays of the predictor-corrector
+    int nDOF = (*sizeCtrl)(OF_Resp_Disp);
+    if (cmdDisp != 0)
+        delete cmdDisp;
+    if (cmdVel != 0)
+        delete cmdVel;
+    if (cmdAccel != 0)
+        delete cmdAccel;
+    if (cmdForce != 0)
+        delete cmdForce;
+    if (cmdTime != 0)
+        delete cmdTime;
+    cmdDisp = cmdVel = cmdAccel = cmdForce = cmdTime = 0;
+    if (cmdSig != 0)
+        delete [] cmdSig;
+    if (cmdSigDot != 0)
+        delete [] cmdSigDot;
+    if (cmdSigDotDot != 0)
+        delete [] cmdSigDotDot;
+    if (tgtSig != 0)
+        delete [] tgtSig;
+    
+    cmdSig = new double [nDOF];
+    cmdSigDot = new double [nDOF];
+    cmdSigDotDot = new double [nDOF];
+    tgtSig = new double [nDOF];
+    for (int i=0; i<nDOF; i++)
+        cmdSig[i] = cmdSigDot[i] = cmdSigDotDot[i] = tgtSig[i] = 0.0;
+    
+    cmdDisp = new Vector(cmdSig, nDOF);
+    if ((*sizeCtrl)(OF_Resp_Vel) != 0)
+        cmdVel = new Vector(cmdSigDot, nDOF);
+    if ((*sizeCtrl)(OF_Resp_Accel) != 0)
+        cmdAccel = new Vector(cmdSigDotDot, nDOF);
+    if ((*sizeCtrl)(OF_Resp_Force) != 0)  {
+        cmdForce = new Vector((*sizeCtrl)(OF_Resp_Force));
+        cmdForce->Zero();
+    }
+    if ((*sizeCtrl)(OF_Resp_Time) != 0)  {
+        cmdTime = new Vector((*sizeCtrl)(OF_Resp_Time));
+        cmdTime->Zero();
+    }
+    
+    // start the polynomials from rest at the initial commands
+    if (thePC->initData(nDOF, 1.0/rate, dtSim, dtSim) != 0)  {
+        opserr << "ECPredictorCorrector::setup() - "
+            << "failed to initialize predictor-corrector.\n";
+        exit(OF_ReturnType_failed);
+    }
+    thePC->setData(cmdSig);
+    thePC->setCurSig(thePC->sig1, 1.0);
+    x = 0.0;
+    correcting = false;
+    
+    newTarget = false;
+    numTargets = numReached = 0;
+    rtStatus = OF_ReturnType_completed;
+    numTicks = numOverruns = numHoldTicks = 0;
+    maxLatency = sumLatency = maxExecTime = 0.0;
+    
+    // print experimental control information
+    //this->Print(opserr);
+    
+    rValue += theControl->setup();
+    
+    return rValue;
+}
+
+
+int ECPredictorCorrector::setSize(ID sizeT, ID sizeO)
+{
+    // check sizeTrial and sizeOut
+    // for ECPredictorCorrector object
+    
+    // ECPredictorCorrector objects generate the commands
+    // from the displacement targets, the remaining trial and
+    // output sizes are determined by the wrapped control
+    if (sizeT(OF_Resp_Disp) == 0)  {
+        opserr << "ECPredictorCorrector::setSize() - wrong sizeTrial/Out\n";
+        opserr << "sizeT(Disp) = 0, need displacement targets\n";
+        opserr << "see User Manual.\n";
+        exit(OF_ReturnType_failed);
+    }
+    
+    theControl->setSize(sizeT, sizeO);
+    
+    *sizeCtrl = theControl->getSizeCtrl();
+    *sizeDaq = theControl->getSizeDaq();
+    
+    int nDOF = (*sizeCtrl)(OF_Resp_Disp);
+    if (nDOF == 0 ||
+        ((*sizeCtrl)(OF_Resp_Vel) != 0 && (*sizeCtrl)(OF_Resp_Vel) != nDOF) ||
+        ((*sizeCtrl)(OF_Resp_Accel) != 0 && (*sizeCtrl)(OF_Resp_Accel) != nDOF))  {
+        opserr << "ECPredictorCorrector::setSize() - wrapped control "
+            << theControl->getTag() << " does not accept "
+            << "displacement commands of consistent size\n";
+        opserr << "sizeCtrl = " << *sizeCtrl;
+        exit(OF_ReturnType_failed);
+    }
+    
+    return OF_ReturnType_completed;
+}
+
+
+int ECPredictorCorrector::setTrialResponse(const Vector* disp,
+    const Vector* vel,
+    const Vector* accel,
+    const Vector* force,
+    const Vector* time)
+{
+    // wait until the loop has reached the previous target
+    {
+        std::unique_lock<std::mutex> lock(pcMutex);
+        stepDone.wait(lock, [this] {
+            return numReached == numTargets || !running; });
+    }
+    
+    int i;
+    if (disp != 0)  {
+        *ctrlDisp = *disp;
+        if (theCtrlFilters[OF_Resp_Disp] != 0)  {
+            for (i=0; i<(*sizeCtrl)(OF_Resp_Disp); i++)
+                (*ctrlDisp)(i) = theCtrlFilters[OF_Resp_Disp]->filtering((*ctrlDisp)(i));
+        }
+    }
+    // the trial velocities and accelerations are only recorded, the
+    // loop commands the derivatives of the displacement polynomials
+    if (vel != 0 && ctrlVel != 0)  {
+        *ctrlVel = *vel;
+        if (theCtrlFilters[OF_Resp_Vel] != 0)  {
+            for (i=0; i<(*sizeCtrl)(OF_Resp_Vel); i++)
+                (*ctrlVel)(i) = theCtrlFilters[OF_Resp_Vel]->filtering((*ctrlVel)(i));
+        }
+    }
+    if (accel != 0 && ctrlAccel != 0)  {
+        *ctrlAccel = *accel;
+        if (theCtrlFilters[OF_Resp_Accel] != 0)  {
+            for (i=0; i<(*sizeCtrl)(OF_Resp_Accel); i++)
+                (*ctrlAccel)(i) = theCtrlFilters[OF_Resp_Accel]->filtering((*ctrlAccel)(i));
+        }
+    }
+    if (force != 0 && ctrlForce != 0)  {
+        *ctrlForce = *force;
+        if (theCtrlFilters[OF_Resp_Force] != 0)  {
+            for (i=0; i<(*sizeCtrl)(OF_Resp_Force); i++)
+                (*ctrlForce)(i) = theCtrlFilters[OF_Resp_Force]->filtering((*ctrlForce)(i));
+        }
+    }
+    if (time != 0 && ctrlTime != 0)  {
+        *ctrlTime = *time;
+        if (theCtrlFilters[OF_Resp_Time] != 0)  {
+            for (i=0; i<(*sizeCtrl)(OF_Resp_Time); i++)
+                (*ctrlTime)(i) = theCtrlFilters[OF_Resp_Time]->filtering((*ctrlTime)(i));
+        }
+    }
+    
+    return this->control();
+}
+
+
+int ECPredictorCorrector::getDaqResponse(Vector* disp,
+    Vector* vel,
+    Vector* accel,
+    Vector* force,
+    Vector* time)
+{
+    int rValue = this->acquire();
+    
+    int i;
+    if (disp != 0 && daqDisp != 0)  {
+        if (theDaqFilters[OF_Resp_Disp] != 0)  {
+            for (i=0; i<(*sizeDaq)(OF_Resp_Disp); i++)
+                (*daqDisp)(i) = theDaqFilters[OF_Resp_Disp]->filtering((*daqDisp)(i));
+        }
+        *disp = *daqDisp;
+    }
+    if (vel != 0 && daqVel != 0)  {
+        if (theDaqFilters[OF_Resp_Vel] != 0)  {
+            for (i=0; i<(*sizeDaq)(OF_Resp_Vel); i++)
+                (*daqVel)(i) = theDaqFilters[OF_Resp_Vel]->filtering((*daqVel)(i));
+        }
+        *vel = *daqVel;
+    }
+    if (accel != 0 && daqAccel != 0)  {
+        if (theDaqFilters[OF_Resp_Accel] != 0)  {
+            for (i=0; i<(*sizeDaq)(OF_Resp_Accel); i++)
+                (*daqAccel)(i) = theDaqFilters[OF_Resp_Accel]->filtering((*daqAccel)(i));
+        }
+        *accel = *daqAccel;
+    }
+    if (force != 0 && daqForce != 0)  {
+        if (theDaqFilters[OF_Resp_Force] != 0)  {
+            for (i=0; i<(*sizeDaq)(OF_Resp_Force); i++)
+                (*daqForce)(i) = theDaqFilters[OF_Resp_Force]->filtering((*daqForce)(i));
+        }
+        *force = *daqForce;
+    }
+    if (time != 0 && daqTime != 0)  {
+        if (theDaqFilters[OF_Resp_Time] != 0)  {
+            for (i=0; i<(*sizeDaq)(OF_Resp_Time); i++)
+                (*daqTime)(i) = theDaqFilters[OF_Resp_Time]->filtering((*daqTime)(i));
+        }
+        *time = *daqTime;
+    }
+    
+    return rValue;
+}
+
+
+int ECPredictorCorrector::commitState()
+{
+    std::lock_guard<std::mutex> lock(innerMutex);
+    
+    theControl->logCommitState();
+    
+    return theControl->commitState();
+}
+
+
+ExperimentalControl* ECPredictorCorrector::getCopy()
+{
+    return new ECPredictorCorrector(*this);
+}
+
+
+Response* ECPredictorCorrector::setResponse(const char **argv, int argc,
+    OPS_Stream &output)
+{
+    int i;
+    char outputData[32];
+    Response *theResponse = 0;
+    
+    output.tag("ExpControlOutput");
+    output.attr("ctrlType",this->getClassType());
+    output.attr("ctrlTag",this->getTag());
+    
+    // ctrl displacements
+    if (ctrlDisp != 0 && (
+        strcmp(argv[0],"ctrlDisp") == 0 ||
+        strcmp(argv[0],"ctrlDisplacement") == 0 ||
+        strcmp(argv[0],"ctrlDisplacements") == 0))
+    {
+        for (i=0; i<(*sizeCtrl)(OF_Resp_Disp); i++)  {
+            snprintf(outputData,sizeof(outputData),"ctrlDisp%d",i+1);
+            output.tag("ResponseType",outputData);
+        }
+        theResponse = new ExpControlResponse(this, 1, *ctrlDisp);
+    }
+    
+    // daq displacements
+    else if (daqDisp != 0 && (
+        strcmp(argv[0],"daqDisp") == 0 ||
+        strcmp(argv[0],"daqDisplacement") == 0 ||
+        strcmp(argv[0],"daqDisplacements") == 0))
+    {
+        for (i=0; i<(*sizeDaq)(OF_Resp_Disp); i++)  {
+            snprintf(outputData,sizeof(outputData),"daqDisp%d",i+1);
+            output.tag("ResponseType",outputData);
+        }
+        theResponse = new ExpControlResponse(this, 2, *daqDisp);
+    }
+    
+    // daq forces
+    else if (daqForce != 0 && (
+        strcmp(argv[0],"daqForce") == 0 ||
+        strcmp(argv[0],"daqForces") == 0))
+    {
+        for (i=0; i<(*sizeDaq)(OF_Resp_Force); i++)  {
+            snprintf(outputData,sizeof(outputData),"daqForce%d",i+1);
+            output.tag("ResponseType",outputData);
+        }
+        theResponse = new ExpControlResponse(this, 3, *daqForce);
+    }
+    
+    // real-time statistics
+    else if (strcmp(argv[0],"rtStats") == 0 ||
+        strcmp(argv[0],"realTimeStats") == 0 ||
+        strcmp(argv[0],"overruns") == 0)
+    {
+        output.tag("ResponseType","numTicks");
+        output.tag("ResponseType","numOverruns");
+        output.tag("ResponseType","numHoldTicks");
+        output.tag("ResponseType","maxLatency");
+        output.tag("ResponseType","meanLatency");
+        output.tag("ResponseType","maxExecTime");
+        theResponse = new ExpControlResponse(this, 4, *rtStats);
+    }
+    
+    output.endTag();
+    
+    return theResponse;
+}
+
+
+int ECPredictorCorrector::getResponse(int responseID, Information &info)
+{
+    switch (responseID)  {
+    case 1:  // ctrl displacements
+        return info.setVector(*ctrlDisp);
+        
+    case 2:  // daq displacements
+        return info.setVector(*daqDisp);
+        
+    case 3:  // daq forces
+        return info.setVector(*daqForce);
+        
+    case 4:  // real-time statistics
+    {
+        std::lock_guard<std::mutex> lock(pcMutex);
+        (*rtStats)(0) = numTicks;
+        (*rtStats)(1) = numOverruns;
+        (*rtStats)(2) = numHoldTicks;
+        (*rtStats)(3) = maxLatency;
+        (*rtStats)(4) = (numTicks > 0) ? sumLatency/numTicks : 0.0;
+        (*rtStats)(5) = maxExecTime;
+        return info.setVector(*rtStats);
+    }
+        
+    default:
+        return -1;
+    }
+}
+
+
+void ECPredictorCorrector::Print(OPS_Stream &s, int flag)
+{
+    s << "****************************************************************\n";
+    s << "* ExperimentalControl: " << this->getTag() << endln; 
+    s << "*   type: ECPredictorCorrector\n";
+    s << "*   wrapped control: " << theControl->getTag()
+        << " (" << theControl->getClassType() << ")\n";
+    s << "*   dtSim: " << dtSim << ", rate: " << rate
+        << ", subSteps: " << 1.0/dx << endln;
+    s << "*   order: " << order << ", predMax: " << predMax << endln;
+    s << "*   priority: " << priority << ", cpu: " << cpuID << endln;
+    s << "*   ctrlFilters:";
+    for (int i=0; i<OF_Resp_All; i++)  {
+        if (theCtrlFilters[i] != 0)
+            s << " " << theCtrlFilters[i]->getTag();
+        else
+            s << " 0";
+    }
+    s << "\n*   daqFilters:";
+    for (int i=0; i<OF_Resp_All; i++)  {
+        if (theDaqFilters[i] != 0)
+            s << " " << theDaqFilters[i]->getTag();
+        else
+            s << " 0";
+    }
+    s << endln;
+    s << "****************************************************************\n";
+    s << endln;
+}
+
+
+int ECPredictorCorrector::control()
+{
+    // the loop is only started once the first target is available
+    if (!running)
+        this->startThread();
+    
+    // post the new target to the real-time thread
+    std::lock_guard<std::mutex> lock(pcMutex);
+    newTarget = true;
+    numTargets++;
+    
+    return OF_ReturnType_completed;
+}
+
+
+int ECPredictorCorrector::acquire()
+{
+    // wait until the loop has reached the target
+    std::unique_lock<std::mutex> lock(pcMutex);
+    stepDone.wait(lock, [this] {
+        return numReached == numTargets || !running; });
+    
+    if (!running || rtStatus < 0)  {
+        opserr << "ECPredictorCorrector::acquire() - "
+            << "real-time loop failed.\n";
+        return OF_ReturnType_failed;
+    }
+    
+    return OF_ReturnType_completed;
+}
+
+
+void ECPredictorCorrector::startThread()
+{
+    if (running)
+        return;
+    
+    // collect a loop that stopped after an error
+    if (rtThread.joinable())
+        rtThread.join();
+    
+    running = true;
+    rtThread = std::thread(&ECPredictorCorrector::rtLoop, this);
+}
+
+
+void ECPredictorCorrector::stopThread()
+{
+    if (!rtThread.joinable())
+        return;
+    
+    {
+        std::lock_guard<std::mutex> lock(pcMutex);
+        running = false;
+    }
+    stepDone.notify_all();
+    rtThread.join();
+}
+
+
+void ECPredictorCorrector::rtLoop()
+{
+#if defined(_LINUX)
+    if (cpuID >= 0)  {
+        cpu_set_t cpuset;
+        CPU_ZERO(&cpuset);
+        CPU_SET(cpuID, &cpuset);
+        if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset) != 0)
+            opserr << "ECPredictorCorrector::rtLoop() - WARNING "
+                << "could not pin real-time thread to cpu " << cpuID << endln;
+    }
+    if (priority > 0)  {
+        struct sched_param param;
+        param.sched_priority = priority;
+        if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) != 0)
+            opserr << "ECPredictorCorrector::rtLoop() - WARNING "
+                << "could not set SCHED_FIFO priority " << priority
+                << ", running with normal priority\n";
+        if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0)
+            opserr << "ECPredictorCorrector::rtLoop() - WARNING "
+                << "could not lock memory\n";
+    }
+#elif defined(_WIN32)
+    if (cpuID >= 0)
+        SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << cpuID);
+    if (priority > 0)
+        SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL);
+#endif
+    
+    const long long period = (long long)(1.0E9/rate + 0.5);
+    long long tNext = rtClock();
+    
+    while (running)  {
+        tNext += period;
+        rtSleepUntil(tNext);
+        long long tWake = rtClock();
+        
+        int rValue = this->tick();
+        
+        long long tDone = rtClock();
+        bool overrun = (tDone - tNext) > period;
+        {
+            std::lock_guard<std::mutex> lock(pcMutex);
+            double latency = 1.0E-9*(tWake - tNext);
+            double execTime = 1.0E-9*(tDone - tWake);
+            numTicks++;
+            sumLatency += latency;
+            if (latency > maxLatency)
+                maxLatency = latency;
+            if (execTime > maxExecTime)
+                maxExecTime = execTime;
+            if (overrun)
+                numOverruns++;
+            if (rValue < 0)  {
+                rtStatus = rValue;
+                running = false;
+                stepDone.notify_all();
+            }
+        }
+        
+        // skip missed deadlines instead of catching up with a burst
+        if (overrun)
+            tNext = tDone - (tDone - tNext)%period;
+    }
+}
+
+
+int ECPredictorCorrector::tick()
+{
+    int rValue = 0;
+    int nDOF = (*sizeCtrl)(OF_Resp_Disp);
+    
+    // switch to correction as soon as a new target is available
+    if (!correcting)  {
+        bool consume = false;
+        {
+            std::lock_guard<std::mutex> lock(pcMutex);
+            if (newTarget)  {
+                for (int i=0; i<nDOF; i++)
+                    tgtSig[i] = (*ctrlDisp)(i);
+                if (cmdForce != 0)
+                    *cmdForce = *ctrlForce;
+                if (cmdTime != 0)
+                    *cmdTime = *ctrlTime;
+                newTarget = false;
+                consume = true;
+            }
+        }
+        if (consume)  {
+            thePC->setCurSig(cmdSig, x);
+            thePC->setNewSig(tgtSig);
+            correcting = true;
+        }
+    }
+    
+    bool reached = false;
+    if (correcting)  {
+        x += dx;
+        if (x > 1.0 - 0.5*dx)  {
+            x = 1.0;
+            reached = true;
+        }
+        this->correct(x);
+    }
+    else  {
+        // hold the last prediction once predMax is reached
+        if (x + dx <= predMax)  {
+            x += dx;
+        }
+        else  {
+            std::lock_guard<std::mutex> lock(pcMutex);
+            numHoldTicks++;
+        }
+        this->predict(x);
+    }
+    
+    // send the command and sample the response at the target
+    {
+        std::lock_guard<std::mutex> lock(innerMutex);
+        rValue = theControl->setTrialResponse(cmdDisp, cmdVel, cmdAccel,
+            cmdForce, cmdTime);
+        theControl->logTrialResponse(cmdDisp, cmdVel, cmdAccel,
+            cmdForce, cmdTime);
+        if (reached && rValue >= 0)  {
+            rValue = theControl->getDaqResponse(daqDisp, daqVel, daqAccel,
+                daqForce, daqTime);
+            theControl->logDaqResponse(daqDisp, daqVel, daqAccel,
+                daqForce, daqTime);
+        }
+    }
+    
+    if (reached)  {
+        thePC->setCurSig(thePC->sig1, 1.0);
+        x = 0.0;
+        correcting = false;
+        
+        std::lock_guard<std::mutex> lock(pcMutex);
+        numReached++;
+        stepDone.notify_all();
+    }
+    
+    return rValue;
+}
+
+
+void ECPredictorCorrector::predict(double x)
+{
+    switch (order)  {
+    case 1:
+        thePC->predictD1(cmdSig, x);
+        if (cmdVel != 0)
+            thePC->predictV1(cmdSigDot, x);
+        if (cmdAccel != 0)
+            thePC->predictA1(cmdSigDotDot, x);
+        break;
+    case 2:
+        thePC->predictD2(cmdSig, x);
+        if (cmdVel != 0)
+            thePC->predictV2(cmdSigDot, x);
+        if (cmdAccel != 0)
+            thePC->predictA2(cmdSigDotDot, x);
+        break;
+    default:
+        thePC->predictD3(cmdSig, x);
+        if (cmdVel != 0)
+            thePC->predictV3(cmdSigDot, x);
+        if (cmdAccel != 0)
+            thePC->predictA3(cmdSigDotDot, x);
+        break;
+    }
+}
+
+
+void ECPredictorCorrector::correct(double x)
+{
+    switch (order)  {
+    case 1:
+        thePC->correctD1(cmdSig, x);
+        if (cmdVel != 0)
+            thePC->correctV1(cmdSigDot, x);
+        if (cmdAccel != 0)
+            thePC->correctA1(cmdSigDotDot, x);
+        break;
+    case 2:
+        thePC->correctD2(cmdSig, x);
+        if (cmdVel != 0)
+            thePC->correctV2(cmdSigDot, x);
+        if (cmdAccel != 0)
+            thePC->correctA2(cmdSigDotDot, x);
+        break;
+    default:
+        thePC->correctD3(cmdSig, x);
+        if (cmdVel != 0)
+            thePC->correctV3(cmdSigDot, x);
+        if (cmdAccel != 0)
+            thePC->correctA3(cmdSigDotDot, x);
+        break;
+    }
+}
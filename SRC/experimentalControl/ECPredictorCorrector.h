@@ -0,0 +1,144 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef ECPredictorCorrector_h
+#define ECPredictorCorrector_h
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the class definition for
+// ECPredictorCorrector. ECPredictorCorrector is a controller class
+// that runs the predictor-corrector loop of the three-loop
+// architecture natively inside OpenFresco. A real-time thread
+// generates commands at the controller rate by extrapolating from
+// the previous targets and, once the integrator has delivered a new
+// target, by interpolating towards it. The commands are sent to a
+// wrapped experimental control (the actuator interface) while the
+// integrator computes the next step asynchronously. Only the target
+// displacements are interpolated, the velocity and acceleration
+// commands are the derivatives of the displacement polynomials and
+// the trial velocities and accelerations are not commanded.
+
+#include "ExperimentalControl.h"
+
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+class PredictorCorrector;
+
+class ECPredictorCorrector : public ExperimentalControl
+{
+public:
+    // constructors
+    ECPredictorCorrector(int tag, ExperimentalControl *theControl,
+        double dtSim, double rate = 1024.0, int order = 3,
+        double predMax = 0.6, int priority = 0, int cpuID = -1);
+    ECPredictorCorrector(const ECPredictorCorrector& ec);
+    
+    // destructor
+    virtual ~ECPredictorCorrector();
+    
+    // method to get class type
+    const char *getClassType() const {return "ECPredictorCorrector";};
+    
+    // public methods to set and to get response
+    virtual int setup();
+    virtual int setSize(ID sizeT, ID sizeO);
+    
+    virtual int setTrialResponse(const Vector* disp,
+        const Vector* vel,
+        const Vector* accel,
+        const Vector* force,
+        const Vector* time);
+    virtual int getDaqResponse(Vector* disp,
+        Vector* vel,
+        Vector* accel,
+        Vector* force,
+        Vector* time);
+    
+    virtual int commitState();
+    
+    virtual ExperimentalControl *getCopy();
+    
+    // public methods for experimental control recorder
+    virtual Response *setResponse(const char **argv, int argc,
+        OPS_Stream &output);
+    virtual int getResponse(int responseID, Information &info);
+    
+    // public methods for output
+    void Print(OPS_Stream &s, int flag = 0);
+
+protected:
+    // protected methods to set and to get response
+    virtual int control();
+    virtual int acquire();
+
+private:
+    void startThread();
+    void stopThread();
+    void rtLoop();
+    int tick();
+    void predict(double x);
+    void correct(double x);
+    
+    ExperimentalControl *theControl;  // wrapped actuator control
+    PredictorCorrector *thePC;        // predictor-corrector polynomials
+    
+    double dtSim;       // simulation time step size (real time)
+    double rate;        // controller rate [Hz]
+    int order;          // order of predictor-corrector polynomials
+    double predMax;     // max fraction of dtSim to predict before hold
+    int priority;       // SCHED_FIFO priority of real-time thread
+    int cpuID;          // cpu the real-time thread is pinned to
+    
+    double dx;          // increment of x per controller tick
+    double x;           // current position within the step
+    bool correcting;    // true when interpolating towards a target
+    
+    Vector *ctrlDisp, *ctrlVel, *ctrlAccel, *ctrlForce, *ctrlTime;
+    Vector *daqDisp, *daqVel, *daqAccel, *daqForce, *daqTime;
+    
+    // commands sent to the wrapped control at every tick
+    double *cmdSig, *cmdSigDot, *cmdSigDotDot, *tgtSig;
+    Vector *cmdDisp, *cmdVel, *cmdAccel, *cmdForce, *cmdTime;
+    
+    // real-time thread and mailbox to the integrator
+    std::thread rtThread;
+    std::atomic<bool> running;
+    std::mutex pcMutex;               // protects mailbox and statistics
+    std::mutex innerMutex;            // serializes calls to theControl
+    std::condition_variable stepDone;
+    bool newTarget;                   // target posted but not consumed
+    unsigned long numTargets;         // number of targets posted
+    unsigned long numReached;         // number of targets reached
+    int rtStatus;                     // last return value of theControl
+    
+    // real-time statistics
+    unsigned long numTicks, numOverruns, numHoldTicks;
+    double maxLatency, sumLatency, maxExecTime;
+    Vector *rtStats;
+};
+
+#endif
@@ -0,0 +1,521 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation of the ECReplay
+// class.
+
+#include "ECReplay.h"
+
+#include <elementAPI.h>
+
+#include <math.h>
+#include <thread>
+
+static const char *respNames[OF_Resp_All] =
+    {"Disp", "Vel", "Accel", "Force", "Time"};
+
+
+void* OPF_ECReplay()
+{
+    // pointer to experimental control that will be returned
+    ExperimentalControl* theControl = 0;
+    
+    if (OPS_GetNumRemainingInputArgs() < 2) {
+        opserr << "WARNING invalid number of arguments\n";
+        opserr << "Want: expControl Replay tag fileName "
+            << "<-check tol> <-realTime timeScale> "
+            << "<-ctrlFilters (5 filterTag)> <-daqFilters (5 filterTag)>\n";
+        return 0;
+    }
+    
+    // control tag
+    int tag;
+    int numdata = 1;
+    if (OPS_GetIntInput(&numdata, &tag) != 0) {
+        opserr << "WARNING invalid expControl Replay tag\n";
+        return 0;
+    }
+    
+    // traffic log
+    const char* fileName = OPS_GetString();
+    
+    // optional parameters
+    double tol = -1.0, timeScale = 0.0;
+    while (OPS_GetNumRemainingInputArgs() > 0) {
+        const char* type = OPS_GetString();
+        if (strcmp(type, "-check") == 0) {
+            numdata = 1;
+            if (OPS_GetDoubleInput(&numdata, &tol) != 0 || tol < 0.0) {
+                opserr << "WARNING invalid tol\n";
+                opserr << "expControl Replay " << tag << endln;
+                return 0;
+            }
+        }
+        else if (strcmp(type, "-realTime") == 0) {
+            timeScale = 1.0;
+            numdata = 1;
+            int numArgs = OPS_GetNumRemainingInputArgs();
+            if (numArgs > 0 && OPS_GetDoubleInput(&numdata, &timeScale) < 0) {
+                if (numArgs > OPS_GetNumRemainingInputArgs()) {
+                    // move current arg back by one
+                    OPS_ResetCurrentInputArg(-1);
+                }
+                timeScale = 1.0;
+            }
+            if (timeScale < 0.0) {
+                opserr << "WARNING invalid timeScale\n";
+                opserr << "expControl Replay " << tag << endln;
+                return 0;
+            }
+        }
+        else {
+            // move current arg back by one
+            OPS_ResetCurrentInputArg(-1);
+            break;
+        }
+    }
+    
+    // parsing was successful, allocate the control
+    theControl = new ECReplay(tag, fileName, tol, timeScale);
+    if (theControl == 0) {
+        opserr << "WARNING could not create experimental control of type Replay\n";
+        return 0;
+    }
+    
+    return theControl;
+}
+
+
+ECReplay::ECReplay(int tag, const char *filename,
+    double tolerance, double timescale)
+    : ExperimentalControl(tag),
+    fileName(0), theReplay(0),
+    tol(tolerance), timeScale(timescale),
+    replayInfo(0), pending(false), hold(false),
+    numCommits(0), numMismatch(0), firstStamp(-1.0)
+{
+    for (int i=0; i<OF_Resp_All; i++)  {
+        ctrlResp[i] = 0;
+        daqResp[i] = 0;
+        recResp[i] = 0;
+    }
+    
+    if (filename == 0)  {
+        opserr << "ECReplay::ECReplay() - "
+            << "null file name passed.\n";
+        exit(OF_ReturnType_failed);
+    }
+    fileName = new char [strlen(filename)+1];
+    strcpy(fileName, filename);
+    
+    // open the traffic log
+    theReplay = new ExpTrafficLog(fileName, true);
+    if (theReplay == 0 || !theReplay->isOpen())  {
+        opserr << "ECReplay::ECReplay() - "
+            << "failed to open traffic log: " << fileName << endln;
+        exit(OF_ReturnType_failed);
+    }
+    
+    replayInfo = new Vector(2);
+}
+
+
+ECReplay::ECReplay(const ECReplay& ec)
+    : ExperimentalControl(ec),
+    fileName(0), theReplay(0),
+    tol(ec.tol), timeScale(ec.timeScale),
+    replayInfo(0), pending(false), hold(false),
+    numCommits(0), numMismatch(0), firstStamp(-1.0)
+{
+    for (int i=0; i<OF_Resp_All; i++)  {
+        ctrlResp[i] = 0;
+        daqResp[i] = 0;
+        recResp[i] = 0;
+    }
+    
+    fileName = new char [strlen(ec.fileName)+1];
+    strcpy(fileName, ec.fileName);
+    
+    // the copy replays the log from its beginning
+    theReplay = new ExpTrafficLog(fileName, true);
+    if (theReplay == 0 || !theReplay->isOpen())  {
+        opserr << "ECReplay::ECReplay() - "
+            << "failed to open traffic log: " << fileName << endln;
+        exit(OF_ReturnType_failed);
+    }
+    
+    replayInfo = new Vector(2);
+}
+
+
+ECReplay::~ECReplay()
+{
+    // delete memory of ctrl, daq and recorded vectors
+    for (int i=0; i<OF_Resp_All; i++)  {
+        if (ctrlResp[i] != 0)
+            delete ctrlResp[i];
+        if (daqResp[i] != 0)
+            delete daqResp[i];
+        if (recResp[i] != 0)
+            delete recResp[i];
+    }
+    if (replayInfo != 0)
+        delete replayInfo;
+    
+    if (theReplay != 0)
+        delete theReplay;
+    if (fileName != 0)
+        delete [] fileName;
+}
+
+
+int ECReplay::setup()
+{
+    const ID &sizeRec = theReplay->getSizeTrial();
+    for (int i=0; i<OF_Resp_All; i++)  {
+        if (ctrlResp[i] != 0)
+            delete ctrlResp[i];
+        if (daqResp[i] != 0)
+            delete daqResp[i];
+        if (recResp[i] != 0)
+            delete recResp[i];
+        ctrlResp[i] = daqResp[i] = recResp[i] = 0;
+        
+        if ((*sizeCtrl)(i) != 0)  {
+            ctrlResp[i] = new Vector((*sizeCtrl)(i));
+            // only commands of matching size are checked
+            if (tol >= 0.0 && sizeRec(i) == (*sizeCtrl)(i))
+                recResp[i] = new Vector((*sizeCtrl)(i));
+        }
+        if ((*sizeDaq)(i) != 0)  {
+            daqResp[i] = new Vector((*sizeDaq)(i));
+            daqResp[i]->Zero();
+        }
+    }
+    
+    // print experimental control information
+    //this->Print(opserr);
+    
+    return OF_ReturnType_completed;
+}
+
+
+int ECReplay::setSize(ID sizeT, ID sizeO)
+{
+    // check sizeTrial and sizeOut
+    // for ECReplay object
+    
+    // ECReplay objects can only return the daq signals that
+    // have been recorded, signals that are missing in the log
+    // are returned as zeros
+    const ID &sizeRec = theReplay->getSizeDaq();
+    for (int i=0; i<OF_Resp_All; i++)  {
+        if (sizeO(i) != 0 && sizeRec(i) != 0 && sizeO(i) != sizeRec(i))  {
+            opserr << "ECReplay::setSize() - wrong sizeOut\n";
+            opserr << "sizeO(" << respNames[i] << ") = " << sizeO(i)
+                << " != " << sizeRec(i) << " recorded in "
+                << fileName << endln;
+            opserr << "see User Manual.\n";
+            exit(OF_ReturnType_failed);
+        }
+    }
+    
+    *sizeCtrl = sizeT;
+    *sizeDaq = sizeO;
+    
+    return OF_ReturnType_completed;
+}
+
+
+int ECReplay::setTrialResponse(const Vector* disp,
+    const Vector* vel,
+    const Vector* accel,
+    const Vector* force,
+    const Vector* time)
+{
+    const Vector* resp[OF_Resp_All] = {disp, vel, accel, force, time};
+    for (int i=0; i<OF_Resp_All; i++)  {
+        if (resp[i] != 0 && ctrlResp[i] != 0)  {
+            *ctrlResp[i] = *resp[i];
+            if (theCtrlFilters[i] != 0)  {
+                for (int j=0; j<(*sizeCtrl)(i); j++)
+                    (*ctrlResp[i])(j) = theCtrlFilters[i]->filtering((*ctrlResp[i])(j));
+            }
+        }
+    }
+    
+    return this->control();
+}
+
+
+int ECReplay::getDaqResponse(Vector* disp,
+    Vector* vel,
+    Vector* accel,
+    Vector* force,
+    Vector* time)
+{
+    int rValue = this->acquire();
+    
+    Vector* resp[OF_Resp_All] = {disp, vel, accel, force, time};
+    for (int i=0; i<OF_Resp_All; i++)  {
+        if (resp[i] != 0 && daqResp[i] != 0)  {
+            if (theDaqFilters[i] != 0)  {
+                for (int j=0; j<(*sizeDaq)(i); j++)
+                    (*daqResp[i])(j) = theDaqFilters[i]->filtering((*daqResp[i])(j));
+            }
+            *resp[i] = *daqResp[i];
+        }
+    }
+    
+    return rValue;
+}
+
+
+int ECReplay::commitState()
+{
+    // skip what is left of the recorded step, including its commit
+    int type;
+    do  {
+        type = this->nextRecord();
+    } while (type != ExpTrafficLog::Commit && type != ExpTrafficLog::None);
+    
+    hold = false;
+    numCommits++;
+    
+    return OF_ReturnType_completed;
+}
+
+
+ExperimentalControl* ECReplay::getCopy()
+{
+    return new ECReplay(*this);
+}
+
+
+Response* ECReplay::setResponse(const char **argv, int argc,
+    OPS_Stream &output)
+{
+    char outputData[20];
+    Response *theResponse = 0;
+    
+    output.tag("ExpControlOutput");
+    output.attr("ctrlType",this->getClassType());
+    output.attr("ctrlTag",this->getTag());
+    
+    // ctrl and daq signals
+    for (int i=0; i<OF_Resp_All && theResponse == 0; i++)  {
+        if (ctrlResp[i] != 0 && strncmp(argv[0],"ctrl",4) == 0 &&
+            strcmp(&argv[0][4],respNames[i]) == 0)
+        {
+            for (int j=0; j<(*sizeCtrl)(i); j++)  {
+                sprintf(outputData,"ctrl%s%d",respNames[i],j+1);
+                output.tag("ResponseType",outputData);
+            }
+            theResponse = new ExpControlResponse(this, 1+i, *ctrlResp[i]);
+        }
+        else if (daqResp[i] != 0 && strncmp(argv[0],"daq",3) == 0 &&
+            strcmp(&argv[0][3],respNames[i]) == 0)
+        {
+            for (int j=0; j<(*sizeDaq)(i); j++)  {
+                sprintf(outputData,"daq%s%d",respNames[i],j+1);
+                output.tag("ResponseType",outputData);
+            }
+            theResponse = new ExpControlResponse(this, 1+OF_Resp_All+i, *daqResp[i]);
+        }
+    }
+    
+    // time stamp and command error of the replay
+    if (theResponse == 0 && (
+        strcmp(argv[0],"replay") == 0 ||
+        strcmp(argv[0],"replayInfo") == 0))
+    {
+        output.tag("ResponseType","stamp");
+        output.tag("ResponseType","error");
+        theResponse = new ExpControlResponse(this, 1+2*OF_Resp_All, *replayInfo);
+    }
+    
+    output.endTag();
+    
+    return theResponse;
+}
+
+
+int ECReplay::getResponse(int responseID, Information &info)
+{
+    if (responseID >= 1 && responseID <= OF_Resp_All)  // ctrl signals
+        return info.setVector(*ctrlResp[responseID-1]);
+    
+    if (responseID > OF_Resp_All && responseID <= 2*OF_Resp_All)  // daq signals
+        return info.setVector(*daqResp[responseID-1-OF_Resp_All]);
+    
+    if (responseID == 1+2*OF_Resp_All)  // replay info
+        return info.setVector(*replayInfo);
+    
+    return -1;
+}
+
+
+void ECReplay::Print(OPS_Stream &s, int flag)
+{
+    s << "****************************************************************\n";
+    s << "* ExperimentalControl: " << this->getTag() << endln;
+    s << "*   type: ECReplay\n";
+    s << "*   fileName: " << fileName << endln;
+    s << "*   source: " << (theReplay->getSource() == ExpTrafficLog::Site ?
+        "site" : "control") << endln;
+    s << "*   sizeTrial:";
+    for (int i=0; i<OF_Resp_All; i++)
+        s << " " << theReplay->getSizeTrial()(i);
+    s << "\n*   sizeDaq:";
+    for (int i=0; i<OF_Resp_All; i++)
+        s << " " << theReplay->getSizeDaq()(i);
+    if (tol >= 0.0)
+        s << "\n*   check tol: " << tol;
+    if (timeScale > 0.0)
+        s << "\n*   timeScale: " << timeScale;
+    s << "\n*   ctrlFilters:";
+    for (int i=0; i<OF_Resp_All; i++)  {
+        if (theCtrlFilters[i] != 0)
+            s << " " << theCtrlFilters[i]->getTag();
+        else
+            s << " 0";
+    }
+    s << "\n*   daqFilters:";
+    for (int i=0; i<OF_Resp_All; i++)  {
+        if (theDaqFilters[i] != 0)
+            s << " " << theDaqFilters[i]->getTag();
+        else
+            s << " 0";
+    }
+    if (flag == 1)  {
+        s << "\n*   replayed steps: " << numCommits;
+        s << "\n*   failed checks: " << numMismatch;
+    }
+    s << endln;
+    s << "****************************************************************\n";
+    s << endln;
+}
+
+
+int ECReplay::control()
+{
+    // a recorded step that is over only holds its last daq response
+    if (hold)
+        return OF_ReturnType_completed;
+    
+    // find the next recorded command, without crossing a commit
+    int type;
+    do  {
+        type = this->nextRecord();
+    } while (type == ExpTrafficLog::Daq);
+    
+    if (type == ExpTrafficLog::Commit)  {
+        pending = true;
+        hold = true;
+        return OF_ReturnType_completed;
+    }
+    if (type == ExpTrafficLog::None)  {
+        opserr << "ECReplay::control() - "
+            << "end of traffic log " << fileName << " reached after "
+            << numCommits << " steps.\n";
+        return OF_ReturnType_failed;
+    }
+    
+    double stamp = theReplay->getStamp();
+    (*replayInfo)(0) = stamp;
+    
+    // check the command against the recorded one
+    if (tol >= 0.0)  {
+        theReplay->getResponse(recResp[OF_Resp_Disp], recResp[OF_Resp_Vel],
+            recResp[OF_Resp_Accel], recResp[OF_Resp_Force], recResp[OF_Resp_Time]);
+        double error = 0.0;
+        for (int i=0; i<OF_Resp_All; i++)  {
+            if (recResp[i] != 0)  {
+                for (int j=0; j<(*sizeCtrl)(i); j++)  {
+                    double e = fabs((*ctrlResp[i])(j) - (*recResp[i])(j));
+                    if (e > error)
+                        error = e;
+                }
+            }
+        }
+        (*replayInfo)(1) = error;
+        if (error > tol)  {
+            if (numMismatch == 0)  {
+                opserr << "ECReplay::control() - "
+                    << "command differs from recorded one by " << error
+                    << " in step " << numCommits+1 << endln;
+            }
+            numMismatch++;
+        }
+    }
+    
+    // wait until the recorded time of the command is reached
+    if (timeScale > 0.0)  {
+        if (firstStamp < 0.0)  {
+            firstStamp = stamp;
+            startTime = std::chrono::steady_clock::now();
+        }
+        std::chrono::duration<double> wait((stamp - firstStamp)*timeScale);
+        std::this_thread::sleep_until(startTime +
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(wait));
+    }
+    
+    return OF_ReturnType_completed;
+}
+
+
+int ECReplay::acquire()
+{
+    // a recorded step that is over only holds its last daq response
+    if (hold)
+        return OF_ReturnType_completed;
+    
+    int type = this->nextRecord();
+    if (type == ExpTrafficLog::Daq)  {
+        return theReplay->getResponse(daqResp[OF_Resp_Disp], daqResp[OF_Resp_Vel],
+            daqResp[OF_Resp_Accel], daqResp[OF_Resp_Force], daqResp[OF_Resp_Time]);
+    }
+    
+    // no daq response was recorded for this command, so keep
+    // the last one and leave the record for the next call
+    if (type != ExpTrafficLog::None)
+        pending = true;
+    
+    return OF_ReturnType_completed;
+}
+
+
+int ECReplay::nextRecord()
+{
+    if (pending)  {
+        pending = false;
+        return theReplay->getRecordType();
+    }
+    
+    if (theReplay->readRecord() != OF_ReturnType_completed)
+        return ExpTrafficLog::None;
+    
+    return theReplay->getRecordType();
+}
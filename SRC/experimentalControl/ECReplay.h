@@ -0,0 +1,111 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef ECReplay_h
+#define ECReplay_h
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the class definition for ECReplay.
+// ECReplay is a controller class that feeds the daq responses of a
+// traffic log captured with the -record option of an experimental
+// control or site back as if they came from the hardware. The n-th
+// trial response of a step receives the daq response recorded for
+// the n-th trial command of the same step, and the replay is synced
+// to the recorded steps at every commit. By default the log is
+// replayed as fast as possible, optionally the recorded commands can
+// be checked against the ones sent during the replay.
+
+#include "ExperimentalControl.h"
+
+#include <chrono>
+
+class ECReplay : public ExperimentalControl
+{
+public:
+    // constructors
+    ECReplay(int tag, const char *fileName,
+        double tol = -1.0, double timeScale = 0.0);
+    ECReplay(const ECReplay &ec);
+    
+    // destructor
+    virtual ~ECReplay();
+    
+    // method to get class type
+    const char *getClassType() const {return "ECReplay";};
+    
+    // public methods to set and to get response
+    virtual int setup();
+    virtual int setSize(ID sizeT, ID sizeO);
+    
+    virtual int setTrialResponse(const Vector* disp,
+        const Vector* vel,
+        const Vector* accel,
+        const Vector* force,
+        const Vector* time);
+    virtual int getDaqResponse(Vector* disp,
+        Vector* vel,
+        Vector* accel,
+        Vector* force,
+        Vector* time);
+    
+    virtual int commitState();
+    
+    virtual ExperimentalControl *getCopy();
+    
+    // public methods for experimental control recorder
+    virtual Response *setResponse(const char **argv, int argc,
+        OPS_Stream &output);
+    virtual int getResponse(int responseID, Information &info);
+    
+    // public methods for output
+    void Print(OPS_Stream &s, int flag = 0);
+
+protected:
+    // protected methods to set and to get response
+    virtual int control();
+    virtual int acquire();
+
+private:
+    int nextRecord();
+    
+    char *fileName;             // name of the traffic log
+    ExpTrafficLog *theReplay;   // traffic log that is replayed
+    double tol;                 // tolerance for command check (< 0: no check)
+    double timeScale;           // factor on recorded timing (0: no waiting)
+    
+    Vector *ctrlResp[OF_Resp_All];  // ctrl signals sent by the caller
+    Vector *daqResp[OF_Resp_All];   // daq signals taken from the log
+    Vector *recResp[OF_Resp_All];   // recorded ctrl signals
+    Vector *replayInfo;             // [0]: time stamp, [1]: command error
+    
+    bool pending;       // current record of the log not consumed yet
+    bool hold;          // recorded step is over, hold last daq response
+    int numCommits;     // number of replayed steps
+    int numMismatch;    // number of commands that failed the check
+    
+    double firstStamp;  // time stamp of the first replayed command
+    std::chrono::steady_clock::time_point startTime;
+};
+
+#endif
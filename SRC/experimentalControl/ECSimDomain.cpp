@@ -42,13 +42,16 @@
 #include <LoadPattern.h>
 #include <NodalLoad.h>
 #include <SP_Constraint.h>
+#include <SP_ConstraintIter.h>
+#include <DOF_Group.h>
 #include <ExpForceControl.h>
 #include <ExpDispControl.h>
 
 #include <AnalysisModel.h>
 #include <CTestNormDispIncr.h>
-//#include <CTestNormUnbalance.h>
-//#include <CTestEnergyIncr.h>
+#include <CTestNormUnbalance.h>
+#include <CTestEnergyIncr.h>
+#include <Linear.h>
 #include <NewtonRaphson.h>
 #include <NewtonLineSearch.h>
 #include <RegulaFalsiLineSearch.h>
@@ -60,14 +63,15 @@
 //#include <LagrangeConstraintHandler.h>
 
 #include <PlainNumberer.h>
-//#include <RCM.h>
+#include <DOF_Numberer.h>
+#include <RCM.h>
 
 //#include <BandSPDLinSOE.h>
 //#include <BandSPDLinLapackSolver.h>
 #include <BandGenLinSOE.h>
 #include <BandGenLinLapackSolver.h>
-//#include <ProfileSPDLinSOE.h>
-//#include <ProfileSPDLinDirectSolver.h>
+#include <ProfileSPDLinSOE.h>
+#include <ProfileSPDLinDirectSolver.h>
 //#include <SymSparseLinSOE.h>
 //#include <SymSparseLinSolver.h>
 //#include <UmfpackGenLinSOE.h>
@@ -87,6 +91,8 @@ void* OPF_ECSimDomain()
     if (OPS_GetNumRemainingInputArgs() < 5) {
         opserr << "WARNING invalid number of arguments\n";
         opserr << "Want: expControl SimDomain tag -trialCP cpTags -outCP cpTags "
+            << "<-numberer type> <-system type> <-handler Penalty alphaSP alphaMP> "
+            << "<-test type tol maxIter> <-algorithm type <-initial> <-factorOnce>> "
             << "<-ctrlFilters (5 filterTag)> <-daqFilters (5 filterTag)>\n";
         return 0;
     }
@@ -193,12 +199,143 @@ void* OPF_ECSimDomain()
         }
     }
     
+    // optional parameters
+    int numbererType = 0, systemType = 0;
+    double alphaSP = 1.0E12, alphaMP = 1.0E12;
+    int testType = 0, testIter = 25;
+    double testTol = 1.0E-8;
+    int algorithmType = 0, initialTangent = 0, factorOnce = 0;
+    while (OPS_GetNumRemainingInputArgs() > 0) {
+        type = OPS_GetString();
+        // numberer
+        if (strcmp(type, "-numberer") == 0) {
+            type = OPS_GetString();
+            if (strcmp(type, "Plain") == 0)
+                numbererType = 0;
+            else if (strcmp(type, "RCM") == 0)
+                numbererType = 1;
+            else {
+                opserr << "WARNING invalid numberer type: " << type
+                    << " (want: Plain or RCM)\n";
+                opserr << "expControl SimDomain " << tag << endln;
+                return 0;
+            }
+        }
+        // system of equations
+        else if (strcmp(type, "-system") == 0) {
+            type = OPS_GetString();
+            if (strcmp(type, "BandGen") == 0 ||
+                strcmp(type, "BandGeneral") == 0)
+                systemType = 0;
+            else if (strcmp(type, "ProfileSPD") == 0)
+                systemType = 1;
+            else {
+                opserr << "WARNING invalid system type: " << type
+                    << " (want: BandGen or ProfileSPD)\n";
+                opserr << "expControl SimDomain " << tag << endln;
+                return 0;
+            }
+        }
+        // constraint handler
+        else if (strcmp(type, "-handler") == 0) {
+            type = OPS_GetString();
+            if (strcmp(type, "Penalty") != 0) {
+                opserr << "WARNING invalid handler type: " << type
+                    << " (want: Penalty alphaSP alphaMP)\n";
+                opserr << "expControl SimDomain " << tag << endln;
+                return 0;
+            }
+            numdata = 1;
+            if (OPS_GetDoubleInput(&numdata, &alphaSP) < 0) {
+                opserr << "WARNING invalid alphaSP\n";
+                opserr << "expControl SimDomain " << tag << endln;
+                return 0;
+            }
+            numdata = 1;
+            if (OPS_GetDoubleInput(&numdata, &alphaMP) < 0) {
+                opserr << "WARNING invalid alphaMP\n";
+                opserr << "expControl SimDomain " << tag << endln;
+                return 0;
+            }
+        }
+        // convergence test
+        else if (strcmp(type, "-test") == 0) {
+            type = OPS_GetString();
+            if (strcmp(type, "NormDispIncr") == 0)
+                testType = 0;
+            else if (strcmp(type, "NormUnbalance") == 0)
+                testType = 1;
+            else if (strcmp(type, "EnergyIncr") == 0)
+                testType = 2;
+            else {
+                opserr << "WARNING invalid test type: " << type
+                    << " (want: NormDispIncr, NormUnbalance or EnergyIncr)\n";
+                opserr << "expControl SimDomain " << tag << endln;
+                return 0;
+            }
+            numdata = 1;
+            if (OPS_GetDoubleInput(&numdata, &testTol) < 0) {
+                opserr << "WARNING invalid test tolerance\n";
+                opserr << "expControl SimDomain " << tag << endln;
+                return 0;
+            }
+            numdata = 1;
+            if (OPS_GetIntInput(&numdata, &testIter) < 0) {
+                opserr << "WARNING invalid test maxIter\n";
+                opserr << "expControl SimDomain " << tag << endln;
+                return 0;
+            }
+        }
+        // solution algorithm
+        else if (strcmp(type, "-algorithm") == 0) {
+            type = OPS_GetString();
+            if (strcmp(type, "Newton") == 0)
+                algorithmType = 0;
+            else if (strcmp(type, "NewtonLineSearch") == 0)
+                algorithmType = 2;
+            else if (strcmp(type, "Linear") == 0)
+                algorithmType = 3;
+            else {
+                opserr << "WARNING invalid algorithm type: " << type
+                    << " (want: Newton, NewtonLineSearch or Linear)\n";
+                opserr << "expControl SimDomain " << tag << endln;
+                return 0;
+            }
+        }
+        else if (strcmp(type, "-initial") == 0) {
+            initialTangent = 1;
+        }
+        else if (strcmp(type, "-factorOnce") == 0) {
+            factorOnce = 1;
+        }
+        else {
+            // move current arg back by one
+            OPS_ResetCurrentInputArg(-1);
+            break;
+        }
+    }
+    if (initialTangent == 1 && algorithmType == 0) {
+        algorithmType = 1;
+    }
+    else if (initialTangent == 1) {
+        opserr << "WARNING -initial can only be used with "
+            << "-algorithm Newton, ignoring it\n";
+        initialTangent = 0;
+    }
+    if (factorOnce == 1 && algorithmType != 3) {
+        opserr << "WARNING -factorOnce can only be used with "
+            << "-algorithm Linear, ignoring it\n";
+        factorOnce = 0;
+    }
+    
     // get the Domain
     Domain *theDomain = OPS_GetDomain();
     
     // parsing was successful, allocate the control
     theControl = new ECSimDomain(tag, numTrialCPs, trialCPs,
-        numOutCPs, outCPs, theDomain);
+        numOutCPs, outCPs, theDomain, numbererType, systemType,
+        alphaSP, alphaMP, testType, testTol, testIter,
+        algorithmType, factorOnce);
     if (theControl == 0) {
         opserr << "WARNING could not create experimental control of type SimDomain\n";
         return 0;
@@ -216,9 +353,15 @@ void* OPF_ECSimDomain()
 
 ECSimDomain::ECSimDomain(int tag,
     int nTrialCPs, ExperimentalCP **trialcps,
-    int nOutCPs, ExperimentalCP **outcps, Domain *thedomain)
+    int nOutCPs, ExperimentalCP **outcps, Domain *thedomain,
+    int numberertype, int systemtype, double alphasp, double alphamp,
+    int testtype, double testtol, int testiter,
+    int algorithmtype, int factoronce)
     : ECSimulation(tag), numTrialCPs(nTrialCPs), numOutCPs(nOutCPs),
-    theDomain(0), theModel(0), theTest(0), theLineSearch(0), theAlgorithm(0),
+    theDomain(0), numbererType(numberertype), systemType(systemtype),
+    alphaSP(alphasp), alphaMP(alphamp), testType(testtype),
+    testTol(testtol), testIter(testiter),
+    algorithmType(algorithmtype), factorOnce(factoronce), theModel(0), theTest(0), theLineSearch(0), theAlgorithm(0),
     theIntegrator(0), theHandler(0), theNumberer(0), theSOE(0), theAnalysis(0),
     theSeries(0), thePattern(0), theNodalLoads(0), theSPs(0), theNodes(0),
     numNodalLoads(0), numSPs(0),
@@ -251,7 +394,10 @@ ECSimDomain::ECSimDomain(int tag,
 
 ECSimDomain::ECSimDomain(const ECSimDomain& ec)
     : ECSimulation(ec), trialCPs(0), outCPs(0),
-    theDomain(0), theModel(0), theTest(0), theLineSearch(0), theAlgorithm(0),
+    theDomain(0), numbererType(ec.numbererType), systemType(ec.systemType),
+    alphaSP(ec.alphaSP), alphaMP(ec.alphaMP), testType(ec.testType),
+    testTol(ec.testTol), testIter(ec.testIter),
+    algorithmType(ec.algorithmType), factorOnce(ec.factorOnce), theModel(0), theTest(0), theLineSearch(0), theAlgorithm(0),
     theIntegrator(0), theHandler(0), theNumberer(0), theSOE(0), theAnalysis(0),
     theSeries(0), thePattern(0), theNodalLoads(0), theSPs(0), theNodes(0),
     numNodalLoads(0), numSPs(0),
@@ -499,26 +645,51 @@ int ECSimDomain::setup()
     
     theModel = new AnalysisModel();
     
-    theTest = new CTestNormDispIncr(1.0E-8, 25, 0);
-    //theTest = new CTestNormUnbalance(1.0E-8, 25, 0);
-    //theTest = new CTestEnergyIncr(1.0E-8, 25, 0);
+    if (testType == 1)
+        theTest = new CTestNormUnbalance(testTol, testIter, 0);
+    else if (testType == 2)
+        theTest = new CTestEnergyIncr(testTol, testIter, 0);
+    else
+        theTest = new CTestNormDispIncr(testTol, testIter, 0);
     
-    theAlgorithm = new NewtonRaphson(*theTest);
-    //theLineSearch = new RegulaFalsiLineSearch(0.8, 10, 0.1, 10.0, 1);
-    //theAlgorithm = new NewtonLineSearch(*theTest, theLineSearch);
+    if (algorithmType == 1)  {
+        theAlgorithm = new NewtonRaphson(*theTest, INITIAL_TANGENT);
+    }
+    else if (algorithmType == 2)  {
+        theLineSearch = new RegulaFalsiLineSearch(0.8, 10, 0.1, 10.0, 1);
+        theAlgorithm = new NewtonLineSearch(*theTest, theLineSearch);
+    }
+    else if (algorithmType == 3)  {
+        // for a linear specimen the factorization can be
+        // reused for all the steps if requested
+        theAlgorithm = new Linear(CURRENT_TANGENT, factorOnce);
+    }
+    else  {
+        theAlgorithm = new NewtonRaphson(*theTest);
+    }
     
     theIntegrator = new LoadControl(1.0, 1, 1.0, 1.0);
     
     //theHandler = new TransformationConstraintHandler();
-    theHandler = new PenaltyConstraintHandler(1.0E12, 1.0E12);
+    theHandler = new PenaltyConstraintHandler(alphaSP, alphaMP);
     //theHandler = new LagrangeConstraintHandler(1.0, 1.0);
     
-    theNumberer = new PlainNumberer();
+    if (numbererType == 1)  {
+        RCM *theRCM = new RCM();
+        theNumberer = new DOF_Numberer(*theRCM);
+    }
+    else  {
+        theNumberer = new PlainNumberer();
+    }
     
-    BandGenLinSolver *theSolver = new BandGenLinLapackSolver();
-    theSOE = new BandGenLinSOE(*theSolver);
-    //ProfileSPDLinSolver *theSolver = new ProfileSPDLinDirectSolver();
-    //theSOE = new ProfileSPDLinSOE(*theSolver);
+    if (systemType == 1)  {
+        ProfileSPDLinSolver *theSolver = new ProfileSPDLinDirectSolver();
+        theSOE = new ProfileSPDLinSOE(*theSolver);
+    }
+    else  {
+        BandGenLinSolver *theSolver = new BandGenLinLapackSolver();
+        theSOE = new BandGenLinSOE(*theSolver);
+    }
     
     theAnalysis = new StaticAnalysis(*theDomain, *theHandler, *theNumberer,
                                      *theModel, *theAlgorithm, *theSOE,
@@ -683,6 +854,135 @@ int ECSimDomain::commitState()
 }
 
 
+bool ECSimDomain::usesGlobalDomain()
+{
+    return (theDomain == OPS_GetDomain());
+}
+
+
+int ECSimDomain::getTangentStiff(Matrix &kt)
+{
+    // the tangent is only available for displacement control
+    // and if the forces are acquired
+    int numCtrl = (*sizeCtrl)(OF_Resp_Disp);
+    int numDaq = (*sizeDaq)(OF_Resp_Force);
+    if (theAnalysis == 0 || numCtrl == 0 || numDaq == 0 || numCtrl > numSPs)
+        return OF_ReturnType_failed;
+    
+    if (kt.noRows() < numDaq || kt.noCols() < numCtrl)
+        kt.resize(numDaq, numCtrl);
+    kt.Zero();
+    
+    // get the equations of the controlled dofs
+    int i, j, k;
+    ID eqnCtrl(numCtrl);
+    for (i=0; i<numCtrl; i++)  {
+        if (theSPs[i] == 0)
+            return OF_ReturnType_failed;
+        Node *theNode = theDomain->getNode(theSPs[i]->getNodeTag());
+        if (theNode == 0 || theNode->getDOF_GroupPtr() == 0)
+            return OF_ReturnType_failed;
+        const ID &theEqn = theNode->getDOF_GroupPtr()->getID();
+        eqnCtrl(i) = theEqn(theSPs[i]->getDOF_Number());
+        if (eqnCtrl(i) < 0)
+            return OF_ReturnType_failed;
+    }
+    
+    // get the equations of the acquired dofs and check if
+    // they are controlled dofs or fixed by the domain
+    ID eqnDaq(numDaq), ctrlDOF(numDaq);
+    Vector alpha(numDaq);
+    int iDOF = 0;
+    for (i=0; i<numOutCPs && iDOF<numDaq; i++)  {
+        int nodeTag = outCPs[i]->getNodeTag();
+        int numDOF = outCPs[i]->getNumDOF();
+        ID dof = outCPs[i]->getUniqueDOF();
+        if (theNodes[i]->getDOF_GroupPtr() == 0)
+            return OF_ReturnType_failed;
+        const ID &theEqn = theNodes[i]->getDOF_GroupPtr()->getID();
+        
+        for (j=0; j<numDOF && iDOF<numDaq; j++)  {
+            eqnDaq(iDOF) = theEqn(dof(j));
+            ctrlDOF(iDOF) = -1;
+            for (k=0; k<numCtrl; k++)  {
+                if (eqnCtrl(k) == eqnDaq(iDOF))  {
+                    ctrlDOF(iDOF) = k;
+                    alpha(iDOF) = alphaSP;
+                }
+            }
+            if (ctrlDOF(iDOF) < 0)  {
+                SP_ConstraintIter &theSPIter = theDomain->getSPs();
+                SP_Constraint *theSP;
+                while ((theSP = theSPIter()) != 0)  {
+                    if (theSP->getNodeTag() == nodeTag &&
+                        theSP->getDOF_Number() == dof(j))
+                        alpha(iDOF) = alphaSP;
+                }
+            }
+            iDOF++;
+        }
+    }
+    
+    // form the tangent at the current state, a Linear
+    // algorithm has already factored the only tangent
+    if (algorithmType != 3)  {
+        if (theIntegrator->formTangent(CURRENT_TANGENT) < 0)  {
+            opserr << "ECSimDomain::getTangentStiff() - "
+                << "failed to form the tangent.\n";
+            return OF_ReturnType_failed;
+        }
+    }
+    
+    // solve for unit loads at the controlled dofs, this gives
+    // the flexibility S of the penalized system at these dofs
+    Vector B(theSOE->getNumEqn());
+    Matrix S(numCtrl, numCtrl), X(numDaq, numCtrl);
+    for (j=0; j<numCtrl; j++)  {
+        B.Zero();
+        B(eqnCtrl(j)) = 1.0;
+        theSOE->setB(B);
+        if (theSOE->solve() < 0)  {
+            opserr << "ECSimDomain::getTangentStiff() - "
+                << "failed to solve for the flexibility.\n";
+            return OF_ReturnType_failed;
+        }
+        const Vector &x = theSOE->getX();
+        for (k=0; k<numCtrl; k++)
+            S(k,j) = x(eqnCtrl(k));
+        for (i=0; i<numDaq; i++)
+            X(i,j) = x(eqnDaq(i));
+    }
+    
+    // inv(S) is the condensed stiffness plus the penalties of the
+    // controlled dofs, the reactions at the fixed dofs follow from
+    // their penalty forces under the unit control displacements
+    Matrix Sinv(numCtrl, numCtrl);
+    if (S.Invert(Sinv) < 0)  {
+        opserr << "ECSimDomain::getTangentStiff() - "
+            << "failed to invert the flexibility.\n";
+        return OF_ReturnType_failed;
+    }
+    for (i=0; i<numDaq; i++)  {
+        k = ctrlDOF(i);
+        if (k >= 0)  {
+            for (j=0; j<numCtrl; j++)
+                kt(i,j) = Sinv(k,j);
+            kt(i,k) -= alphaSP;
+        }
+        else if (alpha(i) != 0.0)  {
+            for (j=0; j<numCtrl; j++)  {
+                double u = 0.0;
+                for (k=0; k<numCtrl; k++)
+                    u += X(i,k)*Sinv(k,j);
+                kt(i,j) = -alpha(i)*u;
+            }
+        }
+    }
+    
+    return OF_ReturnType_completed;
+}
+
+
 ExperimentalControl* ECSimDomain::getCopy()
 {
     return new ECSimDomain(*this);
@@ -863,7 +1163,27 @@ void ECSimDomain::Print(OPS_Stream &s, int flag)
 {
     s << "****************************************************************\n";
     s << "* ExperimentalControl: " << this->getTag() << endln; 
-    s << "*   type: ECSimDomain";
+    s << "*   type: ECSimDomain\n";
+    s << "*   numberer: " << (numbererType == 1 ? "RCM" : "Plain");
+    s << ", system: " << (systemType == 1 ? "ProfileSPD" : "BandGen");
+    s << ", handler: Penalty " << alphaSP << " " << alphaMP << endln;
+    s << "*   test: ";
+    if (testType == 1)
+        s << "NormUnbalance";
+    else if (testType == 2)
+        s << "EnergyIncr";
+    else
+        s << "NormDispIncr";
+    s << " " << testTol << " " << testIter << ", algorithm: ";
+    if (algorithmType == 1)
+        s << "Newton -initial";
+    else if (algorithmType == 2)
+        s << "NewtonLineSearch";
+    else if (algorithmType == 3)
+        s << "Linear" << (factorOnce ? " -factorOnce" : "");
+    else
+        s << "Newton";
+    s << endln;
     s << "*   ctrlFilter tags:";
     for (int i=0; i<OF_Resp_All; i++)  {
         if (theCtrlFilters[i] != 0)
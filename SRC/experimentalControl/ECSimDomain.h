@@ -55,7 +55,11 @@ class ECSimDomain : public ECSimulation
 public:
     // constructors
     ECSimDomain(int tag, int nTrialCPs, ExperimentalCP **trialCPs,
-        int nOutCPs, ExperimentalCP **outCPs, Domain *theDomain);
+        int nOutCPs, ExperimentalCP **outCPs, Domain *theDomain,
+        int numbererType = 0, int systemType = 0,
+        double alphaSP = 1.0E12, double alphaMP = 1.0E12,
+        int testType = 0, double testTol = 1.0E-8, int testIter = 25,
+        int algorithmType = 0, int factorOnce = 0);
     ECSimDomain(const ECSimDomain& ec);
     
     // destructor
@@ -83,6 +87,12 @@ public:
     
     virtual int commitState();
     
+    // method to get the statically condensed tangent stiffness
+    // of the domain at the control point dofs
+    virtual int getTangentStiff(Matrix &kt);
+    
+    virtual bool usesGlobalDomain();
+    
     virtual ExperimentalControl *getCopy();
     
     // public methods for experimental control recorder
@@ -104,6 +114,16 @@ private:
     int numOutCPs;              // number of output control points
     ExperimentalCP **outCPs;    // output control points
     Domain *theDomain;          // OpenSees domain with specimen information
+    
+    int numbererType;   // DOF numberer (0: Plain, 1: RCM)
+    int systemType;     // linear SOE (0: BandGen, 1: ProfileSPD)
+    double alphaSP;     // penalty factor for SP constraints
+    double alphaMP;     // penalty factor for MP constraints
+    int testType;       // test (0: NormDispIncr, 1: NormUnbalance, 2: EnergyIncr)
+    double testTol;     // tolerance of convergence test
+    int testIter;       // maximum number of iterations of convergence test
+    int algorithmType;  // algorithm (0: Newton, 1: Newton -initial, 2: NewtonLineSearch, 3: Linear)
+    int factorOnce;     // flag to reuse tangent factorization (Linear only)
 
     AnalysisModel     *theModel;
     ConvergenceTest   *theTest;
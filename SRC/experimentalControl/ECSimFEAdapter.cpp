@@ -44,7 +44,7 @@ void* OPF_ECSimFEAdapter()
     if (OPS_GetNumRemainingInputArgs() < 7) {
         opserr << "WARNING invalid number of arguments\n";
         opserr << "Want: expControl SimFEAdapter tag ipAddr ipPort -trialCP cpTags -outCP cpTags "
-            << "<-ssl> <-udp> <-useRelativeTrial> "
+            << "<-ssl> <-udp> <-useRelativeTrial> <-fuseTrialForce> "
             << "<-ctrlFilters (5 filterTag)> <-daqFilters (5 filterTag)>\n";
         return 0;
     }
@@ -169,6 +169,7 @@ void* OPF_ECSimFEAdapter()
     // optional parameters
     int ssl = 0, udp = 0;
     int useRelativeTrial = 0;
+    int fuseTrialForce = 0;
     while (OPS_GetNumRemainingInputArgs() > 0)  {
         type = OPS_GetString();
         if (strcmp(type, "-ssl") == 0) {
@@ -183,11 +184,16 @@ void* OPF_ECSimFEAdapter()
             strcmp(type, "-useRelativeTrial") == 0)  {
                 useRelativeTrial = 1;
         }
+        else if (strcmp(type, "-fuse") == 0 ||
+            strcmp(type, "-fuseTrialForce") == 0)  {
+                fuseTrialForce = 1;
+        }
     }
     
     // parsing was successful, allocate the control
     theControl = new ECSimFEAdapter(tag, numTrialCPs, trialCPs,
-        numOutCPs, outCPs, ipAddr, ipPort, ssl, udp, useRelativeTrial);
+        numOutCPs, outCPs, ipAddr, ipPort, ssl, udp, useRelativeTrial,
+        fuseTrialForce);
     if (theControl == 0) {
         opserr << "WARNING could not create experimental control of type SimFEAdapter\n";
         return 0;
@@ -205,13 +211,14 @@ void* OPF_ECSimFEAdapter()
 
 ECSimFEAdapter::ECSimFEAdapter(int tag, int nTrialCPs, ExperimentalCP **trialcps,
     int nOutCPs, ExperimentalCP **outcps, char *ipaddress, int ipport, int _ssl,
-    int _udp, int reltrial)
+    int _udp, int reltrial, int fuse)
     : ECSimulation(tag), numTrialCPs(nTrialCPs), numOutCPs(nOutCPs),
     ipAddress(ipaddress), ipPort(ipport), ssl(_ssl), udp(_udp),
     dataSize(OF_Network_dataSize),
     theChannel(0), sData(0), sendData(0), rData(0), recvData(0),
     numCtrlSignals(0), numDaqSignals(0), ctrlSignal(0), daqSignal(0),
-    trialSigOffset(0), useRelativeTrial(reltrial), gotRelativeTrial(!reltrial)
+    trialSigOffset(0), useRelativeTrial(reltrial), gotRelativeTrial(!reltrial),
+    fuseTrialForce(fuse), forcePending(0)
 {
     // get trial and output control points
     if (trialcps == 0 || outcps == 0)  {
@@ -275,7 +282,8 @@ ECSimFEAdapter::ECSimFEAdapter(const ECSimFEAdapter &ec)
     : ECSimulation(ec), dataSize(OF_Network_dataSize),
     theChannel(0), sData(0), sendData(0), rData(0), recvData(0),
     numCtrlSignals(0), numDaqSignals(0), ctrlSignal(0), daqSignal(0),
-    trialSigOffset(0), useRelativeTrial(0), gotRelativeTrial(1)
+    trialSigOffset(0), useRelativeTrial(0), gotRelativeTrial(1),
+    fuseTrialForce(0), forcePending(0)
 {
     // use the existing channel which is set up
     numTrialCPs = ec.numTrialCPs;
@@ -295,6 +303,7 @@ ECSimFEAdapter::ECSimFEAdapter(const ECSimFEAdapter &ec)
     
     useRelativeTrial = ec.useRelativeTrial;
     gotRelativeTrial = ec.gotRelativeTrial;
+    fuseTrialForce   = ec.fuseTrialForce;
     
     // allocate memory for the send vectors
     sData = new double [dataSize];
@@ -656,6 +665,10 @@ void ECSimFEAdapter::Print(OPS_Stream &s, int flag)
         s << "\n*   useRelativeTrial: no";
     else
         s << "\n*   useRelativeTrial: yes";
+    if (fuseTrialForce == 0)
+        s << "\n*   fuseTrialForce: no";
+    else
+        s << "\n*   fuseTrialForce: yes";
     s << "\n*   ctrlFilter tags:";
     for (int i=0; i<OF_Resp_All; i++)  {
         if (theCtrlFilters[i] != 0)
@@ -676,7 +689,14 @@ void ECSimFEAdapter::Print(OPS_Stream &s, int flag)
 
 int ECSimFEAdapter::control()
 {
-    sData[0] = OF_RemoteTest_setTrialResponse;
+    if (fuseTrialForce)  {
+        // the adapter element returns the daq response by itself
+        // once it has applied the trial response
+        sData[0] = OF_RemoteTest_setTrialGetForce;
+        forcePending = 1;
+    }
+    else
+        sData[0] = OF_RemoteTest_setTrialResponse;
     theChannel->sendVector(0, 0, *sendData, 0);
     
     return OF_ReturnType_completed;
@@ -685,9 +705,13 @@ int ECSimFEAdapter::control()
 
 int ECSimFEAdapter::acquire()
 {
-    sData[0] = OF_RemoteTest_getForce;
-    theChannel->sendVector(0, 0, *sendData, 0);
+    // only request the daq response if it is not already on its way
+    if (forcePending == 0)  {
+        sData[0] = OF_RemoteTest_getForce;
+        theChannel->sendVector(0, 0, *sendData, 0);
+    }
     theChannel->recvVector(0, 0, *recvData, 0);
+    forcePending = 0;
     
     return OF_ReturnType_completed;
 }
@@ -29,6 +29,9 @@
 // Description: This file contains the class definition for ECSimFEAdapter.
 // ECSimFEAdapter is a controller class for communicating with an adapter
 // element of an other FE-software over a single TCP/IP connection.
+// If fuseTrialForce is set, the trial response is sent with an action
+// that tells the adapter element to return the daq response on its
+// own once the step is done, so that acquire only needs to receive.
 
 #include "ECSimulation.h"
 
@@ -44,7 +47,8 @@ public:
         int nOutCPs, ExperimentalCP **outCPs,
         char *ipAddress, int ipPort = 44000,
         int ssl = 0, int udp = 0,
-        int useRelativeTrial = 0);
+        int useRelativeTrial = 0,
+        int fuseTrialForce = 0);
     ECSimFEAdapter(const ECSimFEAdapter &ec);
     
     // destructor
@@ -108,6 +112,8 @@ private:
     Vector *ctrlSignal, *daqSignal;          // control and daq signals
     Vector trialSigOffset;                   // trial signal offsets
     int useRelativeTrial, gotRelativeTrial;  // relative trial signal flags
+    int fuseTrialForce;                      // combined trial/force flag
+    int forcePending;                        // daq response on its way
 };
 
 #endif
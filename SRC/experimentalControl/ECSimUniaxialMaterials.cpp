@@ -31,6 +31,8 @@
 #include <UniaxialMaterial.h>
 #include <elementAPI.h>
 
+#include <chrono>
+
 
 void* OPF_ECSimUniaxialMaterial()
 {
@@ -40,6 +42,7 @@ void* OPF_ECSimUniaxialMaterial()
     if (OPS_GetNumRemainingInputArgs() < 2) {
         opserr << "WARNING invalid number of arguments\n";
         opserr << "Want: expControl SimUniaxialMaterials tag matTags "
+            << "<-threads numThreads> "
             << "<-ctrlFilters (5 filterTag)> <-daqFilters (5 filterTag)>\n";
         return 0;
     }
@@ -75,6 +78,25 @@ void* OPF_ECSimUniaxialMaterial()
     }
     matTags.resize(numMats);
     
+    // optional parameters
+    int numThreads = 1;
+    while (OPS_GetNumRemainingInputArgs() > 0) {
+        const char* type = OPS_GetString();
+        if (strcmp(type, "-threads") == 0) {
+            numdata = 1;
+            if (OPS_GetIntInput(&numdata, &numThreads) != 0 || numThreads < 1) {
+                opserr << "WARNING invalid numThreads\n";
+                opserr << "expControl SimUniaxialMaterials " << tag << endln;
+                return 0;
+            }
+        }
+        else {
+            // move current arg back by one
+            OPS_ResetCurrentInputArg(-1);
+            break;
+        }
+    }
+    
     // create the array to hold the uniaxial materials
     UniaxialMaterial** theSpecimen = new UniaxialMaterial * [numMats];
     if (theSpecimen == 0) {
@@ -95,7 +117,8 @@ void* OPF_ECSimUniaxialMaterial()
     }
     
     // parsing was successful, allocate the control
-    theControl = new ECSimUniaxialMaterials(tag, numMats, theSpecimen);
+    theControl = new ECSimUniaxialMaterials(tag, numMats, theSpecimen,
+        numThreads);
     if (theControl == 0) {
         opserr << "WARNING could not create experimental control of type SimUniaxialMaterials\n";
         return 0;
@@ -110,11 +133,12 @@ void* OPF_ECSimUniaxialMaterial()
 
 
 ECSimUniaxialMaterials::ECSimUniaxialMaterials(int tag,
-    int nummats, UniaxialMaterial **specimen)
+    int nummats, UniaxialMaterial **specimen, int numthreads)
     : ECSimulation(tag),
     numMats(nummats), theSpecimen(0),
     ctrlDisp(0), ctrlVel(0),
-    daqDisp(0), daqVel(0), daqForce(0)
+    daqDisp(0), daqVel(0), daqForce(0), matTime(0),
+    numThreads(numthreads), taskCount(0), curTask(TaskControl), numBusy(0)
 {
     if (specimen == 0)  {
         opserr << "ECSimUniaxialMaterials::ECSimUniaxialMaterials() - "
@@ -144,6 +168,12 @@ ECSimUniaxialMaterials::ECSimUniaxialMaterials(int tag,
             exit(OF_ReturnType_failed);
         }
     }
+    
+    // allocate memory for the material timings
+    matTime = new Vector(numMats);
+    
+    // start the worker threads
+    this->startThreads();
 }
 
 
@@ -151,7 +181,8 @@ ECSimUniaxialMaterials::ECSimUniaxialMaterials(const ECSimUniaxialMaterials& ec)
     : ECSimulation(ec),
     numMats(0), theSpecimen(0),
     ctrlDisp(0), ctrlVel(0),
-    daqDisp(0), daqVel(0), daqForce(0)
+    daqDisp(0), daqVel(0), daqForce(0), matTime(0),
+    numThreads(ec.numThreads), taskCount(0), curTask(TaskControl), numBusy(0)
 {
     // allocate memory for the uniaxial materials
     numMats = ec.numMats;
@@ -176,11 +207,20 @@ ECSimUniaxialMaterials::ECSimUniaxialMaterials(const ECSimUniaxialMaterials& ec)
             exit(OF_ReturnType_failed);
         }
     }
+    
+    // allocate memory for the material timings
+    matTime = new Vector(numMats);
+    
+    // start the worker threads
+    this->startThreads();
 }
 
 
 ECSimUniaxialMaterials::~ECSimUniaxialMaterials()
 {
+    // stop the worker threads
+    this->stopThreads();
+    
     // delete memory of materials
     if (theSpecimen != 0)  {
         for (int i=0; i<numMats; i++)
@@ -202,6 +242,8 @@ ECSimUniaxialMaterials::~ECSimUniaxialMaterials()
         delete daqVel;
     if (daqForce != 0)
         delete daqForce;
+    if (matTime != 0)
+        delete matTime;
 }
 
 
@@ -349,13 +391,10 @@ int ECSimUniaxialMaterials::getDaqResponse(Vector* disp,
 
 int ECSimUniaxialMaterials::commitState()
 {
-    int rValue = 0;
-
-    for (int i=0; i<numMats; i++)  {
-        rValue += theSpecimen[i]->commitState();
-    }
+    if (numThreads > 1)
+        return this->runTask(TaskCommit);
     
-    return rValue;
+    return this->stepMaterials(TaskCommit, 0);
 }
 
 
@@ -440,6 +479,19 @@ Response* ECSimUniaxialMaterials::setResponse(const char **argv, int argc,
         theResponse = new ExpControlResponse(this, 5, *daqForce);
     }
     
+    // material timings
+    else if (strcmp(argv[0],"matTime") == 0 ||
+        strcmp(argv[0],"matTimes") == 0 ||
+        strcmp(argv[0],"materialTime") == 0 ||
+        strcmp(argv[0],"materialTimes") == 0)
+    {
+        for (i=0; i<numMats; i++)  {
+            snprintf(outputData,sizeof(outputData),"matTime%d",i+1);
+            output.tag("ResponseType",outputData);
+        }
+        theResponse = new ExpControlResponse(this, 6, *matTime);
+    }
+    
     output.endTag();
     
     return theResponse;
@@ -464,6 +516,9 @@ int ECSimUniaxialMaterials::getResponse(int responseID, Information &info)
     case 5:  // daq forces
         return info.setVector(*daqForce);
         
+    case 6:  // material timings
+        return info.setVector(*matTime);
+        
     default:
         return -1;
     }
@@ -478,6 +533,7 @@ void ECSimUniaxialMaterials::Print(OPS_Stream &s, int flag)
     for (int i=0; i<numMats; i++)  {
         s << "*   UniaxialMaterial: " << theSpecimen[i]->getTag() << endln;
     }
+    s << "*   numThreads: " << numThreads << endln;
     s << "*   ctrlFilters:";
     for (int i=0; i<OF_Resp_All; i++)  {
         if (theCtrlFilters[i] != 0)
@@ -500,13 +556,10 @@ void ECSimUniaxialMaterials::Print(OPS_Stream &s, int flag)
 
 int ECSimUniaxialMaterials::control()
 {
-    int rValue = 0;
-    
-    for (int i=0; i<numMats; i++)  {
-        rValue += theSpecimen[i]->setTrialStrain((*ctrlDisp)(i),(*ctrlVel)(i));
-    }
+    if (numThreads > 1)
+        return this->runTask(TaskControl);
     
-    return rValue;
+    return this->stepMaterials(TaskControl, 0);
 }
 
 
@@ -520,3 +573,117 @@ int ECSimUniaxialMaterials::acquire()
     
     return OF_ReturnType_completed;
 }
+
+
+void ECSimUniaxialMaterials::startThreads()
+{
+    // there is no point in having more threads than materials
+    if (numThreads > numMats)
+        numThreads = numMats;
+    if (numThreads < 1)
+        numThreads = 1;
+    
+    taskResult.assign(numThreads, 0);
+    
+    // the calling thread works on block 0, so only
+    // numThreads-1 additional workers need to be started
+    for (int t=1; t<numThreads; t++)
+        workers.push_back(std::thread(&ECSimUniaxialMaterials::workerLoop, this, t));
+}
+
+
+void ECSimUniaxialMaterials::stopThreads()
+{
+    if (workers.empty())
+        return;
+    
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        curTask = TaskStop;
+        taskCount++;
+    }
+    taskStart.notify_all();
+    
+    for (std::size_t t=0; t<workers.size(); t++)
+        workers[t].join();
+    workers.clear();
+}
+
+
+void ECSimUniaxialMaterials::workerLoop(int threadID)
+{
+    unsigned long lastTask = 0;
+    
+    while (true)  {
+        int theTask;
+        {
+            std::unique_lock<std::mutex> lock(poolMutex);
+            taskStart.wait(lock, [&]{ return taskCount != lastTask; });
+            lastTask = taskCount;
+            theTask = curTask;
+        }
+        if (theTask == TaskStop)
+            return;
+        
+        int rValue = this->stepMaterials(theTask, threadID);
+        
+        bool lastOne = false;
+        {
+            std::lock_guard<std::mutex> lock(poolMutex);
+            taskResult[threadID] = rValue;
+            lastOne = (--numBusy == 0);
+        }
+        if (lastOne)
+            taskDone.notify_one();
+    }
+}
+
+
+int ECSimUniaxialMaterials::runTask(int theTask)
+{
+    // hand the task to the workers
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        curTask = theTask;
+        numBusy = numThreads - 1;
+        taskCount++;
+    }
+    taskStart.notify_all();
+    
+    // work on own block while the workers are busy
+    int rValue = this->stepMaterials(theTask, 0);
+    
+    // wait for the workers and sum up the return values
+    // in a fixed order so that the result is deterministic
+    std::unique_lock<std::mutex> lock(poolMutex);
+    taskDone.wait(lock, [&]{ return numBusy == 0; });
+    for (int t=1; t<numThreads; t++)
+        rValue += taskResult[t];
+    
+    return rValue;
+}
+
+
+int ECSimUniaxialMaterials::stepMaterials(int theTask, int threadID)
+{
+    int rValue = 0;
+    
+    // contiguous block of materials owned by this thread
+    int first = (threadID*numMats)/numThreads;
+    int last = ((threadID+1)*numMats)/numThreads;
+    
+    if (theTask == TaskControl)  {
+        for (int i=first; i<last; i++)  {
+            std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+            rValue += theSpecimen[i]->setTrialStrain((*ctrlDisp)(i),(*ctrlVel)(i));
+            std::chrono::duration<double> dt = std::chrono::steady_clock::now() - t0;
+            (*matTime)(i) = dt.count();
+        }
+    }
+    else if (theTask == TaskCommit)  {
+        for (int i=first; i<last; i++)
+            rValue += theSpecimen[i]->commitState();
+    }
+    
+    return rValue;
+}
@@ -30,9 +30,18 @@
 // ECSimUniaxialMaterials. ECSimUniaxialMaterials is a controller
 // class for simulating the behavior of a specimen using any number
 // of OpenSees uniaxial material objects. The materials are uncoupled.
+// Optionally, the uncoupled materials can be stepped concurrently by a
+// persistent pool of worker threads, where each thread always owns the
+// same contiguous block of materials so that results are identical to
+// the serial loop.
 
 #include "ECSimulation.h"
 
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+
 class UniaxialMaterial;
 
 class ECSimUniaxialMaterials : public ECSimulation
@@ -40,7 +49,7 @@ class ECSimUniaxialMaterials : public ECSimulation
 public:
     // constructors
     ECSimUniaxialMaterials(int tag, int numMats,
-        UniaxialMaterial **theSpecimen);
+        UniaxialMaterial **theSpecimen, int numThreads = 1);
     ECSimUniaxialMaterials(const ECSimUniaxialMaterials& ec);
     
     // destructor
@@ -82,11 +91,30 @@ protected:
     virtual int acquire();
 
 private:
+    // tasks executed by the worker threads
+    enum {TaskControl, TaskCommit, TaskStop};
+    
+    void startThreads();
+    void stopThreads();
+    void workerLoop(int threadID);
+    int runTask(int task);
+    int stepMaterials(int task, int threadID);
+    
     int numMats;                     // number of uniaxial materials
     UniaxialMaterial **theSpecimen;  // uniaxial materials
     
     Vector *ctrlDisp, *ctrlVel;
     Vector *daqDisp, *daqVel, *daqForce;
+    Vector *matTime;                 // last setTrialStrain time per material
+    
+    int numThreads;                  // number of threads (incl. caller)
+    std::vector<std::thread> workers;
+    std::vector<int> taskResult;     // return value of each thread
+    std::mutex poolMutex;
+    std::condition_variable taskStart, taskDone;
+    unsigned long taskCount;         // incremented for each new task
+    int curTask;                     // task currently being executed
+    int numBusy;                     // number of workers still busy
 };
 
 #endif
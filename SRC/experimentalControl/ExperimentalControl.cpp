@@ -77,7 +77,7 @@ void OPF_clearExperimentalControls()
 ExperimentalControl::ExperimentalControl(int tag)
     : TaggedObject(tag),
     sizeCtrl(0), sizeDaq(0),
-    theCtrlFilters(0), theDaqFilters(0)
+    theCtrlFilters(0), theDaqFilters(0), theLog(0)
 {
     sizeCtrl = new ID(OF_Resp_All);
     sizeDaq = new ID(OF_Resp_All);
@@ -111,7 +111,7 @@ ExperimentalControl::ExperimentalControl(int tag)
 ExperimentalControl::ExperimentalControl(const ExperimentalControl& ec) 
     : TaggedObject(ec), 
     sizeCtrl(0), sizeDaq(0),
-    theCtrlFilters(0), theDaqFilters(0)
+    theCtrlFilters(0), theDaqFilters(0), theLog(0)
 {
     sizeCtrl = new ID(OF_Resp_All);
     sizeDaq = new ID(OF_Resp_All);
@@ -161,6 +161,8 @@ ExperimentalControl::~ExperimentalControl()
         delete [] theCtrlFilters;
     if (theDaqFilters != 0)
         delete [] theDaqFilters;
+    if (theLog != 0)
+        delete theLog;
 }
 
 
@@ -176,6 +178,19 @@ int ExperimentalControl::commitState()
 }
 
 
+int ExperimentalControl::getTangentStiff(Matrix &kt)
+{
+    // not available by default
+    return OF_ReturnType_failed;
+}
+
+
+bool ExperimentalControl::usesGlobalDomain()
+{
+    return false;
+}
+
+
 Response* ExperimentalControl::setResponse(const char **argv, int argc,
     OPS_Stream &output)
 {
@@ -260,3 +275,62 @@ void ExperimentalControl::sleep(const clock_t wait)
     goal = wait + clock();
     while (goal>clock());
 }
+
+
+int ExperimentalControl::setTrafficLog(const char *fileName)
+{
+    if (theLog != 0)
+        delete theLog;
+    
+    // the log is opened once the sizes are known
+    theLog = new ExpTrafficLog(fileName);
+    if (theLog == 0)  {
+        opserr << "ExperimentalControl::setTrafficLog() - "
+            << "failed to create traffic log.\n";
+        return OF_ReturnType_failed;
+    }
+    
+    return OF_ReturnType_completed;
+}
+
+
+int ExperimentalControl::logTrialResponse(const Vector* disp,
+    const Vector* vel,
+    const Vector* accel,
+    const Vector* force,
+    const Vector* time)
+{
+    if (theLog == 0)
+        return OF_ReturnType_completed;
+    
+    if (!theLog->isOpen() &&
+        theLog->open(ExpTrafficLog::Control, *sizeCtrl, *sizeDaq) < 0)  {
+        delete theLog;
+        theLog = 0;
+        return OF_ReturnType_failed;
+    }
+    
+    return theLog->writeTrial(disp, vel, accel, force, time);
+}
+
+
+int ExperimentalControl::logDaqResponse(const Vector* disp,
+    const Vector* vel,
+    const Vector* accel,
+    const Vector* force,
+    const Vector* time)
+{
+    if (theLog == 0 || !theLog->isOpen())
+        return OF_ReturnType_completed;
+    
+    return theLog->writeDaq(disp, vel, accel, force, time);
+}
+
+
+int ExperimentalControl::logCommitState()
+{
+    if (theLog == 0 || !theLog->isOpen())
+        return OF_ReturnType_completed;
+    
+    return theLog->writeCommit();
+}
@@ -35,10 +35,12 @@
 #include <FrescoGlobals.h>
 #include <ExpControlResponse.h>
 #include <ExperimentalSignalFilter.h>
+#include <ExpTrafficLog.h>
 
 #include <TaggedObject.h>
 #include <ID.h>
 #include <Vector.h>
+#include <Matrix.h>
 
 #include <time.h>
 
@@ -74,6 +76,15 @@ public:
     
     virtual int commitState();
     
+    // method to get the tangent stiffness of the control system
+    // (daq forces w.r.t. ctrl displacements), controls that cannot
+    // provide it return OF_ReturnType_failed
+    virtual int getTangentStiff(Matrix &kt);
+    
+    // method to query if the control drives the global domain of
+    // the interpreter, which must not be stepped from two threads
+    virtual bool usesGlobalDomain();
+    
     virtual ExperimentalControl *getCopy() = 0;
     
     // public methods for experimental control recorder
@@ -90,6 +101,21 @@ public:
     const ID& getSizeCtrl();
     const ID& getSizeDaq();
     
+    // public methods to capture the ctrl and daq traffic, these are
+    // called by whoever drives the control (setup, site or wrapper)
+    int setTrafficLog(const char *fileName);
+    int logTrialResponse(const Vector* disp,
+        const Vector* vel,
+        const Vector* accel,
+        const Vector* force,
+        const Vector* time);
+    int logDaqResponse(const Vector* disp,
+        const Vector* vel,
+        const Vector* accel,
+        const Vector* force,
+        const Vector* time);
+    int logCommitState();
+    
 protected:
     // protected methods to set and to get response
     virtual int control() = 0;
@@ -106,6 +132,9 @@ protected:
     // experimental signal filters
     ExperimentalSignalFilter **theCtrlFilters;
     ExperimentalSignalFilter **theDaqFilters;
+    
+    // log of the ctrl and daq traffic (0 if not captured)
+    ExpTrafficLog *theLog;
 };
 
 extern bool OPF_addExperimentalControl(ExperimentalControl* newComponent);
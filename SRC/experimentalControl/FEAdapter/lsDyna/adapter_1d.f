@@ -87,12 +87,16 @@ c
       integer*4 port
       integer*4 socketID
       integer*4 stat
+      integer*4 lastAction
       
       integer*4 iData(11)
       real*8    cData(sizeData)
       real*8    dData(sizeData)
       
       save cData, dData
+      save lastAction
+      
+      data lastAction /0/
       
       do i = lft, llt
          if (nint(hsv(i,1)) .eq. 0) then
@@ -127,6 +131,14 @@ c ...    update response if time has advanced
 c
          if (tt .gt. cData(1)) then
 c
+c ...       send daq displacements and forces of combined
+c ...       trial response and force request
+c
+            if (lastAction .eq. 16) then
+               call senddata(socketID, sizeDouble,
+     *                       dData, sizeData, stat)
+            endif
+c
 c ...       receive data
 c
             call recvdata(socketID, sizeDouble, cData, sizeData, stat)
@@ -146,7 +158,7 @@ c
      *                       cData, sizeData, stat)
             endif
             
-            if (cData(1) .ne. 3.) then
+            if (cData(1) .ne. 3. .and. cData(1) .ne. 16.) then
                if (cData(1) .eq. 99.) then
                   write(*,*) 'The Simulation has successfully completed'
                   call closeconnection(socketID, stat)
@@ -157,6 +169,7 @@ c
                   call adios(2)
                endif
             endif
+            lastAction = nint(cData(1))
 c
 c ...       save current time
 c
@@ -26,6 +26,8 @@
 // Description: This file contains the class definition for SimFEAdapter.
 // SimFEAdapter is a Simulink interface for communicating with an adapter
 // element of an other FE-software over a single TCP/IP connection.
+// The optional fourth parameter fuseTrialForce combines the trial
+// displacements and the force request into a single message.
 
 #define S_FUNCTION_NAME SFun_SimFEAdapter
 #define S_FUNCTION_LEVEL 2
@@ -44,6 +46,7 @@ void tcp_recvdata(const int *socketID, int *dataTypeSize, char data[], int *lenD
 #define ipAddr(S)   ssGetSFcnParam(S,0)    // ip address of adpater element
 #define ipPort(S)   ssGetSFcnParam(S,1)    // ip port of adapter element
 #define dataSize(S) ssGetSFcnParam(S,2)    // send/receive vector data size
+#define fuseTrialForce(S) ssGetSFcnParam(S,3)  // combined trial/force flag
 
 #define NPARAMS 3
 
@@ -71,6 +74,10 @@ static void mdlCheckParameters(SimStruct *S)
         ssSetErrorStatus(S,"dataSize must be a positive nonzero value");
         return;
     }
+    if (ssGetSFcnParamsCount(S) > NPARAMS && !mxIsDouble(fuseTrialForce(S)))  {
+        ssSetErrorStatus(S,"fuseTrialForce must be 0 or 1");
+        return;
+    }
 }
 #endif // MDL_CHECK_PARAMETERS
 
@@ -82,15 +89,17 @@ static void mdlCheckParameters(SimStruct *S)
 
 static void mdlInitializeSizes(SimStruct *S)
 {
-    ssSetNumSFcnParams(S, NPARAMS);    // Number of expected parameters
+    ssSetNumSFcnParams(S, -1);    // Variable number of parameters
 #if defined(MATLAB_MEX_FILE)
-    if (ssGetNumSFcnParams(S) == ssGetSFcnParamsCount(S))  {
+    if (ssGetSFcnParamsCount(S) == NPARAMS ||
+        ssGetSFcnParamsCount(S) == NPARAMS+1)  {
         mdlCheckParameters(S);
         if (ssGetErrorStatus(S) != NULL)  {
             return;
         }
     } else {
-        return;      // Parameter mismatch will be reported by Simulink
+        ssSetErrorStatus(S,"3 or 4 parameters are expected");
+        return;
     }
 #endif // MATLAB_MEX_FILE
     
@@ -106,7 +115,7 @@ static void mdlInitializeSizes(SimStruct *S)
     ssSetOutputPortWidth(S, 1, DYNAMICALLY_SIZED);
     
     ssSetNumSampleTimes(S, 1);
-    ssSetNumDWork(S, 5);
+    ssSetNumDWork(S, 6);
     ssSetNumRWork(S, 0);
     ssSetNumIWork(S, 0);
     ssSetNumPWork(S, 0);
@@ -131,6 +140,10 @@ static void mdlInitializeSizes(SimStruct *S)
     ssSetDWorkWidth(S, 4, 256);
     ssSetDWorkDataType(S, 4, SS_DOUBLE);
     
+    // allocate memory for fuseTrialForce flag
+    ssSetDWorkWidth(S, 5, 1);
+    ssSetDWorkDataType(S, 5, SS_INT32);
+    
     // take care when specifying exception free code - see sfuntmpl_doc.c
     ssSetOptions(S, SS_OPTION_EXCEPTION_FREE_CODE);
 }
@@ -173,9 +186,13 @@ static void mdlStart(SimStruct *S)
     real_T *sData   = (real_T*)ssGetDWork(S,2);
     real_T *rData   = (real_T*)ssGetDWork(S,3);
     real_T *ctrlDispPast = (real_T*)ssGetDWork(S,4);
+    int_T *fuse = (int_T*)ssGetDWork(S,5);
     
-    // initialize socketID and dataSize
+    // initialize socketID, dataSize and fuseTrialForce flag
     socketID[0] = -1;
+    fuse[0] = 0;
+    if (ssGetSFcnParamsCount(S) > NPARAMS)
+        fuse[0] = (mxGetScalar(fuseTrialForce(S)) != 0.0);
     dataSize[0] = (int_T)mxGetScalar(dataSize(S));
     dataSize[0] = (1+sizeCtrlDisp>dataSize[0]) ? 1+sizeCtrlDisp : dataSize[0];
     dataSize[0] = (sizeDaqDisp+sizeDaqForce>dataSize[0]) ? sizeDaqDisp+sizeDaqForce : dataSize[0];
@@ -253,6 +270,7 @@ static void mdlOutputs(SimStruct *S, int_T tid)
     real_T *sData   = (real_T*)ssGetDWork(S,2);
     real_T *rData   = (real_T*)ssGetDWork(S,3);
     real_T *ctrlDispPast = (real_T*)ssGetDWork(S,4);
+    int_T *fuse = (int_T*)ssGetDWork(S,5);
     
     UNUSED_ARG(tid);    // not used in single tasking mode
     
@@ -266,8 +284,9 @@ static void mdlOutputs(SimStruct *S, int_T tid)
     }
     
     if (hasChanged==1)  {
-        // send ctrl displacements
-        sData[0] = 3;
+        // send ctrl displacements, combined with
+        // the force request if requested
+        sData[0] = (fuse[0]) ? 16 : 3;
         for (i=0; i<sizeCtrlDisp; i++)  {
             sData[1+i] = (*ctrlDisp[i]);
             ctrlDispPast[i] = (*ctrlDisp[i]);
@@ -278,10 +297,12 @@ static void mdlOutputs(SimStruct *S, int_T tid)
         tcp_senddata(socketID, &dataTypeSize, gMsg, &nleft, &ierr);
         
         // get daq response
-        sData[0] = 10;
-        gMsg = (char_T *)sData;
-        nleft = dataSize[0];
-        tcp_senddata(socketID, &dataTypeSize, gMsg, &nleft, &ierr);
+        if (!fuse[0])  {
+            sData[0] = 10;
+            gMsg = (char_T *)sData;
+            nleft = dataSize[0];
+            tcp_senddata(socketID, &dataTypeSize, gMsg, &nleft, &ierr);
+        }
         
         gMsg = (char_T *)rData;
         nleft = dataSize[0];
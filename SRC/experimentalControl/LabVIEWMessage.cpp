@@ -0,0 +1,179 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation of
+// LabVIEWMessage.
+
+#include "LabVIEWMessage.h"
+
+#include <stdio.h>
+#include <string.h>
+
+
+LabVIEWMessage::LabVIEWMessage(int cap, int maxtokens)
+    : data(0), size(0), capacity(0),
+    tokens(0), numTokens(0), maxTokens(maxtokens), nextLine(0)
+{
+    if (maxTokens < 1)
+        maxTokens = 1;
+    tokens = new char* [maxTokens];
+    this->reserve(cap);
+    this->clear();
+}
+
+
+LabVIEWMessage::~LabVIEWMessage()
+{
+    if (data != 0)
+        delete [] data;
+    if (tokens != 0)
+        delete [] tokens;
+}
+
+
+int LabVIEWMessage::reserve(int cap)
+{
+    if (cap <= capacity)
+        return 0;
+    
+    char *newData = new char [cap];
+    if (data != 0)  {
+        memcpy(newData, data, size + 1);
+        delete [] data;
+    }
+    data = newData;
+    capacity = cap;
+    
+    return 0;
+}
+
+
+void LabVIEWMessage::clear()
+{
+    size = 0;
+    data[0] = '\0';
+    numTokens = 0;
+    nextLine = 0;
+}
+
+
+LabVIEWMessage &LabVIEWMessage::append(const char *token)
+{
+    int length = (int)strlen(token);
+    if (size + length + 2 >= capacity)
+        this->reserve(2*(size + length + 2));
+    
+    if (size > 0 && data[size-1] != '\n')
+        data[size++] = '\t';
+    memcpy(&data[size], token, length + 1);
+    size += length;
+    
+    return *this;
+}
+
+
+LabVIEWMessage &LabVIEWMessage::append(const char *prefix, int number)
+{
+    // appends the prefix followed by the number with at least two digits
+    int length = (int)strlen(prefix) + 16;
+    if (size + length + 2 >= capacity)
+        this->reserve(2*(size + length + 2));
+    
+    if (size > 0 && data[size-1] != '\n')
+        data[size++] = '\t';
+    size += sprintf(&data[size], "%s%02d", prefix, number);
+    
+    return *this;
+}
+
+
+LabVIEWMessage &LabVIEWMessage::append(double value)
+{
+    if (size + 32 >= capacity)
+        this->reserve(2*(size + 32));
+    
+    if (size > 0 && data[size-1] != '\n')
+        data[size++] = '\t';
+    size += sprintf(&data[size], "%.10E", value);
+    
+    return *this;
+}
+
+
+LabVIEWMessage &LabVIEWMessage::end()
+{
+    if (size + 2 >= capacity)
+        this->reserve(2*(size + 2));
+    
+    data[size++] = '\n';
+    data[size] = '\0';
+    
+    return *this;
+}
+
+
+int LabVIEWMessage::tokenize()
+{
+    // split the next line in place by replacing the
+    // tab and newline characters with null characters
+    numTokens = 0;
+    char *c = &data[nextLine];
+    tokens[0] = c;
+    if (*c == '\0')
+        return 0;
+    
+    numTokens++;
+    while (*c != '\0' && *c != '\n')  {
+        if (*c == '\t')  {
+            *c = '\0';
+            if (numTokens == maxTokens)  {
+                char **newTokens = new char* [2*maxTokens];
+                memcpy(newTokens, tokens, maxTokens*sizeof(char*));
+                delete [] tokens;
+                tokens = newTokens;
+                maxTokens *= 2;
+            }
+            tokens[numTokens++] = c + 1;
+        }
+        c++;
+    }
+    
+    // strip carriage return at end of line
+    if (*c == '\n')  {
+        *c = '\0';
+        nextLine = (int)(c - data) + 1;
+        if (c > data && *(c-1) == '\r')
+            *(c-1) = '\0';
+    } else
+        nextLine = (int)(c - data);
+    
+    return numTokens;
+}
+
+
+int LabVIEWMessage::hasNextLine() const
+{
+    return data[nextLine] != '\0';
+}
@@ -0,0 +1,81 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef LabVIEWMessage_h
+#define LabVIEWMessage_h
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the class definition for
+// LabVIEWMessage. A LabVIEWMessage is a reusable buffer for the
+// tab separated, newline terminated ASCII messages of the NEES
+// LabVIEW-plugin protocol. Messages are built by appending tokens
+// at the end of the buffer, and received messages are split into
+// their tokens in place in a single pass, so that neither building
+// nor parsing a message allocates memory once the buffers are
+// large enough.
+
+#include <FrescoGlobals.h>
+
+class LabVIEWMessage
+{
+public:
+    // constructor
+    LabVIEWMessage(int capacity = 512, int maxTokens = 64);
+    
+    // destructor
+    ~LabVIEWMessage();
+    
+    // method to make sure the buffer can hold capacity characters
+    int reserve(int capacity);
+    
+    // methods to build a message
+    void clear();
+    LabVIEWMessage &append(const char *token);
+    LabVIEWMessage &append(const char *prefix, int number);
+    LabVIEWMessage &append(double value);
+    LabVIEWMessage &end();
+    
+    // method to split the next line of the buffer into tokens
+    int tokenize();
+    int getNumTokens() const {return numTokens;};
+    const char *getToken(int i) const {return tokens[i];};
+    int hasNextLine() const;
+    
+    // methods to access the buffer
+    char *getData() {return data;};
+    int getSize() const {return size;};
+    int getCapacity() const {return capacity;};
+    
+private:
+    char *data;         // message buffer
+    int size;           // number of characters in buffer
+    int capacity;       // capacity of buffer
+    
+    char **tokens;      // tokens of current line
+    int numTokens;      // number of tokens of current line
+    int maxTokens;      // capacity of tokens array
+    int nextLine;       // start of next line in buffer
+};
+
+#endif
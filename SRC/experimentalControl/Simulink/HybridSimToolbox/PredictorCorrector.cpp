@@ -18,8 +18,41 @@
 #include <stdio.h>
 
 
+// Kernels for the Lagrange polynomials. The coefficients only depend
+// on x and xi, so they are evaluated once per call and the loops over
+// the DOFs are left as plain multiply-adds that the compiler can
+// vectorize. The output array must not alias any of the input arrays.
+static inline void combine2(double* __restrict sig, int n,
+    double c1, const double* s1, double c2, const double* s2)
+{
+    for (int k=0; k<n; k++)
+        sig[k] = c1*s1[k] + c2*s2[k];
+}
+
+
+static inline void combine3(double* __restrict sig, int n,
+    double c1, const double* s1, double c2, const double* s2,
+    double c3, const double* s3)
+{
+    for (int k=0; k<n; k++)
+        sig[k] = c1*s1[k] + c2*s2[k] + c3*s3[k];
+}
+
+
+static inline void combine4(double* __restrict sig, int n,
+    double c1, const double* s1, double c2, const double* s2,
+    double c3, const double* s3, double c4, const double* s4)
+{
+    for (int k=0; k<n; k++)
+        sig[k] = c1*s1[k] + c2*s2[k] + c3*s3[k] + c4*s4[k];
+}
+
+
 // constructor
 PredictorCorrector::PredictorCorrector()
+    : i(0), nDOF(0), dtCon(0.0), dtSim(0.0), dtInt(0.0), xi(0.0),
+    sig1(0), sig2(0), sig3(0), sig4(0), sig5(0), sig6(0), sigXi(0),
+    sigDot1(0), sigDot2(0), sigDotDot1(0)
 {
     // does nothing
 }
@@ -28,7 +61,7 @@ PredictorCorrector::PredictorCorrector()
 // destructor
 PredictorCorrector::~PredictorCorrector()
 {
-    // does nothing
+    freeData();
 }
 
 
@@ -39,6 +72,9 @@ int PredictorCorrector::initData(int ndof, double dtcon, double dtsim, double dt
     dtSim = dtsim;   // initialize simulation time step size
     dtInt = dtint;   // initialize integration time step size
     
+    // free data arrays of a previous initialization
+    freeData();
+    
     sig1  = (double*)calloc(nDOF, sizeof(double));
     sig2  = (double*)calloc(nDOF, sizeof(double));
     sig3  = (double*)calloc(nDOF, sizeof(double));
@@ -73,6 +109,19 @@ int PredictorCorrector::initData(int ndof, double dtcon, double dtsim, double dt
 }
 
 
+void PredictorCorrector::freeData()
+{
+    free(sig1);  free(sig2);  free(sig3);
+    free(sig4);  free(sig5);  free(sig6);
+    free(sigXi);
+    free(sigDot1);  free(sigDot2);
+    free(sigDotDot1);
+    
+    sig1 = sig2 = sig3 = sig4 = sig5 = sig6 = sigXi = 0;
+    sigDot1 = sigDot2 = sigDotDot1 = 0;
+}
+
+
 int PredictorCorrector::zeroData()
 {
     xi = 0.0;
@@ -273,10 +322,10 @@ int PredictorCorrector::predictP0(double* sig, double x)
 
 int PredictorCorrector::predictP1(double* sig, double x)
 {
-    for (i=0; i<nDOF; i++)  {
-        sig[i] = sig1[i]*(1.0+x)
-            - sig2[i]*(x);
-    }
+    const double c1 = (1.0+x);
+    const double c2 = -(x);
+    
+    combine2(sig, nDOF, c1, sig1, c2, sig2);
     
     return 0;
 }
@@ -284,10 +333,10 @@ int PredictorCorrector::predictP1(double* sig, double x)
 
 int PredictorCorrector::correctP1(double* sig, double x)
 {
-    for (i=0; i<nDOF; i++)  {
-        sig[i] = sig1[i]*(x)
-            + sig2[i]*(1.0-x);
-    }
+    const double c1 = (x);
+    const double c2 = (1.0-x);
+    
+    combine2(sig, nDOF, c1, sig1, c2, sig2);
     
     return 0;
 }
@@ -295,11 +344,11 @@ int PredictorCorrector::correctP1(double* sig, double x)
 
 int PredictorCorrector::predictP2(double* sig, double x)
 {
-    for (i=0; i<nDOF; i++)  {
-        sig[i] = sig1[i]*(1.0+x)*(2.0+x)/(2.0)
-            - sig2[i]*(x)*(2.0+x)
-            + sig3[i]*(x)*(1.0+x)/(2.0);
-    }
+    const double c1 = (1.0+x)*(2.0+x)/(2.0);
+    const double c2 = -(x)*(2.0+x);
+    const double c3 = (x)*(1.0+x)/(2.0);
+    
+    combine3(sig, nDOF, c1, sig1, c2, sig2, c3, sig3);
     
     return 0;
 }
@@ -307,11 +356,11 @@ int PredictorCorrector::predictP2(double* sig, double x)
 
 int PredictorCorrector::correctP2(double* sig, double x)
 {
-    for (i=0; i<nDOF; i++)  {
-        sig[i] = sig1[i]*(x)*(1.0+x)/(2.0)
-            + sig2[i]*(1.0-x)*(1.0+x)
-            - sig3[i]*(1.0-x)*(x)/(2.0);
-    }
+    const double c1 = (x)*(1.0+x)/(2.0);
+    const double c2 = (1.0-x)*(1.0+x);
+    const double c3 = -(1.0-x)*(x)/(2.0);
+    
+    combine3(sig, nDOF, c1, sig1, c2, sig2, c3, sig3);
     
     return 0;
 }
@@ -319,12 +368,12 @@ int PredictorCorrector::correctP2(double* sig, double x)
 
 int PredictorCorrector::predictP3(double* sig, double x)
 {
-    for (i=0; i<nDOF; i++)  {
-        sig[i] = sig1[i]*(1.0+x)*(2.0+x)*(3.0+x)/(6.0)
-            - sig2[i]*(x)*(2.0+x)*(3.0+x)/(2.0)
-            + sig3[i]*(x)*(1.0+x)*(3.0+x)/(2.0)
-            - sig4[i]*(x)*(1.0+x)*(2.0+x)/(6.0);
-    }
+    const double c1 = (1.0+x)*(2.0+x)*(3.0+x)/(6.0);
+    const double c2 = -(x)*(2.0+x)*(3.0+x)/(2.0);
+    const double c3 = (x)*(1.0+x)*(3.0+x)/(2.0);
+    const double c4 = -(x)*(1.0+x)*(2.0+x)/(6.0);
+    
+    combine4(sig, nDOF, c1, sig1, c2, sig2, c3, sig3, c4, sig4);
     
     return 0;
 }
@@ -332,12 +381,12 @@ int PredictorCorrector::predictP3(double* sig, double x)
 
 int PredictorCorrector::correctP3(double* sig, double x)
 {
-    for (i=0; i<nDOF; i++)  {
-        sig[i] = sig1[i]*(x)*(1.0+x)*(2.0+x)/(6.0)
-            + sig2[i]*(1.0-x)*(1.0+x)*(2.0+x)/(2.0)
-            - sig3[i]*(1.0-x)*(x)*(2.0+x)/(2.0)
-            + sig4[i]*(1.0-x)*(x)*(1.0+x)/(6.0);
-    }
+    const double c1 = (x)*(1.0+x)*(2.0+x)/(6.0);
+    const double c2 = (1.0-x)*(1.0+x)*(2.0+x)/(2.0);
+    const double c3 = -(1.0-x)*(x)*(2.0+x)/(2.0);
+    const double c4 = (1.0-x)*(x)*(1.0+x)/(6.0);
+    
+    combine4(sig, nDOF, c1, sig1, c2, sig2, c3, sig3, c4, sig4);
     
     return 0;
 }
@@ -355,10 +404,10 @@ int PredictorCorrector::predictD0(double* sig, double x)
 
 int PredictorCorrector::predictD1(double* sig, double x)
 {
-    for (i=0; i<nDOF; i++)  {
-        sig[i] = sigXi[i]*(1.0+x)/(xi)
-            - sig2[i]*(1.0+x-xi)/(xi);
-    }
+    const double c1 = (1.0+x)/(xi);
+    const double c2 = -(1.0+x-xi)/(xi);
+    
+    combine2(sig, nDOF, c1, sigXi, c2, sig2);
     
     return 0;
 }
@@ -387,10 +436,10 @@ int PredictorCorrector::predictA1(double* sigDotDot, double x)
 
 int PredictorCorrector::correctD1(double* sig, double x)
 {
-    for (i=0; i<nDOF; i++)  {
-        sig[i] = sig1[i]*(x-xi)/(1.0-xi)
-            + sigXi[i]*(1.0-x)/(1.0-xi);
-    }
+    const double c1 = (x-xi)/(1.0-xi);
+    const double c2 = (1.0-x)/(1.0-xi);
+    
+    combine2(sig, nDOF, c1, sig1, c2, sigXi);
     
     return 0;
 }
@@ -419,11 +468,11 @@ int PredictorCorrector::correctA1(double* sigDotDot, double x)
 
 int PredictorCorrector::predictD2(double* sig, double x)
 {
-    for (i=0; i<nDOF; i++)  {
-        sig[i] = sigXi[i]*(1.0+x)*(2.0+x)/(xi)/(1.0+xi)
-            - sig2[i]*(1.0+x-xi)*(2.0+x)/(xi)
-            + sig3[i]*(1.0+x-xi)*(1.0+x)/(1.0+xi);
-    }
+    const double c1 = (1.0+x)*(2.0+x)/(xi)/(1.0+xi);
+    const double c2 = -(1.0+x-xi)*(2.0+x)/(xi);
+    const double c3 = (1.0+x-xi)*(1.0+x)/(1.0+xi);
+    
+    combine3(sig, nDOF, c1, sigXi, c2, sig2, c3, sig3);
     
     return 0;
 }
@@ -431,12 +480,11 @@ int PredictorCorrector::predictD2(double* sig, double x)
 
 int PredictorCorrector::predictV2(double* sigDot, double x)
 {
-    for (i=0; i<nDOF; i++)  {
-        sigDot[i] = sigXi[i]*(3.0+2.0*x)/(xi)/(1.0+xi)
-            - sig2[i]*(3.0+2.0*x-xi)/(xi)
-            + sig3[i]*(2.0+2.0*x-xi)/(1.0+xi);
-        sigDot[i] /= dtSim;
-    }
+    const double c1 = ((3.0+2.0*x)/(xi)/(1.0+xi))/dtSim;
+    const double c2 = -((3.0+2.0*x-xi)/(xi))/dtSim;
+    const double c3 = ((2.0+2.0*x-xi)/(1.0+xi))/dtSim;
+    
+    combine3(sigDot, nDOF, c1, sigXi, c2, sig2, c3, sig3);
     
     return 0;
 }
@@ -444,12 +492,11 @@ int PredictorCorrector::predictV2(double* sigDot, double x)
 
 int PredictorCorrector::predictA2(double* sigDotDot, double x)
 {
-    for (i=0; i<nDOF; i++)  {
-        sigDotDot[i] = sigXi[i]*(2.0)/(xi)/(1.0+xi)
-            - sig2[i]*(2.0)/(xi)
-            + sig3[i]*(2.0)/(1.0+xi);
-        sigDotDot[i] /= (dtSim*dtSim);
-    }
+    const double c1 = ((2.0)/(xi)/(1.0+xi))/(dtSim*dtSim);
+    const double c2 = -((2.0)/(xi))/(dtSim*dtSim);
+    const double c3 = ((2.0)/(1.0+xi))/(dtSim*dtSim);
+    
+    combine3(sigDotDot, nDOF, c1, sigXi, c2, sig2, c3, sig3);
     
     return 0;
 }
@@ -457,11 +504,11 @@ int PredictorCorrector::predictA2(double* sigDotDot, double x)
 
 int PredictorCorrector::correctD2(double* sig, double x)
 {
-    for (i=0; i<nDOF; i++)  {
-        sig[i] = sig1[i]*(x-xi)*(1.0+x)/(2.0)/(1.0-xi)
-            + sigXi[i]*(1.0-x)*(1.0+x)/(1.0-xi)/(1.0+xi)
-            - sig3[i]*(1.0-x)*(x-xi)/(2.0)/(1.0+xi);
-    }
+    const double c1 = (x-xi)*(1.0+x)/(2.0)/(1.0-xi);
+    const double c2 = (1.0-x)*(1.0+x)/(1.0-xi)/(1.0+xi);
+    const double c3 = -(1.0-x)*(x-xi)/(2.0)/(1.0+xi);
+    
+    combine3(sig, nDOF, c1, sig1, c2, sigXi, c3, sig3);
     
     return 0;
 }
@@ -469,12 +516,11 @@ int PredictorCorrector::correctD2(double* sig, double x)
 
 int PredictorCorrector::correctV2(double* sigDot, double x)
 {
-    for (i=0; i<nDOF; i++)  {
-        sigDot[i] = sig1[i]*(1.0+2.0*x-xi)/(2.0)/(1.0-xi)
-            - sigXi[i]*(2.0*x)/(1.0-xi)/(1.0+xi)
-            - sig3[i]*(1.0-2.0*x+xi)/(2.0)/(1.0+xi);
-        sigDot[i] /= dtSim;
-    }
+    const double c1 = ((1.0+2.0*x-xi)/(2.0)/(1.0-xi))/dtSim;
+    const double c2 = -((2.0*x)/(1.0-xi)/(1.0+xi))/dtSim;
+    const double c3 = -((1.0-2.0*x+xi)/(2.0)/(1.0+xi))/dtSim;
+    
+    combine3(sigDot, nDOF, c1, sig1, c2, sigXi, c3, sig3);
     
     return 0;
 }
@@ -482,12 +528,11 @@ int PredictorCorrector::correctV2(double* sigDot, double x)
 
 int PredictorCorrector::correctA2(double* sigDotDot, double x)
 {
-    for (i=0; i<nDOF; i++)  {
-        sigDotDot[i] = sig1[i]/(1.0-xi)
-            - sigXi[i]*(2.0)/(1.0-xi)/(1.0+xi)
-            + sig3[i]/(1.0+xi);
-        sigDotDot[i] /= (dtSim*dtSim);
-    }
+    const double c1 = (1.0/(1.0-xi))/(dtSim*dtSim);
+    const double c2 = -((2.0)/(1.0-xi)/(1.0+xi))/(dtSim*dtSim);
+    const double c3 = (1.0/(1.0+xi))/(dtSim*dtSim);
+    
+    combine3(sigDotDot, nDOF, c1, sig1, c2, sigXi, c3, sig3);
     
     return 0;
 }
@@ -495,12 +540,12 @@ int PredictorCorrector::correctA2(double* sigDotDot, double x)
 
 int PredictorCorrector::predictD3(double* sig, double x)
 {
-    for (i=0; i<nDOF; i++)  {
-        sig[i] = sigXi[i]*(1.0+x)*(2.0+x)*(3.0+x)/(xi)/(1.0+xi)/(2.0+xi)
-            - sig2[i]*(1.0+x-xi)*(2.0+x)*(3.0+x)/(2.0*xi)
-            + sig3[i]*(1.0+x-xi)*(1.0+x)*(3.0+x)/(1.0+xi)
-            - sig4[i]*(1.0+x-xi)*(1.0+x)*(2.0+x)/(2.0)/(2.0+xi);
-    }
+    const double c1 = (1.0+x)*(2.0+x)*(3.0+x)/(xi)/(1.0+xi)/(2.0+xi);
+    const double c2 = -(1.0+x-xi)*(2.0+x)*(3.0+x)/(2.0*xi);
+    const double c3 = (1.0+x-xi)*(1.0+x)*(3.0+x)/(1.0+xi);
+    const double c4 = -(1.0+x-xi)*(1.0+x)*(2.0+x)/(2.0)/(2.0+xi);
+    
+    combine4(sig, nDOF, c1, sigXi, c2, sig2, c3, sig3, c4, sig4);
     
     return 0;
 }
@@ -508,13 +553,12 @@ int PredictorCorrector::predictD3(double* sig, double x)
 
 int PredictorCorrector::predictV3(double* sigDot, double x)
 {
-    for (i=0; i<nDOF; i++)  {
-        sigDot[i] = sigXi[i]*(11.0+12.0*x+3.0*x*x)/(xi)/(1.0+xi)/(2.0+xi)
-            - sig2[i]*(11.0+12.0*x+3.0*x*x-5.0*xi-2.0*x*xi)/(2.0*xi)
-            + sig3[i]*(7.0+10.0*x+3.0*x*x-4.0*xi-2.0*x*xi)/(1.0+xi)
-            - sig4[i]*(5.0+8.0*x+3.0*x*x-3.0*xi-2.0*x*xi)/(2.0)/(2.0+xi);
-        sigDot[i] /= dtSim;
-    }
+    const double c1 = ((11.0+12.0*x+3.0*x*x)/(xi)/(1.0+xi)/(2.0+xi))/dtSim;
+    const double c2 = -((11.0+12.0*x+3.0*x*x-5.0*xi-2.0*x*xi)/(2.0*xi))/dtSim;
+    const double c3 = ((7.0+10.0*x+3.0*x*x-4.0*xi-2.0*x*xi)/(1.0+xi))/dtSim;
+    const double c4 = -((5.0+8.0*x+3.0*x*x-3.0*xi-2.0*x*xi)/(2.0)/(2.0+xi))/dtSim;
+    
+    combine4(sigDot, nDOF, c1, sigXi, c2, sig2, c3, sig3, c4, sig4);
     
     return 0;
 }
@@ -522,13 +566,12 @@ int PredictorCorrector::predictV3(double* sigDot, double x)
 
 int PredictorCorrector::predictA3(double* sigDotDot, double x)
 {
-    for (i=0; i<nDOF; i++)  {
-        sigDotDot[i] = sigXi[i]*(6.0)*(2.0+x)/(xi)/(1.0+xi)/(2.0+xi)
-            - sig2[i]*(6.0+3.0*x-xi)/(xi)
-            + sig3[i]*(2.0)*(5.0+3.0*x-xi)/(1.0+xi)
-            - sig4[i]*(4.0+3.0*x-xi)/(2.0+xi);
-        sigDotDot[i] /= (dtSim*dtSim);
-    }
+    const double c1 = ((6.0)*(2.0+x)/(xi)/(1.0+xi)/(2.0+xi))/(dtSim*dtSim);
+    const double c2 = -((6.0+3.0*x-xi)/(xi))/(dtSim*dtSim);
+    const double c3 = ((2.0)*(5.0+3.0*x-xi)/(1.0+xi))/(dtSim*dtSim);
+    const double c4 = -((4.0+3.0*x-xi)/(2.0+xi))/(dtSim*dtSim);
+    
+    combine4(sigDotDot, nDOF, c1, sigXi, c2, sig2, c3, sig3, c4, sig4);
     
     return 0;
 }
@@ -536,12 +579,12 @@ int PredictorCorrector::predictA3(double* sigDotDot, double x)
 
 int PredictorCorrector::correctD3(double* sig, double x)
 {
-    for (i=0; i<nDOF; i++)  {
-        sig[i] = sig1[i]*(x-xi)*(1.0+x)*(2.0+x)/(6.0)/(1-xi)
-            + sigXi[i]*(1.0-x)*(1.0+x)*(2.0+x)/(1.0-xi)/(1.0+xi)/(2.0+xi)
-            - sig3[i]*(1.0-x)*(x-xi)*(2.0+x)/(2.0)/(1.0+xi)
-            + sig4[i]*(1.0-x)*(x-xi)*(1.0+x)/(3.0)/(2.0+xi);
-    }
+    const double c1 = (x-xi)*(1.0+x)*(2.0+x)/(6.0)/(1-xi);
+    const double c2 = (1.0-x)*(1.0+x)*(2.0+x)/(1.0-xi)/(1.0+xi)/(2.0+xi);
+    const double c3 = -(1.0-x)*(x-xi)*(2.0+x)/(2.0)/(1.0+xi);
+    const double c4 = (1.0-x)*(x-xi)*(1.0+x)/(3.0)/(2.0+xi);
+    
+    combine4(sig, nDOF, c1, sig1, c2, sigXi, c3, sig3, c4, sig4);
     
     return 0;
 }
@@ -549,13 +592,12 @@ int PredictorCorrector::correctD3(double* sig, double x)
 
 int PredictorCorrector::correctV3(double* sigDot, double x)
 {
-    for (i=0; i<nDOF; i++)  {
-        sigDot[i] = sig1[i]*(2.0+6.0*x+3.0*x*x-3.0*xi-2.0*x*xi)/(6.0)/(1-xi)
-            + sigXi[i]*(1.0-4.0*x-3.0*x*x)/(1.0-xi)/(1.0+xi)/(2.0+xi)
-            - sig3[i]*(2.0-2.0*x-3.0*x*x+xi+2.0*x*xi)/(2.0)/(1.0+xi)
-            + sig4[i]*(1.0-3.0*x*x+2.0*x*xi)/(3.0)/(2.0+xi);
-        sigDot[i] /= dtSim;
-    }
+    const double c1 = ((2.0+6.0*x+3.0*x*x-3.0*xi-2.0*x*xi)/(6.0)/(1-xi))/dtSim;
+    const double c2 = ((1.0-4.0*x-3.0*x*x)/(1.0-xi)/(1.0+xi)/(2.0+xi))/dtSim;
+    const double c3 = -((2.0-2.0*x-3.0*x*x+xi+2.0*x*xi)/(2.0)/(1.0+xi))/dtSim;
+    const double c4 = ((1.0-3.0*x*x+2.0*x*xi)/(3.0)/(2.0+xi))/dtSim;
+    
+    combine4(sigDot, nDOF, c1, sig1, c2, sigXi, c3, sig3, c4, sig4);
     
     return 0;
 }
@@ -563,13 +605,12 @@ int PredictorCorrector::correctV3(double* sigDot, double x)
 
 int PredictorCorrector::correctA3(double* sigDotDot, double x)
 {
-    for (i=0; i<nDOF; i++)  {
-        sigDotDot[i] = sig1[i]*(3.0+3.0*x-xi)/(3.0)/(1-xi)
-            - sigXi[i]*(2.0)*(2.0+3.0*x)/(1.0-xi)/(1.0+xi)/(2.0+xi)
-            + sig3[i]*(1.0+3.0*x-xi)/(1.0+xi)
-            - sig4[i]*(2.0)*(3.0*x-xi)/(3.0)/(2.0+xi);
-        sigDotDot[i] /= (dtSim*dtSim);
-    }
+    const double c1 = ((3.0+3.0*x-xi)/(3.0)/(1-xi))/(dtSim*dtSim);
+    const double c2 = -((2.0)*(2.0+3.0*x)/(1.0-xi)/(1.0+xi)/(2.0+xi))/(dtSim*dtSim);
+    const double c3 = ((1.0+3.0*x-xi)/(1.0+xi))/(dtSim*dtSim);
+    const double c4 = -((2.0)*(3.0*x-xi)/(3.0)/(2.0+xi))/(dtSim*dtSim);
+    
+    combine4(sigDotDot, nDOF, c1, sig1, c2, sigXi, c3, sig3, c4, sig4);
     
     return 0;
 }
@@ -577,12 +618,12 @@ int PredictorCorrector::correctA3(double* sigDotDot, double x)
 
 int PredictorCorrector::predictDV(double* sig, double x)
 {
-    for (i=0; i<nDOF; i++)  {
-        sig[i] = sig1[i]*(1.0+x)*(1.0+x)*(1.0-2.0*x)
-            + sigDot1[i]*(x)*(1.0+x)*(1.0+x) 
-            + sig2[i]*(x)*(x)*(3.0+2.0*x)
-            + sigDot2[i]*(x)*(x)*(1.0+x);
-    }
+    const double c1 = (1.0+x)*(1.0+x)*(1.0-2.0*x);
+    const double c2 = (x)*(1.0+x)*(1.0+x);
+    const double c3 = (x)*(x)*(3.0+2.0*x);
+    const double c4 = (x)*(x)*(1.0+x);
+    
+    combine4(sig, nDOF, c1, sig1, c2, sigDot1, c3, sig2, c4, sigDot2);
     
     return 0;
 }
@@ -590,11 +631,11 @@ int PredictorCorrector::predictDV(double* sig, double x)
 
 int PredictorCorrector::correctDV(double* sig, double x)
 {
-    for (i=0; i<nDOF; i++)  {
-        sig[i] = sig1[i]*(x-xi)*(2.0-x-xi)/(1.0-xi)/(1.0-xi)
-            - sigDot1[i]*(1.0-x)*(x-xi)/(1.0-xi)
-            + sigXi[i]*(1.0-x)*(1.0-x)/(1.0-xi)/(1.0-xi);
-    }
+    const double c1 = (x-xi)*(2.0-x-xi)/(1.0-xi)/(1.0-xi);
+    const double c2 = -(1.0-x)*(x-xi)/(1.0-xi);
+    const double c3 = (1.0-x)*(1.0-x)/(1.0-xi)/(1.0-xi);
+    
+    combine3(sig, nDOF, c1, sig1, c2, sigDot1, c3, sigXi);
     
     return 0;
 }
@@ -602,11 +643,11 @@ int PredictorCorrector::correctDV(double* sig, double x)
 
 int PredictorCorrector::predictDVA(double* sig, double x)
 {
-    for (i=0; i<nDOF; i++)  {
-        sig[i] = sig1[i]
-            + sigDot1[i]*(x)
-            + sigDotDot1[i]*(x)*(x)/(2.0);
-    }
+    const double c1 = 1.0;
+    const double c2 = (x);
+    const double c3 = (x)*(x)/(2.0);
+    
+    combine3(sig, nDOF, c1, sig1, c2, sigDot1, c3, sigDotDot1);
     
     return 0;
 }
@@ -614,12 +655,12 @@ int PredictorCorrector::predictDVA(double* sig, double x)
 
 int PredictorCorrector::correctDVA(double* sig, double x)
 {
-    for (i=0; i<nDOF; i++)  {
-        sig[i] = sig1[i]*(x-xi)*(3.0-3.0*x+x*x-3.0*xi+x*xi+xi*xi)/(1.0-xi)/(1.0-xi)/(1.0-xi)
-            - sigDot1[i]*(1.0-x)*(x-xi)*(2.0-x-xi)/(1.0-xi)/(1.0-xi)
-            + sigDotDot1[i]*(1.0-x)*(1.0-x)*(x-xi)/(2.0)/(1.0-xi)
-            + sigXi[i]*(1.0-x)*(1.0-x)*(1.0-x)/(1.0-xi)/(1.0-xi)/(1.0-xi);
-    }
+    const double c1 = (x-xi)*(3.0-3.0*x+x*x-3.0*xi+x*xi+xi*xi)/(1.0-xi)/(1.0-xi)/(1.0-xi);
+    const double c2 = -(1.0-x)*(x-xi)*(2.0-x-xi)/(1.0-xi)/(1.0-xi);
+    const double c3 = (1.0-x)*(1.0-x)*(x-xi)/(2.0)/(1.0-xi);
+    const double c4 = (1.0-x)*(1.0-x)*(1.0-x)/(1.0-xi)/(1.0-xi)/(1.0-xi);
+    
+    combine4(sig, nDOF, c1, sig1, c2, sigDot1, c3, sigDotDot1, c4, sigXi);
     
     return 0;
 }
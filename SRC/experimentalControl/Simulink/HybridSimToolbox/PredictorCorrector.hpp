@@ -26,6 +26,7 @@ class PredictorCorrector
         // methods to initialize the data arrays
         int initData(int nDOF, double dtCon, double dtSim, double dtInt);
         int zeroData();
+        void freeData();
         int setData(double* sig);
         int setDataDot(double* sigDot);
         int setDataDotDot(double* sigDotDot);
@@ -729,6 +729,7 @@ int EEBeamColumn2d::update()
         else  {
             sData[0] = OF_RemoteTest_setTrialResponse;
             rValue += theChannel->sendVector(0, 0, *sendData, 0);
+            daqFlag = false;
         }
     }
     
@@ -1100,9 +1101,7 @@ const Vector& EEBeamColumn2d::getTime()
         (*tDaq) = theSite->getTime();
     }
     else  {
-        sData[0] = OF_RemoteTest_getTime;
-        theChannel->sendVector(0, 0, *sendData, 0);
-        theChannel->recvVector(0, 0, *recvData, 0);
+        this->recvDaqResponse(theChannel, sendData, recvData);
     }
     
     return *tDaq;
@@ -1115,9 +1114,7 @@ const Vector& EEBeamColumn2d::getBasicDisp()
         (*dbDaq) = theSite->getDisp();
     }
     else  {
-        sData[0] = OF_RemoteTest_getDisp;
-        theChannel->sendVector(0, 0, *sendData, 0);
-        theChannel->recvVector(0, 0, *recvData, 0);
+        this->recvDaqResponse(theChannel, sendData, recvData);
     }
     
     return *dbDaq;
@@ -1130,9 +1127,7 @@ const Vector& EEBeamColumn2d::getBasicVel()
         (*vbDaq) = theSite->getVel();
     }
     else  {
-        sData[0] = OF_RemoteTest_getVel;
-        theChannel->sendVector(0, 0, *sendData, 0);
-        theChannel->recvVector(0, 0, *recvData, 0);
+        this->recvDaqResponse(theChannel, sendData, recvData);
     }
     
     return *vbDaq;
@@ -1145,9 +1140,7 @@ const Vector& EEBeamColumn2d::getBasicAccel()
         (*abDaq) = theSite->getAccel();
     }
     else  {
-        sData[0] = OF_RemoteTest_getAccel;
-        theChannel->sendVector(0, 0, *sendData, 0);
-        theChannel->recvVector(0, 0, *recvData, 0);
+        this->recvDaqResponse(theChannel, sendData, recvData);
     }
     
     return *abDaq;
@@ -1160,9 +1153,7 @@ const Vector& EEBeamColumn2d::getBasicForce()
         (*qbDaq) = theSite->getForce();
     }
     else  {
-        sData[0] = OF_RemoteTest_getForce;
-        theChannel->sendVector(0, 0, *sendData, 0);
-        theChannel->recvVector(0, 0, *recvData, 0);
+        this->recvDaqResponse(theChannel, sendData, recvData);
     }
     
     return *qbDaq;
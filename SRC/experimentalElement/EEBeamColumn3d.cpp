@@ -756,6 +756,7 @@ int EEBeamColumn3d::update()
         else  {
             sData[0] = OF_RemoteTest_setTrialResponse;
             rValue += theChannel->sendVector(0, 0, *sendData, 0);
+            daqFlag = false;
         }
     }
     
@@ -1178,9 +1179,7 @@ const Vector& EEBeamColumn3d::getTime()
         (*tDaq) = theSite->getTime();
     }
     else  {
-        sData[0] = OF_RemoteTest_getTime;
-        theChannel->sendVector(0, 0, *sendData, 0);
-        theChannel->recvVector(0, 0, *recvData, 0);
+        this->recvDaqResponse(theChannel, sendData, recvData);
     }
     
     return *tDaq;
@@ -1193,9 +1192,7 @@ const Vector& EEBeamColumn3d::getBasicDisp()
         (*dbDaq) = theSite->getDisp();
     }
     else  {
-        sData[0] = OF_RemoteTest_getDisp;
-        theChannel->sendVector(0, 0, *sendData, 0);
-        theChannel->recvVector(0, 0, *recvData, 0);
+        this->recvDaqResponse(theChannel, sendData, recvData);
     }
     
     return *dbDaq;
@@ -1208,9 +1205,7 @@ const Vector& EEBeamColumn3d::getBasicVel()
         (*vbDaq) = theSite->getVel();
     }
     else  {
-        sData[0] = OF_RemoteTest_getVel;
-        theChannel->sendVector(0, 0, *sendData, 0);
-        theChannel->recvVector(0, 0, *recvData, 0);
+        this->recvDaqResponse(theChannel, sendData, recvData);
     }
     
     return *vbDaq;
@@ -1223,9 +1218,7 @@ const Vector& EEBeamColumn3d::getBasicAccel()
         (*abDaq) = theSite->getAccel();
     }
     else  {
-        sData[0] = OF_RemoteTest_getAccel;
-        theChannel->sendVector(0, 0, *sendData, 0);
-        theChannel->recvVector(0, 0, *recvData, 0);
+        this->recvDaqResponse(theChannel, sendData, recvData);
     }
     
     return *abDaq;
@@ -1238,9 +1231,7 @@ const Vector& EEBeamColumn3d::getBasicForce()
         (*qbDaq) = theSite->getForce();
     }
     else  {
-        sData[0] = OF_RemoteTest_getForce;
-        theChannel->sendVector(0, 0, *sendData, 0);
-        theChannel->recvVector(0, 0, *recvData, 0);
+        this->recvDaqResponse(theChannel, sendData, recvData);
     }
     
     return *qbDaq;
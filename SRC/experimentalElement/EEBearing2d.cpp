@@ -763,15 +763,8 @@ int EEBearing2d::commitState()
     rValue += this->Element::commitState();
     
     // update dbLast
-    int ndim = 0, i;
-    Vector dgLast(6), dlLast(6);
-    for (i=0; i<2; i++)  {
-        Vector disp = theNodes[i]->getTrialDisp();
-        dgLast.Assemble(disp, ndim);
-        ndim += 3;
-    }
-    dlLast.addMatrixVector(0.0, Tgl, dgLast, 1.0);
-    dbLast.addMatrixVector(0.0, Tlb, dlLast, 1.0);
+    this->transfGlobalBasic(theNodes[0]->getTrialDisp(),
+        theNodes[1]->getTrialDisp(), dbLast);
     
     return rValue;
 }
@@ -786,28 +779,21 @@ int EEBearing2d::update()
     (*t)(0) = theDomain->getCurrentTime();
     
     // get global trial response
-    int ndim = 0, i;
-    Vector dg(6), vg(6), ag(6);
-    for (i=0; i<2; i++)  {
-        Vector disp = theNodes[i]->getTrialDisp();
-        Vector vel = theNodes[i]->getTrialVel();
-        Vector accel = theNodes[i]->getTrialAccel();
-        dg.Assemble(disp, ndim);
-        vg.Assemble(vel, ndim);
-        ag.Assemble(accel, ndim);
-        ndim += 3;
-    }
-    
-    // transform response from the global to the local system
-    Vector vl(6), al(6);
-    dl.addMatrixVector(0.0, Tgl, dg, 1.0);
-    vl.addMatrixVector(0.0, Tgl, vg, 1.0);
-    al.addMatrixVector(0.0, Tgl, ag, 1.0);
-    
-    // transform response from the local to the basic system
-    db->addMatrixVector(0.0, Tlb, dl, 1.0);
-    vb->addMatrixVector(0.0, Tlb, vl, 1.0);
-    ab->addMatrixVector(0.0, Tlb, al, 1.0);
+    const Vector &disp1 = theNodes[0]->getTrialDisp();
+    const Vector &disp2 = theNodes[1]->getTrialDisp();
+    const Vector &vel1 = theNodes[0]->getTrialVel();
+    const Vector &vel2 = theNodes[1]->getTrialVel();
+    const Vector &accel1 = theNodes[0]->getTrialAccel();
+    const Vector &accel2 = theNodes[1]->getTrialAccel();
+    
+    // transform response from the global to the basic system
+    this->transfGlobalBasic(disp1, disp2, *db);
+    this->transfGlobalBasic(vel1, vel2, *vb);
+    this->transfGlobalBasic(accel1, accel2, *ab);
+    
+    // local displacements are only needed for P-Delta effects
+    if (Mratio.Size() == 2)
+        this->setLocalDisp();
     
     // 1) set axial deformations in basic x-direction
     theMaterials[0]->setTrialStrain((*db)(0), (*vb)(0));
@@ -815,11 +801,16 @@ int EEBearing2d::update()
         (*qb)(0) = theMaterials[0]->getStress();
     
     // 2) set shear deformations in basic y-direction
-    Vector dbDelta = (*db) - dbLast;
+    double dbDelta = 0.0;
+    for (int i=0; i<dbLast.Size(); i++)  {
+        double delta = fabs((*db)(i) - dbLast(i));
+        if (delta > dbDelta)
+            dbDelta = delta;
+    }
     // do not check time for right now because of transformation constraint
     // handler calling update at beginning of new step when applying load
-    // if (dbDelta.pNorm(0) > DBL_EPSILON || (*t)(0) > tLast)  {
-    if (dbDelta.pNorm(0) > DBL_EPSILON)  {
+    // if (dbDelta > DBL_EPSILON || (*t)(0) > tLast)  {
+    if (dbDelta > DBL_EPSILON)  {
         // set the trial response at the site
         if (theSite != 0)  {
             theSite->setTrialResponse(db, vb, ab, qb, t);
@@ -827,6 +818,7 @@ int EEBearing2d::update()
         else  {
             sData[0] = OF_RemoteTest_setTrialResponse;
             rValue += theChannel->sendVector(0, 0, *sendData, 0);
+            daqFlag = false;
         }
     }
     
@@ -854,15 +846,9 @@ int EEBearing2d::setInitialStiff(const Matrix& kbinit)
     kbInit(1,1) = kbinit(0,0);
     kbInit(2,2) = theMaterials[1]->getInitialTangent();
     
-    // zero the global matrix
-    theInitStiff.Zero();
-    
-    // transform from basic to local system
-    static Matrix klInit(6,6);
-    klInit.addMatrixTripleProduct(0.0, Tlb, kbInit, 1.0);
-    
-    // transform from local to global system
-    theInitStiff.addMatrixTripleProduct(0.0, Tgl, klInit, 1.0);
+    // transform from basic to global system (once the
+    // transformation is known, otherwise done in setUp)
+    this->transfBasicGlobal(kbInit, theInitStiff);
     
     return OF_ReturnType_completed;
 }
@@ -892,19 +878,17 @@ const Matrix& EEBearing2d::getTangentStiff()
     kb(1,1) = kbInit(1,1);
     kb(2,2) = theMaterials[1]->getTangent();
     
-    // transform from basic to local system
-    static Matrix kl(6,6);
-    kl.addMatrixTripleProduct(0.0, Tlb, kb, 1.0);
-    
     if (Mratio.Size() == 2)  {
+        // transform from basic to local system
+        static Matrix kl(6,6);
+        kl.addMatrixTripleProduct(0.0, Tlb, kb, 1.0);
+        
         // get daq resisting forces in basic system
         if (theSite != 0)  {
             (*qbDaq) = theSite->getForce();
         }
         else  {
-            sData[0] = OF_RemoteTest_getForce;
-            theChannel->sendVector(0, 0, *sendData, 0);
-            theChannel->recvVector(0, 0, *recvData, 0);
+            this->recvDaqResponse(theChannel, sendData, recvData);
         }
         
         // apply optional initial stiffness modification
@@ -919,10 +903,14 @@ const Matrix& EEBearing2d::getTangentStiff()
         
         // add geometric stiffness to local stiffness
         this->addPDeltaStiff(kl);
+        
+        // transform from local to global system
+        theMatrix.addMatrixTripleProduct(0.0, Tgl, kl, 1.0);
+    }
+    else  {
+        // transform from basic to global system
+        this->transfBasicGlobal(kb, theMatrix);
     }
-    
-    // transform from local to global system
-    theMatrix.addMatrixTripleProduct(0.0, Tgl, kl, 1.0);
     
     return theMatrix;
 }
@@ -1030,9 +1018,7 @@ const Vector& EEBearing2d::getResistingForce()
         (*qbDaq) = theSite->getForce();
     }
     else  {
-        sData[0] = OF_RemoteTest_getForce;
-        theChannel->sendVector(0, 0, *sendData, 0);
-        theChannel->recvVector(0, 0, *recvData, 0);
+        this->recvDaqResponse(theChannel, sendData, recvData);
     }
     
     // apply optional initial stiffness modification
@@ -1050,16 +1036,21 @@ const Vector& EEBearing2d::getResistingForce()
     vbCtrl = (*vb);
     abCtrl = (*ab);
     
-    // determine resisting forces in local system
-    static Vector ql(6);
-    ql.addMatrixTransposeVector(0.0, Tlb, *qbDaq, 1.0);
-    
-    // add P-Delta effects to local forces
-    if (Mratio.Size() == 2)
+    if (Mratio.Size() == 2)  {
+        // determine resisting forces in local system
+        static Vector ql(6);
+        ql.addMatrixTransposeVector(0.0, Tlb, *qbDaq, 1.0);
+        
+        // add P-Delta effects to local forces
         this->addPDeltaForces(ql);
-    
-    // determine resisting forces in global system
-    theVector.addMatrixTransposeVector(0.0, Tgl, ql, 1.0);
+        
+        // determine resisting forces in global system
+        theVector.addMatrixTransposeVector(0.0, Tgl, ql, 1.0);
+    }
+    else  {
+        // determine resisting forces in global system
+        this->transfBasicGlobal(*qbDaq, theVector);
+    }
     
     // subtract external load
     theVector.addVector(1.0, theLoad, -1.0);
@@ -1101,9 +1092,7 @@ const Vector& EEBearing2d::getTime()
         (*tDaq) = theSite->getTime();
     }
     else  {
-        sData[0] = OF_RemoteTest_getTime;
-        theChannel->sendVector(0, 0, *sendData, 0);
-        theChannel->recvVector(0, 0, *recvData, 0);
+        this->recvDaqResponse(theChannel, sendData, recvData);
     }
     
     return *tDaq;
@@ -1116,9 +1105,7 @@ const Vector& EEBearing2d::getBasicDisp()
         (*dbDaq) = theSite->getDisp();
     }
     else  {
-        sData[0] = OF_RemoteTest_getDisp;
-        theChannel->sendVector(0, 0, *sendData, 0);
-        theChannel->recvVector(0, 0, *recvData, 0);
+        this->recvDaqResponse(theChannel, sendData, recvData);
     }
     
     return *dbDaq;
@@ -1131,9 +1118,7 @@ const Vector& EEBearing2d::getBasicVel()
         (*vbDaq) = theSite->getVel();
     }
     else  {
-        sData[0] = OF_RemoteTest_getVel;
-        theChannel->sendVector(0, 0, *sendData, 0);
-        theChannel->recvVector(0, 0, *recvData, 0);
+        this->recvDaqResponse(theChannel, sendData, recvData);
     }
     
     return *vbDaq;
@@ -1146,9 +1131,7 @@ const Vector& EEBearing2d::getBasicAccel()
         (*abDaq) = theSite->getAccel();
     }
     else  {
-        sData[0] = OF_RemoteTest_getAccel;
-        theChannel->sendVector(0, 0, *sendData, 0);
-        theChannel->recvVector(0, 0, *recvData, 0);
+        this->recvDaqResponse(theChannel, sendData, recvData);
     }
     
     return *abDaq;
@@ -1410,6 +1393,7 @@ int EEBearing2d::getResponse(int responseID, Information &eleInfo)
         return eleInfo.setVector(*qbDaq);
         
     case 4:  // ctrl local displacements
+        this->setLocalDisp();
         return eleInfo.setVector(dl);
         
     case 5:  // ctrl basic displacements
@@ -1505,6 +1489,32 @@ void EEBearing2d::setUp()
     Tlb(0,3) = Tlb(1,4) = Tlb(2,5) = 1.0;
     Tlb(1,2) = -shearDistI*L;
     Tlb(1,5) = -(1.0 - shearDistI)*L;
+    
+    // create fused transformation matrix from global to basic system
+    this->setTranGlobalBasic(Tlb, Tgl);
+    
+    // set the initial stiffness matrix size
+    theInitStiff.resize(6, 6);
+    
+    // transform the initial stiffness from the basic to the global system
+    this->transfBasicGlobal(kbInit, theInitStiff);
+}
+
+
+// set local displacements from the global trial displacements
+void EEBearing2d::setLocalDisp()
+{
+    const Vector &disp1 = theNodes[0]->getTrialDisp();
+    const Vector &disp2 = theNodes[1]->getTrialDisp();
+    
+    // Tgl is block diagonal with one block per node
+    for (int i=0; i<3; i++)  {
+        dl(i) = dl(i+3) = 0.0;
+        for (int j=0; j<3; j++)  {
+            dl(i) += Tgl(i,j)*disp1(j);
+            dl(i+3) += Tgl(i+3,j+3)*disp2(j);
+        }
+    }
 }
 
 
@@ -1562,9 +1572,7 @@ void EEBearing2d::applyIMod()
         (*dbDaq) = theSite->getDisp();
     }
     else  {
-        sData[0] = OF_RemoteTest_getDisp;
-        theChannel->sendVector(0, 0, *sendData, 0);
-        theChannel->recvVector(0, 0, *recvData, 0);
+        this->recvDaqResponse(theChannel, sendData, recvData);
     }
     
     // correct for displacement control errors using I-Modification
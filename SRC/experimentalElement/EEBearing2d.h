@@ -110,6 +110,7 @@ public:
 private:
     // private methods
     void setUp();
+    void setLocalDisp();
     void setTranGlobalLocal();
     void setTranLocalBasic();
     void addPDeltaForces(Vector &pLocal);
@@ -819,15 +819,8 @@ int EEBearing3d::commitState()
     rValue += this->Element::commitState();
     
     // update dbLast
-    int ndim = 0, i;
-    Vector dgLast(12), dlLast(12);
-    for (i=0; i<2; i++)  {
-        Vector disp = theNodes[i]->getTrialDisp();
-        dgLast.Assemble(disp, ndim);
-        ndim += 6;
-    }
-    dlLast.addMatrixVector(0.0, Tgl, dgLast, 1.0);
-    dbLast.addMatrixVector(0.0, Tlb, dlLast, 1.0);
+    this->transfGlobalBasic(theNodes[0]->getTrialDisp(),
+        theNodes[1]->getTrialDisp(), dbLast);
     
     return rValue;
 }
@@ -842,28 +835,21 @@ int EEBearing3d::update()
     (*t)(0) = theDomain->getCurrentTime();
     
     // get global trial response
-    int ndim = 0, i;
-    Vector dg(12), vg(12), ag(12);
-    for (i=0; i<2; i++)  {
-        Vector disp = theNodes[i]->getTrialDisp();
-        Vector vel = theNodes[i]->getTrialVel();
-        Vector accel = theNodes[i]->getTrialAccel();
-        dg.Assemble(disp, ndim);
-        vg.Assemble(vel, ndim);
-        ag.Assemble(accel, ndim);
-        ndim += 6;
-    }
-    
-    // transform response from the global to the local system
-    Vector vl(12), al(12);
-    dl.addMatrixVector(0.0, Tgl, dg, 1.0);
-    vl.addMatrixVector(0.0, Tgl, vg, 1.0);
-    al.addMatrixVector(0.0, Tgl, ag, 1.0);
-    
-    // transform response from the local to the basic system
-    db->addMatrixVector(0.0, Tlb, dl, 1.0);
-    vb->addMatrixVector(0.0, Tlb, vl, 1.0);
-    ab->addMatrixVector(0.0, Tlb, al, 1.0);
+    const Vector &disp1 = theNodes[0]->getTrialDisp();
+    const Vector &disp2 = theNodes[1]->getTrialDisp();
+    const Vector &vel1 = theNodes[0]->getTrialVel();
+    const Vector &vel2 = theNodes[1]->getTrialVel();
+    const Vector &accel1 = theNodes[0]->getTrialAccel();
+    const Vector &accel2 = theNodes[1]->getTrialAccel();
+    
+    // transform response from the global to the basic system
+    this->transfGlobalBasic(disp1, disp2, *db);
+    this->transfGlobalBasic(vel1, vel2, *vb);
+    this->transfGlobalBasic(accel1, accel2, *ab);
+    
+    // local displacements are only needed for P-Delta effects
+    if (Mratio.Size() == 4)
+        this->setLocalDisp();
     
     // 1) set axial deformations in basic x-direction
     theMaterials[0]->setTrialStrain((*db)(0), (*vb)(0));
@@ -871,11 +857,16 @@ int EEBearing3d::update()
         (*qb)(0) = theMaterials[0]->getStress();
     
     // 2) set shear deformations in basic y- and z-direction
-    Vector dbDelta = (*db) - dbLast;
+    double dbDelta = 0.0;
+    for (int i=0; i<dbLast.Size(); i++)  {
+        double delta = fabs((*db)(i) - dbLast(i));
+        if (delta > dbDelta)
+            dbDelta = delta;
+    }
     // do not check time for right now because of transformation constraint
     // handler calling update at beginning of new step when applying load
-    // if (dbDelta.pNorm(0) > DBL_EPSILON || (*t)(0) > tLast)  {
-    if (dbDelta.pNorm(0) > DBL_EPSILON)  {
+    // if (dbDelta > DBL_EPSILON || (*t)(0) > tLast)  {
+    if (dbDelta > DBL_EPSILON)  {
         // set the trial response at the site
         if (theSite != 0)  {
             theSite->setTrialResponse(db, vb, ab, qb, t);
@@ -883,6 +874,7 @@ int EEBearing3d::update()
         else  {
             sData[0] = OF_RemoteTest_setTrialResponse;
             rValue += theChannel->sendVector(0, 0, *sendData, 0);
+            daqFlag = false;
         }
     }
     
@@ -919,15 +911,9 @@ int EEBearing3d::setInitialStiff(const Matrix& kbinit)
     kbInit(4,4) = theMaterials[2]->getInitialTangent();
     kbInit(5,5) = theMaterials[3]->getInitialTangent();
     
-    // zero the global matrix
-    theInitStiff.Zero();
-    
-    // transform from basic to local system
-    static Matrix klInit(12,12);
-    klInit.addMatrixTripleProduct(0.0, Tlb, kbInit, 1.0);
-    
-    // transform from local to global system
-    theInitStiff.addMatrixTripleProduct(0.0, Tgl, klInit, 1.0);
+    // transform from basic to global system (once the
+    // transformation is known, otherwise done in setUp)
+    this->transfBasicGlobal(kbInit, theInitStiff);
     
     return OF_ReturnType_completed;
 }
@@ -960,19 +946,17 @@ const Matrix& EEBearing3d::getTangentStiff()
     kb(4,4) = theMaterials[2]->getTangent();
     kb(5,5) = theMaterials[3]->getTangent();
     
-    // transform from basic to local system
-    static Matrix kl(12,12);
-    kl.addMatrixTripleProduct(0.0, Tlb, kb, 1.0);
-    
     if (Mratio.Size() == 4)  {
+        // transform from basic to local system
+        static Matrix kl(12,12);
+        kl.addMatrixTripleProduct(0.0, Tlb, kb, 1.0);
+        
         // get daq resisting forces in basic system
         if (theSite != 0)  {
             (*qbDaq) = theSite->getForce();
         }
         else  {
-            sData[0] = OF_RemoteTest_getForce;
-            theChannel->sendVector(0, 0, *sendData, 0);
-            theChannel->recvVector(0, 0, *recvData, 0);
+            this->recvDaqResponse(theChannel, sendData, recvData);
         }
         
         // apply optional initial stiffness modification
@@ -991,10 +975,14 @@ const Matrix& EEBearing3d::getTangentStiff()
         
         // add geometric stiffness to local stiffness
         this->addPDeltaStiff(kl);
+        
+        // transform from local to global system
+        theMatrix.addMatrixTripleProduct(0.0, Tgl, kl, 1.0);
+    }
+    else  {
+        // transform from basic to global system
+        this->transfBasicGlobal(kb, theMatrix);
     }
-    
-    // transform from local to global system
-    theMatrix.addMatrixTripleProduct(0.0, Tgl, kl, 1.0);
     
     return theMatrix;
 }
@@ -1104,9 +1092,7 @@ const Vector& EEBearing3d::getResistingForce()
         (*qbDaq) = theSite->getForce();
     }
     else  {
-        sData[0] = OF_RemoteTest_getForce;
-        theChannel->sendVector(0, 0, *sendData, 0);
-        theChannel->recvVector(0, 0, *recvData, 0);
+        this->recvDaqResponse(theChannel, sendData, recvData);
     }
     
     // apply optional initial stiffness modification
@@ -1128,16 +1114,21 @@ const Vector& EEBearing3d::getResistingForce()
     vbCtrl = (*vb);
     abCtrl = (*ab);
     
-    // determine resisting forces in local system
-    static Vector ql(12);
-    ql.addMatrixTransposeVector(0.0, Tlb, *qbDaq, 1.0);
-    
-    // add P-Delta effects to local forces
-    if (Mratio.Size() == 4)
+    if (Mratio.Size() == 4)  {
+        // determine resisting forces in local system
+        static Vector ql(12);
+        ql.addMatrixTransposeVector(0.0, Tlb, *qbDaq, 1.0);
+        
+        // add P-Delta effects to local forces
         this->addPDeltaForces(ql);
-    
-    // determine resisting forces in global system
-    theVector.addMatrixTransposeVector(0.0, Tgl, ql, 1.0);
+        
+        // determine resisting forces in global system
+        theVector.addMatrixTransposeVector(0.0, Tgl, ql, 1.0);
+    }
+    else  {
+        // determine resisting forces in global system
+        this->transfBasicGlobal(*qbDaq, theVector);
+    }
     
     // subtract external load
     theVector.addVector(1.0, theLoad, -1.0);
@@ -1179,9 +1170,7 @@ const Vector& EEBearing3d::getTime()
         (*tDaq) = theSite->getTime();
     }
     else  {
-        sData[0] = OF_RemoteTest_getTime;
-        theChannel->sendVector(0, 0, *sendData, 0);
-        theChannel->recvVector(0, 0, *recvData, 0);
+        this->recvDaqResponse(theChannel, sendData, recvData);
     }
     
     return *tDaq;
@@ -1194,9 +1183,7 @@ const Vector& EEBearing3d::getBasicDisp()
         (*dbDaq) = theSite->getDisp();
     }
     else  {
-        sData[0] = OF_RemoteTest_getDisp;
-        theChannel->sendVector(0, 0, *sendData, 0);
-        theChannel->recvVector(0, 0, *recvData, 0);
+        this->recvDaqResponse(theChannel, sendData, recvData);
     }
     
     return *dbDaq;
@@ -1209,9 +1196,7 @@ const Vector& EEBearing3d::getBasicVel()
         (*vbDaq) = theSite->getVel();
     }
     else  {
-        sData[0] = OF_RemoteTest_getVel;
-        theChannel->sendVector(0, 0, *sendData, 0);
-        theChannel->recvVector(0, 0, *recvData, 0);
+        this->recvDaqResponse(theChannel, sendData, recvData);
     }
     
     return *vbDaq;
@@ -1224,9 +1209,7 @@ const Vector& EEBearing3d::getBasicAccel()
         (*abDaq) = theSite->getAccel();
     }
     else  {
-        sData[0] = OF_RemoteTest_getAccel;
-        theChannel->sendVector(0, 0, *sendData, 0);
-        theChannel->recvVector(0, 0, *recvData, 0);
+        this->recvDaqResponse(theChannel, sendData, recvData);
     }
     
     return *abDaq;
@@ -1529,6 +1512,7 @@ int EEBearing3d::getResponse(int responseID, Information &eleInfo)
         return eleInfo.setVector(*qbDaq);
         
     case 4:  // ctrl local displacements
+        this->setLocalDisp();
         return eleInfo.setVector(dl);
         
     case 5:  // ctrl basic displacements
@@ -1628,6 +1612,32 @@ void EEBearing3d::setUp()
     Tlb(1,11) = -(1.0 - shearDistI)*L;
     Tlb(2,4) = -Tlb(1,5);
     Tlb(2,10) = -Tlb(1,11);
+    
+    // create fused transformation matrix from global to basic system
+    this->setTranGlobalBasic(Tlb, Tgl);
+    
+    // set the initial stiffness matrix size
+    theInitStiff.resize(12, 12);
+    
+    // transform the initial stiffness from the basic to the global system
+    this->transfBasicGlobal(kbInit, theInitStiff);
+}
+
+
+// set local displacements from the global trial displacements
+void EEBearing3d::setLocalDisp()
+{
+    const Vector &disp1 = theNodes[0]->getTrialDisp();
+    const Vector &disp2 = theNodes[1]->getTrialDisp();
+    
+    // Tgl is block diagonal with one block per node
+    for (int i=0; i<6; i++)  {
+        dl(i) = dl(i+6) = 0.0;
+        for (int j=0; j<6; j++)  {
+            dl(i) += Tgl(i,j)*disp1(j);
+            dl(i+6) += Tgl(i+6,j+6)*disp2(j);
+        }
+    }
 }
 
 
@@ -1710,9 +1720,7 @@ void EEBearing3d::applyIMod()
         (*dbDaq) = theSite->getDisp();
     }
     else  {
-        sData[0] = OF_RemoteTest_getDisp;
-        theChannel->sendVector(0, 0, *sendData, 0);
-        theChannel->recvVector(0, 0, *recvData, 0);
+        this->recvDaqResponse(theChannel, sendData, recvData);
     }
     
     // correct for displacement control errors using I-Modification
@@ -37,6 +37,8 @@
 #include <TCP_Socket.h>
 #include <TCP_SocketSSL.h>
 #include <UDP_Socket.h>
+#include <SHM_Channel.h>
+#include <WAN_Channel.h>
 #include <elementAPI.h>
 
 #include <math.h>
@@ -52,8 +54,8 @@ void* OPF_EEGeneric()
     
     if (OPS_GetNumRemainingInputArgs() < 9) {
         opserr << "WARNING invalid number of arguments\n";
-        opserr << "Want: expElement generic eleTag -node Ndi -dof dofNdi -dof dofNdj ... -site siteTag -initStif Kij <-iMod> <-noRayleigh> <-mass Mij> <-checkTime>\n";
-        opserr << "  or: expElement generic eleTag -node Ndi -dof dofNdi -dof dofNdj ... -server ipPort <ipAddr> <-ssl> <-udp> <-dataSize size> -initStif Kij <-iMod> <-noRayleigh> <-mass Mij> <-checkTime>\n";
+        opserr << "Want: expElement generic eleTag -node Ndi -dof dofNdi -dof dofNdj ... -site siteTag (-initStif Kij | -initStifFile fileName) <-iMod> <-noRayleigh> <-mass Mij | -massFile fileName> <-checkTime> <-maxCmds num>\n";
+        opserr << "  or: expElement generic eleTag -node Ndi -dof dofNdi -dof dofNdj ... -server ipPort <ipAddr> <-ssl> <-udp|-udpFrag> <-shm> <-dataSize size> <-wan delay <-jitter jitter> <-bandwidth bandwidth> <-loss loss> <-reorder reorder> <-seed seed>> (-initStif Kij | -initStifFile fileName) <-iMod> <-noRayleigh> <-mass Mij | -massFile fileName> <-checkTime> <-maxCmds num>\n";
         return 0;
     }
     
@@ -130,8 +132,9 @@ void* OPF_EEGeneric()
     int ipPort = 8090;
     char* ipAddr = new char[10];
     strcpy(ipAddr, "127.0.0.1");
-    int ssl = 0, udp = 0;
+    int ssl = 0, udp = 0, shm = 0;
     int dataSize = OF_Network_dataSize;
+    Vector* wanArgs = 0;
     type = OPS_GetString();
     if (strcmp(type, "-site") == 0) {
         // site tag
@@ -162,16 +165,29 @@ void* OPF_EEGeneric()
         while (OPS_GetNumRemainingInputArgs() > 0) {
             type = OPS_GetString();
             if (strcmp(type, "-initStif") == 0 ||
-                strcmp(type, "-initStiff") == 0) {
+                strcmp(type, "-initStiff") == 0 ||
+                strcmp(type, "-initStifFile") == 0 ||
+                strcmp(type, "-initStiffFile") == 0) {
                 // move current arg back by one
                 OPS_ResetCurrentInputArg(-1);
                 break;
             }
             else if (strcmp(type, "-ssl") == 0) {
-                ssl = 1; udp = 0;
+                ssl = 1; udp = 0; shm = 0;
             }
             else if (strcmp(type, "-udp") == 0) {
-                udp = 1; ssl = 0;
+                udp = 1; ssl = 0; shm = 0;
+            }
+            else if (strcmp(type, "-udpFrag") == 0) {
+                udp = 2; ssl = 0; shm = 0;
+            }
+            else if (strcmp(type, "-shm") == 0) {
+#ifdef _WIN32
+                opserr << "WARNING shared memory channels (-shm) are not supported on Windows\n";
+                opserr << "expElement generic element: " << tag << endln;
+                return 0;
+#endif
+                shm = 1; ssl = 0; udp = 0;
             }
             else if (strcmp(type, "-dataSize") == 0) {
                 numdata = 1;
@@ -181,6 +197,14 @@ void* OPF_EEGeneric()
                     return 0;
                 }
             }
+            else if (strcmp(type, "-wan") == 0) {
+                if (wanArgs == 0)
+                    wanArgs = new Vector(6);
+                if (OPF_GetWANChannelArgs(&(*wanArgs)(0)) < 0) {
+                    opserr << "expElement generic element: " << tag << endln;
+                    return 0;
+                }
+            }
             else {
                 delete[] ipAddr;
                 ipAddr = new char[strlen(type) + 1];
@@ -196,28 +220,45 @@ void* OPF_EEGeneric()
     }
     
     // initial stiffness
+    ExpSparseMatrix theInitStif;
     type = OPS_GetString();
-    if (strcmp(type, "-initStif") != 0 &&
-        strcmp(type, "-initStiff") != 0) {
-        opserr << "WARNING expecting -initStif\n";
-        opserr << "expElement generic element: " << tag << endln;
+    if (strcmp(type, "-initStifFile") == 0 ||
+        strcmp(type, "-initStiffFile") == 0) {
+        if (OPS_GetNumRemainingInputArgs() < 1) {
+            opserr << "WARNING missing initial stiffness file name\n";
+            opserr << "expElement generic element: " << tag << endln;
+            return 0;
+        }
+        const char* fileName = OPS_GetString();
+        if (theInitStif.read(fileName, numDOF, numDOF) < 0) {
+            opserr << "WARNING invalid initial stiffness file\n";
+            opserr << "expElement generic element: " << tag << endln;
+            return 0;
+        }
     }
-    Matrix theInitStif(numDOF, numDOF);
-    double stif[1024];
-    numdata = numDOF * numDOF;
-    if (OPS_GetDoubleInput(&numdata, stif) < 0) {
-        opserr << "WARNING invalid initial stiffness term\n";
-        opserr << "expElement generic element: " << tag << endln;
-        return 0;
+    else {
+        if (strcmp(type, "-initStif") != 0 &&
+            strcmp(type, "-initStiff") != 0) {
+            opserr << "WARNING expecting -initStif\n";
+            opserr << "expElement generic element: " << tag << endln;
+        }
+        Matrix stif(numDOF, numDOF);
+        numdata = numDOF * numDOF;
+        if (OPS_GetDoubleInput(&numdata, &stif(0, 0)) < 0) {
+            opserr << "WARNING invalid initial stiffness term\n";
+            opserr << "expElement generic element: " << tag << endln;
+            return 0;
+        }
+        theInitStif.setData(stif);
     }
-    theInitStif.setData(stif, numDOF, numDOF);
     
     // optional parameters
     ExperimentalTangentStiff* theTangStif = 0;
     bool iMod = false;
     int doRayleigh = 1;
-    Matrix* mass = 0;
+    ExpSparseMatrix* mass = 0;
     int checkTime = 0;
+    int maxCmds = 0;
     while (OPS_GetNumRemainingInputArgs() > 0) {
         type = OPS_GetString();
         // tangent stiffness
@@ -253,30 +294,57 @@ void* OPF_EEGeneric()
                 opserr << "expElement generic element: " << tag << endln;
                 return 0;
             }
-            mass = new Matrix(numDOF, numDOF);
-            double m[1024];
+            Matrix m(numDOF, numDOF);
             numdata = numDOF*numDOF;
-            if (OPS_GetDoubleInput(&numdata, m) < 0) {
+            if (OPS_GetDoubleInput(&numdata, &m(0, 0)) < 0) {
                 opserr << "WARNING: invalid -mass value\n";
                 opserr << "expElement generic element: " << tag << endln;
                 return 0;
             }
-            mass->setData(m, numDOF, numDOF);
+            if (mass != 0)
+                delete mass;
+            mass = new ExpSparseMatrix(m);
+        }
+        else if (strcmp(type, "-massFile") == 0) {
+            if (OPS_GetNumRemainingInputArgs() < 1) {
+                opserr << "WARNING: missing mass file name\n";
+                opserr << "expElement generic element: " << tag << endln;
+                return 0;
+            }
+            const char* fileName = OPS_GetString();
+            if (mass != 0)
+                delete mass;
+            mass = new ExpSparseMatrix();
+            if (mass->read(fileName, numDOF, numDOF) < 0) {
+                opserr << "WARNING: invalid -massFile\n";
+                opserr << "expElement generic element: " << tag << endln;
+                return 0;
+            }
         }
         else if (strcmp(type, "-checkTime") == 0) {
             checkTime = 1;
         }
+        else if (strcmp(type, "-maxCmds") == 0) {
+            numdata = 1;
+            if (OPS_GetIntInput(&numdata, &maxCmds) < 0 || maxCmds < 0) {
+                opserr << "WARNING invalid maxCmds\n";
+                opserr << "expElement generic element: " << tag << endln;
+                return 0;
+            }
+        }
     }
     
     // now create the EEGeneric
     if (theSite != 0) {
         theExpElement = new EEGeneric(tag, nodes, dofs, theSite,
-            iMod, doRayleigh, mass, checkTime);
+            iMod, doRayleigh, 0, checkTime);
     }
     else {
         theExpElement = new EEGeneric(tag, nodes, dofs, ipPort,
-            ipAddr, ssl, udp, dataSize, iMod, doRayleigh, mass,
-            checkTime);
+            ipAddr, ssl, udp, shm, dataSize, iMod, doRayleigh, 0,
+            checkTime, wanArgs);
+        if (wanArgs != 0)
+            delete wanArgs;
     }
     if (theExpElement == 0) {
         opserr << "WARNING ran out of memory creating element\n";
@@ -284,14 +352,21 @@ void* OPF_EEGeneric()
         return 0;
     }
     
+    // add mass matrix
+    if (mass != 0) {
+        ((EEGeneric*)theExpElement)->setMass(*mass);
+        delete mass;
+    }
+    
     // cleanup dynamic memory
     if (dofs != 0)
         delete[] dofs;
-    if (mass != 0)
-        delete mass;
+    
+    // limit the number of commands per step
+    theExpElement->setMaxNumCommands(maxCmds);
     
     // add initial stiffness
-    int setInitStif = theExpElement->setInitialStiff(theInitStif);
+    int setInitStif = ((EEGeneric*)theExpElement)->setInitialStiff(theInitStif);
     if (setInitStif != 0) {
         opserr << "WARNING initial stiffness not set\n";
         opserr << "expElement generic element: " << tag << endln;
@@ -316,7 +391,7 @@ EEGeneric::EEGeneric(int tag, ID nodes, ID *dof,
     db(0), vb(0), ab(0), t(0),
     dbDaq(0), vbDaq(0), abDaq(0), qDaq(0), tDaq(0),
     dbCtrl(1), vbCtrl(1), abCtrl(1),
-    kbInit(1,1), dbLast(1), tLast(0.0) 
+    kbInit(), vbWork(1), qbWork(1), dbLast(1), tLast(0.0) 
 {
     // initialize nodes
     numExternalNodes = connectedExternalNodes.Size();
@@ -347,7 +422,7 @@ EEGeneric::EEGeneric(int tag, ID nodes, ID *dof,
     
     // initialize mass matrix
     if (m != 0)
-        mass = new Matrix(*m);
+        mass = new ExpSparseMatrix(*m);
     
     // set the data size for the experimental site
     sizeCtrl = new ID(OF_Resp_All);
@@ -388,8 +463,10 @@ EEGeneric::EEGeneric(int tag, ID nodes, ID *dof,
     vbCtrl.Zero();
     abCtrl.resize(numBasicDOF);
     abCtrl.Zero();
-    kbInit.resize(numBasicDOF,numBasicDOF);
-    kbInit.Zero();
+    vbWork.resize(numBasicDOF);
+    vbWork.Zero();
+    qbWork.resize(numBasicDOF);
+    qbWork.Zero();
     dbLast.resize(numBasicDOF);
     dbLast.Zero();
 }
@@ -398,9 +475,9 @@ EEGeneric::EEGeneric(int tag, ID nodes, ID *dof,
 // responsible for allocating the necessary space needed
 // by each object and storing the tags of the end nodes.
 EEGeneric::EEGeneric(int tag, ID nodes, ID *dof,
-    int port, char *machineInetAddr, int ssl, int udp,
+    int port, char *machineInetAddr, int ssl, int udp, int shm,
     int dataSize, bool iM, int addRay, const Matrix *m,
-    int checktime)
+    int checktime, const Vector *wan)
     : ExperimentalElement(tag, ELE_TAG_EEGeneric),
     connectedExternalNodes(nodes), basicDOF(1),
     numExternalNodes(0), numDOF(0), numBasicDOF(0),
@@ -411,7 +488,7 @@ EEGeneric::EEGeneric(int tag, ID nodes, ID *dof,
     db(0), vb(0), ab(0), t(0),
     dbDaq(0), vbDaq(0), abDaq(0), qDaq(0), tDaq(0),
     dbCtrl(1), vbCtrl(1), abCtrl(1),
-    kbInit(1,1), dbLast(1), tLast(0.0)
+    kbInit(), vbWork(1), qbWork(1), dbLast(1), tLast(0.0)
 {
     // initialize nodes
     numExternalNodes = connectedExternalNodes.Size();
@@ -442,10 +519,13 @@ EEGeneric::EEGeneric(int tag, ID nodes, ID *dof,
     
     // initialize mass matrix
     if (m != 0)
-        mass = new Matrix(*m);
+        mass = new ExpSparseMatrix(*m);
     
     // setup the connection
-    if (ssl)  {
+    if (shm)  {
+        theChannel = new SHM_Channel(port, machineInetAddr);
+    }
+    else if (ssl)  {
         if (machineInetAddr == 0)
             theChannel = new TCP_SocketSSL(port, "127.0.0.1");
         else
@@ -453,9 +533,9 @@ EEGeneric::EEGeneric(int tag, ID nodes, ID *dof,
     }
     else if (udp)  {
         if (machineInetAddr == 0)
-            theChannel = new UDP_Socket(port, "127.0.0.1");
+            theChannel = new UDP_Socket(port, "127.0.0.1", false, false, udp == 2);
         else
-            theChannel = new UDP_Socket(port, machineInetAddr);
+            theChannel = new UDP_Socket(port, machineInetAddr, false, false, udp == 2);
     }
     else  {
         if (machineInetAddr == 0)
@@ -468,6 +548,11 @@ EEGeneric::EEGeneric(int tag, ID nodes, ID *dof,
             << "- failed to create channel\n";
         exit(-1);
     }
+    if (wan != 0)  {
+        // emulate a wide area network to the server
+        theChannel = new WAN_Channel(theChannel, (*wan)(0), (*wan)(1),
+            (*wan)(2), (*wan)(3), (*wan)(4), udp != 0, (int)(*wan)(5));
+    }
     if (theChannel->setUpConnection() != 0)  {
         opserr << "EEGeneric::EEGeneric() "
             << "- failed to setup connection\n";
@@ -534,8 +619,10 @@ EEGeneric::EEGeneric(int tag, ID nodes, ID *dof,
     vbCtrl.Zero();
     abCtrl.resize(numBasicDOF);
     abCtrl.Zero();
-    kbInit.resize(numBasicDOF,numBasicDOF);
-    kbInit.Zero();
+    vbWork.resize(numBasicDOF);
+    vbWork.Zero();
+    qbWork.resize(numBasicDOF);
+    qbWork.Zero();
     dbLast.resize(numBasicDOF);
     dbLast.Zero();
 }
@@ -665,6 +752,8 @@ void EEGeneric::setDomain(Domain *theDomain)
     // set the matrix and vector sizes and zero them
     theInitStiff.resize(numDOF,numDOF);
     theInitStiff.Zero();
+    if (kbInit.noRows() == numBasicDOF)
+        kbInit.assemble(theInitStiff, basicDOF, basicDOF);
     theMatrix.resize(numDOF,numDOF);
     theMatrix.Zero();
     theVector.resize(numDOF);
@@ -693,6 +782,9 @@ int EEGeneric::commitState()
     // commit the base class
     rValue += this->Element::commitState();
     
+    // start counting the commands of the next step
+    this->commitCommands();
+    
     // update dbLast
     int ndim = 0, i;
     dbLast.Zero();
@@ -732,13 +824,17 @@ int EEGeneric::update()
     // handler calling update at beginning of new step when applying load
     // if (dbDelta.pNorm(0) > DBL_EPSILON || (*t)(0) > tLast)  {
     if (dbDelta.pNorm(0) > DBL_EPSILON || (checkTime && (*t)(0) > tLast))  {
-        // set the trial response at the site
-        if (theSite != 0)  {
-            theSite->setTrialResponse(db, vb, ab, (Vector*)0, t);
-        }
-        else  {
-            sData[0] = OF_RemoteTest_setTrialResponse;
-            rValue += theChannel->sendVector(0, 0, *sendData, 0);
+        // set the trial response at the site unless the
+        // commands of the current step are used up
+        if (this->countCommand() == true)  {
+            if (theSite != 0)  {
+                theSite->setTrialResponse(db, vb, ab, (Vector*)0, t);
+            }
+            else  {
+                sData[0] = OF_RemoteTest_setTrialResponse;
+                rValue += theChannel->sendVector(0, 0, *sendData, 0);
+                daqFlag = false;
+            }
         }
     }
     
@@ -751,6 +847,26 @@ int EEGeneric::update()
 
 
 int EEGeneric::setInitialStiff(const Matrix &kbinit)
+{
+    if (kbinit.noRows() != numBasicDOF || kbinit.noCols() != numBasicDOF)  {
+        opserr << "EEGeneric::setInitialStiff() - " 
+            << "matrix size is incorrect for element: "
+            << this->getTag() << endln;
+        return -1;
+    }
+    kbInit.setData(kbinit);
+    
+    // the basic dof are only known once the domain is set
+    if (numDOF > 0)  {
+        theInitStiff.Zero();
+        kbInit.assemble(theInitStiff, basicDOF, basicDOF);
+    }
+    
+    return 0;
+}
+
+
+int EEGeneric::setInitialStiff(const ExpSparseMatrix &kbinit)
 {
     if (kbinit.noRows() != numBasicDOF || kbinit.noCols() != numBasicDOF)  {
         opserr << "EEGeneric::setInitialStiff() - " 
@@ -760,13 +876,50 @@ int EEGeneric::setInitialStiff(const Matrix &kbinit)
     }
     kbInit = kbinit;
     
-    theInitStiff.Zero();
-    theInitStiff.Assemble(kbInit, basicDOF, basicDOF);
+    // the basic dof are only known once the domain is set
+    if (numDOF > 0)  {
+        theInitStiff.Zero();
+        kbInit.assemble(theInitStiff, basicDOF, basicDOF);
+    }
     
     return 0;
 }
 
 
+int EEGeneric::setMass(const ExpSparseMatrix &m)
+{
+    if (m.noRows() != numBasicDOF || m.noCols() != numBasicDOF)  {
+        opserr << "EEGeneric::setMass() - " 
+            << "matrix size is incorrect for element: "
+            << this->getTag() << endln;
+        return -1;
+    }
+    if (mass != 0)
+        delete mass;
+    mass = new ExpSparseMatrix(m);
+    
+    return 0;
+}
+
+
+const Matrix& EEGeneric::getTangentStiff()
+{
+    // use the tangent stiffness returned by the site if available
+    if (theSite != 0)  {
+        const Matrix *kb = theSite->getTangentStiff();
+        if (kb != 0)  {
+            theMatrix.Zero();
+            theMatrix.Assemble(*kb, basicDOF, basicDOF);
+            
+            return theMatrix;
+        }
+    }
+    
+    // otherwise call the base class method
+    return this->ExperimentalElement::getTangentStiff();
+}
+
+
 const Matrix& EEGeneric::getDamp()
 {
     // zero the global matrix
@@ -788,7 +941,7 @@ const Matrix& EEGeneric::getMass()
     
     // assemble mass matrix
     if (mass != 0)  {
-        theMatrix.Assemble(*mass, basicDOF, basicDOF);
+        mass->assemble(theMatrix, basicDOF, basicDOF);
     }
     
     return theMatrix;
@@ -818,19 +971,18 @@ int EEGeneric::addInertiaLoadToUnbalance(const Vector &accel)
         return 0;
     }
     
-    int ndim = 0, i;
-    Vector Raccel(numDOF);
-    
-    // get mass matrix
-    Matrix M = this->getMass();
-    // assemble Raccel vector
+    // gather R * accel at the basic dof
+    int ndim = 0, i, j;
     for (i=0; i<numExternalNodes; i++ )  {
-        Raccel.Assemble(theNodes[i]->getRV(accel), ndim);
-        ndim += theNodes[i]->getNumberDOF();
+        const Vector &Raccel = theNodes[i]->getRV(accel);
+        for (j=0; j<theDOF[i].Size(); j++)
+            vbWork(ndim++) = Raccel(theDOF[i](j));
     }
     
     // want to add ( - fact * M R * accel ) to unbalance
-    theLoad.addMatrixVector(1.0, M, Raccel, -1.0);
+    qbWork.Zero();
+    mass->addMatrixVector(qbWork, vbWork);
+    theLoad.Assemble(qbWork, basicDOF, -1.0);
     
     return 0;
 }
@@ -846,25 +998,30 @@ const Vector& EEGeneric::getResistingForce()
         (*qDaq) = theSite->getForce();
     }
     else  {
-        sData[0] = OF_RemoteTest_getForce;
-        theChannel->sendVector(0, 0, *sendData, 0);
-        theChannel->recvVector(0, 0, *recvData, 0);
+        this->recvDaqResponse(theChannel, sendData, recvData);
     }
     
-    // apply optional initial stiffness modification
-    if (iMod == true)  {
+    // apply optional initial stiffness modification, which is also
+    // needed if the last trial response was not sent to the site
+    if (iMod == true || cmdSkipped == true)  {
         // get daq displacements
         if (theSite != 0)  {
             (*dbDaq) = theSite->getDisp();
         }
         else  {
-            sData[0] = OF_RemoteTest_getDisp;
-            theChannel->sendVector(0, 0, *sendData, 0);
-            theChannel->recvVector(0, 0, *recvData, 0);
+            this->recvDaqResponse(theChannel, sendData, recvData);
         }
         
+        // use the tangent of the site for skipped commands if available
+        const Matrix *kb = 0;
+        if (cmdSkipped == true && theSite != 0)
+            kb = theSite->getTangentStiff();
+        
         // correct for displacement control errors using I-Modification
-        qDaq->addMatrixVector(1.0, kbInit, (*dbDaq) - (*db), -1.0);
+        if (kb != 0)
+            qDaq->addMatrixVector(1.0, *kb, (*dbDaq) - (*db), -1.0);
+        else
+            kbInit.addMatrixVector(*qDaq, (*dbDaq) - (*db), -1.0);
     }
    
     // save corresponding ctrl displacements for recorder
@@ -888,25 +1045,41 @@ const Vector& EEGeneric::getResistingForceIncInertia()
     theVector = this->getResistingForce();
     
     // add the damping forces from rayleigh damping
+    int ndim, i, j;
     if (addRayleigh == 1)  {
-        if (alphaM != 0.0 || betaK != 0.0 || betaK0 != 0.0 || betaKc != 0.0)
+        if (betaK != 0.0 || betaKc != 0.0)  {
             theVector.addVector(1.0, this->getRayleighDampingForces(), 1.0);
+        }
+        else if (alphaM != 0.0 || betaK0 != 0.0)  {
+            // only the basic dof are coupled by the element, so
+            // use the sparse mass and initial stiffness matrices
+            ndim = 0;
+            for (i=0; i<numExternalNodes; i++ )  {
+                const Vector &vel = theNodes[i]->getTrialVel();
+                for (j=0; j<theDOF[i].Size(); j++)
+                    vbWork(ndim++) = vel(theDOF[i](j));
+            }
+            qbWork.Zero();
+            if (alphaM != 0.0 && mass != 0)
+                mass->addMatrixVector(qbWork, vbWork, alphaM);
+            if (betaK0 != 0.0)
+                kbInit.addMatrixVector(qbWork, vbWork, betaK0);
+            theVector.Assemble(qbWork, basicDOF);
+        }
     }
     
     // add inertia forces from element mass
     if (mass != 0)  {
-        int ndim = 0, i;
-        Vector accel(numDOF);
-        
-        // get mass matrix
-        Matrix M = this->getMass();
-        // assemble accel vector
+        // gather accelerations at the basic dof
+        ndim = 0;
         for (i=0; i<numExternalNodes; i++ )  {
-            accel.Assemble(theNodes[i]->getTrialAccel(), ndim);
-            ndim += theNodes[i]->getNumberDOF();
+            const Vector &accel = theNodes[i]->getTrialAccel();
+            for (j=0; j<theDOF[i].Size(); j++)
+                vbWork(ndim++) = accel(theDOF[i](j));
         }
-        
-        theVector.addMatrixVector(1.0, M, accel, 1.0);
+        qbWork.Zero();
+        mass->addMatrixVector(qbWork, vbWork);
+        theVector.Assemble(qbWork, basicDOF);
     }
     
     return theVector;
@@ -919,9 +1092,7 @@ const Vector& EEGeneric::getTime()
         (*tDaq) = theSite->getTime();
     }
     else  {
-        sData[0] = OF_RemoteTest_getTime;
-        theChannel->sendVector(0, 0, *sendData, 0);
-        theChannel->recvVector(0, 0, *recvData, 0);
+        this->recvDaqResponse(theChannel, sendData, recvData);
     }
     
     return *tDaq;
@@ -934,9 +1105,7 @@ const Vector& EEGeneric::getBasicDisp()
         (*dbDaq) = theSite->getDisp();
     }
     else  {
-        sData[0] = OF_RemoteTest_getDisp;
-        theChannel->sendVector(0, 0, *sendData, 0);
-        theChannel->recvVector(0, 0, *recvData, 0);
+        this->recvDaqResponse(theChannel, sendData, recvData);
     }
     
     return *dbDaq;
@@ -949,9 +1118,7 @@ const Vector& EEGeneric::getBasicVel()
         (*vbDaq) = theSite->getVel();
     }
     else  {
-        sData[0] = OF_RemoteTest_getVel;
-        theChannel->sendVector(0, 0, *sendData, 0);
-        theChannel->recvVector(0, 0, *recvData, 0);
+        this->recvDaqResponse(theChannel, sendData, recvData);
     }
     
     return *vbDaq;
@@ -964,9 +1131,7 @@ const Vector& EEGeneric::getBasicAccel()
         (*abDaq) = theSite->getAccel();
     }
     else  {
-        sData[0] = OF_RemoteTest_getAccel;
-        theChannel->sendVector(0, 0, *sendData, 0);
-        theChannel->recvVector(0, 0, *recvData, 0);
+        this->recvDaqResponse(theChannel, sendData, recvData);
     }
     
     return *abDaq;
@@ -1060,8 +1225,14 @@ void EEGeneric::Print(OPS_Stream &s, int flag)
         s << endln;
         if (theSite != 0)
             s << "  ExperimentalSite: " << theSite->getTag() << endln;
+        WAN_Channel *theWAN = dynamic_cast<WAN_Channel*>(theChannel);
+        if (theWAN != 0)
+            theWAN->Print(s, flag);
         s << "  addRayleigh: " << addRayleigh;
-        s << "  mass matrix: " << mass << endln;
+        s << "  mass matrix non-zeros: "
+            << ((mass != 0) ? mass->getNumNonZeros() : 0) << endln;
+        s << "  maxCmds: " << maxNumCmds << ", commands: " << numCmds
+            << ", iterations: " << numIter << endln;
         // determine resisting forces in global system
         s << "  resisting force: " << this->getResistingForce() << endln;
     } else if (flag == 1)  {
@@ -1200,6 +1371,15 @@ Response* EEGeneric::setResponse(const char **argv, int argc,
         theResponse = new ElementResponse(this, 9, Vector(numBasicDOF));
     }
     
+    // number of commands issued and iterations requested
+    else if (strcmp(argv[0],"numCmds") == 0 ||
+        strcmp(argv[0],"numCommands") == 0)
+    {
+        output.tag("ResponseType","numCmds");
+        output.tag("ResponseType","numIter");
+        theResponse = new ElementResponse(this, 10, Vector(2));
+    }
+    
     output.endTag(); // ElementOutput
     
     return theResponse;
@@ -1236,6 +1416,14 @@ int EEGeneric::getResponse(int responseID, Information &eleInfo)
     case 9:  // daq basic accelerations
         return eleInfo.setVector(this->getBasicAccel());
         
+    case 10:  // number of commands and iterations
+        {
+            Vector cmds(2);
+            cmds(0) = numCmds;
+            cmds(1) = numIter;
+            return eleInfo.setVector(cmds);
+        }
+        
     default:
         return -1;
     }
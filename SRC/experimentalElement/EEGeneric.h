@@ -32,6 +32,7 @@
 // element objects are associated with experimental setup objects.
 
 #include "ExperimentalElement.h"
+#include "ExpSparseMatrix.h"
 
 class Channel;
 
@@ -48,9 +49,10 @@ public:
         int checkTime = 0);
     EEGeneric(int tag, ID nodes, ID *dof,
         int port, char *machineInetAddress = 0,
-        int ssl = 0, int udp = 0, int dataSize = OF_Network_dataSize,
+        int ssl = 0, int udp = 0, int shm = 0,
+        int dataSize = OF_Network_dataSize,
         bool iMod = false, int addRayleigh = 1, const Matrix *mass = 0,
-        int checkTime = 0);
+        int checkTime = 0, const Vector *wanArgs = 0);
     
     // destructor
     ~EEGeneric();
@@ -73,6 +75,9 @@ public:
     // public methods to set and to obtain stiffness,
     // and to obtain mass, damping and residual information
     int setInitialStiff(const Matrix& stiff);
+    int setInitialStiff(const ExpSparseMatrix& stiff);
+    int setMass(const ExpSparseMatrix& m);
+    const Matrix &getTangentStiff();
     const Matrix &getDamp();
     const Matrix &getMass();
     
@@ -116,7 +121,7 @@ private:
     
     bool iMod;                  // I-Modification flag
     int addRayleigh;            // flag to add Rayleigh damping
-    Matrix *mass;               // mass matrix
+    ExpSparseMatrix *mass;      // mass matrix (sparse)
     int checkTime;              // flag to check time when setting trial
     
     Matrix theMatrix;           // objects matrix
@@ -144,7 +149,9 @@ private:
     Vector vbCtrl;      // ctrl velocities in basic system
     Vector abCtrl;      // ctrl accelerations in basic system
     
-    Matrix kbInit;      // stiffness matrix in basic system
+    ExpSparseMatrix kbInit; // stiffness matrix in basic system (sparse)
+    Vector vbWork;      // work vector in basic system
+    Vector qbWork;      // work vector in basic system
     Vector dbLast;      // displacements in basic system at last update
     double tLast;       // time at last update
     
@@ -678,6 +678,7 @@ int EEInvertedVBrace2d::update()
             else  {
                 sData[0] = OF_RemoteTest_setTrialResponse;
                 rValue += theChannel->sendVector(0, 0, *sendData, 0);
+                daqFlag = false;
             }
          }
         
@@ -826,9 +827,7 @@ const Vector& EEInvertedVBrace2d::getResistingForce()
         (*qDaq) = theSite->getForce();
     }
     else  {
-        sData[0] = OF_RemoteTest_getForce;
-        theChannel->sendVector(0, 0, *sendData, 0);
-        theChannel->recvVector(0, 0, *recvData, 0);
+        this->recvDaqResponse(theChannel, sendData, recvData);
     }
     
     // apply optional initial stiffness modification
@@ -838,9 +837,7 @@ const Vector& EEInvertedVBrace2d::getResistingForce()
             (*dbDaq) = theSite->getDisp();
         }
         else  {
-            sData[0] = OF_RemoteTest_getDisp;
-            theChannel->sendVector(0, 0, *sendData, 0);
-            theChannel->recvVector(0, 0, *recvData, 0);
+            this->recvDaqResponse(theChannel, sendData, recvData);
         }
         
         // correct for displacement control errors using I-Modification
@@ -926,9 +923,7 @@ const Vector& EEInvertedVBrace2d::getTime()
         (*tDaq) = theSite->getTime();
     }
     else  {
-        sData[0] = OF_RemoteTest_getTime;
-        theChannel->sendVector(0, 0, *sendData, 0);
-        theChannel->recvVector(0, 0, *recvData, 0);
+        this->recvDaqResponse(theChannel, sendData, recvData);
     }
     
     return *tDaq;
@@ -941,9 +936,7 @@ const Vector& EEInvertedVBrace2d::getBasicDisp()
         (*dbDaq) = theSite->getDisp();
     }
     else  {
-        sData[0] = OF_RemoteTest_getDisp;
-        theChannel->sendVector(0, 0, *sendData, 0);
-        theChannel->recvVector(0, 0, *recvData, 0);
+        this->recvDaqResponse(theChannel, sendData, recvData);
     }
     
     return *dbDaq;
@@ -956,9 +949,7 @@ const Vector& EEInvertedVBrace2d::getBasicVel()
         (*vbDaq) = theSite->getVel();
     }
     else  {
-        sData[0] = OF_RemoteTest_getVel;
-        theChannel->sendVector(0, 0, *sendData, 0);
-        theChannel->recvVector(0, 0, *recvData, 0);
+        this->recvDaqResponse(theChannel, sendData, recvData);
     }
     
     return *vbDaq;
@@ -971,9 +962,7 @@ const Vector& EEInvertedVBrace2d::getBasicAccel()
         (*abDaq) = theSite->getAccel();
     }
     else  {
-        sData[0] = OF_RemoteTest_getAccel;
-        theChannel->sendVector(0, 0, *sendData, 0);
-        theChannel->recvVector(0, 0, *recvData, 0);
+        this->recvDaqResponse(theChannel, sendData, recvData);
     }
     
     return *abDaq;
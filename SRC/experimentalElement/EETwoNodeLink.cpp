@@ -63,8 +63,8 @@ void* OPF_EETwoNodeLink()
     
     if (OPS_GetNumRemainingInputArgs() < 9) {
         opserr << "WARNING invalid number of arguments\n";
-        opserr << "Want: expElement twoNodeLink eleTag iNode jNode -dof dofs -site siteTag -initStif Kij <-tangStif tangStifTag> <-orient <x1 x2 x3> y1 y2 y3> <-pDelta Mratios> <-shearDist sDratios> <-iMod> <-noRayleigh> <-mass m>\n";
-        opserr << "  or: expElement twoNodeLink eleTag iNode jNode -dof dofs -server ipPort <ipAddr> <-ssl> <-udp> <-dataSize size> -initStif Kij <-tangStif tangStifTag> <-orient <x1 x2 x3> y1 y2 y3> <-pDelta Mratios> <-shearDist sDratios> <-iMod> <-noRayleigh> <-mass m>\n";
+        opserr << "Want: expElement twoNodeLink eleTag iNode jNode -dof dofs -site siteTag -initStif Kij <-tangStif tangStifTag> <-orient <x1 x2 x3> y1 y2 y3> <-pDelta Mratios> <-shearDist sDratios> <-iMod> <-noRayleigh> <-mass m> <-maxCmds num>\n";
+        opserr << "  or: expElement twoNodeLink eleTag iNode jNode -dof dofs -server ipPort <ipAddr> <-ssl> <-udp> <-dataSize size> -initStif Kij <-tangStif tangStifTag> <-orient <x1 x2 x3> y1 y2 y3> <-pDelta Mratios> <-shearDist sDratios> <-iMod> <-noRayleigh> <-mass m> <-maxCmds num>\n";
         return 0;
     }
     
@@ -207,6 +207,7 @@ void* OPF_EETwoNodeLink()
     bool iMod = false;
     int doRayleigh = 1;
     double mass = 0.0;
+    int maxCmds = 0;
     while (OPS_GetNumRemainingInputArgs() > 0) {
         type = OPS_GetString();
         // tangent stiffness
@@ -313,6 +314,14 @@ void* OPF_EETwoNodeLink()
                 return 0;
             }
         }
+        else if (strcmp(type, "-maxCmds") == 0) {
+            numdata = 1;
+            if (OPS_GetIntInput(&numdata, &maxCmds) < 0 || maxCmds < 0) {
+                opserr << "WARNING invalid maxCmds\n";
+                opserr << "expElement twoNodeLink element: " << tag << endln;
+                return 0;
+            }
+        }
     }
     
     // now create the EETwoNodeLink
@@ -331,6 +340,9 @@ void* OPF_EETwoNodeLink()
         return 0;
     }
     
+    // limit the number of commands per step
+    theExpElement->setMaxNumCommands(maxCmds);
+    
     // add initial stiffness
     int setInitStif = theExpElement->setInitialStiff(theInitStif);
     if (setInitStif != 0) {
@@ -868,6 +880,12 @@ void EETwoNodeLink::setDomain(Domain *theDomain)
     
     // set transformation matrix from local to basic system
     this->setTranLocalBasic();
+    
+    // set fused transformation matrix from global to basic system
+    this->setTranGlobalBasic(Tlb, Tgl);
+    
+    // transform the initial stiffness from the basic to the global system
+    this->transfBasicGlobal(kbInit, theInitStiff);
 }
 
 
@@ -887,16 +905,12 @@ int EETwoNodeLink::commitState()
     // commit the base class
     rValue += this->Element::commitState();
     
+    // start counting the commands of the next step
+    this->commitCommands();
+    
     // update dbLast
-    int ndim = 0, i;
-    Vector dgLast(numDOF), dlLast(numDOF);
-    for (i=0; i<2; i++)  {
-        Vector disp = theNodes[i]->getTrialDisp();
-        dgLast.Assemble(disp, ndim);
-        ndim += numDOF/2;
-    }
-    dlLast.addMatrixVector(0.0, Tgl, dgLast, 1.0);
-    dbLast.addMatrixVector(0.0, Tlb, dlLast, 1.0);
+    this->transfGlobalBasic(theNodes[0]->getTrialDisp(),
+        theNodes[1]->getTrialDisp(), dbLast);
     
     return rValue;
 }
@@ -918,42 +932,44 @@ int EETwoNodeLink::update()
     (*t)(0) = theDomain->getCurrentTime();
     
     // get global trial response
-    int ndim = 0, i;
-    Vector dg(numDOF), vg(numDOF), ag(numDOF);
-    for (i=0; i<2; i++)  {
-        Vector disp = theNodes[i]->getTrialDisp();
-        Vector vel = theNodes[i]->getTrialVel();
-        Vector accel = theNodes[i]->getTrialAccel();
-        dg.Assemble(disp, ndim);
-        vg.Assemble(vel, ndim);
-        ag.Assemble(accel, ndim);
-        ndim += numDOF/2;
-    }
-    
-    // transform response from the global to the local system
-    Vector vl(numDOF), al(numDOF);
-    dl.addMatrixVector(0.0, Tgl, dg, 1.0);
-    vl.addMatrixVector(0.0, Tgl, vg, 1.0);
-    al.addMatrixVector(0.0, Tgl, ag, 1.0);
-    
-    // transform response from the local to the basic system
-    db->addMatrixVector(0.0, Tlb, dl, 1.0);
-    vb->addMatrixVector(0.0, Tlb, vl, 1.0);
-    ab->addMatrixVector(0.0, Tlb, al, 1.0);
+    const Vector &disp1 = theNodes[0]->getTrialDisp();
+    const Vector &disp2 = theNodes[1]->getTrialDisp();
+    const Vector &vel1 = theNodes[0]->getTrialVel();
+    const Vector &vel2 = theNodes[1]->getTrialVel();
+    const Vector &accel1 = theNodes[0]->getTrialAccel();
+    const Vector &accel2 = theNodes[1]->getTrialAccel();
+    
+    // transform response from the global to the basic system
+    this->transfGlobalBasic(disp1, disp2, *db);
+    this->transfGlobalBasic(vel1, vel2, *vb);
+    this->transfGlobalBasic(accel1, accel2, *ab);
+    
+    // local displacements are only needed for P-Delta effects
+    if (Mratio.Size() == 4)
+        this->setLocalDisp();
     
     // calculate incremental displacement command
-    Vector dbDelta = (*db) - dbLast;
+    double dbDelta = 0.0;
+    for (int i=0; i<numDir; i++)  {
+        double delta = fabs((*db)(i) - dbLast(i));
+        if (delta > dbDelta)
+            dbDelta = delta;
+    }
     // do not check time for right now because of transformation constraint
     // handler calling update at beginning of new step when applying load
-    // if (dbDelta.pNorm(0) > DBL_EPSILON || (*t)(0) > tLast)  {
-    if (dbDelta.pNorm(0) > DBL_EPSILON)  {
-        // set the trial response at the site
-        if (theSite != 0)  {
-            theSite->setTrialResponse(db, vb, ab, (Vector*)0, t);
-        }
-        else  {
-            sData[0] = OF_RemoteTest_setTrialResponse;
-            rValue += theChannel->sendVector(0, 0, *sendData, 0);
+    // if (dbDelta > DBL_EPSILON || (*t)(0) > tLast)  {
+    if (dbDelta > DBL_EPSILON)  {
+        // set the trial response at the site unless the
+        // commands of the current step are used up
+        if (this->countCommand() == true)  {
+            if (theSite != 0)  {
+                theSite->setTrialResponse(db, vb, ab, (Vector*)0, t);
+            }
+            else  {
+                sData[0] = OF_RemoteTest_setTrialResponse;
+                rValue += theChannel->sendVector(0, 0, *sendData, 0);
+                daqFlag = false;
+            }
         }
     }
     
@@ -971,15 +987,9 @@ int EETwoNodeLink::setInitialStiff(const Matrix& kbinit)
     }
     kb = kbInit = kbLast = kbinit;
     
-    // zero the global matrix
-    theInitStiff.Zero();
-    
-    // transform from basic to local system
-    Matrix klInit(numDOF, numDOF);
-    klInit.addMatrixTripleProduct(0.0, Tlb, kbInit, 1.0);
-    
-    // transform from local to global system
-    theInitStiff.addMatrixTripleProduct(0.0, Tgl, klInit, 1.0);
+    // transform from basic to global system (once the
+    // transformation is known, otherwise done in setDomain)
+    this->transfBasicGlobal(kbInit, theInitStiff);
     
     return 0;
 }
@@ -990,7 +1000,27 @@ const Matrix& EETwoNodeLink::getTangentStiff()
     // zero the global matrix
     theMatrix->Zero();
     
-    if (theTangStiff != 0)  {
+    // get the tangent stiffness returned by the site if available
+    const Matrix *kbSite = 0;
+    if (theSite != 0)
+        kbSite = theSite->getTangentStiff();
+    
+    if (kbSite != 0)  {
+        kb = *kbSite;
+        
+        // get current daq resisting force
+        this->getBasicForce();
+        
+        // apply optional initial stiffness modification
+        if (iMod == true)  {
+            // get daq displacement
+            this->getBasicDisp();
+            
+            // correct for displacement control errors using I-Modification
+            qbDaq->addMatrixVector(1.0, kbInit, (*dbDaq) - (*db), -1.0);
+        }
+    }
+    else if (theTangStiff != 0)  {
         // get current daq displacement and resisting force
         this->getBasicDisp();
         this->getBasicForce();
@@ -999,9 +1029,11 @@ const Matrix& EETwoNodeLink::getTangentStiff()
         Vector dbDaqIncr = (*dbDaq) - dbDaqLast;
         Vector qbDaqIncr = (*qbDaq) - qbDaqLast;
         
-        // get updated kb matrix
-        kb = theTangStiff->updateTangentStiff(&dbDaqIncr, (Vector*)0,
-            (Vector*)0, &qbDaqIncr, (Vector*)0, &kbInit, &kbLast);
+        // get updated kb matrix, which cannot change
+        // without a new measurement from the site
+        if (cmdSkipped == false)
+            kb = theTangStiff->updateTangentStiff(&dbDaqIncr, (Vector*)0,
+                (Vector*)0, &qbDaqIncr, (Vector*)0, &kbInit, &kbLast);
         
         // apply optional initial stiffness modification
         if (iMod == true)  {
@@ -1041,16 +1073,28 @@ const Matrix& EETwoNodeLink::getTangentStiff()
             (*qbDaq)(i) = kbInit(i,i) * (*db)(i);
     }
     
-    // transform from basic to local system
-    Matrix kl(numDOF, numDOF);
-    kl.addMatrixTripleProduct(0.0, Tlb, kbInit, 1.0);
-    
-    // add geometric stiffness to local stiffness
-    if (Mratio.Size() == 4)
+    if (Mratio.Size() == 4)  {
+        // transform from basic to local system
+        Matrix kl(numDOF, numDOF);
+        if (kbSite != 0)
+            kl.addMatrixTripleProduct(0.0, Tlb, kb, 1.0);
+        else
+            kl.addMatrixTripleProduct(0.0, Tlb, kbInit, 1.0);
+        
+        // add geometric stiffness to local stiffness
         this->addPDeltaStiff(kl);
-    
-    // transform from local to global system
-    theMatrix->addMatrixTripleProduct(0.0, Tgl, kl, 1.0);
+        
+        // transform from local to global system
+        theMatrix->addMatrixTripleProduct(0.0, Tgl, kl, 1.0);
+    }
+    else if (kbSite != 0)  {
+        // transform the site tangent from basic to global system
+        this->transfBasicGlobal(kb, *theMatrix);
+    }
+    else  {
+        // use the cached initial stiffness in global system
+        (*theMatrix) = theInitStiff;
+    }
     
     return *theMatrix;
 }
@@ -1151,6 +1195,14 @@ const Vector& EETwoNodeLink::getResistingForce()
         // correct for displacement control errors using I-Modification
         qbDaq->addMatrixVector(1.0, kbInit, (*dbDaq) - (*db), -1.0);
     }
+    else if (cmdSkipped == true)  {
+        // get current daq displacement
+        this->getBasicDisp();
+        
+        // the last trial response was not sent to the site, so
+        // correct with the current (site or updated) tangent
+        qbDaq->addMatrixVector(1.0, kb, (*dbDaq) - (*db), -1.0);
+    }
     
     // use elastic force if force from test is zero
     for (int i=0; i<numDir; i++)  {
@@ -1163,16 +1215,21 @@ const Vector& EETwoNodeLink::getResistingForce()
     vbCtrl = (*vb);
     abCtrl = (*ab);
     
-    // determine resisting forces in local system
-    Vector ql(numDOF);
-    ql.addMatrixTransposeVector(0.0, Tlb, *qbDaq, 1.0);
-    
-    // add P-Delta effects to local forces
-    if (Mratio.Size() == 4)
+    if (Mratio.Size() == 4)  {
+        // determine resisting forces in local system
+        Vector ql(numDOF);
+        ql.addMatrixTransposeVector(0.0, Tlb, *qbDaq, 1.0);
+        
+        // add P-Delta effects to local forces
         this->addPDeltaForces(ql);
-    
-    // determine resisting forces in global system
-    theVector->addMatrixTransposeVector(0.0, Tgl, ql, 1.0);
+        
+        // determine resisting forces in global system
+        theVector->addMatrixTransposeVector(0.0, Tgl, ql, 1.0);
+    }
+    else  {
+        // determine resisting forces in global system
+        this->transfBasicGlobal(*qbDaq, *theVector);
+    }
     
     // subtract external load
     theVector->addVector(1.0, *theLoad, -1.0);
@@ -1215,9 +1272,7 @@ const Vector& EETwoNodeLink::getTime()
         (*tDaq) = theSite->getTime();
     }
     else  {
-        sData[0] = OF_RemoteTest_getTime;
-        theChannel->sendVector(0, 0, *sendData, 0);
-        theChannel->recvVector(0, 0, *recvData, 0);
+        this->recvDaqResponse(theChannel, sendData, recvData);
     }
     
     return *tDaq;
@@ -1230,9 +1285,7 @@ const Vector& EETwoNodeLink::getBasicDisp()
         (*dbDaq) = theSite->getDisp();
     }
     else  {
-        sData[0] = OF_RemoteTest_getDisp;
-        theChannel->sendVector(0, 0, *sendData, 0);
-        theChannel->recvVector(0, 0, *recvData, 0);
+        this->recvDaqResponse(theChannel, sendData, recvData);
     }
     
     return *dbDaq;
@@ -1245,9 +1298,7 @@ const Vector& EETwoNodeLink::getBasicVel()
         (*vbDaq) = theSite->getVel();
     }
     else  {
-        sData[0] = OF_RemoteTest_getVel;
-        theChannel->sendVector(0, 0, *sendData, 0);
-        theChannel->recvVector(0, 0, *recvData, 0);
+        this->recvDaqResponse(theChannel, sendData, recvData);
     }
     
     return *vbDaq;
@@ -1260,9 +1311,7 @@ const Vector& EETwoNodeLink::getBasicAccel()
         (*abDaq) = theSite->getAccel();
     }
     else  {
-        sData[0] = OF_RemoteTest_getAccel;
-        theChannel->sendVector(0, 0, *sendData, 0);
-        theChannel->recvVector(0, 0, *recvData, 0);
+        this->recvDaqResponse(theChannel, sendData, recvData);
     }
     
     return *abDaq;
@@ -1275,9 +1324,7 @@ const Vector& EETwoNodeLink::getBasicForce()
         (*qbDaq) = theSite->getForce();
     }
     else  {
-        sData[0] = OF_RemoteTest_getForce;
-        theChannel->sendVector(0, 0, *sendData, 0);
-        theChannel->recvVector(0, 0, *recvData, 0);
+        this->recvDaqResponse(theChannel, sendData, recvData);
     }
     
     return *qbDaq;
@@ -1354,6 +1401,8 @@ void EETwoNodeLink::Print(OPS_Stream &s, int flag)
             s << "  ExperimentalTangStiff: " << theTangStiff->getTag() << endln;
         s << "  Mratio: " << Mratio << "  shearDistI: " << shearDistI << endln;
         s << "  addRayleigh: " << addRayleigh << "  mass: " << mass << endln;
+        s << "  maxCmds: " << maxNumCmds << ", commands: " << numCmds
+            << ", iterations: " << numIter << endln;
         // determine resisting forces in global system
         s << "  resisting force: " << this->getResistingForce() << endln;
     } else if (flag == 1)  {
@@ -1502,6 +1551,15 @@ Response* EETwoNodeLink::setResponse(const char **argv, int argc,
         theResponse = new ElementResponse(this, 10, Vector(numDir));
     }
     
+    // number of commands issued and iterations requested
+    else if (strcmp(argv[0],"numCmds") == 0 ||
+        strcmp(argv[0],"numCommands") == 0)
+    {
+        output.tag("ResponseType","numCmds");
+        output.tag("ResponseType","numIter");
+        theResponse = new ElementResponse(this, 12, Vector(2));
+    }
+    
     // basic deformations and basic forces
     else if (strcmp(argv[0],"defoANDforce") == 0 ||
         strcmp(argv[0],"deformationANDforce") == 0 ||
@@ -1559,6 +1617,7 @@ int EETwoNodeLink::getResponse(int responseID, Information &eleInfo)
         return eleInfo.setVector(*qbDaq);
         
     case 4:  // ctrl local displacements
+        this->setLocalDisp();
         return eleInfo.setVector(dl);
         
     case 5:  // ctrl basic displacements
@@ -1586,6 +1645,14 @@ int EETwoNodeLink::getResponse(int responseID, Information &eleInfo)
         
         return eleInfo.setVector(defoAndForce);
         
+    case 12:  // number of commands and iterations
+        {
+            Vector cmds(2);
+            cmds(0) = numCmds;
+            cmds(1) = numIter;
+            return eleInfo.setVector(cmds);
+        }
+        
     default:
         return 0;
     }
@@ -1770,6 +1837,24 @@ void EETwoNodeLink::setTranLocalBasic()
 }
 
 
+// set local displacements from the global trial displacements
+void EETwoNodeLink::setLocalDisp()
+{
+    const Vector &disp1 = theNodes[0]->getTrialDisp();
+    const Vector &disp2 = theNodes[1]->getTrialDisp();
+    
+    // Tgl is block diagonal with one block per node
+    int numDOF2 = numDOF/2;
+    for (int i=0; i<numDOF2; i++)  {
+        dl(i) = dl(i+numDOF2) = 0.0;
+        for (int j=0; j<numDOF2; j++)  {
+            dl(i) += Tgl(i,j)*disp1(j);
+            dl(i+numDOF2) += Tgl(i+numDOF2,j+numDOF2)*disp2(j);
+        }
+    }
+}
+
+
 void EETwoNodeLink::addPDeltaForces(Vector &pLocal)
 {
     int dirID;
@@ -121,6 +121,7 @@ private:
     void setUp();
     void setTranGlobalLocal();
     void setTranLocalBasic();
+    void setLocalDisp();
     void addPDeltaForces(Vector &pLocal);
     void addPDeltaStiff(Matrix &kLocal);
     
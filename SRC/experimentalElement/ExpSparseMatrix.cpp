@@ -0,0 +1,332 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation of
+// ExpSparseMatrix.
+
+#include "ExpSparseMatrix.h"
+
+#include <string.h>
+
+
+ExpSparseMatrix::ExpSparseMatrix()
+    : numRows(0), numCols(0), rowPtr(1), colInd(), val()
+{
+    rowPtr.Zero();
+}
+
+
+ExpSparseMatrix::ExpSparseMatrix(const Matrix &M)
+    : numRows(0), numCols(0), rowPtr(1), colInd(), val()
+{
+    rowPtr.Zero();
+    this->setData(M);
+}
+
+
+ExpSparseMatrix::~ExpSparseMatrix()
+{
+    // does nothing
+}
+
+
+int ExpSparseMatrix::setData(const Matrix &M)
+{
+    int nRows = M.noRows();
+    int nCols = M.noCols();
+    
+    // count the non-zero entries of each row
+    int i, j, nnz = 0;
+    rowPtr.resize(nRows+1);
+    rowPtr.Zero();
+    for (i=0; i<nRows; i++)  {
+        for (j=0; j<nCols; j++)
+            if (M(i,j) != 0.0)
+                nnz++;
+        rowPtr(i+1) = nnz;
+    }
+    
+    // copy the non-zero entries
+    colInd.resize(nnz);
+    val.resize(nnz);
+    int k = 0;
+    for (i=0; i<nRows; i++)  {
+        for (j=0; j<nCols; j++)  {
+            if (M(i,j) != 0.0)  {
+                colInd(k) = j;
+                val(k) = M(i,j);
+                k++;
+            }
+        }
+    }
+    numRows = nRows;
+    numCols = nCols;
+    
+    return 0;
+}
+
+
+int ExpSparseMatrix::read(const char *fileName, int nRows, int nCols)
+{
+    FILE *theFile = fopen(fileName, "rb");
+    if (theFile == 0)  {
+        opserr << "ExpSparseMatrix::read() - "
+            << "could not open file: " << fileName << endln;
+        return -1;
+    }
+    
+    // MatrixMarket files start with their banner,
+    // everything else is read as binary file
+    char banner[15];
+    int rValue;
+    if (fread(banner, sizeof(char), 14, theFile) == 14 &&
+        strncmp(banner, "%%MatrixMarket", 14) == 0)  {
+        rValue = this->readMatrixMarket(theFile, nRows, nCols);
+    } else  {
+        rewind(theFile);
+        rValue = this->readBinary(theFile, nRows, nCols);
+    }
+    fclose(theFile);
+    
+    if (rValue < 0)  {
+        opserr << "ExpSparseMatrix::read() - "
+            << "failed to read a " << nRows << "x" << nCols
+            << " matrix from file: " << fileName << endln;
+    }
+    
+    return rValue;
+}
+
+
+int ExpSparseMatrix::noRows() const
+{
+    return numRows;
+}
+
+
+int ExpSparseMatrix::noCols() const
+{
+    return numCols;
+}
+
+
+int ExpSparseMatrix::getNumNonZeros() const
+{
+    return rowPtr(numRows);
+}
+
+
+int ExpSparseMatrix::addMatrixVector(Vector &y, const Vector &x,
+    double fact) const
+{
+    if (y.Size() != numRows || x.Size() != numCols)  {
+        opserr << "ExpSparseMatrix::addMatrixVector() - "
+            << "incompatible sizes.\n";
+        return -1;
+    }
+    
+    for (int i=0; i<numRows; i++)  {
+        double sum = 0.0;
+        for (int k=rowPtr(i); k<rowPtr(i+1); k++)
+            sum += val(k) * x(colInd(k));
+        y(i) += fact*sum;
+    }
+    
+    return 0;
+}
+
+
+int ExpSparseMatrix::assemble(Matrix &A, const ID &rows,
+    const ID &cols, double fact) const
+{
+    if (rows.Size() != numRows || cols.Size() != numCols)  {
+        opserr << "ExpSparseMatrix::assemble() - "
+            << "incompatible sizes.\n";
+        return -1;
+    }
+    
+    for (int i=0; i<numRows; i++)  {
+        int a = rows(i);
+        for (int k=rowPtr(i); k<rowPtr(i+1); k++)
+            A(a,cols(colInd(k))) += fact*val(k);
+    }
+    
+    return 0;
+}
+
+
+void ExpSparseMatrix::Print(OPS_Stream &s, int flag) const
+{
+    s << "ExpSparseMatrix: " << numRows << "x" << numCols
+        << ", non-zeros: " << this->getNumNonZeros() << endln;
+    if (flag == 1)  {
+        for (int i=0; i<numRows; i++)
+            for (int k=rowPtr(i); k<rowPtr(i+1); k++)
+                s << "  (" << i << "," << colInd(k) << ") "
+                    << val(k) << endln;
+    }
+}
+
+
+int ExpSparseMatrix::readMatrixMarket(FILE *theFile, int nRows, int nCols)
+{
+    // parse the rest of the banner line
+    char line[1024], object[64], format[64], field[64], symmetry[64];
+    if (fgets(line, 1024, theFile) == 0 ||
+        sscanf(line, "%63s %63s %63s %63s", object, format, field, symmetry) != 4)
+        return -1;
+    if (strcmp(object, "matrix") != 0 ||
+        (strcmp(field, "real") != 0 && strcmp(field, "integer") != 0))  {
+        opserr << "ExpSparseMatrix::readMatrixMarket() - "
+            << "only real and integer matrices are supported.\n";
+        return -1;
+    }
+    bool coordinate = (strcmp(format, "coordinate") == 0);
+    if (!coordinate && strcmp(format, "array") != 0)
+        return -1;
+    bool symmetric = (strcmp(symmetry, "symmetric") == 0);
+    if (!symmetric && strcmp(symmetry, "general") != 0)  {
+        opserr << "ExpSparseMatrix::readMatrixMarket() - "
+            << "only general and symmetric matrices are supported.\n";
+        return -1;
+    }
+    
+    // skip the comments and read the size line
+    do  {
+        if (fgets(line, 1024, theFile) == 0)
+            return -1;
+    } while (line[0] == '%' || line[0] == '\n' || line[0] == '\r');
+    int m, n, nnz;
+    if (coordinate)  {
+        if (sscanf(line, "%d %d %d", &m, &n, &nnz) != 3)
+            return -1;
+    } else  {
+        if (sscanf(line, "%d %d", &m, &n) != 2)
+            return -1;
+        nnz = symmetric ? n*(n+1)/2 : m*n;
+    }
+    if (m != nRows || n != nCols || nnz < 0)
+        return -1;
+    
+    // read the entries, symmetric files only hold the lower triangle
+    int size = symmetric ? 2*nnz : nnz;
+    ID row(size), col(size);
+    Vector value(size);
+    int i, j, k = 0;
+    double v;
+    for (int e=0; e<nnz; e++)  {
+        if (coordinate)  {
+            if (fscanf(theFile, "%d %d %lf", &i, &j, &v) != 3)
+                return -1;
+            i--; j--;
+        } else  {
+            if (fscanf(theFile, "%lf", &v) != 1)
+                return -1;
+            // array format is column-major
+            if (symmetric)  {
+                // lower triangle column by column
+                j = 0;
+                int rem = e;
+                while (rem >= n-j)  {
+                    rem -= n-j;
+                    j++;
+                }
+                i = j + rem;
+            } else  {
+                i = e % m;
+                j = e / m;
+            }
+        }
+        if (i < 0 || i >= m || j < 0 || j >= n)
+            return -1;
+        row(k) = i; col(k) = j; value(k) = v;
+        k++;
+        if (symmetric && i != j)  {
+            row(k) = j; col(k) = i; value(k) = v;
+            k++;
+        }
+    }
+    
+    this->setEntries(m, n, k, row, col, value);
+    
+    return 0;
+}
+
+
+int ExpSparseMatrix::readBinary(FILE *theFile, int nRows, int nCols)
+{
+    // the file holds all the entries in column-major order
+    fseek(theFile, 0, SEEK_END);
+    long numBytes = ftell(theFile);
+    rewind(theFile);
+    if (numBytes != (long)nRows*nCols*(long)sizeof(double))
+        return -1;
+    
+    Matrix M(nRows, nCols);
+    double *data = new double [nCols];
+    for (int i=0; i<nRows*nCols; i+=nCols)  {
+        int n = (int)fread(data, sizeof(double), nCols, theFile);
+        if (n != nCols)  {
+            delete [] data;
+            return -1;
+        }
+        for (int j=0; j<nCols; j++)
+            M((i+j)%nRows,(i+j)/nRows) = data[j];
+    }
+    delete [] data;
+    
+    return this->setData(M);
+}
+
+
+void ExpSparseMatrix::setEntries(int nRows, int nCols, int nnz,
+    const ID &row, const ID &col, const Vector &value)
+{
+    // count the non-zero entries of each row
+    int i, k;
+    rowPtr.resize(nRows+1);
+    rowPtr.Zero();
+    for (k=0; k<nnz; k++)
+        if (value(k) != 0.0)
+            rowPtr(row(k)+1)++;
+    for (i=0; i<nRows; i++)
+        rowPtr(i+1) += rowPtr(i);
+    
+    // sort the entries into their rows
+    colInd.resize(rowPtr(nRows));
+    val.resize(rowPtr(nRows));
+    ID next(nRows);
+    for (i=0; i<nRows; i++)
+        next(i) = rowPtr(i);
+    for (k=0; k<nnz; k++)  {
+        if (value(k) != 0.0)  {
+            int pos = next(row(k))++;
+            colInd(pos) = col(k);
+            val(pos) = value(k);
+        }
+    }
+    numRows = nRows;
+    numCols = nCols;
+}
@@ -0,0 +1,88 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef ExpSparseMatrix_h
+#define ExpSparseMatrix_h
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the class definition for
+// ExpSparseMatrix. An ExpSparseMatrix stores the non-zero entries of
+// an element matrix by rows (compressed sparse row storage), so that
+// products and assembly of large superelement matrices only cost the
+// number of non-zero entries. The matrix can be set from a Matrix or
+// read from a file that is either a MatrixMarket file (coordinate or
+// array format, real or integer, general or symmetric) or a binary
+// file with all the entries as doubles in column-major order (as
+// written by MATLAB's fwrite(fid,K,'double')).
+
+#include <FrescoGlobals.h>
+
+#include <ID.h>
+#include <Vector.h>
+#include <Matrix.h>
+
+#include <stdio.h>
+
+class ExpSparseMatrix
+{
+public:
+    // constructors
+    ExpSparseMatrix();
+    ExpSparseMatrix(const Matrix &M);
+    
+    // destructor
+    ~ExpSparseMatrix();
+    
+    // methods to set the matrix
+    int setData(const Matrix &M);
+    int read(const char *fileName, int nRows, int nCols);
+    
+    // methods to get the size of the matrix
+    int noRows() const;
+    int noCols() const;
+    int getNumNonZeros() const;
+    
+    // method to add fact*this*x to y
+    int addMatrixVector(Vector &y, const Vector &x, double fact = 1.0) const;
+    // method to add fact*this to A(rows,cols)
+    int assemble(Matrix &A, const ID &rows, const ID &cols,
+        double fact = 1.0) const;
+    
+    // public methods for output
+    void Print(OPS_Stream &s, int flag = 0) const;
+    
+private:
+    int readMatrixMarket(FILE *theFile, int nRows, int nCols);
+    int readBinary(FILE *theFile, int nRows, int nCols);
+    void setEntries(int nRows, int nCols, int nnz,
+        const ID &row, const ID &col, const Vector &val);
+    
+    int numRows;    // number of rows
+    int numCols;    // number of columns
+    ID rowPtr;      // start of each row in colInd/val
+    ID colInd;      // column of each non-zero entry
+    Vector val;     // value of each non-zero entry
+};
+
+#endif
@@ -35,6 +35,7 @@
 #include <ElementResponse.h>
 #include <Node.h>
 #include <Renderer.h>
+#include <Channel.h>
 
 #include <math.h>
 #include <stdlib.h>
@@ -49,7 +50,10 @@ ExperimentalElement::ExperimentalElement(int tag,
     theSite(site), theTangStiff(0),
     sizeCtrl(0), sizeDaq(0),
     theInitStiff(1,1),
-    firstWarning(true)
+    TgbRowPtr(), TgbCol(), TgbVal(),
+    daqFlag(false), daqCache(),
+    maxNumCmds(0), numCmdsStep(0), numCmds(0), numIter(0),
+    cmdSkipped(false), firstWarning(true)
 {
     // get copy of experimental tangent stiffness
     if (tang != 0)  {
@@ -137,6 +141,202 @@ const Vector& ExperimentalElement::getTime()
 }
 
 
+int ExperimentalElement::setMaxNumCommands(int maxNum)
+{
+    if (maxNum < 0)  {
+        opserr << "ExperimentalElement::setMaxNumCommands() - "
+            << "Element: " << this->getTag() << endln
+            << "number of commands must not be negative.\n";
+        return OF_ReturnType_failed;
+    }
+    maxNumCmds = maxNum;
+    
+    return OF_ReturnType_completed;
+}
+
+
+int ExperimentalElement::getMaxNumCommands()
+{
+    return maxNumCmds;
+}
+
+
+int ExperimentalElement::getNumCommands()
+{
+    return numCmds;
+}
+
+
+int ExperimentalElement::getNumIterations()
+{
+    return numIter;
+}
+
+
+bool ExperimentalElement::countCommand()
+{
+    numIter++;
+    
+    // once the commands of the step are used up, the trial response
+    // is not sent and the element answers from the measured response
+    if (maxNumCmds > 0 && numCmdsStep >= maxNumCmds)  {
+        cmdSkipped = true;
+        return false;
+    }
+    numCmdsStep++;
+    numCmds++;
+    cmdSkipped = false;
+    
+    return true;
+}
+
+
+void ExperimentalElement::commitCommands()
+{
+    numCmdsStep = 0;
+}
+
+
+int ExperimentalElement::recvDaqResponse(Channel *theChannel,
+    Vector *sendData, Vector *recvData)
+{
+    // the remote daq response cannot change until the next trial
+    // response is sent, so all queries of a step share one round trip
+    if (daqFlag == false)  {
+        (*sendData)(0) = OF_RemoteTest_getDaqResponse;
+        int rValue = theChannel->sendVector(0, 0, *sendData, 0);
+        rValue += theChannel->recvVector(0, 0, *recvData, 0);
+        if (rValue != 0)  {
+            opserr << "ExperimentalElement::recvDaqResponse() - "
+                << "Element: " << this->getTag() << endln
+                << "failed to get daq response over channel.\n";
+            return OF_ReturnType_failed;
+        }
+        daqCache = *recvData;
+        daqFlag = true;
+    } else  {
+        // restore the raw daq response since elements modify
+        // the received vectors in place (e.g. I-Modification)
+        *recvData = daqCache;
+    }
+    
+    return OF_ReturnType_completed;
+}
+
+
+void ExperimentalElement::setTranGlobalBasic(const Matrix &Tlb,
+    const Matrix &Tgl)
+{
+    int numBasic = Tlb.noRows();
+    int numDOF = Tgl.noCols();
+    
+    // fuse the two transformations
+    Matrix Tgb(numBasic, numDOF);
+    Tgb.addMatrixProduct(0.0, Tlb, Tgl, 1.0);
+    
+    // count the non-zero entries and compress them by rows
+    int i, j, nnz = 0;
+    for (i=0; i<numBasic; i++)
+        for (j=0; j<numDOF; j++)
+            if (Tgb(i,j) != 0.0)
+                nnz++;
+    
+    TgbRowPtr.resize(numBasic+1);
+    TgbCol.resize(nnz > 0 ? nnz : 1);
+    TgbVal.resize(nnz > 0 ? nnz : 1);
+    nnz = 0;
+    for (i=0; i<numBasic; i++)  {
+        TgbRowPtr(i) = nnz;
+        for (j=0; j<numDOF; j++)  {
+            if (Tgb(i,j) != 0.0)  {
+                TgbCol(nnz) = j;
+                TgbVal(nnz) = Tgb(i,j);
+                nnz++;
+            }
+        }
+    }
+    TgbRowPtr(numBasic) = nnz;
+}
+
+
+void ExperimentalElement::transfGlobalBasic(const Vector &u1,
+    const Vector &u2, Vector &ub)
+{
+    // ub = Tgb*[u1; u2] without assembling the global vector
+    int numBasic = TgbRowPtr.Size() - 1;
+    int numDOF1 = u1.Size();
+    for (int i=0; i<numBasic; i++)  {
+        double sum = 0.0;
+        for (int k=TgbRowPtr(i); k<TgbRowPtr(i+1); k++)  {
+            int j = TgbCol(k);
+            sum += TgbVal(k) * (j < numDOF1 ? u1(j) : u2(j-numDOF1));
+        }
+        ub(i) = sum;
+    }
+}
+
+
+void ExperimentalElement::transfBasicGlobal(const Vector &qb, Vector &qg)
+{
+    // qg = Tgb^T*qb
+    int numBasic = TgbRowPtr.Size() - 1;
+    int numDOF = this->getNumTgbCols();
+    if (qg.Size() < numDOF)
+        qg.resize(numDOF);
+    qg.Zero();
+    for (int i=0; i<numBasic; i++)  {
+        double qi = qb(i);
+        if (qi == 0.0)
+            continue;
+        for (int k=TgbRowPtr(i); k<TgbRowPtr(i+1); k++)
+            qg(TgbCol(k)) += TgbVal(k) * qi;
+    }
+}
+
+
+void ExperimentalElement::transfBasicGlobal(const Matrix &kb, Matrix &kg)
+{
+    // kg = Tgb^T*kb*Tgb
+    int numBasic = TgbRowPtr.Size() - 1;
+    int numDOF = this->getNumTgbCols();
+    if (kg.noRows() < numDOF || kg.noCols() < numDOF)  {
+        opserr << "WARNING ExperimentalElement::transfBasicGlobal() - "
+            << "element: " << this->getTag()
+            << " - resizing global matrix to " << numDOF << "x" << numDOF << endln;
+        kg.resize(numDOF, numDOF);
+    }
+    kg.Zero();
+    for (int i=0; i<numBasic; i++)  {
+        for (int j=0; j<numBasic; j++)  {
+            double kij = kb(i,j);
+            if (kij == 0.0)
+                continue;
+            for (int ki=TgbRowPtr(i); ki<TgbRowPtr(i+1); ki++)  {
+                int a = TgbCol(ki);
+                double tka = TgbVal(ki) * kij;
+                for (int kj=TgbRowPtr(j); kj<TgbRowPtr(j+1); kj++)
+                    kg(a,TgbCol(kj)) += tka * TgbVal(kj);
+            }
+        }
+    }
+}
+
+
+int ExperimentalElement::getNumTgbCols()
+{
+    // number of global DOF the transformation refers to
+    int numDOF = 0;
+    int numBasic = TgbRowPtr.Size() - 1;
+    if (numBasic < 1)
+        return 0;
+    for (int k=0; k<TgbRowPtr(numBasic); k++)
+        if (TgbCol(k) >= numDOF)
+            numDOF = TgbCol(k) + 1;
+    
+    return numDOF;
+}
+
+
 int ExperimentalElement::revertToLastCommit()
 {
     opserr << "ExperimentalElement::revertToLastCommit() - "
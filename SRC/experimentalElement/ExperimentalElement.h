@@ -38,6 +38,9 @@
 
 #include <Element.h>
 #include <Matrix.h>
+#include <Vector.h>
+
+class Channel;
 
 class ExperimentalElement : public Element
 {
@@ -65,8 +68,35 @@ public:
     virtual const Vector &getVel();
     virtual const Vector &getAccel();
     virtual const Vector &getTime();
+    
+    // public methods to limit the number of physical commands per
+    // step and to obtain the number of commands and iterations
+    int setMaxNumCommands(int maxNum);
+    int getMaxNumCommands();
+    int getNumCommands();
+    int getNumIterations();
 
 protected:
+    // method to get the daq response over a direct channel, which
+    // is fetched only once after every new trial response
+    int recvDaqResponse(Channel *theChannel,
+        Vector *sendData, Vector *recvData);
+    
+    // methods to form and to apply the fused global to basic
+    // transformation Tgb = Tlb*Tgl of two-node elements, which
+    // is stored sparse by rows (non-zero entries only)
+    void setTranGlobalBasic(const Matrix &Tlb, const Matrix &Tgl);
+    void transfGlobalBasic(const Vector &u1, const Vector &u2, Vector &ub);
+    void transfBasicGlobal(const Vector &qb, Vector &qg);
+    void transfBasicGlobal(const Matrix &kb, Matrix &kg);
+    int getNumTgbCols();
+    
+    // method to count a new trial response, returns false if it must
+    // not be sent to the site because the maximum number of commands
+    // of the step has been reached, and method to start a new step
+    bool countCommand();
+    void commitCommands();
+    
     // pointer to ExperimentalSite object
     ExperimentalSite* theSite;
     // pointer to ExperimentalTangentStiff object
@@ -79,6 +109,22 @@ protected:
         
     // initial stiffness matrix
     Matrix theInitStiff;
+    
+    // sparse global to basic transformation
+    ID TgbRowPtr;   // start of each basic row in TgbCol/TgbVal
+    ID TgbCol;      // global DOF of each non-zero entry
+    Vector TgbVal;  // value of each non-zero entry
+    
+    // daqFlag = false (new trial sent) / true (daq response cached)
+    bool daqFlag;
+    Vector daqCache;
+    
+    // commands per step
+    int maxNumCmds;     // max number of commands per step (0 = no limit)
+    int numCmdsStep;    // number of commands issued in the current step
+    int numCmds;        // total number of commands issued
+    int numIter;        // total number of trial responses requested
+    bool cmdSkipped;    // last trial response was not sent to the site
 
 private:
     // the following methods must be defined if the Element object 
@@ -36,6 +36,7 @@
 #include <BinaryFileStream.h>
 //#include <DatabaseStream.h>
 #include <TCP_Stream.h>
+#include <TelemetryStream.h>
 #include <elementAPI.h>
 
 
@@ -62,6 +63,7 @@ void* OPF_ExpSetupRecorder()
     const int DATA_STREAM_CSV = 5;
     const int TCP_STREAM = 6;
     const int DATA_STREAM_ADD = 7;
+    const int TELEMETRY_STREAM = 8;
     
     int eMode = STANDARD_STREAM;
     bool echoTimeFlag = false;
@@ -70,7 +72,11 @@ void* OPF_ExpSetupRecorder()
     int precision = 6;
     bool closeOnWrite = false;
     const char* inetAddr = 0;
-    int inetPort;
+    int inetPort = 0;
+    const char* bindAddr = 0;
+    int batchSize = 32;
+    int queueSize = 1024;
+    bool blockWhenFull = false;
     
     int numSetups = 0;
     ID setupTags(0, 32);
@@ -157,6 +163,41 @@ void* OPF_ExpSetupRecorder()
             }
             eMode = TCP_STREAM;
         }
+        else if (strcmp(option, "-telemetry") == 0) {
+            numdata = 1;
+            if (OPS_GetNumRemainingInputArgs() < 1 ||
+                OPS_GetIntInput(&numdata, &inetPort) < 0) {
+                opserr << "WARNING: want -telemetry port\n";
+                return 0;
+            }
+            eMode = TELEMETRY_STREAM;
+        }
+        else if (strcmp(option, "-bind") == 0) {
+            if (OPS_GetNumRemainingInputArgs() > 0) {
+                bindAddr = OPS_GetString();
+            }
+        }
+        else if (strcmp(option, "-batch") == 0) {
+            if (OPS_GetNumRemainingInputArgs() > 0) {
+                numdata = 1;
+                if (OPS_GetIntInput(&numdata, &batchSize) < 0) {
+                    opserr << "WARNING: failed to read batch size\n";
+                    return 0;
+                }
+            }
+        }
+        else if (strcmp(option, "-queue") == 0) {
+            if (OPS_GetNumRemainingInputArgs() > 0) {
+                numdata = 1;
+                if (OPS_GetIntInput(&numdata, &queueSize) < 0) {
+                    opserr << "WARNING: failed to read queue size\n";
+                    return 0;
+                }
+            }
+        }
+        else if (strcmp(option, "-block") == 0) {
+            blockWhenFull = true;
+        }
         /*else if (strcmp(option, "-database") == 0) {
             theDatabase = OPS_GetFEDatastore();
             if (theDatabase != 0) {
@@ -228,6 +269,19 @@ void* OPF_ExpSetupRecorder()
         theOutputStream = new BinaryFileStream(filename);
     else if (eMode == TCP_STREAM && inetAddr != 0)
         theOutputStream = new TCP_Stream(inetPort, inetAddr);
+    else if (eMode == TELEMETRY_STREAM) {
+        TelemetryStream *theStream = new TelemetryStream(inetPort,
+            bindAddr, batchSize, queueSize, blockWhenFull);
+        if (theStream->getPort() == 0) {
+            opserr << "WARNING: could not open telemetry port "
+                << inetPort << endln;
+            delete theStream;
+            if (data != 0)
+                delete[] data;
+            return 0;
+        }
+        theOutputStream = theStream;
+    }
     else
         theOutputStream = new StandardStream();
     
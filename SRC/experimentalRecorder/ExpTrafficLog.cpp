@@ -0,0 +1,335 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation of
+// ExpTrafficLog.
+
+#include "ExpTrafficLog.h"
+
+#include <string.h>
+#include <time.h>
+
+static const char OF_TrafficLog_magic[4] = {'O','F','T','L'};
+static const int OF_TrafficLog_version = 1;
+
+
+ExpTrafficLog::ExpTrafficLog(const char *filename, bool readmode)
+    : fileName(0), readMode(readmode), theFile(0),
+    source(0), sizeTrial(OF_Resp_All), sizeDaq(OF_Resp_All),
+    record(0), numTrial(0), numDaq(0),
+    recType(None), numRecords(0)
+{
+    fileName = new char [strlen(filename)+1];
+    strcpy(fileName, filename);
+    
+    if (readMode == false)
+        return;
+    
+    // open the file and read the header
+    theFile = fopen(fileName, "rb");
+    if (theFile == 0)  {
+        opserr << "ExpTrafficLog::ExpTrafficLog() - "
+            << "could not open file: " << fileName << endln;
+        return;
+    }
+    char magic[4];
+    int version, sizes[2*OF_Resp_All];
+    double start;
+    if (fread(magic, sizeof(char), 4, theFile) != 4 ||
+        memcmp(magic, OF_TrafficLog_magic, 4) != 0 ||
+        fread(&version, sizeof(int), 1, theFile) != 1 ||
+        version != OF_TrafficLog_version ||
+        fread(&source, sizeof(int), 1, theFile) != 1 ||
+        fread(sizes, sizeof(int), 2*OF_Resp_All, theFile) != 2*OF_Resp_All ||
+        fread(&start, sizeof(double), 1, theFile) != 1)  {
+        opserr << "ExpTrafficLog::ExpTrafficLog() - "
+            << "file " << fileName << " is not a valid traffic log.\n";
+        fclose(theFile);
+        theFile = 0;
+        return;
+    }
+    for (int i=0; i<OF_Resp_All; i++)  {
+        sizeTrial(i) = sizes[i];
+        sizeDaq(i) = sizes[OF_Resp_All+i];
+        numTrial += sizes[i];
+        numDaq += sizes[OF_Resp_All+i];
+    }
+    int numData = (numTrial > numDaq) ? numTrial : numDaq;
+    record = new double [1+numData];
+}
+
+
+ExpTrafficLog::~ExpTrafficLog()
+{
+    if (theFile != 0)
+        fclose(theFile);
+    if (record != 0)
+        delete [] record;
+    if (fileName != 0)
+        delete [] fileName;
+}
+
+
+int ExpTrafficLog::open(int src, const ID &sizeT, const ID &sizeD)
+{
+    if (readMode == true || theFile != 0)  {
+        opserr << "ExpTrafficLog::open() - "
+            << "log " << fileName << " is already open.\n";
+        return OF_ReturnType_failed;
+    }
+    
+    source = src;
+    sizeTrial = sizeT;
+    sizeDaq = sizeD;
+    numTrial = numDaq = 0;
+    int sizes[2*OF_Resp_All];
+    for (int i=0; i<OF_Resp_All; i++)  {
+        sizes[i] = sizeTrial(i);
+        sizes[OF_Resp_All+i] = sizeDaq(i);
+        numTrial += sizes[i];
+        numDaq += sizes[OF_Resp_All+i];
+    }
+    int numData = (numTrial > numDaq) ? numTrial : numDaq;
+    record = new double [1+numData];
+    
+    theFile = fopen(fileName, "wb");
+    if (theFile == 0)  {
+        opserr << "ExpTrafficLog::open() - "
+            << "could not open file: " << fileName << endln;
+        return OF_ReturnType_failed;
+    }
+    
+    // write the header
+    double start = (double)::time(0);
+    fwrite(OF_TrafficLog_magic, sizeof(char), 4, theFile);
+    fwrite(&OF_TrafficLog_version, sizeof(int), 1, theFile);
+    fwrite(&source, sizeof(int), 1, theFile);
+    fwrite(sizes, sizeof(int), 2*OF_Resp_All, theFile);
+    if (fwrite(&start, sizeof(double), 1, theFile) != 1)  {
+        opserr << "ExpTrafficLog::open() - "
+            << "failed to write header to file: " << fileName << endln;
+        return OF_ReturnType_failed;
+    }
+    
+    startTime = std::chrono::steady_clock::now();
+    
+    return OF_ReturnType_completed;
+}
+
+
+int ExpTrafficLog::writeTrial(const Vector* disp,
+    const Vector* vel,
+    const Vector* accel,
+    const Vector* force,
+    const Vector* time)
+{
+    return this->writeRecord(Trial, sizeTrial,
+        disp, vel, accel, force, time);
+}
+
+
+int ExpTrafficLog::writeDaq(const Vector* disp,
+    const Vector* vel,
+    const Vector* accel,
+    const Vector* force,
+    const Vector* time)
+{
+    return this->writeRecord(Daq, sizeDaq,
+        disp, vel, accel, force, time);
+}
+
+
+int ExpTrafficLog::writeCommit()
+{
+    return this->writeRecord(Commit, ID(),
+        0, 0, 0, 0, 0);
+}
+
+
+int ExpTrafficLog::readRecord()
+{
+    recType = None;
+    if (readMode == false || theFile == 0)
+        return OF_ReturnType_failed;
+    
+    char type;
+    if (fread(&type, sizeof(char), 1, theFile) != 1)
+        return OF_ReturnType_failed;
+    
+    int numData;
+    switch (type)  {
+    case Trial:
+        numData = numTrial;
+        break;
+    case Daq:
+        numData = numDaq;
+        break;
+    case Commit:
+        numData = 0;
+        break;
+    default:
+        opserr << "ExpTrafficLog::readRecord() - "
+            << "invalid record type " << int(type)
+            << " in file: " << fileName << endln;
+        return OF_ReturnType_failed;
+    }
+    if (fread(record, sizeof(double), 1+numData, theFile) != size_t(1+numData))  {
+        opserr << "ExpTrafficLog::readRecord() - "
+            << "truncated record in file: " << fileName << endln;
+        return OF_ReturnType_failed;
+    }
+    recType = type;
+    numRecords++;
+    
+    return OF_ReturnType_completed;
+}
+
+
+int ExpTrafficLog::getRecordType() const
+{
+    return recType;
+}
+
+
+double ExpTrafficLog::getStamp() const
+{
+    if (recType == None)
+        return 0.0;
+    
+    return record[0];
+}
+
+
+int ExpTrafficLog::getResponse(Vector* disp,
+    Vector* vel,
+    Vector* accel,
+    Vector* force,
+    Vector* time) const
+{
+    const ID *size;
+    if (recType == Trial)
+        size = &sizeTrial;
+    else if (recType == Daq)
+        size = &sizeDaq;
+    else
+        return OF_ReturnType_failed;
+    
+    Vector* resp[OF_Resp_All] = {disp, vel, accel, force, time};
+    const double *data = &record[1];
+    for (int i=0; i<OF_Resp_All; i++)  {
+        int n = (*size)(i);
+        if (resp[i] != 0 && n > 0)  {
+            if (resp[i]->Size() != n)  {
+                opserr << "ExpTrafficLog::getResponse() - "
+                    << "wrong size of response " << i
+                    << ": want " << n << ", got " << resp[i]->Size() << endln;
+                return OF_ReturnType_failed;
+            }
+            for (int j=0; j<n; j++)
+                (*resp[i])(j) = data[j];
+        }
+        data += n;
+    }
+    
+    return OF_ReturnType_completed;
+}
+
+
+bool ExpTrafficLog::isOpen() const
+{
+    return theFile != 0;
+}
+
+
+int ExpTrafficLog::getSource() const
+{
+    return source;
+}
+
+
+const ID& ExpTrafficLog::getSizeTrial() const
+{
+    return sizeTrial;
+}
+
+
+const ID& ExpTrafficLog::getSizeDaq() const
+{
+    return sizeDaq;
+}
+
+
+int ExpTrafficLog::getNumRecords() const
+{
+    return numRecords;
+}
+
+
+const char* ExpTrafficLog::getFileName() const
+{
+    return fileName;
+}
+
+
+int ExpTrafficLog::writeRecord(char type, const ID &size,
+    const Vector* disp,
+    const Vector* vel,
+    const Vector* accel,
+    const Vector* force,
+    const Vector* time)
+{
+    if (readMode == true || theFile == 0)
+        return OF_ReturnType_failed;
+    
+    // time stamp in seconds since the log was opened
+    std::chrono::duration<double> stamp =
+        std::chrono::steady_clock::now() - startTime;
+    record[0] = stamp.count();
+    
+    // gather the data, missing responses are written as zeros
+    const Vector* resp[OF_Resp_All] = {disp, vel, accel, force, time};
+    int numData = 0;
+    for (int i=0; i<size.Size(); i++)  {
+        int n = size(i);
+        if (resp[i] != 0 && resp[i]->Size() == n)  {
+            for (int j=0; j<n; j++)
+                record[1+numData+j] = (*resp[i])(j);
+        } else  {
+            for (int j=0; j<n; j++)
+                record[1+numData+j] = 0.0;
+        }
+        numData += n;
+    }
+    
+    if (fwrite(&type, sizeof(char), 1, theFile) != 1 ||
+        fwrite(record, sizeof(double), 1+numData, theFile) != size_t(1+numData))  {
+        opserr << "ExpTrafficLog::writeRecord() - "
+            << "failed to write record to file: " << fileName << endln;
+        return OF_ReturnType_failed;
+    }
+    numRecords++;
+    
+    return OF_ReturnType_completed;
+}
@@ -0,0 +1,134 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef ExpTrafficLog_h
+#define ExpTrafficLog_h
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the class definition for
+// ExpTrafficLog. An ExpTrafficLog captures the trial commands and
+// daq responses exchanged with an experimental site or control in a
+// compact binary file, together with the time stamps at which they
+// were exchanged, or reads such a file back for replay.
+//
+// File layout (native byte order):
+//   header:  char magic[4] = "OFTL", int version, int source,
+//            int sizeTrial[5], int sizeDaq[5], double startTime
+//   records: char type, double stamp, double data[n]
+// where stamp is the time in seconds since the log was opened and
+// data holds the disp, vel, accel, force and time values of the
+// record in that order (n = sum of sizeTrial for trial records,
+// n = sum of sizeDaq for daq records and n = 0 for commit records).
+
+#include <FrescoGlobals.h>
+
+#include <ID.h>
+#include <Vector.h>
+
+#include <stdio.h>
+#include <chrono>
+
+class ExpTrafficLog
+{
+public:
+    // source of the captured traffic
+    enum Source  {
+        Site = 1,
+        Control = 2
+    };
+    
+    // types of records
+    enum RecordType  {
+        None = 0,
+        Trial = 1,
+        Daq = 2,
+        Commit = 3
+    };
+    
+    // constructor
+    ExpTrafficLog(const char *fileName, bool readMode = false);
+    
+    // destructor
+    ~ExpTrafficLog();
+    
+    // methods to capture the traffic
+    int open(int source, const ID &sizeT, const ID &sizeD);
+    int writeTrial(const Vector* disp,
+        const Vector* vel,
+        const Vector* accel,
+        const Vector* force,
+        const Vector* time);
+    int writeDaq(const Vector* disp,
+        const Vector* vel,
+        const Vector* accel,
+        const Vector* force,
+        const Vector* time);
+    int writeCommit();
+    
+    // methods to read the traffic back
+    int readRecord();
+    int getRecordType() const;
+    double getStamp() const;
+    int getResponse(Vector* disp,
+        Vector* vel,
+        Vector* accel,
+        Vector* force,
+        Vector* time) const;
+    
+    // methods to query the log
+    bool isOpen() const;
+    int getSource() const;
+    const ID &getSizeTrial() const;
+    const ID &getSizeDaq() const;
+    int getNumRecords() const;
+    const char *getFileName() const;
+    
+private:
+    int writeRecord(char type, const ID &size,
+        const Vector* disp,
+        const Vector* vel,
+        const Vector* accel,
+        const Vector* force,
+        const Vector* time);
+    
+    char *fileName;
+    bool readMode;
+    FILE *theFile;
+    
+    int source;
+    ID sizeTrial;
+    ID sizeDaq;
+    
+    // record buffer holding the stamp followed by the data
+    double *record;
+    int numTrial, numDaq;
+    
+    // current record in read mode
+    int recType;
+    int numRecords;
+    
+    std::chrono::steady_clock::time_point startTime;
+};
+
+#endif
@@ -32,6 +32,20 @@
 #include <elementAPI.h>
 
 
+// returns a view into the aggregated vector for the response of
+// type rType of a setup, or 0 if the setup does not use it
+static Vector *getView(Vector *all, const ID &size, int rType, int *id)
+{
+    if (size(rType) == 0 || all == 0)
+        return 0;
+    
+    Vector *theView = new Vector(&(*all)(id[rType]), size(rType));
+    id[rType] += size(rType);
+    
+    return theView;
+}
+
+
 void* OPF_ESAggregator()
 {
     // pointer to experimental setup that will be returned
@@ -241,92 +255,7 @@ ESAggregator::ESAggregator(int tag, int nSetups,
     this->setup();
     
     // finally initialize all the vectors
-    for (int i=0; i<numSetups; i++)  {
-        // trial vectors
-        tDispAll[i] = 0;
-        if (sizeTrialAll[i](OF_Resp_Disp) != 0)  {
-            tDispAll[i] = new Vector(sizeTrialAll[i](OF_Resp_Disp));
-        }
-        tVelAll[i] = 0;
-        if (sizeTrialAll[i](OF_Resp_Vel) != 0)  {
-            tVelAll[i] = new Vector(sizeTrialAll[i](OF_Resp_Vel));
-        }
-        tAccelAll[i] = 0;
-        if (sizeTrialAll[i](OF_Resp_Accel) != 0)  {
-            tAccelAll[i] = new Vector(sizeTrialAll[i](OF_Resp_Accel));
-        }
-        tForceAll[i] = 0;
-        if (sizeTrialAll[i](OF_Resp_Force) != 0)  {
-            tForceAll[i] = new Vector(sizeTrialAll[i](OF_Resp_Force));
-        }
-        tTimeAll[i] = 0;
-        if (sizeTrialAll[i](OF_Resp_Time) != 0)  {
-            tTimeAll[i] = new Vector(sizeTrialAll[i](OF_Resp_Time));
-        }
-        // output vectors
-        oDispAll[i] = 0;
-        if (sizeOutAll[i](OF_Resp_Disp) != 0)  {
-            oDispAll[i] = new Vector(sizeOutAll[i](OF_Resp_Disp));
-        }
-        oVelAll[i] = 0;
-        if (sizeOutAll[i](OF_Resp_Vel) != 0)  {
-            oVelAll[i] = new Vector(sizeOutAll[i](OF_Resp_Vel));
-        }
-        oAccelAll[i] = 0;
-        if (sizeOutAll[i](OF_Resp_Accel) != 0)  {
-            oAccelAll[i] = new Vector(sizeOutAll[i](OF_Resp_Accel));
-        }
-        oForceAll[i] = 0;
-        if (sizeOutAll[i](OF_Resp_Force) != 0)  {
-            oForceAll[i] = new Vector(sizeOutAll[i](OF_Resp_Force));
-        }
-        oTimeAll[i] = 0;
-        if (sizeOutAll[i](OF_Resp_Time) != 0)  {
-            oTimeAll[i] = new Vector(sizeOutAll[i](OF_Resp_Time));
-        }
-        // control vectors
-        cDispAll[i] = 0;
-        if (sizeCtrlAll[i](OF_Resp_Disp) != 0)  {
-            cDispAll[i] = new Vector(sizeCtrlAll[i](OF_Resp_Disp));
-        }
-        cVelAll[i] = 0;
-        if (sizeCtrlAll[i](OF_Resp_Vel) != 0)  {
-            cVelAll[i] = new Vector(sizeCtrlAll[i](OF_Resp_Vel));
-        }
-        cAccelAll[i] = 0;
-        if (sizeCtrlAll[i](OF_Resp_Accel) != 0)  {
-            cAccelAll[i] = new Vector(sizeCtrlAll[i](OF_Resp_Accel));
-        }
-        cForceAll[i] = 0;
-        if (sizeCtrlAll[i](OF_Resp_Force) != 0)  {
-            cForceAll[i] = new Vector(sizeCtrlAll[i](OF_Resp_Force));
-        }
-        cTimeAll[i] = 0;
-        if (sizeCtrlAll[i](OF_Resp_Time) != 0)  {
-            cTimeAll[i] = new Vector(sizeCtrlAll[i](OF_Resp_Time));
-        }
-        // data acquisition vectors
-        dDispAll[i] = 0;
-        if (sizeDaqAll[i](OF_Resp_Disp) != 0)  {
-            dDispAll[i] = new Vector(sizeDaqAll[i](OF_Resp_Disp));
-        }
-        dVelAll[i] = 0;
-        if (sizeDaqAll[i](OF_Resp_Vel) != 0)  {
-            dVelAll[i] = new Vector(sizeDaqAll[i](OF_Resp_Vel));
-        }
-        dAccelAll[i] = 0;
-        if (sizeDaqAll[i](OF_Resp_Accel) != 0)  {
-            dAccelAll[i] = new Vector(sizeDaqAll[i](OF_Resp_Accel));
-        }
-        dForceAll[i] = 0;
-        if (sizeDaqAll[i](OF_Resp_Force) != 0)  {
-            dForceAll[i] = new Vector(sizeDaqAll[i](OF_Resp_Force));
-        }
-        dTimeAll[i] = 0;
-        if (sizeDaqAll[i](OF_Resp_Time) != 0)  {
-            dTimeAll[i] = new Vector(sizeDaqAll[i](OF_Resp_Time));
-        }
-    }
+    this->setVectors();
 }
 
 
@@ -424,92 +353,7 @@ ESAggregator::ESAggregator(const ESAggregator& es)
     this->setup();
     
     // finally initialize all the vectors
-    for (int i=0; i<numSetups; i++)  {
-        // trial vectors
-        tDispAll[i] = 0;
-        if (sizeTrialAll[i](OF_Resp_Disp) != 0)  {
-            tDispAll[i] = new Vector(sizeTrialAll[i](OF_Resp_Disp));
-        }
-        tVelAll[i] = 0;
-        if (sizeTrialAll[i](OF_Resp_Vel) != 0)  {
-            tVelAll[i] = new Vector(sizeTrialAll[i](OF_Resp_Vel));
-        }
-        tAccelAll[i] = 0;
-        if (sizeTrialAll[i](OF_Resp_Accel) != 0)  {
-            tAccelAll[i] = new Vector(sizeTrialAll[i](OF_Resp_Accel));
-        }
-        tForceAll[i] = 0;
-        if (sizeTrialAll[i](OF_Resp_Force) != 0)  {
-            tForceAll[i] = new Vector(sizeTrialAll[i](OF_Resp_Force));
-        }
-        tTimeAll[i] = 0;
-        if (sizeTrialAll[i](OF_Resp_Time) != 0)  {
-            tTimeAll[i] = new Vector(sizeTrialAll[i](OF_Resp_Time));
-        }
-        // output vectors
-        oDispAll[i] = 0;
-        if (sizeOutAll[i](OF_Resp_Disp) != 0)  {
-            oDispAll[i] = new Vector(sizeOutAll[i](OF_Resp_Disp));
-        }
-        oVelAll[i] = 0;
-        if (sizeOutAll[i](OF_Resp_Vel) != 0)  {
-            oVelAll[i] = new Vector(sizeOutAll[i](OF_Resp_Vel));
-        }
-        oAccelAll[i] = 0;
-        if (sizeOutAll[i](OF_Resp_Accel) != 0)  {
-            oAccelAll[i] = new Vector(sizeOutAll[i](OF_Resp_Accel));
-        }
-        oForceAll[i] = 0;
-        if (sizeOutAll[i](OF_Resp_Force) != 0)  {
-            oForceAll[i] = new Vector(sizeOutAll[i](OF_Resp_Force));
-        }
-        oTimeAll[i] = 0;
-        if (sizeOutAll[i](OF_Resp_Time) != 0)  {
-            oTimeAll[i] = new Vector(sizeOutAll[i](OF_Resp_Time));
-        }
-        // control vectors
-        cDispAll[i] = 0;
-        if (sizeCtrlAll[i](OF_Resp_Disp) != 0)  {
-            cDispAll[i] = new Vector(sizeCtrlAll[i](OF_Resp_Disp));
-        }
-        cVelAll[i] = 0;
-        if (sizeCtrlAll[i](OF_Resp_Vel) != 0)  {
-            cVelAll[i] = new Vector(sizeCtrlAll[i](OF_Resp_Vel));
-        }
-        cAccelAll[i] = 0;
-        if (sizeCtrlAll[i](OF_Resp_Accel) != 0)  {
-            cAccelAll[i] = new Vector(sizeCtrlAll[i](OF_Resp_Accel));
-        }
-        cForceAll[i] = 0;
-        if (sizeCtrlAll[i](OF_Resp_Force) != 0)  {
-            cForceAll[i] = new Vector(sizeCtrlAll[i](OF_Resp_Force));
-        }
-        cTimeAll[i] = 0;
-        if (sizeCtrlAll[i](OF_Resp_Time) != 0)  {
-            cTimeAll[i] = new Vector(sizeCtrlAll[i](OF_Resp_Time));
-        }
-        // data acquisition vectors
-        dDispAll[i] = 0;
-        if (sizeDaqAll[i](OF_Resp_Disp) != 0)  {
-            dDispAll[i] = new Vector(sizeDaqAll[i](OF_Resp_Disp));
-        }
-        dVelAll[i] = 0;
-        if (sizeDaqAll[i](OF_Resp_Vel) != 0)  {
-            dVelAll[i] = new Vector(sizeDaqAll[i](OF_Resp_Vel));
-        }
-        dAccelAll[i] = 0;
-        if (sizeDaqAll[i](OF_Resp_Accel) != 0)  {
-            dAccelAll[i] = new Vector(sizeDaqAll[i](OF_Resp_Accel));
-        }
-        dForceAll[i] = 0;
-        if (sizeDaqAll[i](OF_Resp_Force) != 0)  {
-            dForceAll[i] = new Vector(sizeDaqAll[i](OF_Resp_Force));
-        }
-        dTimeAll[i] = 0;
-        if (sizeDaqAll[i](OF_Resp_Time) != 0)  {
-            dTimeAll[i] = new Vector(sizeDaqAll[i](OF_Resp_Time));
-        }
-    }
+    this->setVectors();
 }
 
 
@@ -707,28 +551,22 @@ int ESAggregator::transfTrialResponse(const Vector* disp,
     const Vector* time)
 {
     int rValue = 0;
-    int tDispID = 0, tVelID = 0, tAccelID = 0, tForceID = 0;
-    int cDispID = 0, cVelID = 0, cAccelID = 0, cForceID = 0;
     
     if (disp != 0)  {
         for (int i=0; i<(*sizeTrial)(OF_Resp_Disp); i++)
             (*tDisp)(i) = (*disp)(i) * (*tDispFact)(i);
-        cDisp->Zero();
     }
     if (vel != 0)  {
         for (int i=0; i<(*sizeTrial)(OF_Resp_Vel); i++)
             (*tVel)(i) = (*vel)(i) * (*tVelFact)(i);
-        cVel->Zero();
     }
     if (accel != 0)  {
         for (int i=0; i<(*sizeTrial)(OF_Resp_Accel); i++)
             (*tAccel)(i) = (*accel)(i) * (*tAccelFact)(i);
-        cAccel->Zero();
     }
     if (force != 0)  {
         for (int i=0; i<(*sizeTrial)(OF_Resp_Force); i++)
             (*tForce)(i) = (*force)(i) * (*tForceFact)(i);
-        cForce->Zero();
     }
     if (time != 0)  {
         for (int i=0; i<(*sizeTrial)(OF_Resp_Time); i++)
@@ -737,23 +575,8 @@ int ESAggregator::transfTrialResponse(const Vector* disp,
     }
     
     for (int i=0; i<numSetups; i++)  {
-        // extract trial response from aggregated setup
-        if (disp != 0 && sizeTrialAll[i](OF_Resp_Disp) != 0)  {
-            tDispAll[i]->Extract(*tDisp,tDispID);
-            tDispID += sizeTrialAll[i](OF_Resp_Disp);
-        }
-        if (vel != 0 && sizeTrialAll[i](OF_Resp_Vel) != 0)  {
-            tVelAll[i]->Extract(*tVel,tVelID);
-            tVelID += sizeTrialAll[i](OF_Resp_Vel);
-        }
-        if (accel != 0 && sizeTrialAll[i](OF_Resp_Accel) != 0)  {
-            tAccelAll[i]->Extract(*tAccel,tAccelID);
-            tAccelID += sizeTrialAll[i](OF_Resp_Accel);
-        }
-        if (force != 0 && sizeTrialAll[i](OF_Resp_Force) != 0)  {
-            tForceAll[i]->Extract(*tForce,tForceID);
-            tForceID += sizeTrialAll[i](OF_Resp_Force);
-        }
+        // the trial response of the setup is a view into the
+        // aggregated one, only the time needs to be copied
         if (time != 0 && sizeTrialAll[i](OF_Resp_Time) != 0)  {
             *tTimeAll[i] = *tTime;
         }
@@ -778,23 +601,7 @@ int ESAggregator::transfTrialResponse(const Vector* disp,
             return OF_ReturnType_failed;
         }
         
-        // assemble control response of aggregated setup
-        if (disp != 0 && sizeCtrlAll[i](OF_Resp_Disp) != 0)  {
-            cDisp->Assemble(*cDispAll[i], cDispID);
-            cDispID += sizeCtrlAll[i](OF_Resp_Disp);
-        }
-        if (vel != 0 && sizeCtrlAll[i](OF_Resp_Vel) != 0)  {
-            cVel->Assemble(*cVelAll[i], cVelID);
-            cVelID += sizeCtrlAll[i](OF_Resp_Vel);
-        }
-        if (accel != 0 && sizeCtrlAll[i](OF_Resp_Accel) != 0)  {
-            cAccel->Assemble(*cAccelAll[i], cAccelID);
-            cAccelID += sizeCtrlAll[i](OF_Resp_Accel);
-        }
-        if (force != 0 && sizeCtrlAll[i](OF_Resp_Force) != 0)  {
-            cForce->Assemble(*cForceAll[i], cForceID);
-            cForceID += sizeCtrlAll[i](OF_Resp_Force);
-        }
+        // the control response was written in place
         if (time != 0 && sizeCtrlAll[i](OF_Resp_Time) != 0)  {
             *cTime = *cTimeAll[i];
         }
@@ -832,28 +639,22 @@ int ESAggregator::transfDaqResponse(Vector* disp,
     Vector* time)
 {
     int rValue = 0;
-    int dDispID = 0, dVelID = 0, dAccelID = 0, dForceID = 0;
-    int oDispID = 0, oVelID = 0, oAccelID = 0, oForceID = 0;
 
     if (disp != 0)  {
         for (int i=0; i<(*sizeDaq)(OF_Resp_Disp); i++)
             (*dDisp)(i) *= (*dDispFact)(i);
-        oDisp->Zero();
     }
     if (vel != 0)  {
         for (int i=0; i<(*sizeDaq)(OF_Resp_Vel); i++)
             (*dVel)(i) *= (*dVelFact)(i);
-        oVel->Zero();
     }
     if (accel != 0)  {
         for (int i=0; i<(*sizeDaq)(OF_Resp_Accel); i++)
             (*dAccel)(i) *= (*dAccelFact)(i);
-        oAccel->Zero();
     }
     if (force != 0)  {
         for (int i=0; i<(*sizeDaq)(OF_Resp_Force); i++)
             (*dForce)(i) *= (*dForceFact)(i);
-        oForce->Zero();
     }
     if (time != 0)  {
         for (int i=0; i<(*sizeDaq)(OF_Resp_Time); i++)
@@ -862,23 +663,8 @@ int ESAggregator::transfDaqResponse(Vector* disp,
     }
 
     for (int i=0; i<numSetups; i++)  {
-        // extract daq response from aggregated setup
-        if (disp != 0 && sizeDaqAll[i](OF_Resp_Disp) != 0)  {
-            dDispAll[i]->Extract(*dDisp,dDispID);
-            dDispID += sizeDaqAll[i](OF_Resp_Disp);
-        }
-        if (vel != 0 && sizeDaqAll[i](OF_Resp_Vel) != 0)  {
-            dVelAll[i]->Extract(*dVel,dVelID);
-            dVelID += sizeDaqAll[i](OF_Resp_Vel);
-        }
-        if (accel != 0 && sizeDaqAll[i](OF_Resp_Accel) != 0)  {
-            dAccelAll[i]->Extract(*dAccel,dAccelID);
-            dAccelID += sizeDaqAll[i](OF_Resp_Accel);
-        }
-        if (force != 0 && sizeDaqAll[i](OF_Resp_Force) != 0)  {
-            dForceAll[i]->Extract(*dForce,dForceID);
-            dForceID += sizeDaqAll[i](OF_Resp_Force);
-        }
+        // the daq response of the setup is a view into the
+        // aggregated one, only the time needs to be copied
         if (time != 0 && sizeDaqAll[i](OF_Resp_Time) != 0)  {
             *dTimeAll[i] = *dTime;
         }
@@ -903,23 +689,7 @@ int ESAggregator::transfDaqResponse(Vector* disp,
             return OF_ReturnType_failed;
         }
 
-        // assemble output response of aggregated setup
-        if (disp != 0 && sizeOutAll[i](OF_Resp_Disp) != 0) {
-            oDisp->Assemble(*oDispAll[i], oDispID);
-            oDispID += sizeOutAll[i](OF_Resp_Disp);
-        }
-        if (vel != 0 && sizeOutAll[i](OF_Resp_Vel) != 0) {
-            oVel->Assemble(*oVelAll[i], oVelID);
-            oVelID += sizeOutAll[i](OF_Resp_Vel);
-        }
-        if (accel != 0 && sizeOutAll[i](OF_Resp_Accel) != 0) {
-            oAccel->Assemble(*oAccelAll[i], oAccelID);
-            oAccelID += sizeOutAll[i](OF_Resp_Accel);
-        }
-        if (force != 0 && sizeOutAll[i](OF_Resp_Force) != 0) {
-            oForce->Assemble(*oForceAll[i], oForceID);
-            oForceID += sizeOutAll[i](OF_Resp_Force);
-        }
+        // the output response was written in place
         if (time != 0 && sizeOutAll[i](OF_Resp_Time) != 0) {
             *oTime = *oTimeAll[i];
         }
@@ -965,6 +735,64 @@ int ESAggregator::commitState()
 }
 
 
+bool ESAggregator::usesGlobalDomain()
+{
+    for (int i=0; i<numSetups; i++)
+        if (theSetups[i]->usesGlobalDomain())
+            return true;
+    
+    return this->ExperimentalSetup::usesGlobalDomain();
+}
+
+
+void ESAggregator::setVectors()
+{
+    // the disp, vel, accel and force vectors of the individual setups
+    // are views into the vectors of the aggregated setup, so that the
+    // responses are transformed in place without extracting them
+    int tID[OF_Resp_Time] = {0}, oID[OF_Resp_Time] = {0};
+    int cID[OF_Resp_Time] = {0}, dID[OF_Resp_Time] = {0};
+    for (int i=0; i<numSetups; i++)  {
+        // trial vectors
+        tDispAll[i] = getView(tDisp, sizeTrialAll[i], OF_Resp_Disp, tID);
+        tVelAll[i] = getView(tVel, sizeTrialAll[i], OF_Resp_Vel, tID);
+        tAccelAll[i] = getView(tAccel, sizeTrialAll[i], OF_Resp_Accel, tID);
+        tForceAll[i] = getView(tForce, sizeTrialAll[i], OF_Resp_Force, tID);
+        tTimeAll[i] = 0;
+        if (sizeTrialAll[i](OF_Resp_Time) != 0)  {
+            tTimeAll[i] = new Vector(sizeTrialAll[i](OF_Resp_Time));
+        }
+        // output vectors
+        oDispAll[i] = getView(oDisp, sizeOutAll[i], OF_Resp_Disp, oID);
+        oVelAll[i] = getView(oVel, sizeOutAll[i], OF_Resp_Vel, oID);
+        oAccelAll[i] = getView(oAccel, sizeOutAll[i], OF_Resp_Accel, oID);
+        oForceAll[i] = getView(oForce, sizeOutAll[i], OF_Resp_Force, oID);
+        oTimeAll[i] = 0;
+        if (sizeOutAll[i](OF_Resp_Time) != 0)  {
+            oTimeAll[i] = new Vector(sizeOutAll[i](OF_Resp_Time));
+        }
+        // control vectors
+        cDispAll[i] = getView(cDisp, sizeCtrlAll[i], OF_Resp_Disp, cID);
+        cVelAll[i] = getView(cVel, sizeCtrlAll[i], OF_Resp_Vel, cID);
+        cAccelAll[i] = getView(cAccel, sizeCtrlAll[i], OF_Resp_Accel, cID);
+        cForceAll[i] = getView(cForce, sizeCtrlAll[i], OF_Resp_Force, cID);
+        cTimeAll[i] = 0;
+        if (sizeCtrlAll[i](OF_Resp_Time) != 0)  {
+            cTimeAll[i] = new Vector(sizeCtrlAll[i](OF_Resp_Time));
+        }
+        // data acquisition vectors
+        dDispAll[i] = getView(dDisp, sizeDaqAll[i], OF_Resp_Disp, dID);
+        dVelAll[i] = getView(dVel, sizeDaqAll[i], OF_Resp_Vel, dID);
+        dAccelAll[i] = getView(dAccel, sizeDaqAll[i], OF_Resp_Accel, dID);
+        dForceAll[i] = getView(dForce, sizeDaqAll[i], OF_Resp_Force, dID);
+        dTimeAll[i] = 0;
+        if (sizeDaqAll[i](OF_Resp_Time) != 0)  {
+            dTimeAll[i] = new Vector(sizeDaqAll[i](OF_Resp_Time));
+        }
+    }
+}
+
+
 ExperimentalSetup* ESAggregator::getCopy()
 {
 	ESAggregator *theCopy = new ESAggregator(*this);
@@ -61,6 +61,7 @@ public:
         Vector* time);
     
     virtual int commitState();
+    virtual bool usesGlobalDomain();
     
     virtual ExperimentalSetup *getCopy();
     
@@ -117,6 +118,8 @@ private:
     Vector **dAccelAll;
     Vector **dForceAll;
     Vector **dTimeAll;    
+    
+    void setVectors();
 };
 
 #endif
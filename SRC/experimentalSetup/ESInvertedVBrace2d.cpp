@@ -304,7 +304,7 @@ void ESInvertedVBrace2d::Print(OPS_Stream &s, int flag)
 int ESInvertedVBrace2d::transfTrialDisp(const Vector* disp)
 {  
     // rotate direction
-    static Vector d(3);
+    Vector d(3);
     d = rotLocX*(*disp);
 
     // linear geometry, horizontal actuator left
@@ -358,7 +358,7 @@ int ESInvertedVBrace2d::transfTrialVel(const Vector* disp,
     const Vector* vel)
 {  
     // rotate direction
-    static Vector d(3), v(3);
+    Vector d(3), v(3);
     d = rotLocX*(*disp);
     v = rotLocX*(*vel);
 
@@ -414,7 +414,7 @@ int ESInvertedVBrace2d::transfTrialAccel(const Vector* disp,
     const Vector* accel)
 {  
     // rotate direction
-    static Vector d(3), v(3), a(3);
+    Vector d(3), v(3), a(3);
     d = rotLocX*(*disp);
     v = rotLocX*(*vel);
     a = rotLocX*(*accel);
@@ -463,7 +463,7 @@ int ESInvertedVBrace2d::transfTrialAccel(const Vector* disp,
 int ESInvertedVBrace2d::transfTrialForce(const Vector* force)
 {  
     // rotate direction
-    static Vector f(3);
+    Vector f(3);
     f = rotLocX*(*force);
 
     // linear geometry, horizontal actuator left
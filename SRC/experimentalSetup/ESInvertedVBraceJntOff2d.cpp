@@ -313,7 +313,7 @@ void ESInvertedVBraceJntOff2d::Print(OPS_Stream &s, int flag)
 int ESInvertedVBraceJntOff2d::transfTrialDisp(const Vector* disp)
 {  
     // rotate direction
-    static Vector d(3);
+    Vector d(3);
     d = rotLocX*(*disp);
 
     // linear geometry, horizontal actuator left
@@ -377,7 +377,7 @@ int ESInvertedVBraceJntOff2d::transfTrialVel(const Vector* disp,
     const Vector* vel)
 {  
     // rotate direction
-    static Vector d(3), v(3);
+    Vector d(3), v(3);
     d = rotLocX*(*disp);
     v = rotLocX*(*vel);
 
@@ -443,7 +443,7 @@ int ESInvertedVBraceJntOff2d::transfTrialAccel(const Vector* disp,
     const Vector* accel)
 {  
     // rotate direction
-    static Vector d(3), v(3), a(3);
+    Vector d(3), v(3), a(3);
     d = rotLocX*(*disp);
     v = rotLocX*(*vel);
     a = rotLocX*(*accel);
@@ -502,7 +502,7 @@ int ESInvertedVBraceJntOff2d::transfTrialAccel(const Vector* disp,
 int ESInvertedVBraceJntOff2d::transfTrialForce(const Vector* force)
 {  
     // rotate direction
-    static Vector f(3);
+    Vector f(3);
     f = rotLocX*(*force);
 
     // linear geometry, horizontal actuator left
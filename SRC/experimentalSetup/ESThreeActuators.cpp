@@ -338,7 +338,7 @@ void ESThreeActuators::Print(OPS_Stream &s, int flag)
 int ESThreeActuators::transfTrialDisp(const Vector* disp)
 {
     // extract directions
-    static Vector d(numDOF);
+    Vector d(numDOF);
     for (int i=0; i<numDOF; i++)  {
         d(i) = (*disp)(DOF(i));
     }
@@ -394,7 +394,7 @@ int ESThreeActuators::transfTrialVel(const Vector* disp,
     const Vector* vel)
 {
     // extract directions
-    static Vector d(numDOF), v(numDOF);
+    Vector d(numDOF), v(numDOF);
     for (int i=0; i<numDOF; i++)  {
         d(i) = (*disp)(DOF(i));
         v(i) = (*vel)(DOF(i));
@@ -452,7 +452,7 @@ int ESThreeActuators::transfTrialAccel(const Vector* disp,
     const Vector* accel)
 {
     // extract directions
-    static Vector d(numDOF), v(numDOF), a(numDOF);
+    Vector d(numDOF), v(numDOF), a(numDOF);
     for (int i=0; i<numDOF; i++)  {
         d(i) = (*disp)(DOF(i));
         v(i) = (*vel)(DOF(i));
@@ -503,7 +503,7 @@ int ESThreeActuators::transfTrialAccel(const Vector* disp,
 int ESThreeActuators::transfTrialForce(const Vector* force)
 {
     // extract directions
-    static Vector f(numDOF);
+    Vector f(numDOF);
     for (int i=0; i<numDOF; i++)  {
         f(i) = (*force)(DOF(i));
     }
@@ -571,7 +571,7 @@ int ESThreeActuators::transfTrialTime(const Vector* time)
 
 int ESThreeActuators::transfDaqDisp(Vector* disp)
 {
-    static Vector d(numDOF);
+    Vector d(numDOF);
     
     // linear geometry, horizontal actuator left
     if (nlGeom == 0 && strcmp(posAct0,"left") == 0)  {
@@ -679,7 +679,7 @@ int ESThreeActuators::transfDaqDisp(Vector* disp)
 
 int ESThreeActuators::transfDaqVel(Vector* vel)
 {
-    static Vector v(numDOF);
+    Vector v(numDOF);
     
     // linear geometry, horizontal actuator left
     if (nlGeom == 0 && strcmp(posAct0,"left") == 0)  {
@@ -729,7 +729,7 @@ int ESThreeActuators::transfDaqVel(Vector* vel)
 
 int ESThreeActuators::transfDaqAccel(Vector* accel)
 {
-    static Vector a(numDOF);
+    Vector a(numDOF);
     
     // linear geometry, horizontal actuator left
     if (nlGeom == 0 && strcmp(posAct0,"left") == 0)  {
@@ -779,7 +779,7 @@ int ESThreeActuators::transfDaqAccel(Vector* accel)
 
 int ESThreeActuators::transfDaqForce(Vector* force)
 {
-    static Vector f(numDOF);
+    Vector f(numDOF);
     
     // linear geometry, horizontal actuator left
     if (nlGeom == 0 && strcmp(posAct0,"left") == 0)  {
@@ -832,7 +832,7 @@ int ESThreeActuators::transfDaqForce(Vector* force)
         
         double disp2 = atan2(d2*cos(theta(1))-d1*cos(theta(0))+La1-La2,d2*sin(theta(1))-d1*sin(theta(0))+L0+L1);
         
-        static Vector fx(3), fy(3);
+        Vector fx(3), fy(3);
         fx(0) = (*dForce)(0)*(d1*sin(theta(0))+La0)/d0;
         fx(1) = (*dForce)(1)*sin(theta(0));
         fx(2) = (*dForce)(2)*sin(theta(1));
@@ -884,7 +884,7 @@ int ESThreeActuators::transfDaqForce(Vector* force)
         
         double disp2 = atan2(d2*cos(theta(1))-d1*cos(theta(0))+La1-La2,-d2*sin(theta(1))+d1*sin(theta(0))+L0+L1);
         
-        static Vector fx(3), fy(3);
+        Vector fx(3), fy(3);
         fx(0) = (*dForce)(0)*(d2*sin(theta(1))+La0)/d0;
         fx(1) = (*dForce)(1)*sin(theta(0));
         fx(2) = (*dForce)(2)*sin(theta(1));
@@ -300,7 +300,7 @@ void ESThreeActuators2d::Print(OPS_Stream &s, int flag)
 int ESThreeActuators2d::transfTrialDisp(const Vector* disp)
 {
     // rotate direction
-    static Vector d(3);
+    Vector d(3);
     d = rotLocX*(*disp);
 
     // linear geometry, horizontal actuator left
@@ -354,7 +354,7 @@ int ESThreeActuators2d::transfTrialVel(const Vector* disp,
     const Vector* vel)
 {  
     // rotate direction
-    static Vector d(3), v(3);
+    Vector d(3), v(3);
     d = rotLocX*(*disp);
     v = rotLocX*(*vel);
 
@@ -410,7 +410,7 @@ int ESThreeActuators2d::transfTrialAccel(const Vector* disp,
     const Vector* accel)
 {  
     // rotate direction
-    static Vector d(3), v(3), a(3);
+    Vector d(3), v(3), a(3);
     d = rotLocX*(*disp);
     v = rotLocX*(*vel);
     a = rotLocX*(*accel);
@@ -459,7 +459,7 @@ int ESThreeActuators2d::transfTrialAccel(const Vector* disp,
 int ESThreeActuators2d::transfTrialForce(const Vector* force)
 {  
     // rotate direction
-    static Vector f(3);
+    Vector f(3);
     f = rotLocX*(*force);
 
     // linear geometry, horizontal actuator left
@@ -778,7 +778,7 @@ int ESThreeActuators2d::transfDaqForce(Vector* force)
 
         double disp2 = atan2(d2*cos(theta(1))+La1-La2-d1*cos(theta(0)),d2*sin(theta(1))+L0+L1-d1*sin(theta(0)));
 
-        static Vector fx(3), fy(3);
+        Vector fx(3), fy(3);
         fx(0) = (*dForce)(0)*(d1*sin(theta(0))+La0)/d0;
         fx(1) = (*dForce)(1)*sin(theta(0));
         fx(2) = (*dForce)(2)*sin(theta(1));
@@ -829,7 +829,7 @@ int ESThreeActuators2d::transfDaqForce(Vector* force)
 
         double disp2 = atan2(d2*cos(theta(1))+La1-La2-d1*cos(theta(0)),-d2*sin(theta(1))+L0+L1+d1*sin(theta(0)));
 
-        static Vector fx(3), fy(3);
+        Vector fx(3), fy(3);
         fx(0) = (*dForce)(0)*(d2*sin(theta(1))+La0)/d0;
         fx(1) = (*dForce)(1)*sin(theta(0));
         fx(2) = (*dForce)(2)*sin(theta(1));
@@ -350,7 +350,7 @@ void ESThreeActuatorsJntOff::Print(OPS_Stream &s, int flag)
 int ESThreeActuatorsJntOff::transfTrialDisp(const Vector* disp)
 {
     // extract directions
-    static Vector d(numDOF);
+    Vector d(numDOF);
     for (int i=0; i<numDOF; i++)  {
         d(i) = (*disp)(DOF(i));
     }
@@ -406,7 +406,7 @@ int ESThreeActuatorsJntOff::transfTrialVel(const Vector* disp,
     const Vector* vel)
 {
     // extract directions
-    static Vector d(numDOF), v(numDOF);
+    Vector d(numDOF), v(numDOF);
     for (int i=0; i<numDOF; i++)  {
         d(i) = (*disp)(DOF(i));
         v(i) = (*vel)(DOF(i));
@@ -474,7 +474,7 @@ int ESThreeActuatorsJntOff::transfTrialAccel(const Vector* disp,
     const Vector* accel)
 {
     // extract directions
-    static Vector d(numDOF), v(numDOF), a(numDOF);
+    Vector d(numDOF), v(numDOF), a(numDOF);
     for (int i=0; i<numDOF; i++)  {
         d(i) = (*disp)(DOF(i));
         v(i) = (*vel)(DOF(i));
@@ -535,7 +535,7 @@ int ESThreeActuatorsJntOff::transfTrialAccel(const Vector* disp,
 int ESThreeActuatorsJntOff::transfTrialForce(const Vector* force)
 {
     // extract directions
-    static Vector f(numDOF);
+    Vector f(numDOF);
     for (int i=0; i<numDOF; i++)  {
         f(i) = (*force)(DOF(i));
     }
@@ -603,7 +603,7 @@ int ESThreeActuatorsJntOff::transfTrialTime(const Vector* time)
 
 int ESThreeActuatorsJntOff::transfDaqDisp(Vector* disp)
 {
-    static Vector d(numDOF);
+    Vector d(numDOF);
     
     // linear geometry, horizontal actuator left
     if (nlGeom == 0 && strcmp(posAct0, "left") == 0) {
@@ -729,7 +729,7 @@ int ESThreeActuatorsJntOff::transfDaqDisp(Vector* disp)
 
 int ESThreeActuatorsJntOff::transfDaqVel(Vector* vel)
 {
-    static Vector v(numDOF);
+    Vector v(numDOF);
     
     // linear geometry, horizontal actuator left
     if (nlGeom == 0 && strcmp(posAct0, "left") == 0) {
@@ -779,7 +779,7 @@ int ESThreeActuatorsJntOff::transfDaqVel(Vector* vel)
 
 int ESThreeActuatorsJntOff::transfDaqAccel(Vector* accel)
 {
-    static Vector a(numDOF);
+    Vector a(numDOF);
     
     // linear geometry, horizontal actuator left
     if (nlGeom == 0 && strcmp(posAct0, "left") == 0) {
@@ -829,7 +829,7 @@ int ESThreeActuatorsJntOff::transfDaqAccel(Vector* accel)
 
 int ESThreeActuatorsJntOff::transfDaqForce(Vector* force)
 {
-    static Vector f(numDOF);
+    Vector f(numDOF);
     
     // linear geometry, horizontal actuator left
     if (nlGeom == 0 && strcmp(posAct0, "left") == 0) {
@@ -893,7 +893,7 @@ int ESThreeActuatorsJntOff::transfDaqForce(Vector* force)
         double beta0 = atan2(L4, L1) + disp2;
         double beta1 = atan2(L6, L2) - disp2;
         
-        static Vector fx(3), fy(3);
+        Vector fx(3), fy(3);
         fx(0) = (*dForce)(0)*cos(theta(0));
         fx(1) = (*dForce)(1)*sin(theta(1));
         fx(2) = (*dForce)(2)*sin(theta(2));
@@ -955,7 +955,7 @@ int ESThreeActuatorsJntOff::transfDaqForce(Vector* force)
         double beta0 = atan2(L4, L1) + disp2;
         double beta1 = atan2(L6, L2) - disp2;
         
-        static Vector fx(3), fy(3);
+        Vector fx(3), fy(3);
         fx(0) = (*dForce)(0)*cos(theta(0));
         fx(1) = (*dForce)(1)*sin(theta(1));
         fx(2) = (*dForce)(2)*sin(theta(2));
@@ -309,7 +309,7 @@ void ESThreeActuatorsJntOff2d::Print(OPS_Stream &s, int flag)
 int ESThreeActuatorsJntOff2d::transfTrialDisp(const Vector* disp)
 {  
     // rotate direction
-    static Vector d(3);
+    Vector d(3);
     d = rotLocX*(*disp);
 
     // linear geometry, horizontal actuator left
@@ -373,7 +373,7 @@ int ESThreeActuatorsJntOff2d::transfTrialVel(const Vector* disp,
     const Vector* vel)
 {  
     // rotate direction
-    static Vector d(3), v(3);
+    Vector d(3), v(3);
     d = rotLocX*(*disp);
     v = rotLocX*(*vel);
 
@@ -439,7 +439,7 @@ int ESThreeActuatorsJntOff2d::transfTrialAccel(const Vector* disp,
     const Vector* accel)
 {  
     // rotate direction
-    static Vector d(3), v(3), a(3);
+    Vector d(3), v(3), a(3);
     d = rotLocX*(*disp);
     v = rotLocX*(*vel);
     a = rotLocX*(*accel);
@@ -498,7 +498,7 @@ int ESThreeActuatorsJntOff2d::transfTrialAccel(const Vector* disp,
 int ESThreeActuatorsJntOff2d::transfTrialForce(const Vector* force)
 {  
     // rotate direction
-    static Vector f(3);
+    Vector f(3);
     f = rotLocX*(*force);
 
     // linear geometry, horizontal actuator left
@@ -845,7 +845,7 @@ int ESThreeActuatorsJntOff2d::transfDaqForce(Vector* force)
         double beta0 = atan2(L4,L1) + disp2;
         double beta1 = atan2(L5,L2) - disp2;
 
-        static Vector fx(3), fy(3);
+        Vector fx(3), fy(3);
         fx(0) = (*dForce)(0)*cos(theta(0));
         fx(1) = (*dForce)(1)*sin(theta(1));
         fx(2) = (*dForce)(2)*sin(theta(2));
@@ -907,7 +907,7 @@ int ESThreeActuatorsJntOff2d::transfDaqForce(Vector* force)
         double beta0 = atan2(L4,L1) + disp2;
         double beta1 = atan2(L5,L2) - disp2;
 
-        static Vector fx(3), fy(3);
+        Vector fx(3), fy(3);
         fx(0) = (*dForce)(0)*cos(theta(0));
         fx(1) = (*dForce)(1)*sin(theta(1));
         fx(2) = (*dForce)(2)*sin(theta(2));
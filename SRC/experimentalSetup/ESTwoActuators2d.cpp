@@ -289,7 +289,7 @@ void ESTwoActuators2d::Print(OPS_Stream &s, int flag)
 int ESTwoActuators2d::transfTrialDisp(const Vector* disp)
 {  
     // rotate direction
-    static Vector d(3);
+    Vector d(3);
     d = rotLocX*(*disp);
 
     // linear geometry, actuators left
@@ -335,7 +335,7 @@ int ESTwoActuators2d::transfTrialVel(const Vector* disp,
     const Vector* vel)
 {  
     // rotate direction
-    static Vector d(3), v(3);
+    Vector d(3), v(3);
     d = rotLocX*(*disp);
     v = rotLocX*(*vel);
 
@@ -383,7 +383,7 @@ int ESTwoActuators2d::transfTrialAccel(const Vector* disp,
     const Vector* accel)
 {  
     // rotate direction
-    static Vector d(3), v(3), a(3);
+    Vector d(3), v(3), a(3);
     d = rotLocX*(*disp);
     v = rotLocX*(*vel);
     a = rotLocX*(*accel);
@@ -424,7 +424,7 @@ int ESTwoActuators2d::transfTrialAccel(const Vector* disp,
 int ESTwoActuators2d::transfTrialForce(const Vector* force)
 {  
     // rotate direction
-    static Vector f(3);
+    Vector f(3);
     f = rotLocX*(*force);
 
     // linear geometry, actuators left
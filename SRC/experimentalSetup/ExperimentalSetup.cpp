@@ -36,6 +36,56 @@
 static MapOfTaggedObjects theExperimentalSetups;
 
 
+// lays out the disp, vel, accel, force and time vectors of a group
+// one after the other in a new arena, followed by their factors
+static void setViews(Vector **resp[], Vector **fact[],
+    double *&arena, const ID &size)
+{
+    int i, j;
+    for (i=0; i<OF_Resp_All; i++)  {
+        if (*resp[i] != 0)  {
+            delete *resp[i];
+            *resp[i] = 0;
+        }
+        if (*fact[i] != 0)  {
+            delete *fact[i];
+            *fact[i] = 0;
+        }
+    }
+    if (arena != 0)  {
+        delete [] arena;
+        arena = 0;
+    }
+    
+    int numData = 0;
+    for (i=0; i<OF_Resp_All; i++)
+        numData += size(i);
+    if (numData == 0)
+        return;
+    
+    arena = new double [2*numData];
+    if (arena == 0)  {
+        opserr << "ExperimentalSetup::setViews() - "
+            << "failed to create arena.\n";
+        exit(OF_ReturnType_failed);
+    }
+    double *data = arena;
+    double *factor = &arena[numData];
+    for (i=0; i<OF_Resp_All; i++)  {
+        if (size(i) != 0)  {
+            for (j=0; j<size(i); j++)  {
+                data[j] = 0.0;
+                factor[j] = 1.0;
+            }
+            *resp[i] = new Vector(data, size(i));
+            *fact[i] = new Vector(factor, size(i));
+            data += size(i);
+            factor += size(i);
+        }
+    }
+}
+
+
 bool OPF_addExperimentalSetup(ExperimentalSetup* newComponent)
 {
     return theExperimentalSetups.addComponent(newComponent);
@@ -84,7 +134,8 @@ ExperimentalSetup::ExperimentalSetup(int tag,
     tDispFact(0), tVelFact(0), tAccelFact(0), tForceFact(0), tTimeFact(0),
     oDispFact(0), oVelFact(0), oAccelFact(0), oForceFact(0), oTimeFact(0),
     cDispFact(0), cVelFact(0), cAccelFact(0), cForceFact(0), cTimeFact(0),
-    dDispFact(0), dVelFact(0), dAccelFact(0), dForceFact(0), dTimeFact(0)
+    dDispFact(0), dVelFact(0), dAccelFact(0), dForceFact(0), dTimeFact(0),
+    tArena(0), oArena(0), cArena(0), dArena(0)
 {
     sizeTrial = new ID(OF_Resp_All);
     sizeOut = new ID(OF_Resp_All);
@@ -114,7 +165,8 @@ ExperimentalSetup::ExperimentalSetup(const ExperimentalSetup& es)
     tDispFact(0), tVelFact(0), tAccelFact(0), tForceFact(0), tTimeFact(0),
     oDispFact(0), oVelFact(0), oAccelFact(0), oForceFact(0), oTimeFact(0),
     cDispFact(0), cVelFact(0), cAccelFact(0), cForceFact(0), cTimeFact(0),
-    dDispFact(0), dVelFact(0), dAccelFact(0), dForceFact(0), dTimeFact(0)
+    dDispFact(0), dVelFact(0), dAccelFact(0), dForceFact(0), dTimeFact(0),
+    tArena(0), oArena(0), cArena(0), dArena(0)
 {
     if (es.theControl != 0)  {
         theControl = (es.theControl)->getCopy();
@@ -290,6 +342,15 @@ ExperimentalSetup::~ExperimentalSetup()
     if (dTimeFact != 0)
         delete dTimeFact;
     
+    if (tArena != 0)
+        delete [] tArena;
+    if (oArena != 0)
+        delete [] oArena;
+    if (cArena != 0)
+        delete [] cArena;
+    if (dArena != 0)
+        delete [] dArena;
+    
     if (sizeTrial != 0)
         delete sizeTrial;
     if (sizeOut != 0)
@@ -492,6 +553,7 @@ int ExperimentalSetup::setTrialResponse(const Vector* disp,
                 << "failed to set trial response at the control.\n";
             exit(OF_ReturnType_failed);
         }
+        theControl->logTrialResponse(cDisp, cVel, cAccel, cForce, cTime);
     }
     
     return OF_ReturnType_completed;
@@ -555,6 +617,7 @@ int ExperimentalSetup::getDaqResponse(Vector* disp,
                 << "failed to get daq response from the control.\n";
             exit(OF_ReturnType_failed);
         }
+        theControl->logDaqResponse(dDisp, dVel, dAccel, dForce, dTime);
     }
     
     // transform data
@@ -662,6 +725,7 @@ int ExperimentalSetup::commitState()
 {
     if (theControl != 0)  {
         int rValue;
+        theControl->logCommitState();
         rValue = theControl->commitState();
         if (rValue != OF_ReturnType_completed)  {
             opserr << "ExperimentalSetup::commitState() - "
@@ -674,6 +738,18 @@ int ExperimentalSetup::commitState()
 }
 
 
+bool ExperimentalSetup::usesGlobalDomain()
+{
+    return (theControl != 0 && theControl->usesGlobalDomain());
+}
+
+
+ExperimentalControl* ExperimentalSetup::getControl()
+{
+    return theControl;
+}
+
+
 Response* ExperimentalSetup::setResponse(const char **argv, int argc,
     OPS_Stream &output)
 {
@@ -1342,467 +1418,35 @@ int ExperimentalSetup::getDaqSize(int rType)
 
 void ExperimentalSetup::setTrial()
 {
-    if (tDisp != 0)  {
-        delete tDisp;
-        tDisp = 0;
-    }
-    if (tVel != 0)  {
-        delete tVel;
-        tVel = 0;
-    }
-    if (tAccel != 0)  {
-        delete tAccel;
-        tAccel = 0;
-    }
-    if (tForce != 0)  {
-        delete tForce;
-        tForce = 0;
-    }
-    if (tTime != 0)  {
-        delete tTime;
-        tTime = 0;
-    }
-    if (tDispFact != 0)  {
-        delete tDispFact;
-        tDispFact = 0;
-    }
-    if (tVelFact != 0)  {
-        delete tVelFact;
-        tVelFact = 0;
-    }
-    if (tAccelFact != 0)  {
-        delete tAccelFact;
-        tAccelFact = 0;
-    }
-    if (tForceFact != 0)  {
-        delete tForceFact;
-        tForceFact = 0;
-    }
-    if (tTimeFact != 0)  {
-        delete tTimeFact;
-        tTimeFact = 0;
-    }
-    
-    int size, i;
-    size = (*sizeTrial)(OF_Resp_Disp);
-    if (size != 0)  {
-        tDisp = new Vector(size);
-        if (tDispFact == 0)  {
-            tDispFact = new Vector(size);
-            for (i=0; i<size; i++)
-                (*tDispFact)(i) = 1.0;
-        }
-        if (tDisp == 0 || tDispFact == 0)  {
-            opserr << "ExperimentalSetup::setTrial() - "
-                << "failed to create Vector.\n";
-            exit(OF_ReturnType_failed);
-        }
-    }
-    size = (*sizeTrial)(OF_Resp_Vel);
-    if (size != 0)  {
-        tVel = new Vector(size);
-        if (tVelFact == 0)  {
-            tVelFact = new Vector(size);
-            for (i=0; i<size; i++)
-                (*tVelFact)(i) = 1.0;
-        }
-        if (tVel == 0 || tVelFact == 0)  {
-            opserr << "ExperimentalSetup::setTrial() - "
-                << "failed to create Vector.\n";
-            exit(OF_ReturnType_failed);
-        }
-    }
-    size = (*sizeTrial)(OF_Resp_Accel);
-    if (size != 0)  {
-        tAccel = new Vector(size);
-        if (tAccelFact == 0)  {
-            tAccelFact = new Vector(size);
-            for (i=0; i<size; i++)
-                (*tAccelFact)(i) = 1.0;
-        }
-        if (tAccel == 0 || tAccelFact == 0)  {
-            opserr << "ExperimentalSetup::setTrial() - "
-                << "failed to create Vector.\n";
-            exit(OF_ReturnType_failed);
-        }
-    }
-    size = (*sizeTrial)(OF_Resp_Force);
-    if (size != 0) {
-        tForce = new Vector(size);
-        if (tForceFact == 0) {
-            tForceFact = new Vector(size);
-            for (i=0; i<size; i++)
-                (*tForceFact)(i) = 1.0;
-        }
-        if (tForce == 0 || tForceFact == 0)  {
-            opserr << "ExperimentalSetup::setTrial() - "
-                << "failed to create Vector.\n";
-            exit(OF_ReturnType_failed);
-        }
-    }
-    size = (*sizeTrial)(OF_Resp_Time);
-    if (size != 0)  {
-        tTime = new Vector(size);
-        if (tTimeFact == 0)  {
-            tTimeFact = new Vector(size);
-            for (i=0; i<size; i++)
-                (*tTimeFact)(i) = 1.0;
-        }
-        if (tTime == 0 || tTimeFact == 0)  {
-            opserr << "ExperimentalSetup::setTrial() - "
-                << "failed to create Vector.\n";
-            exit(OF_ReturnType_failed);
-        }
-    }
+    Vector **resp[OF_Resp_All] = {&tDisp, &tVel, &tAccel, &tForce, &tTime};
+    Vector **fact[OF_Resp_All] = {&tDispFact, &tVelFact,
+        &tAccelFact, &tForceFact, &tTimeFact};
+    setViews(resp, fact, tArena, *sizeTrial);
 }
 
 
 void ExperimentalSetup::setOut()
 {
-    if (oDisp != 0)  {
-        delete oDisp;
-        oDisp = 0;
-    }
-    if (oVel != 0)  {
-        delete oVel;
-        oVel = 0;
-    }
-    if (oAccel != 0)  {
-        delete oAccel;
-        oAccel = 0;
-    }
-    if (oForce != 0)  {
-        delete oForce;
-        oForce = 0;
-    }
-    if (oTime != 0)  {
-        delete oTime;
-        oTime = 0;
-    }
-    if (oDispFact != 0)  {
-        delete oDispFact;
-        oDispFact = 0;
-    }
-    if (oVelFact != 0)  {
-        delete oVelFact;
-        oVelFact = 0;
-    }
-    if (oAccelFact != 0)  {
-        delete oAccelFact;
-        oAccelFact = 0;
-    }
-    if (oForceFact != 0)  {
-        delete oForceFact;
-        oForceFact = 0;
-    }
-    if (oTimeFact != 0)  {
-        delete oTimeFact;
-        oTimeFact = 0;
-    }
-    
-    int size, i;
-    size = (*sizeOut)(OF_Resp_Disp);
-    if (size != 0)  {
-        oDisp = new Vector(size);
-        if (oDispFact == 0)  {
-            oDispFact = new Vector(size);
-            for (i=0; i<size; i++)
-                (*oDispFact)(i) = 1.0;
-        }
-        if (oDisp == 0 || oDispFact == 0)  {
-            opserr << "ExperimentalSetup::setOut() - "
-                << "failed to create Vector.\n";
-            exit(OF_ReturnType_failed);
-        }
-    }
-    size = (*sizeOut)(OF_Resp_Vel);
-    if (size != 0)  {
-        oVel = new Vector(size);
-        if (oVelFact == 0)  {
-            oVelFact = new Vector(size);
-            for (i=0; i<size; i++)
-                (*oVelFact)(i) = 1.0;
-        }
-        if (oVel == 0 || oVelFact == 0)  {
-            opserr << "ExperimentalSetup::setOut() - "
-                << "failed to create Vector.\n";
-            exit(OF_ReturnType_failed);
-        }
-    }
-    size = (*sizeOut)(OF_Resp_Accel);
-    if (size != 0)  {
-        oAccel = new Vector(size);
-        if (oAccelFact == 0)  {
-            oAccelFact = new Vector(size);
-            for (i=0; i<size; i++)
-                (*oAccelFact)(i) = 1.0;
-        }
-        if (oAccel == 0 || oAccelFact == 0)  {
-            opserr << "ExperimentalSetup::setOut() - "
-                << "failed to create Vector.\n";
-            exit(OF_ReturnType_failed);
-        }
-    }
-    size = (*sizeOut)(OF_Resp_Force);
-    if (size != 0)  {
-        oForce = new Vector(size);
-        if (oForceFact == 0)  {
-            oForceFact = new Vector(size);
-            for (i=0; i<size; i++)
-                (*oForceFact)(i) = 1.0;
-        }
-        if (oForce == 0 || oForceFact == 0)  {
-            opserr << "ExperimentalSetup::setOut() - "
-                << "failed to create Vector.\n";
-            exit(OF_ReturnType_failed);
-        }
-    }
-    size = (*sizeOut)(OF_Resp_Time);
-    if (size != 0)  {
-        oTime = new Vector(size);
-        if (oTimeFact == 0)  {
-            oTimeFact = new Vector(size);
-            for (i=0; i<size; i++)
-                (*oTimeFact)(i) = 1.0;
-        }
-        if (oTime == 0 || oTimeFact == 0)  {
-            opserr << "ExperimentalSetup::setOut() - "
-                << "failed to create Vector.\n";
-            exit(OF_ReturnType_failed);
-        }
-    }
+    Vector **resp[OF_Resp_All] = {&oDisp, &oVel, &oAccel, &oForce, &oTime};
+    Vector **fact[OF_Resp_All] = {&oDispFact, &oVelFact,
+        &oAccelFact, &oForceFact, &oTimeFact};
+    setViews(resp, fact, oArena, *sizeOut);
 }
 
 
 void ExperimentalSetup::setCtrl()
 {
-    if (cDisp != 0)  {
-        delete cDisp;
-        cDisp = 0;
-    }
-    if (cVel != 0)  {
-        delete cVel;
-        cVel = 0;
-    }
-    if (cAccel != 0)  {
-        delete cAccel;
-        cAccel = 0;
-    }
-    if (cForce != 0)  {
-        delete cForce;
-        cForce = 0;
-    }
-    if (cTime != 0)  {
-        delete cTime;
-        cTime = 0;
-    }
-    if (cDispFact != 0)  {
-        delete cDispFact;
-        cDispFact = 0;
-    }
-    if (cVelFact != 0)  {
-        delete cVelFact;
-        cVelFact = 0;
-    }
-    if (cAccelFact != 0)  {
-        delete cAccelFact;
-        cAccelFact = 0;
-    }
-    if (cForceFact != 0)  {
-        delete cForceFact;
-        cForceFact = 0;
-    }
-    if (cTimeFact != 0)  {
-        delete cTimeFact;
-        cTimeFact = 0;
-    }
-    
-    int size, i;
-    size = (*sizeCtrl)(OF_Resp_Disp);
-    if (size != 0)  {
-        cDisp = new Vector(size);
-        if (cDispFact == 0)  {
-            cDispFact = new Vector(size);
-            for (i=0; i<size; i++)
-                (*cDispFact)(i) = 1.0;
-        }
-        if (cDisp == 0 || cDispFact == 0)  {
-            opserr << "ExperimentalSetup::setCtrl() - "
-                << "failed to create Vector.\n";
-            exit(OF_ReturnType_failed);
-        }
-    }
-    size = (*sizeCtrl)(OF_Resp_Vel);
-    if (size != 0)  {
-        cVel = new Vector(size);
-        if (cVelFact == 0)  {
-            cVelFact = new Vector(size);
-            for (i=0; i<size; i++)
-                (*cVelFact)(i) = 1.0;
-        }
-        if (cVel == 0 || cVelFact == 0)  {
-            opserr << "ExperimentalSetup::setCtrl() - "
-                << "failed to create Vector.\n";
-            exit(OF_ReturnType_failed);
-        }
-    }
-    size = (*sizeCtrl)(OF_Resp_Accel);
-    if (size != 0)  {
-        cAccel = new Vector(size);
-        if (cAccelFact == 0)  {
-            cAccelFact = new Vector(size);
-            for (i=0; i<size; i++)
-                (*cAccelFact)(i) = 1.0;
-        }
-        if (cAccel == 0 || cAccelFact == 0)  {
-            opserr << "ExperimentalSetup::setCtrl() - "
-                << "failed to create Vector.\n";
-            exit(OF_ReturnType_failed);
-        }
-    }
-    size = (*sizeCtrl)(OF_Resp_Force);
-    if (size != 0) {
-        cForce = new Vector(size);
-        if (cForceFact == 0) {
-            cForceFact = new Vector(size);
-            for (i=0; i<size; i++)
-                (*cForceFact)(i) = 1.0;
-        }
-        if (cForce == 0 || cForceFact == 0)  {
-            opserr << "ExperimentalSetup::setCtrl() - "
-                << "failed to create Vector.\n";
-            exit(OF_ReturnType_failed);
-        }
-    }
-    size = (*sizeCtrl)(OF_Resp_Time);
-    if (size != 0)  {
-        cTime = new Vector(size);
-        if (cTimeFact == 0)  {
-            cTimeFact = new Vector(size);
-            for (i=0; i<size; i++)
-                (*cTimeFact)(i) = 1.0;
-        }
-        if (cTime == 0 || cTimeFact == 0)  {
-            opserr << "ExperimentalSetup::setCtrl() - "
-                << "failed to create Vector.\n";
-            exit(OF_ReturnType_failed);
-        }
-    }
+    Vector **resp[OF_Resp_All] = {&cDisp, &cVel, &cAccel, &cForce, &cTime};
+    Vector **fact[OF_Resp_All] = {&cDispFact, &cVelFact,
+        &cAccelFact, &cForceFact, &cTimeFact};
+    setViews(resp, fact, cArena, *sizeCtrl);
 }
 
 
 void ExperimentalSetup::setDaq()
 {
-    if (dDisp != 0)  {
-        delete dDisp;
-        dDisp = 0;
-    }
-    if (dVel != 0)  {
-        delete dVel;
-        dVel = 0;
-    }
-    if (dAccel != 0)  {
-        delete dAccel;
-        dAccel = 0;
-    }
-    if (dForce != 0)  {
-        delete dForce;
-        dForce = 0;
-    }
-    if (dTime != 0)  {
-        delete dTime;
-        dTime = 0;
-    }
-    if (dDispFact != 0)  {
-        delete dDispFact;
-        dDispFact = 0;
-    }
-    if (dVelFact != 0)  {
-        delete dVelFact;
-        dVelFact = 0;
-    }
-    if (dAccelFact != 0)  {
-        delete dAccelFact;
-        dAccelFact = 0;
-    }
-    if (dForceFact != 0)  {
-        delete dForceFact;
-        dForceFact = 0;
-    }
-    if (dTimeFact != 0)  {
-        delete dTimeFact;
-        dTimeFact = 0;
-    }
-    
-    int size, i;
-    size = (*sizeDaq)(OF_Resp_Disp);
-    if (size != 0)  {
-        dDisp = new Vector(size);
-        if (dDispFact == 0)  {
-            dDispFact = new Vector(size);
-            for (i=0; i<size; i++)
-                (*dDispFact)(i) = 1.0;
-        }
-        if (dDisp == 0 || dDispFact == 0)  {
-            opserr << "ExperimentalSetup::setDaq() - "
-                << "failed to create Vector.\n";
-            exit(OF_ReturnType_failed);
-        }
-    }
-    size = (*sizeDaq)(OF_Resp_Vel);
-    if (size != 0)  {
-        dVel = new Vector(size);
-        if (dVelFact == 0)  {
-            dVelFact = new Vector(size);
-            for (i=0; i<size; i++)
-                (*dVelFact)(i) = 1.0;
-        }
-        if (dVel == 0 || dVelFact == 0)  {
-            opserr << "ExperimentalSetup::setDaq() - "
-                << "failed to create Vector.\n";
-            exit(OF_ReturnType_failed);
-        }
-    }
-    size = (*sizeDaq)(OF_Resp_Accel);
-    if (size != 0)  {
-        dAccel = new Vector(size);
-        if (dAccelFact == 0)  {
-            dAccelFact = new Vector(size);
-            for (i=0; i<size; i++)
-                (*dAccelFact)(i) = 1.0;
-        }
-        if (dAccel == 0 || dAccelFact == 0)  {
-            opserr << "ExperimentalSetup::setDaq() - "
-                << "failed to create Vector.\n";
-            exit(OF_ReturnType_failed);
-        }
-    }
-    size = (*sizeDaq)(OF_Resp_Force);
-    if (size != 0)  {
-        dForce = new Vector(size);
-        if (dForceFact == 0)  {
-            dForceFact = new Vector(size);
-            for (i=0; i<size; i++)
-                (*dForceFact)(i) = 1.0;
-        }
-        if (dForce == 0 || dForceFact == 0)  {
-            opserr << "ExperimentalSetup::setDaq() - "
-                << "failed to create Vector.\n";
-            exit(OF_ReturnType_failed);
-        }
-    }
-    size = (*sizeDaq)(OF_Resp_Time);
-    if (size != 0)  {
-        dTime = new Vector(size);
-        if (dTimeFact == 0)  {
-            dTimeFact = new Vector(size);
-            for (i=0; i<size; i++)
-                (*dTimeFact)(i) = 1.0;
-        }
-        if (dTime == 0 || dTimeFact == 0)  {
-            opserr << "ExperimentalSetup::setDaq() - "
-                << "failed to create Vector.\n";
-            exit(OF_ReturnType_failed);
-        }
-    }
+    Vector **resp[OF_Resp_All] = {&dDisp, &dVel, &dAccel, &dForce, &dTime};
+    Vector **fact[OF_Resp_All] = {&dDispFact, &dVelFact,
+        &dAccelFact, &dForceFact, &dTimeFact};
+    setViews(resp, fact, dArena, *sizeDaq);
 }
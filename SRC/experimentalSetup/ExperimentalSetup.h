@@ -97,6 +97,12 @@ public:
     
     virtual int commitState();
     
+    // method to query if the control drives the global domain
+    virtual bool usesGlobalDomain();
+    
+    // method to get the control, which is not copied by the constructor
+    ExperimentalControl *getControl();
+    
     virtual ExperimentalSetup *getCopy() = 0;
     
     // public methods for experimental setup recorder
@@ -204,6 +210,13 @@ protected:
     Vector *dForceFact;
     Vector *dTimeFact;
     
+    // one arena per group that holds the data in the order
+    // disp, vel, accel, force, time followed by the factors
+    double *tArena;
+    double *oArena;
+    double *cArena;
+    double *dArena;
+    
     // protected tranformation methods
     virtual int transfTrialDisp(const Vector* disp) = 0;
     virtual int transfTrialVel(const Vector* vel) = 0;
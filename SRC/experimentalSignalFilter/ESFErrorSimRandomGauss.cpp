@@ -34,6 +34,7 @@
 #include <elementAPI.h>
 
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 #include <time.h>
 
@@ -44,7 +45,7 @@ void* OPF_ESFErrorSimRandomGauss()
     
     if (OPS_GetNumRemainingInputArgs() < 3) {
         opserr << "WARNING invalid number of arguments\n";
-        opserr << "Want: expSignalFilter ErrorSimRandomGauss tag avg std\n";
+        opserr << "Want: expSignalFilter ErrorSimRandomGauss tag avg std <-seed seed>\n";
         return 0;
     }
     
@@ -74,8 +75,22 @@ void* OPF_ESFErrorSimRandomGauss()
         return 0;
     }
     
+    // optional seed of the random numbers
+    int seed = -1;
+    while (OPS_GetNumRemainingInputArgs() > 0) {
+        const char* type = OPS_GetString();
+        if (strcmp(type, "-seed") == 0) {
+            numdata = 1;
+            if (OPS_GetIntInput(&numdata, &seed) != 0 || seed < 0) {
+                opserr << "WARNING invalid seed\n";
+                opserr << "expSignalFilter ErrorSimRandomGauss " << tag << endln;
+                return 0;
+            }
+        }
+    }
+    
     // parsing was successful, allocate the signal filter
-    theFilter = new ESFErrorSimRandomGauss(tag, avg, std);
+    theFilter = new ESFErrorSimRandomGauss(tag, avg, std, seed);
     if (theFilter == 0) {
         opserr << "WARNING could not create experimental signal filter "
             << "of type ESFErrorSimRandomGauss\n";
@@ -86,60 +101,38 @@ void* OPF_ESFErrorSimRandomGauss()
 }
 
 
-ESFErrorSimRandomGauss::ESFErrorSimRandomGauss(int tag, double ave, double std)
+ESFErrorSimRandomGauss::ESFErrorSimRandomGauss(int tag,
+    double ave, double std, int seed)
     : ESFErrorSimulation(tag), data(0.0),
-    mean(ave), sigma(std), idseed(0),
-    Pi(atan(1.0)*4.0), sw(0), inext(0), inextp(0),
-    MBIG(1000000000), MSEED(161803398), MZ(0), FAC(1.0/MBIG), ma(0),
-    amp(0.0), theta(0.0)
+    mean(ave), sigma(std), idseed(seed),
+    theStream(0, ExpRandomStream::getNewStream())
 {
-    idseed = ((unsigned)time(NULL)) % MBIG;
-    ma = new int [56];
-    if (ma == 0)
-        opserr << "ESFErrorSimRandomGauss::ESFErrorSimRandomGauss() - failed to create ma.\n";
-    idseed = ((unsigned)time(NULL)) % MBIG;
-    init_rand3();
-    srand(idseed);
-    for (int i=0; i<100; i++)
-        filtering(0.0);
+    // without a given seed the noise differs from run to run
+    if (idseed < 0)
+        idseed = ((unsigned)time(NULL)) % 1000000000;
+    theStream.setStream(idseed, theStream.getStream());
 }
 
 
 ESFErrorSimRandomGauss::ESFErrorSimRandomGauss(const ESFErrorSimRandomGauss& esf)
-    : ESFErrorSimulation(esf)
+    : ESFErrorSimulation(esf), data(esf.data),
+    mean(esf.mean), sigma(esf.sigma), idseed(esf.idseed),
+    theStream(esf.idseed, ExpRandomStream::getNewStream())
 {
-    data = esf.data;
-    mean = esf.mean;
-    sigma = esf.sigma;
-    Pi = esf.Pi;
-    sw = esf.sw;
-    inext = esf.inext;
-    inextp = esf.inextp;
-    MBIG = esf.MBIG;
-    MSEED = esf.MSEED;
-    MZ = esf.MZ;
-    FAC = esf.FAC;
-    ma = new int[56];
-    
-    idseed = ((unsigned)time(NULL)) % MBIG;
-    init_rand3();
-    srand(idseed);
-    for (int i=0; i<100; i++)
-        filtering(0.0);
+    // the copy draws from its own stream of the same seed
 }
 
 
 ESFErrorSimRandomGauss::~ESFErrorSimRandomGauss()
 {
-    if (ma != 0)
-        delete [] ma;
+    // does nothing
 }
 
 
 double ESFErrorSimRandomGauss::filtering(double d)
 {
     data = d;
-    data += gen_rand();
+    data += mean + sigma*theStream.getGauss();
 
     return data;
 }
@@ -162,76 +155,6 @@ void ESFErrorSimRandomGauss::Print(OPS_Stream &s, int flag)
     s << "Filter: " << this->getTag(); 
     s << "  type: ESFErrorSimRandomGauss\n";
     s << "  mean: " << mean << ", sigma: " << sigma << endln;
+    s << "  seed: " << idseed << ", stream: " << (int)theStream.getStream() << endln;
 }
 
-
-void ESFErrorSimRandomGauss::init_rand3()
-{
-    // Numerical Recipes in C++, 2nd Ed., pp.287
-    int i, ii, k, mj, mk;
-    
-    mj = labs(MSEED-labs(idseed));      // Initialize ma[55] using the seed
-    mj %= MBIG;                         // idseed and the large number MSEED.
-    ma[55] = mj;
-    mk = 1;
-    for (i=1; i<=54; i++)  {            // Now initialize the rest of the table,
-        ii=(21*i)%55;                   // in a slightly random order,
-        ma[ii] = mk;                    // with numbers that are not especially 
-        mk = mj-mk;                     // random.
-        if (mk < int(MZ))
-            mk += MBIG;
-        mj = ma[ii];
-    }
-    for (k=0; k<4; k++)  {              // We randomize them by "wrapping up
-        for (i=1; i<=55; i++)  {        // the generator".
-            ma[i] -= ma[1+(i+30)%55];
-            if (ma[i] < int(MZ))
-                ma[i] += MBIG;
-        }
-    }
-    inext = 0;                          // Prepare indices for our first generated 
-    inextp = 31;                        // number. The contant 31 is special; see Knuth.
-}
-
-
-double ESFErrorSimRandomGauss::rand3()
-{
-    // Numerical Recipes in C++, 2nd Ed., pp.287
-    int mj;
-    
-    if (++inext == 56)                  // Increment inext and inextp, wrapping
-        inext = 1;
-    if (++inextp == 56)                 // around 56 to 1
-        inextp = 1;
-    mj = ma[inext]-ma[inextp];          // Generate a new random number subtractively
-    if (mj < int(MZ))                   // Be sure that it is in range
-        mj += MBIG;
-    ma[inext] = mj;
-    
-    return mj*FAC;                      // Output the derived uniform deviate between 0.0 .. 1.0
-}
-
-
-double ESFErrorSimRandomGauss::rand1()
-{
-    // simple but not recommended random generator
-    return (1.0 / (RAND_MAX + 1.0)) * rand();
-}
-
-
-double ESFErrorSimRandomGauss::gen_rand()
-{
-    double nd;
-    
-    amp = sqrt(-2 * log(rand3()));
-    theta = 2 * Pi * rand3();
-    if (sw == 0)  {
-        sw = 1;
-        nd = amp*cos(theta);
-    } else  {
-        sw = 0;
-        nd = amp*sin(theta);
-    }
-
-    return mean + sigma*nd;
-}
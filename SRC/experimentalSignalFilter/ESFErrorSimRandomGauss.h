@@ -32,16 +32,19 @@
 // Description: This file contains the class definition for 
 // ESFErrorSimRandomGauss. The white noise Gauss noise is
 // generated using the Box-Muller method. The uniform deviates
-// are generated by the special function based on NR::ran3
-// in Numerical Recipes in C++, 2nd Ed.
+// are generated by a counter-based ExpRandomStream, where every
+// copy of the filter draws from its own stream. With a given seed
+// the noise is reproducible, and each ensemble member gets an
+// independent realisation.
 
 #include "ESFErrorSimulation.h"
+#include "ExpRandomStream.h"
 
 class ESFErrorSimRandomGauss : public ESFErrorSimulation
 {
 public:
     // constructors
-    ESFErrorSimRandomGauss(int tag, double ave, double std);
+    ESFErrorSimRandomGauss(int tag, double ave, double std, int seed = -1);
     ESFErrorSimRandomGauss(const ESFErrorSimRandomGauss& esf);
     
     // destructor
@@ -59,31 +62,13 @@ public:
     void Print(OPS_Stream &s, int flag = 0);
     
 private:
-    void init_rand3();
-    double rand3();
-    double rand1();
-    double gen_rand();
-    
     double data;
     
     double mean;    // mean value of random numbers
     double sigma;   // variation of random numbers
-    double ampl;    // amplitude of error
-    int idseed;     // seed of random numbers, defined by time() % MBIG
-    
-    double Pi;      // = 3.141592....
-    int sw;
-    
-    int inext, inextp;
+    int idseed;     // seed of random numbers, defined by time() if not given
     
-    // According to Knuth, any large MBIG, and any smaller 
-    // (but still large) MSEED can be substituted. In this object, 
-    int MBIG;       // = 1000000000
-    int MSEED;      // = 161803398
-    int MZ;         // = 0
-    double FAC;     // = 1/MBIG
-    int *ma;        // array ma[56]. The value 56 is special and shouldn't modified.
-    double amp, theta;
+    ExpRandomStream theStream;  // counter-based stream of the filter
 };
 
 #endif
@@ -0,0 +1,152 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation of
+// ExpRandomStream.
+
+#include "ExpRandomStream.h"
+
+#include <math.h>
+#include <atomic>
+
+// stream ids are handed out from objects created on server threads
+static std::atomic<unsigned int> numStreams(0);
+
+unsigned int ExpRandomStream::ensembleMember = 0;
+unsigned int ExpRandomStream::ensembleEpoch = 0;
+
+
+ExpRandomStream::ExpRandomStream(unsigned int seed, unsigned int stream)
+{
+    this->setStream(seed, stream);
+}
+
+
+void ExpRandomStream::setStream(unsigned int seed, unsigned int stream)
+{
+    key[0] = seed;
+    key[1] = stream;
+    this->restart();
+}
+
+
+double ExpRandomStream::getUniform()
+{
+    // every setting of the ensemble member, even of the same one in a
+    // forked realisation, starts the streams from the beginning
+    if (epoch != ensembleEpoch)
+        this->restart();
+
+    if (numLeft == 0)
+        this->generate();
+
+    // use 53 bits of a pair of words and stay away from 0 and 1
+    numLeft--;
+    unsigned long long bits = ((unsigned long long)rnd[2*numLeft] << 32)
+        | rnd[2*numLeft+1];
+
+    return ((bits >> 11) + 0.5) * (1.0/9007199254740992.0);
+}
+
+
+double ExpRandomStream::getGauss()
+{
+    if (epoch != ensembleEpoch)
+        this->restart();
+
+    if (haveGauss)  {
+        haveGauss = 0;
+        return gauss;
+    }
+
+    // both deviates of the pair are used
+    double amp = sqrt(-2.0*log(this->getUniform()));
+    double theta = 8.0*atan(1.0)*this->getUniform();
+    gauss = amp*sin(theta);
+    haveGauss = 1;
+
+    return amp*cos(theta);
+}
+
+
+unsigned int ExpRandomStream::getNewStream()
+{
+    return numStreams.fetch_add(1);
+}
+
+
+void ExpRandomStream::setEnsembleMember(unsigned int m)
+{
+    ensembleMember = m;
+    ensembleEpoch++;
+}
+
+
+unsigned int ExpRandomStream::getEnsembleMember()
+{
+    return ensembleMember;
+}
+
+
+void ExpRandomStream::restart()
+{
+    member = ensembleMember;
+    epoch = ensembleEpoch;
+    block = 0;
+    numLeft = 0;
+    gauss = 0.0;
+    haveGauss = 0;
+}
+
+
+void ExpRandomStream::generate()
+{
+    // Philox4x32-10 of the counter (block, member, 0)
+    unsigned int ctr[4], k[2];
+    ctr[0] = (unsigned int)block;
+    ctr[1] = (unsigned int)(block >> 32);
+    ctr[2] = member;
+    ctr[3] = 0;
+    k[0] = key[0];
+    k[1] = key[1];
+
+    for (int i=0; i<10; i++)  {
+        unsigned long long p0 = 0xD2511F53ULL * ctr[0];
+        unsigned long long p1 = 0xCD9E8D57ULL * ctr[2];
+        unsigned int hi0 = (unsigned int)(p0 >> 32), lo0 = (unsigned int)p0;
+        unsigned int hi1 = (unsigned int)(p1 >> 32), lo1 = (unsigned int)p1;
+        ctr[0] = hi1 ^ ctr[1] ^ k[0];
+        ctr[1] = lo1;
+        ctr[2] = hi0 ^ ctr[3] ^ k[1];
+        ctr[3] = lo0;
+        k[0] += 0x9E3779B9U;
+        k[1] += 0xBB67AE85U;
+    }
+
+    for (int i=0; i<4; i++)
+        rnd[i] = ctr[i];
+    numLeft = 2;
+    block++;
+}
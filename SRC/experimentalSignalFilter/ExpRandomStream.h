@@ -0,0 +1,76 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef ExpRandomStream_h
+#define ExpRandomStream_h
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the class definition for
+// ExpRandomStream. An ExpRandomStream is a counter-based random number
+// generator (Philox4x32-10, Salmon et al., SC'11). The n-th number of a
+// stream is a pure function of the seed, the stream id, the ensemble
+// member and n, so streams need no shared state and can be split
+// across any number of workers. Every object that draws random numbers
+// gets its own stream id, and the ensemble member that is set by the
+// ensemble analysis selects an independent realisation of all streams.
+
+class ExpRandomStream
+{
+public:
+    // constructor
+    ExpRandomStream(unsigned int seed, unsigned int stream);
+
+    // methods to set and query the stream
+    void setStream(unsigned int seed, unsigned int stream);
+    unsigned int getSeed() const {return key[0];};
+    unsigned int getStream() const {return key[1];};
+
+    // methods to draw uniform deviates in (0,1) and
+    // standard normal deviates (Box-Muller method)
+    double getUniform();
+    double getGauss();
+
+    // methods to get a new stream id and to select the ensemble member
+    static unsigned int getNewStream();
+    static void setEnsembleMember(unsigned int member);
+    static unsigned int getEnsembleMember();
+
+private:
+    void restart();
+    void generate();
+
+    unsigned int key[2];        // seed and stream id
+    unsigned int member;        // ensemble member the counter belongs to
+    unsigned int epoch;         // ensemble epoch the counter belongs to
+    unsigned long long block;   // counter of the next block
+    unsigned int rnd[4];        // current block of random bits
+    int numLeft;                // number of unused pairs in rnd
+    double gauss;               // second deviate of the Box-Muller pair
+    int haveGauss;              // flag if gauss is unused
+
+    static unsigned int ensembleMember;
+    static unsigned int ensembleEpoch;
+};
+
+#endif
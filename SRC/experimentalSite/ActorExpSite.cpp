@@ -34,6 +34,8 @@
 #include <TCP_Socket.h>
 #include <TCP_SocketSSL.h>
 #include <UDP_Socket.h>
+#include <SHM_Channel.h>
+#include <WAN_Channel.h>
 #include <elementAPI.h>
 
 
@@ -43,10 +45,10 @@ void* OPF_ActorExpSite()
     ExperimentalSite* theSite = 0;
     
     int numArgs = OPS_GetNumRemainingInputArgs();
-    if (4 > numArgs || numArgs > 6) {
+    if (4 > numArgs || numArgs > 22) {
         opserr << "WARNING invalid number of arguments\n";
-        opserr << "Want: expSite ActorSite tag -setup setupTag ipPort <-udp> <-ssl>\n"
-            << "  or: expSite ActorSite tag -control ctrlTag ipPort <-udp> <-ssl>\n";
+        opserr << "Want: expSite ActorSite tag -setup setupTag ipPort <-udp|-udpFrag> <-ssl> <-shm> <-noDelay> <-record fileName> <-wan delay <-jitter jitter> <-bandwidth bandwidth> <-loss loss> <-reorder reorder> <-seed seed>>\n"
+            << "  or: expSite ActorSite tag -control ctrlTag ipPort <-udp|-udpFrag> <-ssl> <-shm> <-noDelay> <-record fileName> <-wan delay <-jitter jitter> <-bandwidth bandwidth> <-loss loss> <-reorder reorder> <-seed seed>>\n";
         return 0;
     }
     
@@ -105,24 +107,65 @@ void* OPF_ActorExpSite()
     }
     
     // optional parameters
-    int ssl = 0, udp = 0;
+    int ssl = 0, udp = 0, shm = 0;
     int noDelay = 0;
+    const char* recordFile = 0;
+    bool wan = false;
+    double wanArgs[6];
     while (OPS_GetNumRemainingInputArgs() > 0) {
         type = OPS_GetString();
         if (strcmp(type, "-ssl") == 0) {
-            ssl = 1; udp = 0;
+            ssl = 1; udp = 0; shm = 0;
         }
         else if (strcmp(type, "-udp") == 0) {
-            udp = 1; ssl = 0;
+            udp = 1; ssl = 0; shm = 0;
+        }
+        else if (strcmp(type, "-udpFrag") == 0) {
+            udp = 2; ssl = 0; shm = 0;
+        }
+        else if (strcmp(type, "-shm") == 0) {
+#ifdef _WIN32
+            opserr << "WARNING shared memory channels (-shm) are not supported on Windows\n";
+            opserr << "expSite ActorSite " << tag << endln;
+            return 0;
+#endif
+            shm = 1; ssl = 0; udp = 0;
         }
         else if (strcmp(type, "-noDelay") == 0) {
             noDelay = 1;
         }
+        else if (strcmp(type, "-record") == 0) {
+            if (OPS_GetNumRemainingInputArgs() < 1) {
+                opserr << "WARNING want -record fileName\n";
+                opserr << "expSite ActorSite " << tag << endln;
+                return 0;
+            }
+            recordFile = OPS_GetString();
+        }
+        else if (strcmp(type, "-wan") == 0) {
+            if (OPF_GetWANChannelArgs(wanArgs) < 0) {
+                opserr << "expSite ActorSite " << tag << endln;
+                return 0;
+            }
+            wan = true;
+        }
     }
     
     // parsing was successful, setup the connection and allocate the site
     Channel* theChannel = 0;
-    if (ssl) {
+    if (shm) {
+        theChannel = new SHM_Channel(ipPort);
+        if (theChannel != 0) {
+            opserr << "\nSHM Channel successfully created: "
+                << "Waiting for ShadowExpSite...\n";
+        }
+        else {
+            opserr << "WARNING could not create SHM channel\n";
+            opserr << "expSite ActorSite " << tag << endln;
+            return 0;
+        }
+    }
+    else if (ssl) {
         theChannel = new TCP_SocketSSL(ipPort, true, noDelay);
         if (theChannel != 0) {
             opserr << "\nSSL Channel successfully created: "
@@ -135,7 +178,7 @@ void* OPF_ActorExpSite()
         }
     }
     else if (udp) {
-        theChannel = new UDP_Socket(ipPort, true);
+        theChannel = new UDP_Socket(ipPort, true, false, udp == 2);
         if (theChannel != 0) {
             opserr << "\nUDP Channel successfully created: "
                 << "Waiting for ShadowExpSite...\n";
@@ -159,6 +202,17 @@ void* OPF_ActorExpSite()
         }
     }
     
+    // emulate a wide area network between the sites
+    if (wan) {
+        theChannel = new WAN_Channel(theChannel, wanArgs[0], wanArgs[1],
+            wanArgs[2], wanArgs[3], wanArgs[4], udp != 0, (int)wanArgs[5]);
+        if (!theChannel) {
+            opserr << "WARNING could not create WAN channel\n";
+            opserr << "expSite ActorSite " << tag << endln;
+            return 0;
+        }
+    }
+    
     // parsing was successful, allocate the site
     if (theControl == 0)
         theSite = new ActorExpSite(tag, theSetup, *theChannel);
@@ -170,6 +224,10 @@ void* OPF_ActorExpSite()
         return 0;
     }
     
+    // capture the traffic of the site
+    if (recordFile != 0)
+        theSite->setTrafficLog(recordFile);
+    
     return theSite;
 }
 
@@ -181,7 +239,8 @@ ActorExpSite::ActorExpSite(int tag,
     : ExperimentalSite(tag, setup), 
     Actor(theChannel, *theObjectBroker, 0),
     theControl(0), dataSize(0),
-    sendV(OF_Network_dataSize), recvV(OF_Network_dataSize)
+    sendV(OF_Network_dataSize), recvV(OF_Network_dataSize),
+    sendStiff(false), stiffFlag(false), oStiff(0)
 { 
     if (theSetup == 0)  {
         opserr << "ActorExpSite::ActorExpSite() - "
@@ -199,7 +258,8 @@ ActorExpSite::ActorExpSite(int tag,
     : ExperimentalSite(tag, (ExperimentalSetup*)0), 
     Actor(theChannel, *theObjectBroker, 0),
     theControl(control), dataSize(0),
-    sendV(OF_Network_dataSize), recvV(OF_Network_dataSize)
+    sendV(OF_Network_dataSize), recvV(OF_Network_dataSize),
+    sendStiff(false), stiffFlag(false), oStiff(0)
 { 
     if (theControl == 0)  {
         opserr << "ActorExpSite::ActorExpSite() - "
@@ -213,7 +273,8 @@ ActorExpSite::ActorExpSite(int tag,
 ActorExpSite::ActorExpSite(const ActorExpSite& es)
     : ExperimentalSite(es), Actor(es), 
     theControl(0), dataSize(0),
-    sendV(OF_Network_dataSize), recvV(OF_Network_dataSize)
+    sendV(OF_Network_dataSize), recvV(OF_Network_dataSize),
+    sendStiff(false), stiffFlag(false), oStiff(0)
 {  
     if (es.theControl != 0)  {
         theControl = (es.theControl)->getCopy();
@@ -228,6 +289,12 @@ ActorExpSite::ActorExpSite(const ActorExpSite& es)
     dataSize = es.dataSize;    
     sendV.resize(dataSize);
     recvV.resize(dataSize);
+    if (dataSize > 0)
+        this->setOut(&sendV(0));
+    
+    sendStiff = es.sendStiff;
+    if (es.oStiff != 0)
+        oStiff = new Matrix(*(es.oStiff));
 }
 
 
@@ -235,6 +302,8 @@ ActorExpSite::~ActorExpSite()
 {
     if (theControl != 0) 
         delete theControl;
+    if (oStiff != 0)
+        delete oStiff;
 }
 
 
@@ -273,31 +342,19 @@ int ActorExpSite::runTill(int exitWhen)
             break;
         case OF_RemoteTest_setup:
             dataSize = (int)recvV(1);
+            sendStiff = (recvV(2) == 1.0);
             this->setup();
             if (exitWhen == action)
                 exitYet = true;
             break;
         case OF_RemoteTest_setTrialResponse:
-            ndim = 1;
-            if (tDisp != 0)  {
-                tDisp->Extract(recvV, ndim);
-                ndim += getTrialSize(OF_Resp_Disp);
-            }
-            if (tVel != 0)  {
-                tVel->Extract(recvV, ndim);
-                ndim += getTrialSize(OF_Resp_Vel);
-            }
-            if (tAccel != 0)  {
-                tAccel->Extract(recvV, ndim);
-                ndim += getTrialSize(OF_Resp_Accel);
-            }
-            if (tForce != 0)  {
-                tForce->Extract(recvV, ndim);
-                ndim += getTrialSize(OF_Resp_Force);
-            }
-            if (tTime != 0)  {
-                tTime->Extract(recvV, ndim);
-            }            
+            // the trial arena has the same layout as the
+            // message, so it is filled with one block copy
+            ndim = 0;
+            for (int i=0; i<OF_Resp_All; i++)
+                ndim += getTrialSize(i);
+            for (int i=0; i<ndim; i++)
+                tArena[i] = recvV(1+i);
             this->setTrialResponse(tDisp, tVel, tAccel, tForce, tTime);
             if (exitWhen == action)
                 exitYet = true;
@@ -366,6 +423,19 @@ int ActorExpSite::setSize(ID sizeT, ID sizeO)
     } else if (theControl != 0)  {
         theControl->setSize(sizeT, sizeO);
         theControl->setup();
+        
+        // the control can provide the tangent stiffness
+        // of the out forces w.r.t. the trial displacements
+        if (sizeO(OF_Resp_Force) != 0 && sizeT(OF_Resp_Disp) != 0)  {
+            if (oStiff != 0)
+                delete oStiff;
+            oStiff = new Matrix(sizeO(OF_Resp_Force), sizeT(OF_Resp_Disp));
+        }
+    }
+    if (sendStiff == true && oStiff == 0)  {
+        opserr << "\nWARNING ActorExpSite::setSize() - "
+            << "tangent stiffness is only available "
+            << "from an ExperimentalControl.\n";
     }
     
     int nTrial = 0, nOutput = 0;
@@ -373,11 +443,21 @@ int ActorExpSite::setSize(ID sizeT, ID sizeO)
         nTrial += sizeT(i);
         nOutput += sizeO(i);
     }
+    if (dataSize < 1+nTrial || dataSize < nOutput)  {
+        if (dataSize < 1+nTrial) dataSize = 1+nTrial;
+        if (dataSize < nOutput)  dataSize = nOutput;
+        opserr << "\nWARNING ActorExpSite::setSize() - "
+            << "dataSize increased to " << dataSize << ".\n";
+    }
     
     // resize channel Vectors
     sendV.resize(dataSize);
     recvV.resize(dataSize);
     
+    // the out response is sent directly from sendV
+    sendV.Zero();
+    this->setOut(&sendV(0));
+    
     return OF_ReturnType_completed;
 }
 
@@ -391,8 +471,9 @@ int ActorExpSite::setTrialResponse(const Vector* disp,
     // save data in basic sys
     this->ExperimentalSite::setTrialResponse(disp, vel, accel, force, time);
     
-    // set daq flag
+    // set daq and tangent stiffness flags
     daqFlag = false;
+    stiffFlag = false;
     
     int rValue;
     // set trial response at the setup
@@ -420,6 +501,7 @@ int ActorExpSite::setTrialResponse(const Vector* disp,
                 << "failed to set trial response at the control.\n";
             exit(OF_ReturnType_failed);
         }
+        theControl->logTrialResponse(tDisp, tVel, tAccel, tForce, tTime);
         
         // get daq response from the control
         rValue = theControl->getDaqResponse(oDisp, oVel, oAccel, oForce, oTime);
@@ -428,6 +510,7 @@ int ActorExpSite::setTrialResponse(const Vector* disp,
                 << "failed to get daq response from the control.\n";
             exit(OF_ReturnType_failed);
         }
+        theControl->logDaqResponse(oDisp, oVel, oAccel, oForce, oTime);
     }
     
     // save data
@@ -461,6 +544,7 @@ int ActorExpSite::checkDaqResponse()
                     << "failed to get daq response from the control.\n";
                 exit(OF_ReturnType_failed);
             }
+            theControl->logDaqResponse(oDisp, oVel, oAccel, oForce, oTime);
         }
         
         // save data
@@ -476,47 +560,58 @@ int ActorExpSite::checkDaqResponse()
 
 int ActorExpSite::setSendDaqResponse()
 {
-    int ndim = 0, size;
-    sendV.Zero();
-    size = getOutSize(OF_Resp_Disp);
-    if (size != 0)  {
-        sendV.Assemble(*oDisp, ndim);
-        ndim += size;
-    }
-    size = getOutSize(OF_Resp_Vel);
-    if (size != 0)  {
-        sendV.Assemble(*oVel, ndim);
-        ndim += size;
-    }
-    size = getOutSize(OF_Resp_Accel);
-    if (size != 0)  {
-        sendV.Assemble(*oAccel, ndim);
-        ndim += size;
-    }
-    size = getOutSize(OF_Resp_Force);
-    if (size != 0)  {
-        sendV.Assemble(*oForce, ndim);
-        ndim += size;
-    }
-    size = getOutSize(OF_Resp_Time);
-    if (size != 0)  {
-        sendV.Assemble(*oTime, ndim);
+    // the out response is already in sendV (see setSize)
+    int ndim = 0;
+    for (int i=0; i<OF_Resp_All; i++)
+        ndim += getOutSize(i);
+    
+    // append the flag and the tangent stiffness if requested
+    if (sendStiff == true)  {
+        const Matrix *kt = this->getTangentStiff();
+        if (kt != 0)  {
+            sendV(ndim++) = 1.0;
+            for (int j=0; j<kt->noCols(); j++)
+                for (int i=0; i<kt->noRows(); i++)
+                    sendV(ndim++) = (*kt)(i,j);
+        } else  {
+            sendV(ndim) = 0.0;
+        }
     }
     
     return OF_ReturnType_completed;
 }
 
 
+const Matrix* ActorExpSite::getTangentStiff()
+{
+    this->checkDaqResponse();
+    
+    // get the tangent stiffness from the control
+    // only once for each trial response
+    if (stiffFlag == false && oStiff != 0)  {
+        if (theControl->getTangentStiff(*oStiff) != OF_ReturnType_completed)
+            return 0;
+        stiffFlag = true;
+    }
+    
+    if (stiffFlag == true)
+        return oStiff;
+    
+    return 0;
+}
+
+
 int ActorExpSite::commitState(Vector* time)
 {
     int rValue = 0;
     
     // update the trial time vector
     if (time != 0 && tTime != 0)
-        *tTime = *time;
+        this->copyResponse(tTime, time, "commitState");
     
     // first commit the control
     if (theControl != 0)  {
+        theControl->logCommitState();
         rValue += theControl->commitState();
         if (rValue != OF_ReturnType_completed)  {
             opserr << "ActorExpSite::commitState() - "
@@ -550,4 +645,7 @@ void ActorExpSite::Print(OPS_Stream &s, int flag)
         s << "\tExperimentalControl tag: " << theControl->getTag() << endln;
         s << *theControl;
     }
+    WAN_Channel *theWAN = dynamic_cast<WAN_Channel*>(theChannel);
+    if (theWAN != 0)
+        theWAN->Print(s, flag);
 }
@@ -76,6 +76,8 @@ public:
     virtual int checkDaqResponse();
     virtual int setSendDaqResponse();
     
+    virtual const Matrix* getTangentStiff();
+    
     virtual int commitState(Vector *time = 0);
     
     virtual ExperimentalSite *getCopy();
@@ -93,6 +95,11 @@ protected:
     // vectors in Channel
     Vector sendV;
     Vector recvV;
+    
+    // tangent stiffness sent with the daq response
+    bool sendStiff;     // tangent stiffness requested by ShadowExpSite
+    bool stiffFlag;     // tangent stiffness is valid for current trial
+    Matrix *oStiff;
 };
 
 #endif
@@ -30,6 +30,7 @@
 // ExperimentalSite.
 
 #include "ExperimentalSite.h"
+#include "ExperimentalSiteGroup.h"
 
 #include <TaggedObject.h>
 #include <MapOfTaggedObjects.h>
@@ -39,6 +40,49 @@
 static MapOfTaggedObjects theExperimentalSites;
 
 
+// lays out the disp, vel, accel, force and time vectors one after
+// the other in the given arena, or in an own arena if none is given
+static void setViews(Vector **resp[], double *&ownArena,
+    const ID &size, double *arena)
+{
+    int i;
+    for (i=0; i<OF_Resp_All; i++)  {
+        if (*resp[i] != 0)  {
+            delete *resp[i];
+            *resp[i] = 0;
+        }
+    }
+    if (ownArena != 0)  {
+        delete [] ownArena;
+        ownArena = 0;
+    }
+    
+    if (arena == 0)  {
+        int numData = 0;
+        for (i=0; i<OF_Resp_All; i++)
+            numData += size(i);
+        if (numData == 0)
+            return;
+        ownArena = new double [numData];
+        if (ownArena == 0)  {
+            opserr << "ExperimentalSite::setViews() - "
+                << "failed to create arena.\n";
+            exit(OF_ReturnType_failed);
+        }
+        for (i=0; i<numData; i++)
+            ownArena[i] = 0.0;
+        arena = ownArena;
+    }
+    
+    for (i=0; i<OF_Resp_All; i++)  {
+        if (size(i) != 0)  {
+            *resp[i] = new Vector(arena, size(i));
+            arena += size(i);
+        }
+    }
+}
+
+
 bool OPF_addExperimentalSite(ExperimentalSite* newComponent)
 {
     return theExperimentalSites.addComponent(newComponent);
@@ -86,6 +130,7 @@ ExperimentalSite* OPF_getExperimentalSiteFirst()
 void OPF_clearExperimentalSites()
 {
     theExperimentalSites.clearAll();
+    OPF_clearExperimentalSiteGroups();
 }
 
 
@@ -185,7 +230,8 @@ ExperimentalSite::ExperimentalSite(int tag,
     sizeTrial(0), sizeOut(0),
     tDisp(0), tVel(0), tAccel(0), tForce(0), tTime(0),
     oDisp(0), oVel(0), oAccel(0), oForce(0), oTime(0),
-    daqFlag(false), commitTag(0), numRecorders(0), theRecorders(0)
+    tArena(0), oArena(0), daqFlag(false), theGroup(0), theLog(0),
+    commitTag(0), numRecorders(0), theRecorders(0)
 {
     sizeTrial = new ID(OF_Resp_All);
     sizeOut = new ID(OF_Resp_All);
@@ -202,7 +248,8 @@ ExperimentalSite::ExperimentalSite(const ExperimentalSite& es)
     sizeTrial(0), sizeOut(0),
     tDisp(0), tVel(0), tAccel(0), tForce(0), tTime(0),
     oDisp(0), oVel(0), oAccel(0), oForce(0), oTime(0),
-    daqFlag(false), commitTag(0), numRecorders(0), theRecorders(0)
+    tArena(0), oArena(0), daqFlag(false), theGroup(0), theLog(0),
+    commitTag(0), numRecorders(0), theRecorders(0)
 {
     if (es.theSetup != 0)  {
         theSetup = (es.theSetup)->getCopy();
@@ -230,6 +277,10 @@ ExperimentalSite::ExperimentalSite(const ExperimentalSite& es)
 
 ExperimentalSite::~ExperimentalSite()
 {
+    // derived classes leave the group in their destructors already
+    if (theGroup != 0)
+        theGroup->removeSite(this);
+    
     // theSetup is not a copy, so do not clean it up here
     //if (theSetup != 0)
     //    delete theSetup;
@@ -244,6 +295,8 @@ ExperimentalSite::~ExperimentalSite()
         delete tForce;
     if (tTime != 0)
         delete tTime;
+    if (tArena != 0)
+        delete [] tArena;
     
     if (oDisp != 0) 
         delete oDisp;
@@ -255,12 +308,17 @@ ExperimentalSite::~ExperimentalSite()
         delete oForce;
     if (oTime != 0)
         delete oTime;
+    if (oArena != 0)
+        delete [] oArena;
     
     if (sizeTrial != 0)
         delete sizeTrial;
     if (sizeOut != 0)
         delete sizeOut;
     
+    if (theLog != 0)
+        delete theLog;
+    
     if (theRecorders != 0)  {
         for (int i=0; i<numRecorders; i++)
             if (theRecorders[i] != 0)
@@ -276,6 +334,21 @@ const char* ExperimentalSite::getClassType() const
 }
 
 
+void ExperimentalSite::copyResponse(Vector *to, const Vector *from,
+    const char *method)
+{
+    // the response vectors are views into an arena, so they are filled
+    // in place and must never be resized by an assignment
+    if (from == 0 || from->Size() != to->Size())  {
+        opserr << this->getClassType() << "::" << method
+            << "() - response of size " << (from != 0 ? from->Size() : 0)
+            << " received for a vector of size " << to->Size() << endln;
+        exit(OF_ReturnType_failed);
+    }
+    *to = *from;
+}
+
+
 int ExperimentalSite::setSize(ID sizeT, ID sizeO) 
 {
     *sizeTrial = sizeT;
@@ -295,15 +368,26 @@ int ExperimentalSite::setTrialResponse(const Vector* disp,
     const Vector* time)
 {
     if (tDisp != 0)
-        *tDisp = *disp;
+        copyResponse(tDisp, disp, "setTrialResponse");
     if (tVel != 0)
-        *tVel = *vel;
+        copyResponse(tVel, vel, "setTrialResponse");
     if (tAccel != 0)
-        *tAccel = *accel;
+        copyResponse(tAccel, accel, "setTrialResponse");
     if (tForce != 0)
-        *tForce = *force;
+        copyResponse(tForce, force, "setTrialResponse");
     if (tTime != 0)
-        *tTime = *time;
+        copyResponse(tTime, time, "setTrialResponse");
+    
+    // capture the trial response, the log is opened once the sizes are known
+    if (theLog != 0)  {
+        if (!theLog->isOpen() &&
+            theLog->open(ExpTrafficLog::Site, *sizeTrial, *sizeOut) < 0)  {
+            delete theLog;
+            theLog = 0;
+        } else  {
+            theLog->writeTrial(tDisp, tVel, tAccel, tForce, tTime);
+        }
+    }
     
     return OF_ReturnType_completed;
 }
@@ -316,15 +400,19 @@ int ExperimentalSite::setDaqResponse(const Vector* disp,
     const Vector* time)
 {
     if (oDisp != 0)
-        *oDisp = *disp;
+        copyResponse(oDisp, disp, "setDaqResponse");
     if (oVel != 0)
-        *oVel = *vel;
+        copyResponse(oVel, vel, "setDaqResponse");
     if (oAccel != 0)
-        *oAccel = *accel;
+        copyResponse(oAccel, accel, "setDaqResponse");
     if (oForce != 0)
-        *oForce = *force;
+        copyResponse(oForce, force, "setDaqResponse");
     if (oTime != 0)
-        *oTime = *time;
+        copyResponse(oTime, time, "setDaqResponse");
+    
+    // capture the daq response
+    if (theLog != 0 && theLog->isOpen())
+        theLog->writeDaq(oDisp, oVel, oAccel, oForce, oTime);
     
     return OF_ReturnType_completed;
 }
@@ -353,6 +441,20 @@ int ExperimentalSite::getDaqResponse(Vector* disp,
 }
 
 
+int ExperimentalSite::sendTrialResponse()
+{
+    // does nothing
+    return OF_ReturnType_completed;
+}
+
+
+int ExperimentalSite::recvDaqResponse()
+{
+    // does nothing
+    return OF_ReturnType_completed;
+}
+
+
 const Vector& ExperimentalSite::getTrialDisp()
 {
     return *tDisp;
@@ -423,16 +525,43 @@ const Vector& ExperimentalSite::getTime()
 }
 
 
+const Matrix* ExperimentalSite::getTangentStiff()
+{
+    // not available by default
+    return 0;
+}
+
+
+bool ExperimentalSite::usesGlobalDomain()
+{
+    return (theSetup != 0 && theSetup->usesGlobalDomain());
+}
+
+
+ExperimentalSetup* ExperimentalSite::getSetup()
+{
+    return theSetup;
+}
+
+
 int ExperimentalSite::commitState(Vector* time)
 {
     int rValue = 0;
     
+    // wait for the group to finish the step
+    if (theGroup != 0)
+        theGroup->wait(this);
+    
     // update the commitTag
     commitTag++;
     
+    // capture the commit
+    if (theLog != 0 && theLog->isOpen())
+        theLog->writeCommit();
+    
     // update the trial time vector
     if (time != 0 && tTime != 0)
-        *tTime = *time;
+        copyResponse(tTime, time, "commitState");
     
     // first commit the setup
     if (theSetup != 0)  {
@@ -699,6 +828,10 @@ int ExperimentalSite::record()
 {
     int rValue = 0;
     
+    // wait for the group to finish the step
+    if (theGroup != 0)
+        theGroup->wait(this);
+    
     // update the commitTag
     commitTag++;
     
@@ -777,145 +910,44 @@ int ExperimentalSite::getDaqSize(int rType)
 }
 
 
-void ExperimentalSite::setTrial()
+void ExperimentalSite::setGroup(ExperimentalSiteGroup *group)
 {
-    if (tDisp != 0)  {
-        delete tDisp;
-        tDisp = 0;
-    }
-    if (tVel != 0)  {
-        delete tVel;
-        tVel = 0;
-    }
-    if (tAccel != 0)  {
-        delete tAccel;
-        tAccel = 0;
-    }
-    if (tForce != 0)  {
-        delete tForce;
-        tForce = 0;
-    }
-    if (tTime != 0)  {
-        delete tTime;
-        tTime = 0;
-    }
-    
-    int size;
-    size = (*sizeTrial)(OF_Resp_Disp);
-    if (size != 0)  {
-        tDisp = new Vector(size);
-        if (tDisp == 0)  {
-            opserr << "ExperimentalSite::setTrial() - "
-                << "failed to create tDisp Vector.\n";
-            exit(OF_ReturnType_failed);
-        }
-    }
-    size = (*sizeTrial)(OF_Resp_Vel);
-    if (size != 0)  {
-        tVel = new Vector(size);
-        if (tVel == 0)  {
-            opserr << "ExperimentalSite::setTrial() - "
-                << "failed to create tVel Vector.\n";
-            exit(OF_ReturnType_failed);
-        }
-    }
-    size = (*sizeTrial)(OF_Resp_Accel);
-    if (size != 0)  {
-        tAccel = new Vector(size);
-        if (tAccel == 0)  {
-            opserr << "ExperimentalSite::setTrial() - "
-                << "failed to create tAccel Vector.\n";
-            exit(OF_ReturnType_failed);
-        }
-    }
-    size = (*sizeTrial)(OF_Resp_Force);
-    if (size != 0)  {
-        tForce = new Vector(size);
-        if (tForce == 0)  {
-            opserr << "ExperimentalSite::setTrial() - "
-                << "failed to create tForce Vector.\n";
-            exit(OF_ReturnType_failed);
-        }
-    }
-    size = (*sizeTrial)(OF_Resp_Time);
-    if (size != 0)  {
-        tTime = new Vector(size);
-        if (tTime == 0)  {
-            opserr << "ExperimentalSite::setTrial() - "
-                << "failed to create tTime Vector.\n";
-            exit(OF_ReturnType_failed);
-        }
-    }
+    theGroup = group;
 }
 
 
-void ExperimentalSite::setOut()
+ExperimentalSiteGroup* ExperimentalSite::getGroup()
 {
-    if (oDisp != 0)  {
-        delete oDisp;
-        oDisp = 0;
-    }
-    if (oVel != 0)  {
-        delete oVel;
-        oVel = 0;
-    }
-    if (oAccel != 0)  {
-        delete oAccel;
-        oAccel = 0;
-    }
-    if (oForce != 0)  {
-        delete oForce;
-        oForce = 0;
-    }
-    if (oTime != 0)  {
-        delete oTime;
-        oTime = 0;
-    }
+    return theGroup;
+}
+
+
+int ExperimentalSite::setTrafficLog(const char *fileName)
+{
+    if (theLog != 0)
+        delete theLog;
     
-    int size;
-    size = (*sizeOut)(OF_Resp_Disp);
-    if (size != 0)  {
-        oDisp = new Vector(size);
-        if (oDisp == 0)  {
-            opserr << "ExperimentalSite::setOut() - "
-                << "failed to create Disp Vector.\n";
-            exit(OF_ReturnType_failed);
-        }
-    }
-    size = (*sizeOut)(OF_Resp_Vel);
-    if (size != 0)  {
-        oVel = new Vector(size);
-        if (oVel == 0)  {
-            opserr << "ExperimentalSite::setOut() - "
-                << "failed to create Vel Vector.\n";
-            exit(OF_ReturnType_failed);
-        }
-    }
-    size = (*sizeOut)(OF_Resp_Accel);
-    if (size != 0)  {
-        oAccel = new Vector(size);
-        if (oAccel == 0)  {
-            opserr << "ExperimentalSite::setOut() - "
-                << "failed to create Accel Vector.\n";
-            exit(OF_ReturnType_failed);
-        }
-    }
-    size = (*sizeOut)(OF_Resp_Force);
-    if (size != 0)  {
-        oForce = new Vector(size);
-        if (oForce == 0)  {
-            opserr << "ExperimentalSite::setOut() - "
-                << "failed to create Force Vector.\n";
-            exit(OF_ReturnType_failed);
-        }
-    }
-    size = (*sizeOut)(OF_Resp_Time);
-    if (size != 0)  {
-        oTime = new Vector(size);
-        if (oTime == 0)  {
-            opserr << "ExperimentalSite::setOut() - "
-                << "failed to create Time Vector.\n";
-            exit(OF_ReturnType_failed);
-        }
+    // the log is opened once the sizes are known
+    theLog = new ExpTrafficLog(fileName);
+    if (theLog == 0)  {
+        opserr << "ExperimentalSite::setTrafficLog() - "
+            << "failed to create traffic log.\n";
+        return OF_ReturnType_failed;
     }
+    
+    return OF_ReturnType_completed;
+}
+
+
+void ExperimentalSite::setTrial(double *arena)
+{
+    Vector **resp[OF_Resp_All] = {&tDisp, &tVel, &tAccel, &tForce, &tTime};
+    setViews(resp, tArena, *sizeTrial, arena);
+}
+
+
+void ExperimentalSite::setOut(double *arena)
+{
+    Vector **resp[OF_Resp_All] = {&oDisp, &oVel, &oAccel, &oForce, &oTime};
+    setViews(resp, oArena, *sizeOut, arena);
 }
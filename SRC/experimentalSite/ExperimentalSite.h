@@ -37,13 +37,16 @@
 #include <FrescoGlobals.h>
 #include <ExpSiteResponse.h>
 #include <ExperimentalSetup.h>
+#include <ExpTrafficLog.h>
 
 #include <TaggedObject.h>
 #include <ID.h>
 #include <Vector.h>
+#include <Matrix.h>
 
 class Response;
 class Recorder;
+class ExperimentalSiteGroup;
 
 class ExperimentalSite : public TaggedObject
 {
@@ -80,6 +83,11 @@ public:
         Vector* time);
     virtual int checkDaqResponse() = 0;
     
+    // methods used by an ExperimentalSiteGroup to send the trial
+    // and to receive the daq response on a worker thread
+    virtual int sendTrialResponse();
+    virtual int recvDaqResponse();
+    
     virtual const Vector& getTrialDisp();
     virtual const Vector& getTrialVel();
     virtual const Vector& getTrialAccel();
@@ -92,6 +100,16 @@ public:
     virtual const Vector& getForce();
     virtual const Vector& getTime();
     
+    // method to get the tangent stiffness (out forces w.r.t. trial
+    // displacements), returns 0 if the site cannot provide it
+    virtual const Matrix* getTangentStiff();
+    
+    // method to query if the setup drives the global domain
+    virtual bool usesGlobalDomain();
+    
+    // method to get the setup, which is not copied by the constructor
+    ExperimentalSetup *getSetup();
+    
     virtual int commitState(Vector *time = 0);
     
     virtual ExperimentalSite *getCopy() = 0;
@@ -117,7 +135,18 @@ public:
     virtual int getCtrlSize(int rType);
     virtual int getDaqSize(int rType);
     
+    // methods to set and to get the group the site belongs to
+    void setGroup(ExperimentalSiteGroup *group);
+    ExperimentalSiteGroup *getGroup();
+    
+    // method to capture the trial and daq traffic of the site
+    int setTrafficLog(const char *fileName);
+    
 protected:
+    // method to copy a response into a view of the arenas, which
+    // exits if the sizes do not match instead of resizing the view
+    void copyResponse(Vector *to, const Vector *from, const char *method);
+    
     // pointer of ExperimentalSetup
     ExperimentalSetup* theSetup;
     
@@ -126,7 +155,8 @@ protected:
     ID* sizeTrial;
     ID* sizeOut;
     
-    // trial/out data
+    // trial/out data, views into one arena per group that holds
+    // disp, vel, accel, force and time in the order of the channel
     Vector* tDisp;
     Vector* tVel;
     Vector* tAccel;
@@ -139,16 +169,27 @@ protected:
     Vector* oForce;
     Vector* oTime;
     
+    double *tArena;     // arena owned by the site (0 if external)
+    double *oArena;
+    
     // daqFlag = false (first time) / true (NOT first time)
     bool daqFlag;
     
+    // group for concurrent stepping (0 if stepped on its own)
+    ExperimentalSiteGroup *theGroup;
+    
+    // log of the trial and daq traffic (0 if not captured)
+    ExpTrafficLog *theLog;
+    
     // array of pointers for experimental recorders
     int commitTag;
     int numRecorders;
     Recorder **theRecorders;
     
-    virtual void setTrial();
-    virtual void setOut();
+    // lay out the trial/out vectors in the given external arena
+    // or in an arena that is owned by the site if none is given
+    virtual void setTrial(double *arena = 0);
+    virtual void setOut(double *arena = 0);
 };
 
 extern bool OPF_addExperimentalSite(ExperimentalSite* newComponent);
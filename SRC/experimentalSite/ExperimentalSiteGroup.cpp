@@ -0,0 +1,289 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation of
+// ExperimentalSiteGroup.
+
+#include "ExperimentalSiteGroup.h"
+#include "ExperimentalSite.h"
+
+#include <MapOfTaggedObjects.h>
+
+static MapOfTaggedObjects theExperimentalSiteGroups;
+
+
+bool OPF_addExperimentalSiteGroup(ExperimentalSiteGroup* newComponent)
+{
+    return theExperimentalSiteGroups.addComponent(newComponent);
+}
+
+
+bool OPF_removeExperimentalSiteGroup(int tag)
+{
+    TaggedObject* obj = theExperimentalSiteGroups.removeComponent(tag);
+    if (obj != 0) {
+        delete obj;
+        return true;
+    }
+    return false;
+}
+
+
+ExperimentalSiteGroup* OPF_getExperimentalSiteGroup(int tag)
+{
+    // no warning here since groups are created on first use
+    TaggedObject* theResult = theExperimentalSiteGroups.getComponentPtr(tag);
+    if (theResult == 0)
+        return 0;
+    
+    ExperimentalSiteGroup* theGroup = (ExperimentalSiteGroup*)theResult;
+    
+    return theGroup;
+}
+
+
+void OPF_clearExperimentalSiteGroups()
+{
+    theExperimentalSiteGroups.clearAll();
+}
+
+
+ExperimentalSiteGroup::ExperimentalSiteGroup(int tag)
+    : TaggedObject(tag), numSites(0), members(0)
+{
+    // does nothing
+}
+
+
+ExperimentalSiteGroup::~ExperimentalSiteGroup()
+{
+    // release the sites that are still in the group
+    while (numSites > 0)
+        this->removeSite(members[numSites-1]->site);
+    
+    if (members != 0)
+        delete [] members;
+}
+
+
+int ExperimentalSiteGroup::addSite(ExperimentalSite *site)
+{
+    if (site == 0)  {
+        opserr << "ExperimentalSiteGroup::addSite() - "
+            << "null site pointer passed.\n";
+        return OF_ReturnType_failed;
+    }
+    if (site->getGroup() != 0)  {
+        opserr << "ExperimentalSiteGroup::addSite() - "
+            << "site " << site->getTag()
+            << " already belongs to a group.\n";
+        return OF_ReturnType_failed;
+    }
+    
+    Member *m = new Member;
+    m->site = site;
+    m->sendReq = false;
+    m->recvReq = false;
+    m->busy = false;
+    m->sent = false;
+    m->exit = false;
+    m->rValue = OF_ReturnType_completed;
+    
+    {
+        std::lock_guard<std::mutex> lock(groupMutex);
+        Member **newMembers = new Member* [numSites+1];
+        for (int i=0; i<numSites; i++)
+            newMembers[i] = members[i];
+        newMembers[numSites] = m;
+        if (members != 0)
+            delete [] members;
+        members = newMembers;
+        numSites++;
+    }
+    
+    m->worker = std::thread(&ExperimentalSiteGroup::workerLoop, this, m);
+    site->setGroup(this);
+    
+    return OF_ReturnType_completed;
+}
+
+
+int ExperimentalSiteGroup::removeSite(ExperimentalSite *site)
+{
+    Member *m = 0;
+    {
+        std::unique_lock<std::mutex> lock(groupMutex);
+        m = this->findMember(site);
+        if (m == 0)
+            return OF_ReturnType_failed;
+        
+        // let outstanding requests finish before stopping the worker
+        doneCV.wait(lock, [&]{return this->isIdle(m);});
+        m->exit = true;
+        
+        int j = 0;
+        for (int i=0; i<numSites; i++)
+            if (members[i] != m)
+                members[j++] = members[i];
+        numSites--;
+    }
+    workCV.notify_all();
+    
+    if (m->worker.joinable())
+        m->worker.join();
+    site->setGroup(0);
+    delete m;
+    
+    return OF_ReturnType_completed;
+}
+
+
+int ExperimentalSiteGroup::getNumSites()
+{
+    std::lock_guard<std::mutex> lock(groupMutex);
+    return numSites;
+}
+
+
+int ExperimentalSiteGroup::setTrialResponse(ExperimentalSite *site)
+{
+    {
+        std::lock_guard<std::mutex> lock(groupMutex);
+        Member *m = this->findMember(site);
+        if (m == 0)  {
+            opserr << "ExperimentalSiteGroup::setTrialResponse() - "
+                << "site " << site->getTag() << " not in group "
+                << this->getTag() << ".\n";
+            return OF_ReturnType_failed;
+        }
+        m->sendReq = true;
+    }
+    workCV.notify_all();
+    
+    return OF_ReturnType_completed;
+}
+
+
+int ExperimentalSiteGroup::checkDaqResponse(ExperimentalSite *site)
+{
+    std::unique_lock<std::mutex> lock(groupMutex);
+    Member *m = this->findMember(site);
+    if (m == 0)  {
+        opserr << "ExperimentalSiteGroup::checkDaqResponse() - "
+            << "site " << site->getTag() << " not in group "
+            << this->getTag() << ".\n";
+        return OF_ReturnType_failed;
+    }
+    
+    // gather the daq responses of all sites that have been sent a
+    // trial response, not only the one of the requesting site
+    m->recvReq = true;
+    for (int i=0; i<numSites; i++)
+        if (members[i]->sendReq || members[i]->sent)
+            members[i]->recvReq = true;
+    workCV.notify_all();
+    
+    doneCV.wait(lock, [&]{
+        for (int i=0; i<numSites; i++)
+            if (!this->isIdle(members[i]))
+                return false;
+        return true;
+    });
+    
+    return m->rValue;
+}
+
+
+int ExperimentalSiteGroup::wait(ExperimentalSite *site)
+{
+    std::unique_lock<std::mutex> lock(groupMutex);
+    Member *m = this->findMember(site);
+    if (m == 0)
+        return OF_ReturnType_failed;
+    
+    doneCV.wait(lock, [&]{return this->isIdle(m);});
+    
+    return m->rValue;
+}
+
+
+void ExperimentalSiteGroup::Print(OPS_Stream &s, int flag)
+{
+    std::lock_guard<std::mutex> lock(groupMutex);
+    s << "ExperimentalSiteGroup: " << this->getTag() << endln;
+    s << "\tExperimentalSite tags:";
+    for (int i=0; i<numSites; i++)
+        s << " " << members[i]->site->getTag();
+    s << endln;
+}
+
+
+ExperimentalSiteGroup::Member* ExperimentalSiteGroup::findMember(
+    ExperimentalSite *site)
+{
+    for (int i=0; i<numSites; i++)
+        if (members[i]->site == site)
+            return members[i];
+    
+    return 0;
+}
+
+
+bool ExperimentalSiteGroup::isIdle(const Member *m) const
+{
+    return !m->sendReq && !m->recvReq && !m->busy;
+}
+
+
+void ExperimentalSiteGroup::workerLoop(Member *m)
+{
+    std::unique_lock<std::mutex> lock(groupMutex);
+    while (true)  {
+        workCV.wait(lock, [&]{return m->exit || m->sendReq || m->recvReq;});
+        if (m->exit)
+            break;
+        
+        // a pending trial response always goes out before the
+        // daq response of the same step is received
+        m->busy = true;
+        if (m->sendReq)  {
+            m->sendReq = false;
+            lock.unlock();
+            int rValue = m->site->sendTrialResponse();
+            lock.lock();
+            m->sent = true;
+            m->rValue = rValue;
+        } else  {
+            m->recvReq = false;
+            lock.unlock();
+            int rValue = m->site->recvDaqResponse();
+            lock.lock();
+            m->sent = false;
+            m->rValue = rValue;
+        }
+        m->busy = false;
+        doneCV.notify_all();
+    }
+}
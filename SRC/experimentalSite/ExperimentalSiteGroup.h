@@ -0,0 +1,103 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef ExperimentalSiteGroup_h
+#define ExperimentalSiteGroup_h
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the class definition for
+// ExperimentalSiteGroup. An ExperimentalSiteGroup coordinates
+// several experimental sites that are stepped together. Each site
+// gets a worker thread that sends its trial response and receives
+// its daq response, so that the trial responses of all sites are
+// scattered concurrently and the daq responses are gathered
+// concurrently once the first site of the group is asked for them.
+// The latency of a step is thus the maximum instead of the sum of
+// the latencies of the individual sites.
+
+#include <FrescoGlobals.h>
+
+#include <TaggedObject.h>
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+class ExperimentalSite;
+
+class ExperimentalSiteGroup : public TaggedObject
+{
+public:
+    // constructor
+    ExperimentalSiteGroup(int tag);
+    
+    // destructor
+    virtual ~ExperimentalSiteGroup();
+    
+    // method to get class type
+    const char *getClassType() const {return "ExperimentalSiteGroup";};
+    
+    // methods to add and remove sites
+    int addSite(ExperimentalSite *site);
+    int removeSite(ExperimentalSite *site);
+    int getNumSites();
+    
+    // methods called by the grouped sites
+    int setTrialResponse(ExperimentalSite *site);
+    int checkDaqResponse(ExperimentalSite *site);
+    int wait(ExperimentalSite *site);
+    
+    // public methods for output
+    void Print(OPS_Stream &s, int flag = 0);
+    
+private:
+    struct Member  {
+        ExperimentalSite *site;
+        std::thread worker;
+        bool sendReq;   // trial response needs to be sent
+        bool recvReq;   // daq response needs to be received
+        bool busy;      // worker is talking to the site
+        bool sent;      // trial response sent but daq not received
+        bool exit;      // worker needs to terminate
+        int rValue;     // return value of last send/receive
+    };
+    
+    Member *findMember(ExperimentalSite *site);
+    bool isIdle(const Member *m) const;
+    void workerLoop(Member *m);
+    
+    int numSites;
+    Member **members;
+    
+    std::mutex groupMutex;
+    std::condition_variable workCV;    // wakes up the workers
+    std::condition_variable doneCV;    // signals finished requests
+};
+
+extern bool OPF_addExperimentalSiteGroup(ExperimentalSiteGroup* newComponent);
+extern bool OPF_removeExperimentalSiteGroup(int tag);
+extern ExperimentalSiteGroup* OPF_getExperimentalSiteGroup(int tag);
+extern void OPF_clearExperimentalSiteGroups();
+
+#endif
@@ -30,6 +30,7 @@
 // LocalExpSite.
 
 #include "LocalExpSite.h"
+#include "ExperimentalSiteGroup.h"
 
 #include <elementAPI.h>
 
@@ -41,7 +42,7 @@ void* OPF_LocalExpSite()
     
     if (OPS_GetNumRemainingInputArgs() < 2) {
         opserr << "WARNING invalid number of arguments\n";
-        opserr << "Want: expSite LocalSite tag setupTag\n";
+        opserr << "Want: expSite LocalSite tag setupTag <-group groupTag>\n";
         return 0;
     }
     
@@ -69,6 +70,20 @@ void* OPF_LocalExpSite()
         return 0;
     }
     
+    // optional parameters
+    int groupTag = -1;
+    while (OPS_GetNumRemainingInputArgs() > 0) {
+        const char* type = OPS_GetString();
+        if (strcmp(type, "-group") == 0) {
+            numdata = 1;
+            if (OPS_GetIntInput(&numdata, &groupTag) != 0) {
+                opserr << "WARNING invalid groupTag\n";
+                opserr << "expSite LocalSite " << tag << endln;
+                return 0;
+            }
+        }
+    }
+    
     // parsing was successful, allocate the site
     theSite = new LocalExpSite(tag, theSetup);
     if (theSite == 0) {
@@ -76,6 +91,21 @@ void* OPF_LocalExpSite()
         return 0;
     }
     
+    // add the site to the group it is stepped with
+    if (groupTag >= 0) {
+        ExperimentalSiteGroup* theGroup = OPF_getExperimentalSiteGroup(groupTag);
+        if (theGroup == 0) {
+            theGroup = new ExperimentalSiteGroup(groupTag);
+            OPF_addExperimentalSiteGroup(theGroup);
+        }
+        if (theGroup->addSite(theSite) != OF_ReturnType_completed) {
+            opserr << "WARNING could not add site to group " << groupTag << endln;
+            opserr << "expSite LocalSite " << tag << endln;
+            delete theSite;
+            return 0;
+        }
+    }
+    
     return theSite;
 }
 
@@ -101,7 +131,9 @@ LocalExpSite::LocalExpSite(const LocalExpSite& es)
 
 LocalExpSite::~LocalExpSite()
 {
-    // does nothing
+    // leave the group before the site is torn down
+    if (theGroup != 0)
+        theGroup->removeSite(this);
 }
 
 
@@ -129,12 +161,26 @@ int LocalExpSite::setTrialResponse(const Vector* disp,
     const Vector* force,
     const Vector* time)
 {
+    // wait until the group is done with the previous step
+    if (theGroup != 0)
+        theGroup->wait(this);
+    
     // save data in basic sys
     this->ExperimentalSite::setTrialResponse(disp, vel, accel, force, time);
     
     // set daq flag
     daqFlag = false;
     
+    // let the group scatter the trial response concurrently
+    if (theGroup != 0)
+        return theGroup->setTrialResponse(this);
+    
+    return this->sendTrialResponse();
+}
+
+
+int LocalExpSite::sendTrialResponse()
+{
     int rValue;
     // set trial response at the setup
     rValue = theSetup->setTrialResponse(tDisp, tVel, tAccel, tForce, tTime);
@@ -151,26 +197,38 @@ int LocalExpSite::setTrialResponse(const Vector* disp,
 int LocalExpSite::checkDaqResponse()
 {
     if (daqFlag == false)  {
-        int rValue;
-        // get daq response from the setup
-        rValue = theSetup->getDaqResponse(oDisp, oVel, oAccel, oForce, oTime);
-        if (rValue != OF_ReturnType_completed)  {
-            opserr << "LocalExpSite::checkDaqResponse() - "
-                << "failed to get daq response from the setup.\n";
-            exit(OF_ReturnType_failed);
-        }
+        // let the group gather the daq responses concurrently
+        if (theGroup != 0)
+            return theGroup->checkDaqResponse(this);
         
-        // save data in basic sys
-        this->ExperimentalSite::setDaqResponse(oDisp, oVel, oAccel, oForce, oTime);
-        
-        // set daq flag
-        daqFlag = true;
+        return this->recvDaqResponse();
     }
     
     return OF_ReturnType_completed;
 }
 
 
+int LocalExpSite::recvDaqResponse()
+{
+    int rValue;
+    // get daq response from the setup
+    rValue = theSetup->getDaqResponse(oDisp, oVel, oAccel, oForce, oTime);
+    if (rValue != OF_ReturnType_completed)  {
+        opserr << "LocalExpSite::recvDaqResponse() - "
+            << "failed to get daq response from the setup.\n";
+        exit(OF_ReturnType_failed);
+    }
+    
+    // save data in basic sys
+    this->ExperimentalSite::setDaqResponse(oDisp, oVel, oAccel, oForce, oTime);
+    
+    // set daq flag
+    daqFlag = true;
+    
+    return OF_ReturnType_completed;
+}
+
+
 ExperimentalSite* LocalExpSite::getCopy()
 {
     LocalExpSite *theCopy = new LocalExpSite(*this);
@@ -184,5 +242,7 @@ void LocalExpSite::Print(OPS_Stream &s, int flag)
     s << "ExperimentalSite: " << this->getTag(); 
     s << " type: LocalExpSite\n";
     s << "\tExperimentalSetup tag: " << theSetup->getTag() << endln;
+    if (theGroup != 0)
+        s << "\tExperimentalSiteGroup tag: " << theGroup->getTag() << endln;
     s << *theSetup;
 }
@@ -62,6 +62,9 @@ public:
     
     virtual int checkDaqResponse();
     
+    virtual int sendTrialResponse();
+    virtual int recvDaqResponse();
+    
     virtual ExperimentalSite *getCopy();
     
     // public methods for output
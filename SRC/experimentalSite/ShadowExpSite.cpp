@@ -29,11 +29,14 @@
 // Description: This file contains the implementation of ShadowExpSite.
 
 #include "ShadowExpSite.h"
+#include "ExperimentalSiteGroup.h"
 
 #include <Channel.h>
 #include <TCP_Socket.h>
 #include <TCP_SocketSSL.h>
 #include <UDP_Socket.h>
+#include <SHM_Channel.h>
+#include <WAN_Channel.h>
 #include <elementAPI.h>
 
 
@@ -43,9 +46,9 @@ void* OPF_ShadowExpSite()
     ExperimentalSite* theSite = 0;
     
     int numArgs = OPS_GetNumRemainingInputArgs();
-    if (3 > numArgs || numArgs > 7) {
+    if (3 > numArgs || numArgs > 28) {
         opserr << "WARNING invalid number of arguments\n";
-        opserr << "Want: expSite ShadowSite tag <-setup setupTag> ipAddr ipPort <-udp> <-ssl> <-dataSize size>\n";
+        opserr << "Want: expSite ShadowSite tag <-setup setupTag> ipAddr ipPort <-udp|-udpFrag> <-ssl> <-shm> <-noDelay> <-dataSize size> <-group groupTag> <-record fileName> <-tangent> <-wan delay <-jitter jitter> <-bandwidth bandwidth> <-loss loss> <-reorder reorder> <-seed seed>>\n";
         return 0;
     }
     
@@ -96,16 +99,32 @@ void* OPF_ShadowExpSite()
     }
     
     // optional parameters
-    int ssl = 0, udp = 0;
+    int ssl = 0, udp = 0, shm = 0;
     int noDelay = 0;
     int dataSize = OF_Network_dataSize;
+    int groupTag = -1;
+    const char* recordFile = 0;
+    bool tangent = false;
+    bool wan = false;
+    double wanArgs[6];
     while (OPS_GetNumRemainingInputArgs() > 0) {
         type = OPS_GetString();
         if (strcmp(type, "-ssl") == 0) {
-            ssl = 1; udp = 0;
+            ssl = 1; udp = 0; shm = 0;
         }
         else if (strcmp(type, "-udp") == 0) {
-            udp = 1; ssl = 0;
+            udp = 1; ssl = 0; shm = 0;
+        }
+        else if (strcmp(type, "-udpFrag") == 0) {
+            udp = 2; ssl = 0; shm = 0;
+        }
+        else if (strcmp(type, "-shm") == 0) {
+#ifdef _WIN32
+            opserr << "WARNING shared memory channels (-shm) are not supported on Windows\n";
+            opserr << "expSite ShadowSite " << tag << endln;
+            return 0;
+#endif
+            shm = 1; ssl = 0; udp = 0;
         }
         else if (strcmp(type, "-noDelay") == 0) {
             noDelay = 1;
@@ -117,11 +136,44 @@ void* OPF_ShadowExpSite()
                 return 0;
             }
         }
+        else if (strcmp(type, "-group") == 0) {
+            if (OPS_GetIntInput(&numdata, &groupTag) < 0) {
+                opserr << "WARNING invalid ShadowSite groupTag\n";
+                opserr << "expSite ShadowSite " << tag << endln;
+                return 0;
+            }
+        }
+        else if (strcmp(type, "-record") == 0) {
+            if (OPS_GetNumRemainingInputArgs() < 1) {
+                opserr << "WARNING want -record fileName\n";
+                opserr << "expSite ShadowSite " << tag << endln;
+                return 0;
+            }
+            recordFile = OPS_GetString();
+        }
+        else if (strcmp(type, "-tangent") == 0) {
+            tangent = true;
+        }
+        else if (strcmp(type, "-wan") == 0) {
+            if (OPF_GetWANChannelArgs(wanArgs) < 0) {
+                opserr << "expSite ShadowSite " << tag << endln;
+                return 0;
+            }
+            wan = true;
+        }
     }
     
     // parsing was successful, setup the connection and allocate the site
     Channel* theChannel = 0;
-    if (ssl) {
+    if (shm) {
+        theChannel = new SHM_Channel(ipPort, ipAddr);
+        if (!theChannel) {
+            opserr << "WARNING could not create SHM channel\n";
+            opserr << "expSite ShadowSite " << tag << endln;
+            return 0;
+        }
+    }
+    else if (ssl) {
         theChannel = new TCP_SocketSSL(ipPort, ipAddr, true, noDelay);
         if (!theChannel) {
             opserr << "WARNING could not create SSL channel\n";
@@ -130,7 +182,7 @@ void* OPF_ShadowExpSite()
         }
     }
     else if (udp) {
-        theChannel = new UDP_Socket(ipPort, ipAddr, true);
+        theChannel = new UDP_Socket(ipPort, ipAddr, true, false, udp == 2);
         if (!theChannel) {
             opserr << "WARNING could not create UDP channel\n";
             opserr << "expSite ShadowSite " << tag << endln;
@@ -146,6 +198,17 @@ void* OPF_ShadowExpSite()
         }
     }
     
+    // emulate a wide area network between the sites
+    if (wan) {
+        theChannel = new WAN_Channel(theChannel, wanArgs[0], wanArgs[1],
+            wanArgs[2], wanArgs[3], wanArgs[4], udp != 0, (int)wanArgs[5]);
+        if (!theChannel) {
+            opserr << "WARNING could not create WAN channel\n";
+            opserr << "expSite ShadowSite " << tag << endln;
+            return 0;
+        }
+    }
+    
     // parsing was successful, allocate the site
     if (theSetup == 0)
         theSite = new ShadowExpSite(tag, *theChannel, dataSize);
@@ -157,6 +220,29 @@ void* OPF_ShadowExpSite()
         return 0;
     }
     
+    // capture the traffic of the site
+    if (recordFile != 0)
+        theSite->setTrafficLog(recordFile);
+    
+    // request the tangent stiffness with the daq response
+    if (tangent == true)
+        ((ShadowExpSite*)theSite)->setTangentStiffFlag(true);
+    
+    // add the site to the group it is stepped with
+    if (groupTag >= 0) {
+        ExperimentalSiteGroup* theGroup = OPF_getExperimentalSiteGroup(groupTag);
+        if (theGroup == 0) {
+            theGroup = new ExperimentalSiteGroup(groupTag);
+            OPF_addExperimentalSiteGroup(theGroup);
+        }
+        if (theGroup->addSite(theSite) != OF_ReturnType_completed) {
+            opserr << "WARNING could not add site to group " << groupTag << endln;
+            opserr << "expSite ShadowSite " << tag << endln;
+            delete theSite;
+            return 0;
+        }
+    }
+    
     // cleanup dynamic memory
     if (ipAddr != 0)
         delete[] ipAddr;
@@ -172,7 +258,8 @@ ShadowExpSite::ShadowExpSite(int tag,
     Shadow(theChannel, *theObjectBroker), dataSize(datasize),
     sendV(OF_Network_dataSize), recvV(OF_Network_dataSize),
     bDisp(0), bVel(0), bAccel(0), bForce(0), bTime(0),
-    rDisp(0), rVel(0), rAccel(0), rForce(0), rTime(0)
+    rDisp(0), rVel(0), rAccel(0), rForce(0), rTime(0),
+    recvStiff(false), stiffFlag(false), rStiff(0)
 {
     sendV(0) = OF_RemoteTest_open;
     sendV(1) = tag;
@@ -200,7 +287,8 @@ ShadowExpSite::ShadowExpSite(int tag,
     Shadow(theChannel, *theObjectBroker), dataSize(datasize),
     sendV(OF_Network_dataSize), recvV(OF_Network_dataSize),
     bDisp(0), bVel(0), bAccel(0), bForce(0), bTime(0),
-    rDisp(0), rVel(0), rAccel(0), rForce(0), rTime(0)
+    rDisp(0), rVel(0), rAccel(0), rForce(0), rTime(0),
+    recvStiff(false), stiffFlag(false), rStiff(0)
 {
     if (theSetup == 0)  {
         opserr << "ShadowExpSite::ShadowExpSite() - "
@@ -231,16 +319,26 @@ ShadowExpSite::ShadowExpSite(const ShadowExpSite& es)
     : ExperimentalSite(es), Shadow(es), dataSize(0),
     sendV(OF_Network_dataSize), recvV(OF_Network_dataSize),
     bDisp(0), bVel(0), bAccel(0), bForce(0), bTime(0),
-    rDisp(0), rVel(0), rAccel(0), rForce(0), rTime(0)
+    rDisp(0), rVel(0), rAccel(0), rForce(0), rTime(0),
+    recvStiff(false), stiffFlag(false), rStiff(0)
 {
     dataSize = es.dataSize;
     sendV.resize(dataSize);
     recvV.resize(dataSize);
+    this->setChannelViews();
+    
+    recvStiff = es.recvStiff;
+    if (es.rStiff != 0)
+        rStiff = new Matrix(*(es.rStiff));
 }
 
 
 ShadowExpSite::~ShadowExpSite()
 {
+    // leave the group before the site is torn down
+    if (theGroup != 0)
+        theGroup->removeSite(this);
+    
     if (bDisp != 0)
         delete bDisp;
     if (bVel != 0)
@@ -261,6 +359,8 @@ ShadowExpSite::~ShadowExpSite()
         delete rForce;
     if (rTime != 0)
         delete rTime;
+    if (rStiff != 0)
+        delete rStiff;
     
     sendV(0) = OF_RemoteTest_DIE;
     sendV(1) = this->getTag();
@@ -276,6 +376,7 @@ int ShadowExpSite::setup()
 {    
     sendV(0) = OF_RemoteTest_setup;
     sendV(1) = dataSize;
+    sendV(2) = recvStiff ? 1.0 : 0.0;
     this->sendVector(sendV);
     
     if (theSetup != 0)  {
@@ -302,6 +403,14 @@ int ShadowExpSite::setSize(ID sizeT, ID sizeO)
     int usrDataSize = dataSize;
 
     if (theSetup != 0)  {
+        // the tangent stiffness is returned in the ctrl/daq
+        // system which the setup cannot transform
+        if (recvStiff == true)  {
+            opserr << "\nWARNING ShadowExpSite::setSize() - "
+                << "tangent stiffness is not available with "
+                << "an ExperimentalSetup.\n";
+            recvStiff = false;
+        }
         theSetup->checkSize(sizeT, sizeO);
         int nCtrl = 0, nDaq = 0;
         for (int i=0; i<OF_Resp_All; i++)  {
@@ -316,6 +425,23 @@ int ShadowExpSite::setSize(ID sizeT, ID sizeO)
             nInput  += sizeT(i);
             nOutput += sizeO(i);
         }
+        // make room for the flag and the tangent stiffness
+        // that follow the daq response
+        if (recvStiff == true)  {
+            int nRows = sizeO(OF_Resp_Force);
+            int nCols = sizeT(OF_Resp_Disp);
+            if (nRows != 0 && nCols != 0)  {
+                if (rStiff != 0)
+                    delete rStiff;
+                rStiff = new Matrix(nRows, nCols);
+                nOutput += 1 + nRows*nCols;
+            } else  {
+                opserr << "\nWARNING ShadowExpSite::setSize() - "
+                    << "tangent stiffness needs trial displacements "
+                    << "and output forces.\n";
+                recvStiff = false;
+            }
+        }
         if (dataSize < 1+nInput) dataSize = 1+nInput;
         if (dataSize < nOutput)  dataSize = nOutput;
     }
@@ -332,6 +458,7 @@ int ShadowExpSite::setSize(ID sizeT, ID sizeO)
     // resize channel Vectors
     sendV.resize(dataSize);
     recvV.resize(dataSize);
+    this->setChannelViews();
     
     return OF_ReturnType_completed;
 }
@@ -343,99 +470,46 @@ int ShadowExpSite::setTrialResponse(const Vector* disp,
     const Vector* force,
     const Vector* time)
 {
+    // wait until the group is done with the previous step
+    if (theGroup != 0)
+        theGroup->wait(this);
+    
     // save data in basic sys
     this->ExperimentalSite::setTrialResponse(disp, vel, accel, force, time);
     
     // set daq flag
     daqFlag = false;
     
+    // let the group scatter the trial response concurrently
+    if (theGroup != 0)
+        return theGroup->setTrialResponse(this);
+    
+    return this->sendTrialResponse();
+}
+
+
+int ShadowExpSite::sendTrialResponse()
+{
     int rValue;
     if (theSetup != 0)  {
         // transform trial response
         rValue = theSetup->transfTrialResponse(tDisp, tVel, tAccel, tForce, tTime);
         if (rValue != OF_ReturnType_completed)  {
-            opserr << "ShadowExpSite::setTrialResponse() - "
+            opserr << "ShadowExpSite::sendTrialResponse() - "
                 << "failed to set trial response at the setup.\n";
             exit(OF_ReturnType_failed);
         }
         
-        if (bDisp == 0)  {
-            if (getCtrlSize(OF_Resp_Disp) != 0)
-                bDisp = new Vector(getCtrlSize(OF_Resp_Disp));
-            if (getCtrlSize(OF_Resp_Vel) != 0)
-                bVel = new Vector(getCtrlSize(OF_Resp_Vel));
-            if (getCtrlSize(OF_Resp_Accel) != 0)
-                bAccel = new Vector(getCtrlSize(OF_Resp_Accel));
-            if (getCtrlSize(OF_Resp_Force) != 0)
-                bForce = new Vector(getCtrlSize(OF_Resp_Force));
-            if (getCtrlSize(OF_Resp_Time) != 0)
-                bTime = new Vector(getCtrlSize(OF_Resp_Time));
-        }
-        
-        // get trial response from the setup
+        // get trial response from the setup (directly into sendV)
         rValue = theSetup->getTrialResponse(bDisp, bVel, bAccel, bForce, bTime);
         if (rValue != OF_ReturnType_completed)  {
-            opserr << "ShadowExpSite::setTrialResponse() - "
+            opserr << "ShadowExpSite::sendTrialResponse() - "
                 << "failed to get trial response from the setup.\n";
             exit(OF_ReturnType_failed);
         }
-        
-        int ndim = 1, size;
-        sendV.Zero();
-        size = getCtrlSize(OF_Resp_Disp);
-        if (size != 0)  {
-            sendV.Assemble(*bDisp, ndim);
-            ndim += size;
-        }
-        size = getCtrlSize(OF_Resp_Vel);
-        if (size != 0)  {
-            sendV.Assemble(*bVel, ndim);
-            ndim += size;
-        }
-        size = getCtrlSize(OF_Resp_Accel);
-        if (size != 0)  {
-            sendV.Assemble(*bAccel, ndim);
-            ndim += size;
-        }
-        size = getCtrlSize(OF_Resp_Force);
-        if (size != 0)  {
-            sendV.Assemble(*bForce, ndim);
-            ndim += size;
-        }
-        size = getCtrlSize(OF_Resp_Time);
-        if (size != 0)  {
-            sendV.Assemble(*bTime, ndim);
-        }
-    } else  {
-        int ndim = 1, size;
-        sendV.Zero();
-        size = getTrialSize(OF_Resp_Disp);
-        if (size != 0)  {
-            sendV.Assemble(*tDisp, ndim);
-            ndim += size;
-        }
-        size = getTrialSize(OF_Resp_Vel);
-        if (size != 0)  {
-            sendV.Assemble(*tVel, ndim);
-            ndim += size;
-        }
-        size = getTrialSize(OF_Resp_Accel);
-        if (size != 0)  {
-            sendV.Assemble(*tAccel, ndim);
-            ndim += size;
-        }
-        size = getTrialSize(OF_Resp_Force);
-        if (size != 0)  {
-            sendV.Assemble(*tForce, ndim);
-            ndim += size;
-        }
-        size = getTrialSize(OF_Resp_Time);
-        if (size != 0)  {
-            sendV.Assemble(*tTime, ndim);
-        }
     }
     
-    // set trial response
+    // set trial response, the responses are already in sendV
     sendV(0) = OF_RemoteTest_setTrialResponse;
     this->sendVector(sendV);
     
@@ -446,69 +520,52 @@ int ShadowExpSite::setTrialResponse(const Vector* disp,
 int ShadowExpSite::checkDaqResponse()
 {
     if (daqFlag == false)  {
-        sendV(0) = OF_RemoteTest_getDaqResponse;
-        this->sendVector(sendV);
+        // let the group gather the daq responses concurrently
+        if (theGroup != 0)
+            return theGroup->checkDaqResponse(this);
         
-        if (rDisp == 0)  {
-            if (getDaqSize(OF_Resp_Disp) != 0)
-                rDisp = new Vector(getDaqSize(OF_Resp_Disp));
-            if (getDaqSize(OF_Resp_Vel) != 0)
-                rVel = new Vector(getDaqSize(OF_Resp_Vel));
-            if (getDaqSize(OF_Resp_Accel) != 0)
-                rAccel = new Vector(getDaqSize(OF_Resp_Accel));
-            if (getDaqSize(OF_Resp_Force) != 0)
-                rForce = new Vector(getDaqSize(OF_Resp_Force));
-            if (getDaqSize(OF_Resp_Time) != 0)
-                rTime = new Vector(getDaqSize(OF_Resp_Time));
-        }
-        this->recvVector(recvV);
-        
-        int ndim = 0;
-        if (rDisp != 0)  {
-            rDisp->Extract(recvV, 0);
-            ndim += getDaqSize(OF_Resp_Disp);
-        }
-        if (rVel != 0)  {
-            rVel->Extract(recvV, ndim);
-            ndim += getDaqSize(OF_Resp_Vel);
-        }
-        if (rAccel != 0)  {
-            rAccel->Extract(recvV, ndim);
-            ndim += getDaqSize(OF_Resp_Accel);
-        }
-        if (rForce != 0)  {
-            rForce->Extract(recvV, ndim);
-            ndim += getDaqSize(OF_Resp_Force);
-        }
-        if (rTime != 0)  {
-            rTime->Extract(recvV, ndim);
-        }
-        
-        if (theSetup != 0)  {
-            // set daq response at the setup
-            theSetup->setDaqResponse(rDisp, rVel, rAccel, rForce, rTime);
-            // transform daq response
-            theSetup->transfDaqResponse(oDisp, oVel, oAccel, oForce, oTime);
-        } else  {
-            if (oDisp != 0) 
-                *oDisp = *rDisp;
-            if (oVel != 0) 
-                *oVel = *rVel;
-            if (oAccel != 0) 
-                *oAccel = *rAccel;
-            if (oForce != 0) 
-                *oForce = *rForce;
-            if (oTime != 0) 
-                *oTime = *rTime;
+        return this->recvDaqResponse();
+    }
+    
+    return OF_ReturnType_completed;
+}
+
+
+int ShadowExpSite::recvDaqResponse()
+{
+    sendV(0) = OF_RemoteTest_getDaqResponse;
+    this->sendVector(sendV);
+    
+    this->recvVector(recvV);
+    
+    int ndim = 0;
+    for (int i=0; i<OF_Resp_All; i++)
+        ndim += getDaqSize(i);
+    
+    // extract the tangent stiffness that follows the daq response
+    if (recvStiff == true)  {
+        stiffFlag = (recvV(ndim++) == 1.0);
+        if (stiffFlag == true)  {
+            for (int j=0; j<rStiff->noCols(); j++)
+                for (int i=0; i<rStiff->noRows(); i++)
+                    (*rStiff)(i,j) = recvV(ndim++);
         }
-        
-        // save data in basic sys
-        this->ExperimentalSite::setDaqResponse(oDisp, oVel, oAccel, oForce, oTime); 
-        
-        // set daq flag
-        daqFlag = true;
     }
     
+    // without a setup the out response was received in place
+    if (theSetup != 0)  {
+        // set daq response at the setup
+        theSetup->setDaqResponse(rDisp, rVel, rAccel, rForce, rTime);
+        // transform daq response
+        theSetup->transfDaqResponse(oDisp, oVel, oAccel, oForce, oTime);
+    }
+    
+    // save data in basic sys
+    this->ExperimentalSite::setDaqResponse(oDisp, oVel, oAccel, oForce, oTime); 
+    
+    // set daq flag
+    daqFlag = true;
+    
     return OF_ReturnType_completed;
 }
 
@@ -517,15 +574,15 @@ int ShadowExpSite::commitState(Vector* time)
 {
     int rValue = 0;
     
-    // update the trial time vector
+    // wait for the group to finish the step
+    if (theGroup != 0)
+        theGroup->wait(this);
+    
+    // update the trial time vector (in sendV without a setup)
     if (time != 0 && tTime != 0)  {
-        *tTime = *time;
-        int ndim = 1
-            + getTrialSize(OF_Resp_Disp)
-            + getTrialSize(OF_Resp_Vel)
-            + getTrialSize(OF_Resp_Accel)
-            + getTrialSize(OF_Resp_Force);
-        sendV.Assemble(*tTime, ndim);
+        this->copyResponse(tTime, time, "commitState");
+        if (theSetup != 0 && bTime != 0 && bTime->Size() == tTime->Size())
+            *bTime = *tTime;
     }
     
     // first commit the ActorExpSite
@@ -539,6 +596,64 @@ int ShadowExpSite::commitState(Vector* time)
 }
 
 
+const Matrix* ShadowExpSite::getTangentStiff()
+{
+    this->checkDaqResponse();
+    
+    if (stiffFlag == true)
+        return rStiff;
+    
+    return 0;
+}
+
+
+void ShadowExpSite::setTangentStiffFlag(bool flag)
+{
+    recvStiff = flag;
+}
+
+
+void ShadowExpSite::setChannelViews()
+{
+    Vector **bResp[OF_Resp_All] = {&bDisp, &bVel, &bAccel, &bForce, &bTime};
+    Vector **rResp[OF_Resp_All] = {&rDisp, &rVel, &rAccel, &rForce, &rTime};
+    int i, size;
+    for (i=0; i<OF_Resp_All; i++)  {
+        if (*bResp[i] != 0)  {
+            delete *bResp[i];
+            *bResp[i] = 0;
+        }
+        if (*rResp[i] != 0)  {
+            delete *rResp[i];
+            *rResp[i] = 0;
+        }
+    }
+    sendV.Zero();
+    recvV.Zero();
+    
+    // the responses follow each other in sendV after the action
+    // and in recvV from the start, so that nothing needs to be
+    // assembled before sending or extracted after receiving
+    if (theSetup != 0)  {
+        double *sData = &sendV(1);
+        double *rData = &recvV(0);
+        for (i=0; i<OF_Resp_All; i++)  {
+            if ((size = getCtrlSize(i)) != 0)  {
+                *bResp[i] = new Vector(sData, size);
+                sData += size;
+            }
+            if ((size = getDaqSize(i)) != 0)  {
+                *rResp[i] = new Vector(rData, size);
+                rData += size;
+            }
+        }
+    } else  {
+        this->setTrial(&sendV(1));
+        this->setOut(&recvV(0));
+    }
+}
+
+
 ExperimentalSite* ShadowExpSite::getCopy()
 {
     ShadowExpSite *theCopy = new ShadowExpSite(*this);
@@ -555,4 +670,11 @@ void ShadowExpSite::Print(OPS_Stream &s, int flag)
         s << "\tExperimentalSetup tag: " << theSetup->getTag() << endln;
         s << *theSetup;
     }
+    if (theGroup != 0)
+        s << "\tExperimentalSiteGroup tag: " << theGroup->getTag() << endln;
+    if (recvStiff == true)
+        s << "\ttangent stiffness returned with daq response\n";
+    WAN_Channel *theWAN = dynamic_cast<WAN_Channel*>(theChannel);
+    if (theWAN != 0)
+        theWAN->Print(s, flag);
 }
@@ -70,10 +70,19 @@ public:
     
     virtual int checkDaqResponse();
     
+    virtual int sendTrialResponse();
+    virtual int recvDaqResponse();
+    
+    virtual const Matrix* getTangentStiff();
+    
     virtual int commitState(Vector *time = 0);
     
     virtual ExperimentalSite *getCopy();
     
+    // method to request the tangent stiffness with the daq response,
+    // needs to be called before the sizes are set
+    void setTangentStiffFlag(bool flag);
+    
     // public methods for output
     void Print(OPS_Stream &s, int flag = 0);
     
@@ -85,8 +94,17 @@ protected:
     Vector sendV;
     Vector recvV;
     
+    // ctrl/daq responses as views into the channel vectors
     Vector *bDisp, *bVel, *bAccel, *bForce, *bTime;
     Vector *rDisp, *rVel, *rAccel, *rForce, *rTime;
+    
+    // tangent stiffness received with the daq response
+    bool recvStiff;     // tangent stiffness requested from ActorExpSite
+    bool stiffFlag;     // received tangent stiffness is valid
+    Matrix *rStiff;
+    
+    // lay out the responses as views into the channel vectors
+    void setChannelViews();
 };
 
 #endif
@@ -0,0 +1,675 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation of
+// WAN_Channel.
+
+#include "WAN_Channel.h"
+
+#include <Matrix.h>
+#include <Vector.h>
+#include <ID.h>
+#include <Message.h>
+#include <MovableObject.h>
+#include <elementAPI.h>
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <chrono>
+
+// channels that are still alive when the program exits
+// get their queued messages delivered and report their delays
+static std::mutex registryMutex;
+static std::list<WAN_Channel*> theWANChannels;
+static bool exitHandlerSet = false;
+
+// a receive that returns faster than this (in ms) found the
+// message already waiting in the wrapped channel
+static const double minRecvWait = 0.1;
+
+static void flushAtExit()
+{
+    std::lock_guard<std::mutex> lock(registryMutex);
+    std::list<WAN_Channel*>::iterator it;
+    for (it = theWANChannels.begin(); it != theWANChannels.end(); ++it)  {
+        (*it)->flush();
+        (*it)->Print(opserr);
+    }
+}
+
+
+int OPF_GetWANChannelArgs(double *wanArgs)
+{
+    // default: no jitter, infinite bandwidth, no loss,
+    // no reordering and a seed that differs from run to run
+    for (int i=0; i<5; i++)
+        wanArgs[i] = 0.0;
+    wanArgs[5] = -1.0;
+    
+    int numdata = 1;
+    if (OPS_GetNumRemainingInputArgs() < 1 ||
+        OPS_GetDoubleInput(&numdata, &wanArgs[0]) != 0 ||
+        wanArgs[0] < 0.0) {
+        opserr << "WARNING invalid -wan delay\n";
+        opserr << "Want: -wan delay <-jitter jitter> <-bandwidth bandwidth> "
+            << "<-loss loss> <-reorder reorder> <-seed seed>\n";
+        return -1;
+    }
+    while (OPS_GetNumRemainingInputArgs() > 0) {
+        const char* type = OPS_GetString();
+        int i;
+        if (strcmp(type, "-jitter") == 0)
+            i = 1;
+        else if (strcmp(type, "-bandwidth") == 0)
+            i = 2;
+        else if (strcmp(type, "-loss") == 0)
+            i = 3;
+        else if (strcmp(type, "-reorder") == 0)
+            i = 4;
+        else if (strcmp(type, "-seed") == 0)
+            i = 5;
+        else {
+            // move current arg back by one
+            OPS_ResetCurrentInputArg(-1);
+            break;
+        }
+        if (OPS_GetNumRemainingInputArgs() < 1 ||
+            OPS_GetDoubleInput(&numdata, &wanArgs[i]) != 0 ||
+            wanArgs[i] < 0.0) {
+            opserr << "WARNING invalid -wan " << type << endln;
+            return -1;
+        }
+    }
+    if (wanArgs[3] >= 1.0 || wanArgs[4] > 1.0) {
+        opserr << "WARNING -wan loss must be less than 1.0 "
+            << "and reorder can not be larger than 1.0\n";
+        return -1;
+    }
+    
+    return 0;
+}
+
+
+WAN_Channel::Packet::Packet()
+    : type(0), dbTag(0), commitTag(0),
+    theVector(0), theMatrix(0), theID(0), data(0), size(0),
+    theAddress(0), sendTime(0.0), dueTime(0.0), seq(0)
+{
+    
+}
+
+
+WAN_Channel::Packet::~Packet()
+{
+    if (theVector != 0)
+        delete theVector;
+    if (theMatrix != 0)
+        delete theMatrix;
+    if (theID != 0)
+        delete theID;
+    if (data != 0)
+        delete [] data;
+}
+
+
+WAN_Channel::WAN_Channel(Channel *thechannel, double dly,
+    double jit, double bw, double los, double reord,
+    bool dgram, int seed)
+    : Channel(), theChannel(thechannel),
+    delay(dly), jitter(jit), bandwidth(bw), loss(los), reorder(reord),
+    datagram(dgram), rto(200.0),
+    theStream(0, ExpRandomStream::getNewStream()),
+    numPending(0), sendLinkFree(0.0), recvLinkFree(0.0), lastDueTime(0.0),
+    lastDelivered(0.0), lastArrival(0.0), sendSeq(0), lastSeq(0),
+    sendFailed(false), exitFlag(false)
+{
+    if (theChannel == 0)  {
+        opserr << "WAN_Channel::WAN_Channel() - "
+            << "no channel to wrap provided\n";
+        exit(-1);
+    }
+    if (delay < 0.0)
+        delay = 0.0;
+    if (jitter < 0.0)
+        jitter = 0.0;
+    if (bandwidth < 0.0)
+        bandwidth = 0.0;
+    if (loss < 0.0 || loss >= 1.0)  {
+        opserr << "WAN_Channel::WAN_Channel() - "
+            << "loss must be in the range [0,1)\n";
+        exit(-1);
+    }
+    if (reorder > 0.0 && datagram == false)  {
+        opserr << "WARNING WAN_Channel::WAN_Channel() - "
+            << "a stream channel delivers the messages in order, "
+            << "reorder is ignored\n";
+        reorder = 0.0;
+    }
+    
+    // without a given seed the delays differ from run to run
+    if (seed < 0)
+        seed = ((unsigned)time(NULL)) % 1000000000;
+    theStream.setStream(seed, theStream.getStream());
+    
+    // a lost segment is retransmitted after the timeout of the
+    // sender, which can not be shorter than 200 ms
+    if (2.0*delay + 4.0*jitter > rto)
+        rto = 2.0*delay + 4.0*jitter;
+    
+    Stats zero = {0, 0.0, 0.0, 0.0, 0.0, 0.0, 0, 0, 0};
+    sendStats = zero;
+    recvStats = zero;
+    
+    worker = std::thread(&WAN_Channel::run, this);
+    
+    std::lock_guard<std::mutex> lock(registryMutex);
+    if (exitHandlerSet == false)  {
+        atexit(flushAtExit);
+        exitHandlerSet = true;
+    }
+    theWANChannels.push_back(this);
+}
+
+
+WAN_Channel::~WAN_Channel()
+{
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        theWANChannels.remove(this);
+    }
+    
+    // deliver the queued messages and stop the worker
+    this->flush();
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        exitFlag = true;
+    }
+    notEmpty.notify_all();
+    worker.join();
+    
+    // report the achieved delays
+    this->Print(opserr);
+    
+    if (theChannel != 0)
+        delete theChannel;
+}
+
+
+char* WAN_Channel::addToProgram()
+{
+    return theChannel->addToProgram();
+}
+
+
+int WAN_Channel::setUpConnection()
+{
+    return theChannel->setUpConnection();
+}
+
+
+int WAN_Channel::setNextAddress(const ChannelAddress &theAddress)
+{
+    return theChannel->setNextAddress(theAddress);
+}
+
+
+ChannelAddress* WAN_Channel::getLastSendersAddress()
+{
+    return theChannel->getLastSendersAddress();
+}
+
+
+int WAN_Channel::isDatastore()
+{
+    return theChannel->isDatastore();
+}
+
+
+int WAN_Channel::getDbTag()
+{
+    return theChannel->getDbTag();
+}
+
+
+int WAN_Channel::sendObj(int commitTag,
+    MovableObject &theObject, ChannelAddress *theAddress)
+{
+    // the object sends its data through this channel,
+    // so that every message is delayed
+    return theObject.sendSelf(commitTag, *this);
+}
+
+
+int WAN_Channel::recvObj(int commitTag,
+    MovableObject &theObject, FEM_ObjectBroker &theBroker,
+    ChannelAddress *theAddress)
+{
+    return theObject.recvSelf(commitTag, *this, theBroker);
+}
+
+
+int WAN_Channel::sendMsg(int dbTag, int commitTag,
+    const Message &theMessage, ChannelAddress *theAddress)
+{
+    Message &msg = (Message &)theMessage;
+    Packet *thePacket = new Packet();
+    thePacket->type = 3;
+    thePacket->dbTag = dbTag;
+    thePacket->commitTag = commitTag;
+    thePacket->size = msg.getSize();
+    thePacket->data = new char [thePacket->size];
+    memcpy(thePacket->data, msg.getData(), thePacket->size);
+    thePacket->theAddress = theAddress;
+    
+    return this->queue(thePacket);
+}
+
+
+int WAN_Channel::recvMsg(int dbTag, int commitTag,
+    Message &theMessage, ChannelAddress *theAddress)
+{
+    if (this->flush() < 0)
+        return -1;
+    
+    double start = this->getTime();
+    int res = theChannel->recvMsg(dbTag, commitTag, theMessage, theAddress);
+    if (res >= 0)
+        this->hold(theMessage.getSize(), start);
+    
+    return res;
+}
+
+
+int WAN_Channel::recvMsgUnknownSize(int dbTag, int commitTag,
+    Message &theMessage, ChannelAddress *theAddress)
+{
+    if (this->flush() < 0)
+        return -1;
+    
+    double start = this->getTime();
+    int res = theChannel->recvMsgUnknownSize(dbTag, commitTag,
+        theMessage, theAddress);
+    if (res >= 0)
+        this->hold(theMessage.getSize(), start);
+    
+    return res;
+}
+
+
+int WAN_Channel::sendMatrix(int dbTag, int commitTag,
+    const Matrix &theMatrix, ChannelAddress *theAddress)
+{
+    Packet *thePacket = new Packet();
+    thePacket->type = 1;
+    thePacket->dbTag = dbTag;
+    thePacket->commitTag = commitTag;
+    thePacket->theMatrix = new Matrix(theMatrix);
+    thePacket->size = theMatrix.noRows()*theMatrix.noCols()*sizeof(double);
+    thePacket->theAddress = theAddress;
+    
+    return this->queue(thePacket);
+}
+
+
+int WAN_Channel::recvMatrix(int dbTag, int commitTag,
+    Matrix &theMatrix, ChannelAddress *theAddress)
+{
+    if (this->flush() < 0)
+        return -1;
+    
+    double start = this->getTime();
+    int res = theChannel->recvMatrix(dbTag, commitTag, theMatrix, theAddress);
+    if (res >= 0)
+        this->hold(theMatrix.noRows()*theMatrix.noCols()*sizeof(double),
+            start);
+    
+    return res;
+}
+
+
+int WAN_Channel::sendVector(int dbTag, int commitTag,
+    const Vector &theVector, ChannelAddress *theAddress)
+{
+    Packet *thePacket = new Packet();
+    thePacket->type = 0;
+    thePacket->dbTag = dbTag;
+    thePacket->commitTag = commitTag;
+    thePacket->theVector = new Vector(theVector);
+    thePacket->size = theVector.Size()*sizeof(double);
+    thePacket->theAddress = theAddress;
+    
+    return this->queue(thePacket);
+}
+
+
+int WAN_Channel::recvVector(int dbTag, int commitTag,
+    Vector &theVector, ChannelAddress *theAddress)
+{
+    if (this->flush() < 0)
+        return -1;
+    
+    double start = this->getTime();
+    int res = theChannel->recvVector(dbTag, commitTag, theVector, theAddress);
+    if (res >= 0)
+        this->hold(theVector.Size()*sizeof(double), start);
+    
+    return res;
+}
+
+
+int WAN_Channel::sendID(int dbTag, int commitTag,
+    const ID &theID, ChannelAddress *theAddress)
+{
+    Packet *thePacket = new Packet();
+    thePacket->type = 2;
+    thePacket->dbTag = dbTag;
+    thePacket->commitTag = commitTag;
+    thePacket->theID = new ID(theID);
+    thePacket->size = theID.Size()*sizeof(int);
+    thePacket->theAddress = theAddress;
+    
+    return this->queue(thePacket);
+}
+
+
+int WAN_Channel::recvID(int dbTag, int commitTag,
+    ID &theID, ChannelAddress *theAddress)
+{
+    if (this->flush() < 0)
+        return -1;
+    
+    double start = this->getTime();
+    int res = theChannel->recvID(dbTag, commitTag, theID, theAddress);
+    if (res >= 0)
+        this->hold(theID.Size()*sizeof(int), start);
+    
+    return res;
+}
+
+
+int WAN_Channel::flush()
+{
+    std::unique_lock<std::mutex> lock(queueMutex);
+    drained.wait(lock, [this] {return numPending == 0;});
+    if (sendFailed)  {
+        opserr << "WAN_Channel::flush() - "
+            << "failed to deliver the queued messages\n";
+        return -1;
+    }
+    
+    return 0;
+}
+
+
+void WAN_Channel::Print(OPS_Stream &s, int flag)
+{
+    std::lock_guard<std::mutex> lock(queueMutex);
+    s << "WAN_Channel: " << this->getTag() << endln;
+    s << "  delay: " << delay << " ms, jitter: " << jitter << " ms";
+    if (bandwidth > 0.0)
+        s << ", bandwidth: " << bandwidth << " Mbit/s";
+    s << ", loss: " << loss;
+    if (datagram)
+        s << ", reorder: " << reorder;
+    s << endln;
+    this->printStats(s, "sent", sendStats);
+    this->printStats(s, "received", recvStats);
+}
+
+
+double WAN_Channel::getTime()
+{
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+double WAN_Channel::getDueTime(int numBytes, double now,
+    double &linkFree, Stats &stats)
+{
+    // the message waits until the link is free and then
+    // needs numBytes*8/bandwidth to be pushed through it
+    double start = (now > linkFree) ? now : linkFree;
+    if (bandwidth > 0.0)
+        start += 8.0E-3*numBytes/bandwidth;
+    linkFree = start;
+    
+    // propagation delay, a message can not arrive before it was sent
+    double dueTime = delay;
+    if (jitter > 0.0)
+        dueTime += jitter*theStream.getGauss();
+    if (dueTime < 0.0)
+        dueTime = 0.0;
+    dueTime += start;
+    
+    // lost segments of a stream are retransmitted after
+    // a timeout that doubles with every retransmission
+    if (datagram == false && loss > 0.0)  {
+        double timeout = rto;
+        while (theStream.getUniform() < loss)  {
+            dueTime += timeout;
+            timeout *= 2.0;
+            stats.numRetrans++;
+        }
+    }
+    
+    return dueTime;
+}
+
+
+int WAN_Channel::queue(Packet *thePacket)
+{
+    std::unique_lock<std::mutex> lock(queueMutex);
+    if (sendFailed)  {
+        opserr << "WAN_Channel::queue() - "
+            << "failed to deliver the queued messages\n";
+        delete thePacket;
+        return -1;
+    }
+    
+    double now = this->getTime();
+    thePacket->sendTime = now;
+    thePacket->seq = sendSeq++;
+    
+    // a lost datagram is never delivered
+    if (datagram && loss > 0.0 && theStream.getUniform() < loss)  {
+        sendStats.numLost++;
+        delete thePacket;
+        return 0;
+    }
+    
+    double dueTime = this->getDueTime(thePacket->size, now,
+        sendLinkFree, sendStats);
+    // the jitter does not change the order of the messages
+    if (dueTime < lastDueTime)
+        dueTime = lastDueTime;
+    lastDueTime = dueTime;
+    
+    // a reordered datagram is held back by another one-way
+    // delay, so that the following datagrams overtake it
+    if (datagram && reorder > 0.0 && theStream.getUniform() < reorder)
+        dueTime += (delay > 1.0) ? delay : 1.0;
+    thePacket->dueTime = dueTime;
+    
+    // keep the queue sorted by due time
+    std::list<Packet*>::iterator it = packets.end();
+    while (it != packets.begin())  {
+        std::list<Packet*>::iterator prev = it;
+        --prev;
+        if ((*prev)->dueTime <= dueTime)
+            break;
+        it = prev;
+    }
+    packets.insert(it, thePacket);
+    numPending++;
+    lock.unlock();
+    notEmpty.notify_one();
+    
+    return 0;
+}
+
+
+int WAN_Channel::hold(int numBytes, double start)
+{
+    double now = this->getTime();
+    double dueTime;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        
+        // a receive that had to wait got the message the moment it
+        // arrived, otherwise the message was already waiting and is
+        // assumed to have arrived together with the previous message
+        // or right after the last message sent was delivered
+        if (now - start > minRecvWait ||
+            (lastArrival == 0.0 && lastDelivered == 0.0))
+            lastArrival = now;
+        else if (lastDelivered > lastArrival)
+            lastArrival = (lastDelivered < now) ? lastDelivered : now;
+        dueTime = this->getDueTime(numBytes, lastArrival,
+            recvLinkFree, recvStats);
+    }
+    
+    // the message is held back as if it was still in flight
+    double wait = dueTime - this->getTime();
+    if (wait > 0.0)
+        std::this_thread::sleep_for(
+            std::chrono::duration<double, std::milli>(wait));
+    
+    std::lock_guard<std::mutex> lock(queueMutex);
+    this->addDelay(recvStats, this->getTime() - lastArrival, numBytes);
+    
+    return 0;
+}
+
+
+int WAN_Channel::deliver(Packet *thePacket)
+{
+    int res = -1;
+    switch (thePacket->type)  {
+    case 0:
+        res = theChannel->sendVector(thePacket->dbTag, thePacket->commitTag,
+            *thePacket->theVector, thePacket->theAddress);
+        break;
+    case 1:
+        res = theChannel->sendMatrix(thePacket->dbTag, thePacket->commitTag,
+            *thePacket->theMatrix, thePacket->theAddress);
+        break;
+    case 2:
+        res = theChannel->sendID(thePacket->dbTag, thePacket->commitTag,
+            *thePacket->theID, thePacket->theAddress);
+        break;
+    case 3:
+        {
+            Message theMessage(thePacket->data, thePacket->size);
+            res = theChannel->sendMsg(thePacket->dbTag, thePacket->commitTag,
+                theMessage, thePacket->theAddress);
+        }
+        break;
+    }
+    
+    return res;
+}
+
+
+void WAN_Channel::addDelay(Stats &stats, double value, int numBytes)
+{
+    if (stats.numMsgs == 0 || value < stats.min)
+        stats.min = value;
+    if (stats.numMsgs == 0 || value > stats.max)
+        stats.max = value;
+    stats.numMsgs++;
+    stats.numBytes += numBytes;
+    stats.sum += value;
+    stats.sumSq += value*value;
+}
+
+
+void WAN_Channel::printStats(OPS_Stream &s, const char *name,
+    const Stats &stats)
+{
+    s << "  " << name << ": " << (int)stats.numMsgs << " messages, "
+        << stats.numBytes << " bytes";
+    if (stats.numMsgs > 0)  {
+        double mean = stats.sum/stats.numMsgs;
+        double var = stats.sumSq/stats.numMsgs - mean*mean;
+        s << ", delay mean: " << mean << " ms, std: "
+            << ((var > 0.0) ? sqrt(var) : 0.0) << " ms, min: "
+            << stats.min << " ms, max: " << stats.max << " ms";
+    }
+    if (datagram)
+        s << ", lost: " << (int)stats.numLost
+            << ", reordered: " << (int)stats.numReordered;
+    else
+        s << ", retransmitted: " << (int)stats.numRetrans;
+    s << endln;
+}
+
+
+void WAN_Channel::run()
+{
+    std::unique_lock<std::mutex> lock(queueMutex);
+    while (true)  {
+        if (packets.empty())  {
+            if (exitFlag)
+                break;
+            notEmpty.wait(lock);
+            continue;
+        }
+        
+        // wait until the first message is due, an earlier
+        // message might be queued in the meantime
+        Packet *thePacket = packets.front();
+        double wait = thePacket->dueTime - this->getTime();
+        if (wait > 0.0)  {
+            notEmpty.wait_for(lock,
+                std::chrono::duration<double, std::milli>(wait));
+            continue;
+        }
+        packets.pop_front();
+        lock.unlock();
+        
+        int res = this->deliver(thePacket);
+        double now = this->getTime();
+        
+        lock.lock();
+        if (res < 0 && sendFailed == false)  {
+            opserr << "WAN_Channel::run() - "
+                << "wrapped channel failed to send message\n";
+            sendFailed = true;
+        }
+        this->addDelay(sendStats, now - thePacket->sendTime, thePacket->size);
+        lastDelivered = now;
+        if (thePacket->seq < lastSeq)
+            sendStats.numReordered++;
+        else
+            lastSeq = thePacket->seq;
+        delete thePacket;
+        numPending--;
+        if (numPending == 0)
+            drained.notify_all();
+    }
+}
@@ -0,0 +1,197 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef WAN_Channel_h
+#define WAN_Channel_h
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the class definition for
+// WAN_Channel. A WAN_Channel wraps another channel (TCP_Socket,
+// UDP_Socket, ...) and emulates a wide area network between the two
+// ends of a connection that actually run on the same machine or LAN.
+// Each message, in either direction, is delayed by the one-way delay
+// plus a normally distributed jitter and the time it takes to push its
+// bytes through a link of the given bandwidth. Outgoing messages are
+// copied into a queue and handed to the wrapped channel by a
+// background thread once they are due, so that the sender is not
+// blocked while the message is in flight. Incoming messages are held
+// back after they arrived at the wrapped channel. Hence, only one
+// end of a connection should use a WAN_Channel and the round trip time
+// is twice the one-way delay. On stream channels lost packets are
+// retransmitted, so a loss only adds the retransmission timeout to the
+// delay. On datagram channels lost messages are dropped and messages
+// can be reordered, the jitter alone keeps the order of the messages.
+// As UDP_Socket does not retransmit, a lost datagram stalls the
+// lock-step protocol of the sites. A receive waits until all the
+// queued messages have been delivered, so that the wrapped channel is
+// never used by two threads at the same time. The achieved delays are
+// collected and printed when the channel is destroyed or when the
+// program exits.
+//
+// All times are in milliseconds and the bandwidth is in Mbit/s.
+
+#include <Channel.h>
+#include <ExpRandomStream.h>
+
+#include <list>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+class OPS_Stream;
+
+class WAN_Channel : public Channel
+{
+public:
+    // constructor, the WAN_Channel takes ownership of theChannel
+    WAN_Channel(Channel *theChannel, double delay,
+        double jitter = 0.0, double bandwidth = 0.0,
+        double loss = 0.0, double reorder = 0.0,
+        bool datagram = false, int seed = -1);
+    
+    // destructor
+    ~WAN_Channel();
+    
+    char *addToProgram();
+    int setUpConnection();
+    int setNextAddress(const ChannelAddress &theAddress);
+    ChannelAddress *getLastSendersAddress();
+    
+    int isDatastore();
+    int getDbTag();
+    
+    int sendObj(int commitTag,
+        MovableObject &theObject,
+        ChannelAddress *theAddress = 0);
+    int recvObj(int commitTag,
+        MovableObject &theObject,
+        FEM_ObjectBroker &theBroker,
+        ChannelAddress *theAddress = 0);
+    
+    int sendMsg(int dbTag, int commitTag,
+        const Message &theMessage,
+        ChannelAddress *theAddress = 0);
+    int recvMsg(int dbTag, int commitTag,
+        Message &theMessage,
+        ChannelAddress *theAddress = 0);
+    int recvMsgUnknownSize(int dbTag, int commitTag,
+        Message &theMessage,
+        ChannelAddress *theAddress = 0);
+    
+    int sendMatrix(int dbTag, int commitTag,
+        const Matrix &theMatrix,
+        ChannelAddress *theAddress = 0);
+    int recvMatrix(int dbTag, int commitTag,
+        Matrix &theMatrix,
+        ChannelAddress *theAddress = 0);
+    
+    int sendVector(int dbTag, int commitTag,
+        const Vector &theVector,
+        ChannelAddress *theAddress = 0);
+    int recvVector(int dbTag, int commitTag,
+        Vector &theVector,
+        ChannelAddress *theAddress = 0);
+    
+    int sendID(int dbTag, int commitTag,
+        const ID &theID,
+        ChannelAddress *theAddress = 0);
+    int recvID(int dbTag, int commitTag,
+        ID &theID,
+        ChannelAddress *theAddress = 0);
+    
+    // method to wait until all the queued messages are delivered
+    int flush();
+    
+    // method to print the settings and the achieved delays
+    void Print(OPS_Stream &s, int flag = 0);
+    
+private:
+    // queued outgoing message
+    struct Packet {
+        Packet();
+        ~Packet();
+        int type;               // 0 = vector, 1 = matrix, 2 = ID, 3 = message
+        int dbTag, commitTag;
+        Vector *theVector;
+        Matrix *theMatrix;
+        ID *theID;
+        char *data;             // copy of message data
+        int size;               // number of bytes
+        ChannelAddress *theAddress;
+        double sendTime;        // time the message was sent
+        double dueTime;         // time the message is delivered
+        unsigned long long seq; // number of the message
+    };
+    
+    // achieved delays in one direction
+    struct Stats {
+        unsigned long numMsgs;
+        double numBytes;
+        double sum, sumSq, min, max;
+        unsigned long numLost, numRetrans, numReordered;
+    };
+    
+    double getTime();
+    double getDueTime(int numBytes, double now,
+        double &linkFree, Stats &stats);
+    int queue(Packet *thePacket);
+    int hold(int numBytes, double start);
+    int deliver(Packet *thePacket);
+    void addDelay(Stats &stats, double value, int numBytes);
+    void printStats(OPS_Stream &s, const char *name, const Stats &stats);
+    void run();
+    
+    Channel *theChannel;    // wrapped channel
+    double delay;           // one-way delay
+    double jitter;          // standard deviation of delay
+    double bandwidth;       // bandwidth of link (0 = infinite)
+    double loss;            // probability of packet loss
+    double reorder;         // probability of reordering (datagrams only)
+    bool datagram;          // flag if wrapped channel is datagram based
+    double rto;             // initial retransmission timeout
+    ExpRandomStream theStream;
+    
+    std::list<Packet*> packets; // queue sorted by due time
+    int numPending;         // number of messages not yet delivered
+    double sendLinkFree;    // time outgoing link is free again
+    double recvLinkFree;    // time incoming link is free again
+    double lastDueTime;     // due time of last queued message
+    double lastDelivered;   // time last queued message was delivered
+    double lastArrival;     // time last received message arrived
+    unsigned long long sendSeq, lastSeq;
+    Stats sendStats, recvStats;
+    bool sendFailed;        // flag if wrapped channel failed to send
+    
+    std::thread worker;
+    std::mutex queueMutex;
+    std::condition_variable notEmpty, drained;
+    bool exitFlag;
+};
+
+// function to parse the arguments following a -wan option:
+// delay <-jitter jitter> <-bandwidth bandwidth> <-loss loss>
+// <-reorder reorder> <-seed seed>
+int OPF_GetWANChannelArgs(double *wanArgs);
+
+#endif
@@ -98,8 +98,13 @@ Matrix& ETBroyden::updateTangentStiff(
     int dimC = kPrev->noCols();
     int szD	 = incrDisp->Size();
     
-    // FIX ME add size check
-    theStiff = new Matrix(dimR, dimC);
+    // reuse the stiffness matrix if the size did not change
+    if (theStiff == 0 || theStiff->noRows() != dimR ||
+        theStiff->noCols() != dimC)  {
+        if (theStiff != 0)
+            delete theStiff;
+        theStiff = new Matrix(dimR, dimC);
+    }
     theStiff->Zero();
     
     double normD = incrDisp->Norm();
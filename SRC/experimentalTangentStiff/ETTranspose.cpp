@@ -116,8 +116,13 @@ Matrix& ETTranspose::updateTangentStiff(
     Matrix tempDM(dimR, dimCiDM);
     Matrix tempFM(dimR, dimCiDM);
     Matrix iDMatrixT, iFMatrixT, tempDDT(dimC, dimR), tempDFT(dimC, dimR), theStiffT(dimC, dimR);
-    // FIX ME add size check
-    theStiff = new Matrix(dimR, dimC);
+    // reuse the stiffness matrix if the size did not change
+    if (theStiff == 0 || theStiff->noRows() != dimR ||
+        theStiff->noCols() != dimC)  {
+        if (theStiff != 0)
+            delete theStiff;
+        theStiff = new Matrix(dimR, dimC);
+    }
     theStiff->Zero();
     theStiffT.Zero();
     
@@ -37,7 +37,9 @@ extern void* OPF_ECSimDomain();
 extern void* OPF_ECSimFEAdapter();
 extern void* OPF_ECSimSimulink();
 extern void* OPF_ECGenericTCP();
+extern void* OPF_ECPredictorCorrector();
 extern void* OPF_ECLabVIEW();
+extern void* OPF_ECReplay();
 extern void* OPF_ECxPCtarget();
 extern void* OPF_ECSCRAMNet();
 extern void* OPF_ECSCRAMNetGT();
@@ -68,7 +70,9 @@ namespace {
         expControlMap.insert(std::make_pair("SimFEAdapter", &OPF_ECSimFEAdapter));
         expControlMap.insert(std::make_pair("SimSimulink", &OPF_ECSimSimulink));
         expControlMap.insert(std::make_pair("GenericTCP", &OPF_ECGenericTCP));
+        expControlMap.insert(std::make_pair("PredictorCorrector", &OPF_ECPredictorCorrector));
         expControlMap.insert(std::make_pair("LabVIEW", &OPF_ECLabVIEW));
+        expControlMap.insert(std::make_pair("Replay", &OPF_ECReplay));
         expControlMap.insert(std::make_pair("xPCtarget", &OPF_ECxPCtarget));
         expControlMap.insert(std::make_pair("SCRAMNet", &OPF_ECSCRAMNet));
         expControlMap.insert(std::make_pair("SCRAMNetGT", &OPF_ECSCRAMNetGT));
@@ -113,7 +117,7 @@ int OPF_ExperimentalControl()
         return -1;
     }
     
-    // finally check for signal filters
+    // finally check for signal filters and traffic capture
     int filterTag;
     int numdata = 1;
     ExperimentalSignalFilter* theFilter = 0;
@@ -159,6 +163,19 @@ int OPF_ExperimentalControl()
                 }
             }
         }
+        if (strcmp(type, "-record") == 0) {
+            if (OPS_GetNumRemainingInputArgs() < 1) {
+                opserr << "WARNING want -record fileName\n";
+                opserr << "expControl: " << theControl->getTag() << endln;
+                return -1;
+            }
+            const char* fileName = OPS_GetString();
+            if (theControl->setTrafficLog(fileName) < 0) {
+                opserr << "WARNING could not capture traffic to file " << fileName << endln;
+                opserr << "expControl: " << theControl->getTag() << endln;
+                return -1;
+            }
+        }
     }
     
     // now add the control to the modelBuilder
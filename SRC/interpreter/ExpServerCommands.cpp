@@ -32,12 +32,23 @@
 #include <TCP_Socket.h>
 #include <TCP_SocketSSL.h>
 #include <UDP_Socket.h>
+#include <SHM_Channel.h>
 
 #include <ExperimentalElement.h>
 #include <ExperimentalSite.h>
 #include <ActorExpSite.h>
+#include <LabVIEWMessage.h>
+#include <Message.h>
 
 #include <conio.h>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+#if defined(_LINUX)
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 
 int OPF_startLabServer()
@@ -311,80 +322,43 @@ int OPF_stopLabServer()
 }
 
 
-int OPF_startSimAppSiteServer()
+// statistics of one simulation application connection
+struct SimAppSiteServerStats
 {
-    if (OPS_GetNumRemainingInputArgs() < 2) {
-        opserr << "WARNING insufficient arguments\n"
-            << "Want: startSimAppSiteServer siteTag ipPort <-udp> <-ssl>\n";
-        return -1;
-    }
-    
-    int siteTag, ipPort;
-    int ssl = 0, udp = 0;
-    Channel* theChannel = 0;
-    int numdata = 1;
-    if (OPS_GetIntInput(&numdata, &siteTag) < 0) {
-        opserr << "WARNING invalid startSimAppSiteServer siteTag\n";
-        return -1;
-    }
-    ExperimentalSite* theExperimentalSite = OPF_getExperimentalSite(siteTag);
-    if (theExperimentalSite == 0) {
-        opserr << "WARNING experimental site not found\n";
-        opserr << "startSimAppSiteServer expSite: " << siteTag << endln;
-        return -1;
-    }
-    numdata = 1;
-    if (OPS_GetIntInput(&numdata, &ipPort) < 0) {
-        opserr << "WARNING invalid startSimAppSiteServer ipPort\n";
-        return -1;
-    }
-    // optional parameters
-    if (OPS_GetNumRemainingInputArgs() > 0) {
-        const char* type = OPS_GetString();
-        if (strcmp(type, "-ssl") == 0)
-            ssl = 1;
-        else if (strcmp(type, "-udp") == 0)
-            udp = 1;
-    }
+    SimAppSiteServerStats()
+        : numRecv(0), numSent(0), bytesRecv(0), bytesSent(0),
+        numSteps(0), sumTime(0.0), maxTime(0.0),
+        sumStepTime(0.0), maxStepTime(0.0), runTime(0.0) {}
     
-    // setup the connection
-    if (ssl) {
-        theChannel = new TCP_SocketSSL(ipPort);
-        if (theChannel != 0) {
-            opserr << "\nSSL Channel successfully created: "
-                << "Waiting for Simulation Application Client...\n";
-        }
-        else {
-            opserr << "WARNING could not create SSL channel\n";
-            return -1;
-        }
-    }
-    else if (udp) {
-        theChannel = new UDP_Socket(ipPort);
-        if (theChannel != 0) {
-            opserr << "\nUDP Channel successfully created: "
-                << "Waiting for Simulation Application Client...\n";
-        }
-        else {
-            opserr << "WARNING could not create UDP channel\n";
-            return -1;
-        }
-    }
-    else {
-        theChannel = new TCP_Socket(ipPort);
-        if (theChannel != 0) {
-            opserr << "\nTCP Channel successfully created: "
-                << "Waiting for Simulation Application Client...\n";
-        }
-        else {
-            opserr << "WARNING could not create TCP channel\n";
-            return -1;
-        }
-    }
-    if (theChannel->setUpConnection() != 0) {
-        opserr << "WARNING could not setup connection\n";
-        return -1;
-    }
+    long numRecv, numSent;         // number of messages
+    double bytesRecv, bytesSent;   // number of payload bytes
+    long numSteps;                 // number of trial/daq cycles
+    double sumTime, maxTime;       // time to service one message
+    double sumStepTime, maxStepTime;  // time from trial to daq response
+    double runTime;                // time from open to shut down
+};
+
+
+// the sites of a SimAppSiteServer are served from concurrent threads,
+// so the output stream and the sites that step the global domain of
+// the interpreter (ECSimDomain) are guarded by these locks
+static std::mutex simAppOutputMutex;
+static std::mutex simAppDomainMutex;
+
+
+// serves one simulation application client on an already
+// connected channel until the client sends the DIE action, the
+// site is locked with siteMutex if it is not 0
+static int serveSimAppSite(int siteTag,
+    ExperimentalSite* theExperimentalSite,
+    Channel* theChannel,
+    SimAppSiteServerStats& stats,
+    std::mutex* siteMutex = 0)
+{
+    typedef std::chrono::steady_clock clock;
+    std::unique_lock<std::mutex> siteLock;
+    if (siteMutex != 0)
+        siteLock = std::unique_lock<std::mutex>(*siteMutex, std::defer_lock);
     
     // get the data size for the experimental site
     int intData[2 * OF_Resp_All + 1];
@@ -395,10 +369,17 @@ int OPF_startSimAppSiteServer()
     idData.Zero();
     
     theChannel->recvID(0, 0, idData, 0);
+    if (siteMutex != 0)
+        siteLock.lock();
     theExperimentalSite->setSize(sizeCtrl, sizeDaq);
-    opserr << "\nSimAppSiteServer with ExpSite " << siteTag
-        << " has the following DOF sizes:" << endln;
-    opserr << "   sizeCtrl = " << sizeCtrl << "   sizeDaq  = " << sizeDaq;
+    if (siteMutex != 0)
+        siteLock.unlock();
+    {
+        std::lock_guard<std::mutex> outputLock(simAppOutputMutex);
+        opserr << "\nSimAppSiteServer with ExpSite " << siteTag
+            << " has the following DOF sizes:" << endln;
+        opserr << "   sizeCtrl = " << sizeCtrl << "   sizeDaq  = " << sizeDaq;
+    }
     
     // initialize the receive and send vectors
     Vector* rDisp = 0, * sDisp = 0;
@@ -457,24 +438,45 @@ int OPF_startSimAppSiteServer()
     }
     sendData->Zero();
     
+    const double msgBytes = sizeof(double) * (*dataSize);
+    clock::time_point tStart = clock::now();
+    clock::time_point tTrial = tStart;
+    
     // start server loop
-    opserr << "\nSimAppSiteServer with ExpSite " << siteTag
-        << " - now running...\n";
+    {
+        std::lock_guard<std::mutex> outputLock(simAppOutputMutex);
+        opserr << "\nSimAppSiteServer with ExpSite " << siteTag
+            << " - now running...\n";
+    }
     bool exitYet = false;
     while (!exitYet) {
         theChannel->recvVector(0, 0, *recvData, 0);
+        clock::time_point tRecv = clock::now();
+        stats.numRecv++;
+        stats.bytesRecv += msgBytes;
         int action = (int)rData[0];
         
         //opserr << "\nLOOP action: " << *recvData << endln;
+        bool reply = false;
+        if (siteMutex != 0)
+            siteLock.lock();
         switch (action) {
         case OF_RemoteTest_open:
-            opserr << "\nConnected to Experimental Element\n";
+            {
+                std::lock_guard<std::mutex> outputLock(simAppOutputMutex);
+                opserr << "\nConnected to Experimental Element\n";
+            }
+            tStart = tRecv;
             break;
         case OF_RemoteTest_setup:
-            opserr << "WARNING SimAppSiteServer action setup "
-                << "received which does nothing, continuing execution\n";
+            {
+                std::lock_guard<std::mutex> outputLock(simAppOutputMutex);
+                opserr << "WARNING SimAppSiteServer action setup "
+                    << "received which does nothing, continuing execution\n";
+            }
             break;
         case OF_RemoteTest_setTrialResponse:
+            tTrial = tRecv;
             theExperimentalSite->setTrialResponse(rDisp, rVel, rAccel, rForce, rTime);
             break;
         case OF_RemoteTest_commitState:
@@ -483,26 +485,32 @@ int OPF_startSimAppSiteServer()
         case OF_RemoteTest_getDaqResponse:
             theExperimentalSite->getDaqResponse(sDisp, sVel, sAccel, sForce, sTime);
             theChannel->sendVector(0, 0, *sendData, 0);
+            reply = true;
             break;
         case OF_RemoteTest_getDisp:
             (*sDisp) = theExperimentalSite->getDisp();
             theChannel->sendVector(0, 0, *sendData, 0);
+            reply = true;
             break;
         case OF_RemoteTest_getVel:
             (*sVel) = theExperimentalSite->getVel();
             theChannel->sendVector(0, 0, *sendData, 0);
+            reply = true;
             break;
         case OF_RemoteTest_getAccel:
             (*sAccel) = theExperimentalSite->getAccel();
             theChannel->sendVector(0, 0, *sendData, 0);
+            reply = true;
             break;
         case OF_RemoteTest_getForce:
             (*sForce) = theExperimentalSite->getForce();
             theChannel->sendVector(0, 0, *sendData, 0);
+            reply = true;
             break;
         case OF_RemoteTest_getTime:
             (*sTime) = theExperimentalSite->getTime();
             theChannel->sendVector(0, 0, *sendData, 0);
+            reply = true;
             break;
         case OF_RemoteTest_DIE:
             //OPF_removeExperimentalSite(siteTag);
@@ -510,18 +518,43 @@ int OPF_startSimAppSiteServer()
             exitYet = true;
             break;
         default:
-            opserr << "WARNING SimAppSiteServer invalid action "
-                << action << " received\n";
+            {
+                std::lock_guard<std::mutex> outputLock(simAppOutputMutex);
+                opserr << "WARNING SimAppSiteServer invalid action "
+                    << action << " received\n";
+            }
             break;
         }
+        if (siteMutex != 0)
+            siteLock.unlock();
+        
+        // update the connection statistics
+        clock::time_point tDone = clock::now();
+        double dt = std::chrono::duration<double>(tDone - tRecv).count();
+        stats.sumTime += dt;
+        if (dt > stats.maxTime)
+            stats.maxTime = dt;
+        if (reply) {
+            stats.numSent++;
+            stats.bytesSent += msgBytes;
+        }
+        if (action == OF_RemoteTest_getDaqResponse && tTrial != tStart) {
+            dt = std::chrono::duration<double>(tDone - tTrial).count();
+            stats.numSteps++;
+            stats.sumStepTime += dt;
+            if (dt > stats.maxStepTime)
+                stats.maxStepTime = dt;
+            tTrial = tStart;
+        }
+        stats.runTime = std::chrono::duration<double>(tDone - tStart).count();
+    }
+    {
+        std::lock_guard<std::mutex> outputLock(simAppOutputMutex);
+        opserr << "\nSimAppSiteServer with ExpSite " << siteTag
+            << " - shut down\n\n";
     }
-    opserr << "\nSimAppSiteServer with ExpSite " << siteTag
-        << " - shut down\n\n";
     
     // delete allocated memory
-    if (theChannel != 0)
-        delete theChannel;
-    
     if (rDisp != 0)
         delete rDisp;
     if (rVel != 0)
@@ -552,11 +585,351 @@ int OPF_startSimAppSiteServer()
 }
 
 
+static void printSimAppSiteServerStats(int siteTag, int ipPort,
+    const SimAppSiteServerStats& stats)
+{
+    double runTime = (stats.runTime > 0.0) ? stats.runTime : 1.0;
+    opserr << "SimAppSiteServer with ExpSite " << siteTag
+        << " on port " << ipPort << " - statistics:\n";
+    opserr << "   messages recv/sent = " << (int)stats.numRecv
+        << " / " << (int)stats.numSent
+        << "   (" << (stats.numRecv + stats.numSent) / runTime << " msg/s)\n";
+    opserr << "   throughput recv/sent = " << stats.bytesRecv / runTime / 1024.0
+        << " / " << stats.bytesSent / runTime / 1024.0 << " kB/s\n";
+    if (stats.numRecv > 0)
+        opserr << "   service time avg/max = "
+            << 1.0E3 * stats.sumTime / stats.numRecv << " / "
+            << 1.0E3 * stats.maxTime << " ms\n";
+    if (stats.numSteps > 0)
+        opserr << "   step latency avg/max = "
+            << 1.0E3 * stats.sumStepTime / stats.numSteps << " / "
+            << 1.0E3 * stats.maxStepTime << " ms  ("
+            << (int)stats.numSteps << " steps)\n";
+}
+
+
+// checks if two sites step the same setup or control, which
+// the sites do not copy when they are created
+static bool shareSimAppSiteObjects(ExperimentalSite* site1,
+    ExperimentalSite* site2)
+{
+    ExperimentalSetup* setup1 = site1->getSetup();
+    ExperimentalSetup* setup2 = site2->getSetup();
+    if (setup1 == 0 || setup2 == 0)
+        return false;
+    if (setup1 == setup2)
+        return true;
+    
+    ExperimentalControl* control1 = setup1->getControl();
+    ExperimentalControl* control2 = setup2->getControl();
+    return (control1 != 0 && control1 == control2);
+}
+
+
+// pins the calling thread to the given cpu (Linux only)
+static int pinThreadToCPU(int cpu)
+{
+#if defined(_LINUX)
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(cpu, &cpuSet);
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet);
+#else
+    return -1;
+#endif
+}
+
+
+int OPF_startSimAppSiteServer()
+{
+    if (OPS_GetNumRemainingInputArgs() < 2) {
+        opserr << "WARNING insufficient arguments\n"
+            << "Want: startSimAppSiteServer siteTag ipPort <siteTag ipPort ...> "
+            << "<-udp|-udpFrag> <-ssl> <-shm> <-pin>\n";
+        return -1;
+    }
+    
+    ID siteTags(4), ipPorts(4);
+    int numSites = 0;
+    int ssl = 0, udp = 0, shm = 0, pin = 0;
+    int numdata = 1;
+    
+    // pairs of site tags and ports
+    while (OPS_GetNumRemainingInputArgs() > 0) {
+        int siteTag, ipPort;
+        int numArgs = OPS_GetNumRemainingInputArgs();
+        numdata = 1;
+        if (OPS_GetIntInput(&numdata, &siteTag) < 0) {
+            if (numArgs > OPS_GetNumRemainingInputArgs()) {
+                // move current arg back by one
+                OPS_ResetCurrentInputArg(-1);
+            }
+            break;
+        }
+        numdata = 1;
+        if (OPS_GetNumRemainingInputArgs() < 1 ||
+            OPS_GetIntInput(&numdata, &ipPort) < 0) {
+            opserr << "WARNING invalid startSimAppSiteServer ipPort\n";
+            opserr << "startSimAppSiteServer expSite: " << siteTag << endln;
+            return -1;
+        }
+        for (int i = 0; i < numSites; i++) {
+            if (siteTags(i) == siteTag || ipPorts(i) == ipPort) {
+                opserr << "WARNING each experimental site and port can "
+                    << "only be served once\n";
+                opserr << "startSimAppSiteServer expSite: " << siteTag << endln;
+                return -1;
+            }
+        }
+        siteTags[numSites] = siteTag;
+        ipPorts[numSites] = ipPort;
+        numSites++;
+    }
+    if (numSites == 0) {
+        opserr << "WARNING invalid startSimAppSiteServer siteTag\n";
+        return -1;
+    }
+    
+    // optional parameters
+    while (OPS_GetNumRemainingInputArgs() > 0) {
+        const char* type = OPS_GetString();
+        if (strcmp(type, "-ssl") == 0)
+            ssl = 1;
+        else if (strcmp(type, "-udp") == 0)
+            udp = 1;
+        else if (strcmp(type, "-udpFrag") == 0)
+            udp = 2;
+        else if (strcmp(type, "-shm") == 0) {
+#ifdef _WIN32
+            opserr << "WARNING shared memory channels (-shm) are not supported on Windows\n";
+            return -1;
+#endif
+            shm = 1;
+        }
+        else if (strcmp(type, "-pin") == 0)
+            pin = 1;
+        else {
+            opserr << "WARNING unknown option " << type << " ignored\n";
+        }
+    }
+    
+    // get the experimental sites
+    ExperimentalSite** theSites = new ExperimentalSite * [numSites];
+    for (int i = 0; i < numSites; i++) {
+        theSites[i] = OPF_getExperimentalSite(siteTags(i));
+        if (theSites[i] == 0) {
+            opserr << "WARNING experimental site not found\n";
+            opserr << "startSimAppSiteServer expSite: " << siteTags(i) << endln;
+            delete[] theSites;
+            return -1;
+        }
+    }
+    
+    // create the channels
+    Channel** theChannels = new Channel * [numSites];
+    for (int i = 0; i < numSites; i++) {
+        const char* channelType = "TCP";
+        if (shm) {
+            theChannels[i] = new SHM_Channel(ipPorts(i));
+            channelType = "SHM";
+        }
+        else if (ssl) {
+            theChannels[i] = new TCP_SocketSSL(ipPorts(i));
+            channelType = "SSL";
+        }
+        else if (udp) {
+            theChannels[i] = new UDP_Socket(ipPorts(i), false, false, udp == 2);
+            channelType = "UDP";
+        }
+        else {
+            theChannels[i] = new TCP_Socket(ipPorts(i));
+        }
+        if (theChannels[i] == 0) {
+            opserr << "WARNING could not create " << channelType << " channel\n";
+            for (int j = 0; j < i; j++)
+                delete theChannels[j];
+            delete[] theChannels;
+            delete[] theSites;
+            return -1;
+        }
+        opserr << "\n" << channelType << " Channel successfully created: "
+            << "Waiting for Simulation Application Client...\n";
+    }
+    
+    std::vector<SimAppSiteServerStats> stats(numSites);
+    int rValue = 0;
+    
+    if (numSites == 1) {
+        // serve the single site from the calling thread
+        if (pin && pinThreadToCPU(0) != 0)
+            opserr << "WARNING could not pin SimAppSiteServer to cpu 0\n";
+        if (theChannels[0]->setUpConnection() != 0) {
+            opserr << "WARNING could not setup connection\n";
+            rValue = -1;
+        }
+        else
+            rValue = serveSimAppSite(siteTags(0), theSites[0],
+                theChannels[0], stats[0]);
+    }
+    else {
+        // serve each site from its own thread, the sites that step
+        // the global domain are serialized with one lock since they
+        // share the domain and its analysis
+        std::vector<std::mutex*> siteMutex(numSites, (std::mutex*)0);
+        for (int i = 0; i < numSites; i++) {
+            if (theSites[i]->usesGlobalDomain())
+                siteMutex[i] = &simAppDomainMutex;
+        }
+        
+        // the sites that share a setup or control directly or through
+        // other sites are serialized with one lock per group
+        std::vector<int> group(numSites);
+        for (int i = 0; i < numSites; i++) {
+            group[i] = i;
+            for (int j = 0; j < i; j++) {
+                if (group[j] != group[i] &&
+                    shareSimAppSiteObjects(theSites[i], theSites[j])) {
+                    int oldGroup = group[i];
+                    for (int k = 0; k <= i; k++) {
+                        if (group[k] == oldGroup)
+                            group[k] = group[j];
+                    }
+                }
+            }
+        }
+        std::vector<std::mutex> groupMutex(numSites);
+        for (int i = 0; i < numSites; i++) {
+            if (siteMutex[i] != 0)
+                continue;
+            for (int j = 0; j < numSites; j++) {
+                if (j != i && group[j] == group[i]) {
+                    siteMutex[i] = &groupMutex[group[i]];
+                    break;
+                }
+            }
+        }
+        int numCPUs = std::thread::hardware_concurrency();
+        if (numCPUs < 1)
+            numCPUs = 1;
+        std::vector<int> result(numSites, 0);
+        std::vector<std::thread> workers;
+        for (int i = 0; i < numSites; i++) {
+            workers.push_back(std::thread([&, i]() {
+                if (pin && pinThreadToCPU(i % numCPUs) != 0) {
+                    std::lock_guard<std::mutex> outputLock(simAppOutputMutex);
+                    opserr << "WARNING could not pin SimAppSiteServer with ExpSite "
+                        << siteTags(i) << " to cpu " << i % numCPUs << endln;
+                }
+                if (theChannels[i]->setUpConnection() != 0) {
+                    std::lock_guard<std::mutex> outputLock(simAppOutputMutex);
+                    opserr << "WARNING could not setup connection\n";
+                    opserr << "startSimAppSiteServer expSite: " << siteTags(i) << endln;
+                    result[i] = -1;
+                    return;
+                }
+                result[i] = serveSimAppSite(siteTags(i), theSites[i],
+                    theChannels[i], stats[i], siteMutex[i]);
+            }));
+        }
+        for (int i = 0; i < numSites; i++) {
+            workers[i].join();
+            if (result[i] != 0)
+                rValue = -1;
+        }
+    }
+    
+    // report the connection statistics
+    for (int i = 0; i < numSites; i++)
+        printSimAppSiteServerStats(siteTags(i), ipPorts(i), stats[i]);
+    opserr << endln;
+    
+    // delete allocated memory
+    for (int i = 0; i < numSites; i++)
+        delete theChannels[i];
+    delete[] theChannels;
+    delete[] theSites;
+    
+    return rValue;
+}
+
+
+// prints the tags of the elements served by a SimAppElemServer
+static void printSimAppElemServerTags(const ID& eleTags, int numEle)
+{
+    opserr << "\nSimAppElemServer with ExpElement";
+    if (numEle > 8) {
+        opserr << "s " << eleTags(0) << " ... " << eleTags(numEle - 1)
+            << " (" << numEle << " elements)";
+        return;
+    }
+    if (numEle > 1)
+        opserr << "s";
+    for (int i = 0; i < numEle; i++)
+        opserr << " " << eleTags(i);
+}
+
+
+// assembles the daq response of all the served elements
+// into the consecutive blocks of the send vector
+static void getSimAppElemResponse(ExperimentalElement** theElements,
+    int numEle, const ID& eleNDF, int respType, Vector& resp)
+{
+    resp.Zero();
+    int id = 0;
+    for (int i = 0; i < numEle; i++) {
+        switch (respType) {
+        case OF_Resp_Disp:
+            resp.Assemble(theElements[i]->getDisp(), id);
+            break;
+        case OF_Resp_Vel:
+            resp.Assemble(theElements[i]->getVel(), id);
+            break;
+        case OF_Resp_Accel:
+            resp.Assemble(theElements[i]->getAccel(), id);
+            break;
+        case OF_Resp_Force:
+            resp.Assemble(theElements[i]->getResistingForce(), id);
+            break;
+        }
+        id += eleNDF(i);
+    }
+}
+
+
+// copies the requested matrices of all the served elements
+// one after the other into the send data
+static void getSimAppElemMatrix(ExperimentalElement** theElements,
+    int numEle, const ID& eleNDF, int action, double* data)
+{
+    int id = 0;
+    for (int i = 0; i < numEle; i++) {
+        int ndf = eleNDF(i);
+        Matrix theMatrix(&data[id], ndf, ndf);
+        switch (action) {
+        case OF_RemoteTest_getInitialStiff:
+            theMatrix = theElements[i]->getInitialStiff();
+            break;
+        case OF_RemoteTest_getTangentStiff:
+            theMatrix = theElements[i]->getTangentStiff();
+            break;
+        case OF_RemoteTest_getDamp:
+            theMatrix = theElements[i]->getDamp();
+            break;
+        case OF_RemoteTest_getMass:
+            theMatrix = theElements[i]->getMass();
+            break;
+        }
+        id += ndf * ndf;
+    }
+}
+
+
 int OPF_startSimAppElemServer()
 {
     if (OPS_GetNumRemainingInputArgs() < 2) {
         opserr << "WARNING insufficient arguments\n"
-            << "Want: startSimAppElemServer eleTag ipPort <-udp> <-ssl>\n";
+            << "Want: startSimAppElemServer eleTag <eleTag ...> ipPort "
+            << "<-udp|-udpFrag> <-ssl> <-shm>\n";
         return -1;
     }
     
@@ -567,25 +940,53 @@ int OPF_startSimAppElemServer()
         return -1;
     }
     
-    int eleTag, ipPort;
-    int ssl = 0, udp = 0;
+    // element tags followed by the port, where several elements
+    // are served in bundled form over the same connection
+    ID eleTags(4);
+    int numEle = 0;
+    int ipPort;
+    int ssl = 0, udp = 0, shm = 0;
     Channel* theChannel = 0;
     int numdata = 1;
-    if (OPS_GetIntInput(&numdata, &eleTag) < 0) {
-        opserr << "WARNING invalid startSimAppElemServer eleTag\n";
-        return -1;
+    while (OPS_GetNumRemainingInputArgs() > 0) {
+        int tag;
+        int numArgs = OPS_GetNumRemainingInputArgs();
+        numdata = 1;
+        if (OPS_GetIntInput(&numdata, &tag) < 0) {
+            if (numArgs > OPS_GetNumRemainingInputArgs()) {
+                // move current arg back by one
+                OPS_ResetCurrentInputArg(-1);
+            }
+            break;
+        }
+        eleTags[numEle++] = tag;
     }
-    ExperimentalElement* theExperimentalElement =
-        dynamic_cast <ExperimentalElement*> (theDomain->getElement(eleTag));
-    if (theExperimentalElement == 0) {
-        opserr << "WARNING experimental element not found\n";
-        opserr << "startSimAppElemServer expElement: " << eleTag << endln;
+    if (numEle < 2) {
+        opserr << "WARNING invalid startSimAppElemServer eleTag or ipPort\n";
         return -1;
     }
-    numdata = 1;
-    if (OPS_GetIntInput(&numdata, &ipPort) < 0) {
-        opserr << "WARNING invalid startSimAppElemServer ipPort\n";
-        return -1;
+    ipPort = eleTags(--numEle);
+    
+    int i, j;
+    ExperimentalElement** theElements = new ExperimentalElement* [numEle];
+    for (i = 0; i < numEle; i++) {
+        theElements[i] = dynamic_cast <ExperimentalElement*>
+            (theDomain->getElement(eleTags(i)));
+        if (theElements[i] == 0) {
+            opserr << "WARNING experimental element not found\n";
+            opserr << "startSimAppElemServer expElement: " << eleTags(i) << endln;
+            delete[] theElements;
+            return -1;
+        }
+        for (j = 0; j < i; j++) {
+            if (eleTags(j) == eleTags(i)) {
+                opserr << "WARNING each experimental element can "
+                    << "only be served once\n";
+                opserr << "startSimAppElemServer expElement: " << eleTags(i) << endln;
+                delete[] theElements;
+                return -1;
+            }
+        }
     }
     // optional parameters
     if (OPS_GetNumRemainingInputArgs() > 0) {
@@ -594,10 +995,32 @@ int OPF_startSimAppElemServer()
             ssl = 1;
         else if (strcmp(type, "-udp") == 0)
             udp = 1;
+        else if (strcmp(type, "-udpFrag") == 0)
+            udp = 2;
+        else if (strcmp(type, "-shm") == 0) {
+#ifdef _WIN32
+            opserr << "WARNING shared memory channels (-shm) are not supported on Windows\n";
+            delete[] theElements;
+            return -1;
+#endif
+            shm = 1;
+        }
     }
     
     // setup the connection
-    if (ssl) {
+    if (shm) {
+        theChannel = new SHM_Channel(ipPort);
+        if (theChannel != 0) {
+            opserr << "\nSHM Channel successfully created: "
+                << "Waiting for Simulation Application Client...\n";
+        }
+        else {
+            opserr << "WARNING could not create SHM channel\n";
+            delete[] theElements;
+            return -1;
+        }
+    }
+    else if (ssl) {
         theChannel = new TCP_SocketSSL(ipPort);
         if (theChannel != 0) {
             opserr << "\nSSL Channel successfully created: "
@@ -605,17 +1028,19 @@ int OPF_startSimAppElemServer()
         }
         else {
             opserr << "WARNING could not create SSL channel\n";
+            delete[] theElements;
             return -1;
         }
     }
     else if (udp) {
-        theChannel = new UDP_Socket(ipPort);
+        theChannel = new UDP_Socket(ipPort, false, false, udp == 2);
         if (theChannel != 0) {
             opserr << "\nUDP Channel successfully created: "
                 << "Waiting for Simulation Application Client...\n";
         }
         else {
             opserr << "WARNING could not create UDP channel\n";
+            delete[] theElements;
             return -1;
         }
     }
@@ -627,15 +1052,18 @@ int OPF_startSimAppElemServer()
         }
         else {
             opserr << "WARNING could not create TCP channel\n";
+            delete[] theElements;
             return -1;
         }
     }
     if (theChannel->setUpConnection() != 0) {
         opserr << "WARNING could not setup connection\n";
+        delete theChannel;
+        delete[] theElements;
         return -1;
     }
     
-    // get the data size for the experimental element
+    // get the data size for the experimental elements
     int intData[2 * OF_Resp_All + 1];
     ID idData(intData, 2 * OF_Resp_All + 1);
     ID sizeCtrl(intData, OF_Resp_All);
@@ -645,14 +1073,19 @@ int OPF_startSimAppElemServer()
     
     theChannel->recvID(0, 0, idData, 0);
     
-    // check data size of experimental element
-    int i, ndf = 0;
-    const ID eleNodes = theExperimentalElement->getExternalNodes();
-    int numNodes = eleNodes.Size();
-    Node** theNodes = theExperimentalElement->getNodePtrs();
-    
-    for (i = 0; i < numNodes; i++) {
-        ndf += theNodes[i]->getNumberDOF();
+    // the vectors of a bundle are the vectors of the individual
+    // elements in the order of the element tags, so check the
+    // data sizes against the total number of element DOF
+    int ndf = 0, matSize = 0;
+    ID eleNDF(numEle);
+    for (i = 0; i < numEle; i++) {
+        int numNodes = theElements[i]->getNumExternalNodes();
+        Node** theNodes = theElements[i]->getNodePtrs();
+        eleNDF(i) = 0;
+        for (j = 0; j < numNodes; j++)
+            eleNDF(i) += theNodes[j]->getNumberDOF();
+        ndf += eleNDF(i);
+        matSize += eleNDF(i) * eleNDF(i);
     }
     
     if ((sizeCtrl(OF_Resp_Disp) != 0 && sizeCtrl(OF_Resp_Disp) != ndf) ||
@@ -660,9 +1093,11 @@ int OPF_startSimAppElemServer()
         (sizeCtrl(OF_Resp_Accel) != 0 && sizeCtrl(OF_Resp_Accel) != ndf) ||
         (sizeCtrl(OF_Resp_Force) != 0 && sizeCtrl(OF_Resp_Force) != ndf) ||
         (sizeCtrl(OF_Resp_Time) != 0 && sizeCtrl(OF_Resp_Time) != 1)) {
-        opserr << "\nSimAppElemServer with ExpElement " << eleTag
-            << " - incorrect number of control DOF (ndf)\n"
+        printSimAppElemServerTags(eleTags, numEle);
+        opserr << " - incorrect number of control DOF (ndf)\n"
             << "want: " << ndf << " but got: " << sizeCtrl << endln;
+        delete theChannel;
+        delete[] theElements;
         return -1;
     }
     if ((sizeDaq(OF_Resp_Disp) != 0 && sizeDaq(OF_Resp_Disp) != ndf) ||
@@ -670,15 +1105,34 @@ int OPF_startSimAppElemServer()
         (sizeDaq(OF_Resp_Accel) != 0 && sizeDaq(OF_Resp_Accel) != ndf) ||
         (sizeDaq(OF_Resp_Force) != 0 && sizeDaq(OF_Resp_Force) != ndf) ||
         (sizeDaq(OF_Resp_Time) != 0 && sizeDaq(OF_Resp_Time) != 1)) {
-        opserr << "\nSimAppElemServer with ExpElement " << eleTag
-            << " - incorrect number of daq DOF (ndf)\n"
+        printSimAppElemServerTags(eleTags, numEle);
+        opserr << " - incorrect number of daq DOF (ndf)\n"
             << "want: " << ndf << " but got: " << sizeDaq << endln;
+        delete theChannel;
+        delete[] theElements;
+        return -1;
+    }
+    int sizeRecv = 1, sizeSend = 0;
+    for (i = 0; i < OF_Resp_All; i++) {
+        sizeRecv += sizeCtrl(i);
+        sizeSend += sizeDaq(i);
+    }
+    if (*dataSize < sizeRecv || *dataSize < sizeSend) {
+        printSimAppElemServerTags(eleTags, numEle);
+        opserr << " - data size " << *dataSize << " is too small "
+            << "for the requested responses\n";
+        delete theChannel;
+        delete[] theElements;
         return -1;
     }
-    opserr << "\nSimAppElemServer with ExpElement " << eleTag
-        << " has the following DOF sizes:" << endln;
+    printSimAppElemServerTags(eleTags, numEle);
+    opserr << " has the following DOF sizes:" << endln;
     opserr << "   sizeCtrl = " << sizeCtrl << "   sizeDaq  = " << sizeDaq;
-
+    if (matSize > *dataSize) {
+        opserr << "WARNING data size " << *dataSize << " is too small "
+            << "to send the element matrices, which need " << matSize << endln;
+    }
+    
     // initialize the receive and send vectors
     Vector* rDisp = 0, * sDisp = 0;
     Vector* rVel = 0, * sVel = 0;
@@ -712,7 +1166,8 @@ int OPF_startSimAppElemServer()
     recvData->Zero();
     
     id = 0;
-    double* sData = new double[*dataSize];
+    int sizeData = (matSize > *dataSize) ? matSize : *dataSize;
+    double* sData = new double[sizeData];
     Vector* sendData = new Vector(sData, *dataSize);
     if (sizeDaq(OF_Resp_Disp) != 0) {
         sDisp = new Vector(&sData[id], sizeDaq(OF_Resp_Disp));
@@ -735,12 +1190,10 @@ int OPF_startSimAppElemServer()
         id += sizeDaq(OF_Resp_Time);
     }
     sendData->Zero();
-    Matrix* sMatrix = new Matrix(sData, ndf, ndf);
-    sMatrix->Zero();
     
     // start server loop
-    opserr << "\nSimAppElemServer with ExpElement " << eleTag
-        << " - now running...\n";
+    printSimAppElemServerTags(eleTags, numEle);
+    opserr << " - now running...\n";
     Vector nodeData(1);
     bool exitYet = false;
     while (!exitYet) {
@@ -757,23 +1210,29 @@ int OPF_startSimAppElemServer()
                 << "received which does nothing, continuing execution\n";
             break;
         case OF_RemoteTest_setTrialResponse:
+            // set the trial response of the nodes of all the
+            // elements and update the domain only once
             id = 0;
-            for (i = 0; i < numNodes; i++) {
-                ndf = theNodes[i]->getNumberDOF();
-                nodeData.resize(ndf);
-                if (rDisp != 0) {
-                    nodeData.Extract(*rDisp, id);
-                    theNodes[i]->setTrialDisp(nodeData);
-                }
-                if (rVel != 0) {
-                    nodeData.Extract(*rVel, id);
-                    theNodes[i]->setTrialVel(nodeData);
-                }
-                if (rAccel != 0) {
-                    nodeData.Extract(*rAccel, id);
-                    theNodes[i]->setTrialAccel(nodeData);
+            for (i = 0; i < numEle; i++) {
+                int numNodes = theElements[i]->getNumExternalNodes();
+                Node** theNodes = theElements[i]->getNodePtrs();
+                for (j = 0; j < numNodes; j++) {
+                    ndf = theNodes[j]->getNumberDOF();
+                    nodeData.resize(ndf);
+                    if (rDisp != 0) {
+                        nodeData.Extract(*rDisp, id);
+                        theNodes[j]->setTrialDisp(nodeData);
+                    }
+                    if (rVel != 0) {
+                        nodeData.Extract(*rVel, id);
+                        theNodes[j]->setTrialVel(nodeData);
+                    }
+                    if (rAccel != 0) {
+                        nodeData.Extract(*rAccel, id);
+                        theNodes[j]->setTrialAccel(nodeData);
+                    }
+                    id += ndf;
                 }
-                id += ndf;
             }
             if (rTime != 0)
                 theDomain->setCurrentTime((*rTime)(0));
@@ -784,51 +1243,42 @@ int OPF_startSimAppElemServer()
             break;
         case OF_RemoteTest_getDaqResponse:
             if (sDisp != 0)
-                (*sDisp) = theExperimentalElement->getDisp();
+                getSimAppElemResponse(theElements, numEle, eleNDF, OF_Resp_Disp, *sDisp);
             if (sVel != 0)
-                (*sVel) = theExperimentalElement->getVel();
+                getSimAppElemResponse(theElements, numEle, eleNDF, OF_Resp_Vel, *sVel);
             if (sAccel != 0)
-                (*sAccel) = theExperimentalElement->getAccel();
+                getSimAppElemResponse(theElements, numEle, eleNDF, OF_Resp_Accel, *sAccel);
             if (sForce != 0)
-                (*sForce) = theExperimentalElement->getResistingForce();
+                getSimAppElemResponse(theElements, numEle, eleNDF, OF_Resp_Force, *sForce);
             if (sTime != 0)
-                (*sTime) = theExperimentalElement->getTime();
+                (*sTime) = theElements[0]->getTime();
             theChannel->sendVector(0, 0, *sendData, 0);
             break;
         case OF_RemoteTest_getDisp:
-            (*sDisp) = theExperimentalElement->getDisp();
+            getSimAppElemResponse(theElements, numEle, eleNDF, OF_Resp_Disp, *sDisp);
             theChannel->sendVector(0, 0, *sendData, 0);
             break;
         case OF_RemoteTest_getVel:
-            (*sVel) = theExperimentalElement->getVel();
+            getSimAppElemResponse(theElements, numEle, eleNDF, OF_Resp_Vel, *sVel);
             theChannel->sendVector(0, 0, *sendData, 0);
             break;
         case OF_RemoteTest_getAccel:
-            (*sAccel) = theExperimentalElement->getAccel();
+            getSimAppElemResponse(theElements, numEle, eleNDF, OF_Resp_Accel, *sAccel);
             theChannel->sendVector(0, 0, *sendData, 0);
             break;
         case OF_RemoteTest_getForce:
-            (*sForce) = theExperimentalElement->getResistingForce();
+            getSimAppElemResponse(theElements, numEle, eleNDF, OF_Resp_Force, *sForce);
             theChannel->sendVector(0, 0, *sendData, 0);
             break;
         case OF_RemoteTest_getTime:
-            (*sTime) = theExperimentalElement->getTime();
+            (*sTime) = theElements[0]->getTime();
             theChannel->sendVector(0, 0, *sendData, 0);
             break;
         case OF_RemoteTest_getInitialStiff:
-            (*sMatrix) = theExperimentalElement->getInitialStiff();
-            theChannel->sendVector(0, 0, *sendData, 0);
-            break;
         case OF_RemoteTest_getTangentStiff:
-            (*sMatrix) = theExperimentalElement->getTangentStiff();
-            theChannel->sendVector(0, 0, *sendData, 0);
-            break;
         case OF_RemoteTest_getDamp:
-            (*sMatrix) = theExperimentalElement->getDamp();
-            theChannel->sendVector(0, 0, *sendData, 0);
-            break;
         case OF_RemoteTest_getMass:
-            (*sMatrix) = theExperimentalElement->getMass();
+            getSimAppElemMatrix(theElements, numEle, eleNDF, action, sData);
             theChannel->sendVector(0, 0, *sendData, 0);
             break;
         case OF_RemoteTest_DIE:
@@ -840,12 +1290,13 @@ int OPF_startSimAppElemServer()
             break;
         }
     }
-    opserr << "\nSimAppElemServer with ExpElement " << eleTag
-        << " - shut down\n\n";
+    printSimAppElemServerTags(eleTags, numEle);
+    opserr << " - shut down\n\n";
     
     // delete allocated memory
     if (theChannel != 0)
         delete theChannel;
+    delete[] theElements;
     
     if (rDisp != 0)
         delete rDisp;
@@ -870,9 +1321,160 @@ int OPF_startSimAppElemServer()
         delete sForce;
     if (sTime != 0)
         delete sTime;
-    delete sMatrix;
     delete sendData;
     delete[] sData;
     
     return 0;
 }
+
+
+int OPF_startLabVIEWMockServer()
+{
+    if (OPS_GetNumRemainingInputArgs() < 1) {
+        opserr << "WARNING insufficient arguments\n"
+            << "Want: startLabVIEWMockServer ipPort <-stiff k>\n";
+        return -1;
+    }
+    
+    int ipPort;
+    double stiff = 1.0;
+    int numdata = 1;
+    if (OPS_GetIntInput(&numdata, &ipPort) < 0) {
+        opserr << "WARNING invalid startLabVIEWMockServer ipPort\n";
+        return -1;
+    }
+    // optional parameters
+    while (OPS_GetNumRemainingInputArgs() > 0) {
+        const char* type = OPS_GetString();
+        if (strcmp(type, "-stiff") == 0) {
+            numdata = 1;
+            if (OPS_GetDoubleInput(&numdata, &stiff) < 0 || stiff == 0.0) {
+                opserr << "WARNING invalid startLabVIEWMockServer stiff\n";
+                return -1;
+            }
+        }
+    }
+    
+    // setup the connection
+    TCP_Socket* theSocket = new TCP_Socket(ipPort, false, 1);
+    opserr << "\nLabVIEW mock server: waiting for ECLabVIEW client...\n";
+    if (theSocket->setUpConnection() != 0) {
+        opserr << "WARNING could not setup connection\n";
+        delete theSocket;
+        return -1;
+    }
+    
+    // the mock plugin acknowledges all commands, keeps the
+    // executed control point parameters and returns them together
+    // with the conjugate parameters of a linear specimen with the
+    // given stiffness when the control points are acquired
+    LabVIEWMessage recvMsg(65536), sendMsg(65536);
+    LabVIEWMessage* proposed = new LabVIEWMessage(65536);
+    LabVIEWMessage* executed = new LabVIEWMessage(65536);
+    Message recvData(recvMsg.getData(), recvMsg.getCapacity());
+    Message sendData(sendMsg.getData(), 0);
+    
+    std::vector<int> cpStart, cpEnd;
+    int numTransactions = 0;
+    int rValue = 0;
+    bool exitYet = false;
+    
+    while (!exitYet) {
+        recvMsg.clear();
+        if (theSocket->recvMsgUnknownSize(0, 0, recvData, 0) < 0) {
+            // the client disconnected without closing the session
+            opserr << "WARNING LabVIEW mock server - "
+                << "connection lost before close-session\n";
+            rValue = -1;
+            break;
+        }
+        
+        sendMsg.clear();
+        int numTokens = recvMsg.tokenize();
+        const char* command = recvMsg.getToken(0);
+        const char* id = (numTokens > 1) ? recvMsg.getToken(1) : "";
+        
+        if (strcmp(command, "propose") == 0) {
+            // keep a copy of the proposed parameters
+            proposed->clear();
+            for (int i = 0; i < numTokens; i++)
+                proposed->append(recvMsg.getToken(i));
+            proposed->end();
+            sendMsg.append("OK").append("0").append(id).end();
+        }
+        else if (strcmp(command, "execute") == 0) {
+            // execute the proposed parameters and find where the
+            // parameters of the different control points start
+            LabVIEWMessage* swap = executed;
+            executed = proposed;
+            proposed = swap;
+            numTokens = executed->tokenize();
+            cpStart.clear();
+            cpEnd.clear();
+            int i = 2;
+            while (i < numTokens) {
+                // skip the control point name
+                cpStart.push_back(++i);
+                while (i < numTokens &&
+                    strcmp(executed->getToken(i), "control-point") != 0)
+                    i++;
+                cpEnd.push_back(i++);
+            }
+            numTransactions++;
+            sendMsg.append("OK").append("0").append(id).end();
+        }
+        else if (strcmp(command, "get-control-point") == 0) {
+            // reply with one line per requested control point
+            for (int k = 2; k < numTokens; k++) {
+                sendMsg.append("OK").append("0").append(id);
+                sendMsg.append(recvMsg.getToken(k));
+                size_t cp = k - 2;
+                if (cp < cpStart.size()) {
+                    for (int i = cpStart[cp]; i + 2 < cpEnd[cp]; i += 3) {
+                        const char* geomType = executed->getToken(i);
+                        const char* paramType = executed->getToken(i + 1);
+                        double value = strtod(executed->getToken(i + 2), 0);
+                        const char* conjType = "force";
+                        double conjValue = stiff * value;
+                        if (strcmp(paramType, "force") == 0) {
+                            conjType = "displacement";
+                            conjValue = value / stiff;
+                        }
+                        else if (strcmp(paramType, "rotation") == 0) {
+                            conjType = "moment";
+                        }
+                        else if (strcmp(paramType, "moment") == 0) {
+                            conjType = "rotation";
+                            conjValue = value / stiff;
+                        }
+                        sendMsg.append(geomType).append(paramType).append(value);
+                        sendMsg.append(geomType).append(conjType).append(conjValue);
+                    }
+                }
+                sendMsg.end();
+            }
+        }
+        else if (strcmp(command, "open-session") == 0 ||
+            strcmp(command, "set-parameter") == 0) {
+            sendMsg.append("OK").append("0").append(id).end();
+        }
+        else if (strcmp(command, "close-session") == 0) {
+            sendMsg.append("OK").append("0").append(id).end();
+            exitYet = true;
+        }
+        else {
+            sendMsg.append("ERROR").append("-1").append(command).end();
+        }
+        sendData.setData(sendMsg.getData(), sendMsg.getSize());
+        theSocket->sendMsg(0, 0, sendData, 0);
+    }
+    opserr << "\nLabVIEW mock server - shut down after "
+        << numTransactions << " transactions\n\n";
+    
+    // delete allocated memory
+    delete theSocket;
+    delete proposed;
+    delete executed;
+    
+    return rValue;
+}
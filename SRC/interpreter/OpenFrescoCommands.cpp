@@ -40,6 +40,33 @@
 #include <FrescoGlobals.h>
 #include <ExperimentalSite.h>
 
+#include <AnalysisModel.h>
+#include <PenaltyConstraintHandler.h>
+#include <DOF_Numberer.h>
+#include <RCM.h>
+#include <Linear.h>
+#include <BandGenLinSOE.h>
+#include <BandGenLinLapackSolver.h>
+#include <TransientIntegrator.h>
+#include <DirectIntegrationAnalysis.h>
+#include <Node.h>
+#include <ExpRandomStream.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <vector>
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <poll.h>
+#include <sys/wait.h>
+#endif
+
+void* OPS_NewmarkExplicit();
+void* OPS_AlphaOS();
+void* OPS_KRAlphaExplicit();
+
 
 // active object
 static OpenFrescoCommands* cmds = 0;
@@ -47,7 +74,8 @@ static OpenFrescoCommands* cmds = 0;
 
 OpenFrescoCommands::OpenFrescoCommands(DL_Interpreter* interp)
     :interpreter(interp), theDomain(0), ndf(0), ndm(0),
-    theTimer(), theSimulationInfo()
+    theTimer(), theSimulationInfo(),
+    theTransientIntegrator(0), theTransientAnalysis(0), analysisDt(0.0)
 {
     cmds = this;
 
@@ -57,6 +85,7 @@ OpenFrescoCommands::OpenFrescoCommands(DL_Interpreter* interp)
 
 OpenFrescoCommands::~OpenFrescoCommands()
 {
+    this->wipeAnalysis();
     if (theDomain != 0) delete theDomain;
     //if (theDatabase != 0) delete theDatabase;
     cmds = 0;
@@ -75,8 +104,69 @@ Domain* OpenFrescoCommands::getDomain()
 }
 
 
+void OpenFrescoCommands::setIntegrator(TransientIntegrator* integrator)
+{
+    this->wipeAnalysis();
+    theTransientIntegrator = integrator;
+}
+
+
+DirectIntegrationAnalysis* OpenFrescoCommands::getTransientAnalysis(double dt)
+{
+    if (theTransientAnalysis != 0) {
+        // the factorized tangent depends on the time step
+        if (dt != analysisDt) {
+            theTransientAnalysis->getAlgorithm()->domainChanged();
+            analysisDt = dt;
+        }
+        return theTransientAnalysis;
+    }
+
+    if (theTransientIntegrator == 0) {
+        opserr << "WARNING no integrator has been defined\n";
+        return 0;
+    }
+
+    // the explicit integrators solve once per step with a tangent
+    // that does not change, so it only needs to be factored once
+    AnalysisModel* theModel = new AnalysisModel();
+    ConstraintHandler* theHandler = new PenaltyConstraintHandler(1.0E12, 1.0E12);
+    RCM* theRCM = new RCM();
+    DOF_Numberer* theNumberer = new DOF_Numberer(*theRCM);
+    EquiSolnAlgo* theAlgorithm = new Linear(CURRENT_TANGENT, 1);
+    BandGenLinSolver* theSolver = new BandGenLinLapackSolver();
+    LinearSOE* theSOE = new BandGenLinSOE(*theSolver);
+
+    theTransientAnalysis = new DirectIntegrationAnalysis(*theDomain,
+        *theHandler, *theNumberer, *theModel, *theAlgorithm, *theSOE,
+        *theTransientIntegrator);
+    analysisDt = dt;
+
+    return theTransientAnalysis;
+}
+
+
+void OpenFrescoCommands::wipeAnalysis()
+{
+    if (theTransientAnalysis != 0) {
+        // this also deletes the integrator
+        theTransientAnalysis->clearAll();
+        delete theTransientAnalysis;
+        theTransientAnalysis = 0;
+        theTransientIntegrator = 0;
+    }
+    if (theTransientIntegrator != 0) {
+        delete theTransientIntegrator;
+        theTransientIntegrator = 0;
+    }
+    analysisDt = 0.0;
+}
+
+
 void OpenFrescoCommands::wipeExp()
 {
+    this->wipeAnalysis();
+
     OPF_clearExperimentalCPs();
     OPF_clearExperimentalSignalFilters();
     OPF_clearExperimentalControls();
@@ -780,6 +870,382 @@ int OPS_setElementRayleighDampingFactors()
 }
 
 
+int OPS_Integrator()
+{
+    if (OPS_GetNumRemainingInputArgs() < 1) {
+        opserr << "WARNING insufficient args: integrator type ...\n";
+        return -1;
+    }
+
+    const char* type = OPS_GetString();
+
+    TransientIntegrator* theIntegrator = 0;
+    if (strcmp(type, "NewmarkExplicit") == 0) {
+        theIntegrator = (TransientIntegrator*)OPS_NewmarkExplicit();
+    } else if (strcmp(type, "AlphaOS") == 0) {
+        theIntegrator = (TransientIntegrator*)OPS_AlphaOS();
+    } else if (strcmp(type, "KRAlphaExplicit") == 0) {
+        theIntegrator = (TransientIntegrator*)OPS_KRAlphaExplicit();
+    } else {
+        opserr << "WARNING integrator type " << type << " is unknown\n";
+        return -1;
+    }
+
+    if (theIntegrator == 0) {
+        opserr << "WARNING failed to create integrator " << type << endln;
+        return -1;
+    }
+
+    if (cmds != 0)
+        cmds->setIntegrator(theIntegrator);
+    else
+        delete theIntegrator;
+
+    return 0;
+}
+
+
+int OPS_analyze()
+{
+    if (OPS_GetNumRemainingInputArgs() < 2) {
+        opserr << "WARNING insufficient args: analyze numIncr? deltaT?\n";
+        return -1;
+    }
+
+    int numIncr;
+    int numdata = 1;
+    if (OPS_GetIntInput(&numdata, &numIncr) < 0) {
+        opserr << "WARNING analyze numIncr? deltaT? - could not read numIncr\n";
+        return -1;
+    }
+
+    double dt;
+    if (OPS_GetDoubleInput(&numdata, &dt) < 0) {
+        opserr << "WARNING analyze numIncr? deltaT? - could not read deltaT\n";
+        return -1;
+    }
+
+    if (cmds == 0) return 0;
+    DirectIntegrationAnalysis* theAnalysis = cmds->getTransientAnalysis(dt);
+    if (theAnalysis == 0) return -1;
+
+    int result = theAnalysis->analyze(numIncr, dt);
+    if (result < 0) {
+        opserr << "WARNING analyze - transient analysis failed\n";
+    }
+
+    if (OPS_SetIntOutput(&numdata, &result, true) < 0) {
+        opserr << "WARNING failed to set output\n";
+        return -1;
+    }
+
+    return 0;
+}
+
+
+int OPF_analyzeEnsemble()
+{
+    if (OPS_GetNumRemainingInputArgs() < 6) {
+        opserr << "WARNING insufficient args\n";
+        opserr << "Want: analyzeEnsemble numRuns numIncr deltaT -node nodeTag dofs "
+            << "<-node nodeTag dofs ...> <-resp disp|vel|accel> <-jobs numJobs> "
+            << "<-first firstMember> <-file fileName>\n";
+        return -1;
+    }
+    
+    int numRuns, numIncr;
+    double dt;
+    int numdata = 1;
+    if (OPS_GetIntInput(&numdata, &numRuns) < 0 || numRuns < 1) {
+        opserr << "WARNING analyzeEnsemble - invalid numRuns\n";
+        return -1;
+    }
+    if (OPS_GetIntInput(&numdata, &numIncr) < 0 || numIncr < 1) {
+        opserr << "WARNING analyzeEnsemble - invalid numIncr\n";
+        return -1;
+    }
+    if (OPS_GetDoubleInput(&numdata, &dt) < 0) {
+        opserr << "WARNING analyzeEnsemble - invalid deltaT\n";
+        return -1;
+    }
+    
+    if (cmds == 0) return 0;
+    Domain* theDomain = cmds->getDomain();
+    
+    // nodal degrees of freedom whose peak responses are collected
+    std::vector<Node*> theNodes;
+    std::vector<int> theDOFs;
+    int respType = OF_Resp_Disp;
+    int numJobs = 0, firstMember = 0;
+    const char* fileName = 0;
+    while (OPS_GetNumRemainingInputArgs() > 0) {
+        const char* type = OPS_GetString();
+        if (strcmp(type, "-node") == 0) {
+            int nodeTag;
+            if (OPS_GetIntInput(&numdata, &nodeTag) < 0) {
+                opserr << "WARNING analyzeEnsemble - invalid nodeTag\n";
+                return -1;
+            }
+            Node* theNode = theDomain->getNode(nodeTag);
+            if (theNode == 0) {
+                opserr << "WARNING analyzeEnsemble - node "
+                    << nodeTag << " does not exist\n";
+                return -1;
+            }
+            int dof, numDOF = 0;
+            while (OPS_GetNumRemainingInputArgs() > 0) {
+                int numArgs = OPS_GetNumRemainingInputArgs();
+                if (OPS_GetIntInput(&numdata, &dof) < 0) {
+                    if (numArgs > OPS_GetNumRemainingInputArgs()) {
+                        // move current arg back by one
+                        OPS_ResetCurrentInputArg(-1);
+                    }
+                    break;
+                }
+                if (dof < 1 || dof > theNode->getNumberDOF()) {
+                    opserr << "WARNING analyzeEnsemble - invalid dof "
+                        << dof << " of node " << nodeTag << endln;
+                    return -1;
+                }
+                theNodes.push_back(theNode);
+                theDOFs.push_back(dof - 1);
+                numDOF++;
+            }
+            if (numDOF == 0) {
+                opserr << "WARNING analyzeEnsemble - no dofs given for node "
+                    << nodeTag << endln;
+                return -1;
+            }
+        }
+        else if (strcmp(type, "-resp") == 0) {
+            const char* resp = OPS_GetString();
+            if (strcmp(resp, "disp") == 0)
+                respType = OF_Resp_Disp;
+            else if (strcmp(resp, "vel") == 0)
+                respType = OF_Resp_Vel;
+            else if (strcmp(resp, "accel") == 0)
+                respType = OF_Resp_Accel;
+            else {
+                opserr << "WARNING analyzeEnsemble - invalid response type "
+                    << resp << endln;
+                return -1;
+            }
+        }
+        else if (strcmp(type, "-jobs") == 0) {
+            if (OPS_GetIntInput(&numdata, &numJobs) < 0 || numJobs < 1) {
+                opserr << "WARNING analyzeEnsemble - invalid numJobs\n";
+                return -1;
+            }
+        }
+        else if (strcmp(type, "-first") == 0) {
+            if (OPS_GetIntInput(&numdata, &firstMember) < 0 || firstMember < 0) {
+                opserr << "WARNING analyzeEnsemble - invalid firstMember\n";
+                return -1;
+            }
+        }
+        else if (strcmp(type, "-file") == 0) {
+            fileName = OPS_GetString();
+        }
+        else {
+            opserr << "WARNING analyzeEnsemble - unknown option " << type << endln;
+            return -1;
+        }
+    }
+    int numResp = (int)theDOFs.size();
+    if (numResp == 0) {
+        opserr << "WARNING analyzeEnsemble - no nodal responses given\n";
+        return -1;
+    }
+    
+#ifdef _WIN32
+    opserr << "WARNING analyzeEnsemble - not available on Windows\n";
+    return -1;
+#else
+    // the realisations are run in forked copies of the process, so the
+    // model is only built once and the domain here stays untouched
+    DirectIntegrationAnalysis* theAnalysis = cmds->getTransientAnalysis(dt);
+    if (theAnalysis == 0) return -1;
+    if (numJobs == 0) {
+        numJobs = (int)sysconf(_SC_NPROCESSORS_ONLN);
+        if (numJobs < 1) numJobs = 1;
+    }
+    if (numJobs > numRuns)
+        numJobs = numRuns;
+    
+    FILE* theFile = 0;
+    if (fileName != 0) {
+        theFile = fopen(fileName, "w");
+        if (theFile == 0) {
+            opserr << "WARNING analyzeEnsemble - could not open file "
+                << fileName << endln;
+            return -1;
+        }
+    }
+    
+    opserr << "analyzeEnsemble - running " << numRuns
+        << " realisations on " << numJobs << " processes\n";
+    
+    // running statistics of the peak responses (Welford)
+    std::vector<double> mean(numResp, 0.0), M2(numResp, 0.0);
+    std::vector<double> minPeak(numResp, 0.0), maxPeak(numResp, 0.0);
+    std::vector<double> msg(numResp + 1);
+    std::vector<struct pollfd> pfds(numJobs);
+    std::vector<pid_t> pids(numJobs);
+    std::vector<int> members(numJobs);
+    int numStarted = 0, numRunning = 0, numDone = 0, numFailed = 0;
+    
+    while (numDone < numRuns) {
+        // start new realisations while there are free jobs
+        while (numRunning < numJobs && numStarted < numRuns) {
+            int fd[2];
+            if (pipe(fd) != 0) {
+                opserr << "WARNING analyzeEnsemble - could not create pipe\n";
+                break;
+            }
+            fflush(NULL);
+            pid_t pid = fork();
+            if (pid < 0) {
+                close(fd[0]);
+                close(fd[1]);
+                opserr << "WARNING analyzeEnsemble - could not fork\n";
+                break;
+            }
+            if (pid == 0) {
+                // realisation with its own member of all random streams
+                close(fd[0]);
+                ExpRandomStream::setEnsembleMember(firstMember + numStarted);
+                msg.assign(numResp + 1, 0.0);
+                for (int i = 0; i < numIncr; i++) {
+                    if (theAnalysis->analyze(1, dt) < 0) {
+                        msg[0] = -1.0;
+                        break;
+                    }
+                    for (int j = 0; j < numResp; j++) {
+                        const Vector* resp;
+                        if (respType == OF_Resp_Vel)
+                            resp = &theNodes[j]->getVel();
+                        else if (respType == OF_Resp_Accel)
+                            resp = &theNodes[j]->getAccel();
+                        else
+                            resp = &theNodes[j]->getDisp();
+                        double peak = fabs((*resp)(theDOFs[j]));
+                        if (peak > msg[j + 1])
+                            msg[j + 1] = peak;
+                    }
+                }
+                ssize_t n = write(fd[1], &msg[0], msg.size()*sizeof(double));
+                close(fd[1]);
+                fflush(NULL);
+                // do not run any destructors of the parent's objects
+                _exit(n == (ssize_t)(msg.size()*sizeof(double)) ? 0 : 1);
+            }
+            close(fd[1]);
+            pfds[numRunning].fd = fd[0];
+            pfds[numRunning].events = POLLIN;
+            pfds[numRunning].revents = 0;
+            pids[numRunning] = pid;
+            members[numRunning] = firstMember + numStarted;
+            numRunning++;
+            numStarted++;
+        }
+        if (numRunning == 0) {
+            // no realisation could be started, so the remaining ones
+            // are counted as failed and no statistics are reported
+            numFailed += numRuns - numStarted;
+            opserr << "WARNING analyzeEnsemble - " << numFailed << " of "
+                << numRuns << " realisations failed or could not be started\n";
+            if (theFile != 0)
+                fclose(theFile);
+            return -1;
+        }
+        
+        // wait for realisations to finish
+        if (poll(&pfds[0], numRunning, -1) < 0)
+            continue;
+        for (int k = numRunning - 1; k >= 0; k--) {
+            if (pfds[k].revents == 0)
+                continue;
+            size_t nbytes = msg.size()*sizeof(double), nread = 0;
+            char* buf = (char*)&msg[0];
+            while (nread < nbytes) {
+                ssize_t n = read(pfds[k].fd, buf + nread, nbytes - nread);
+                if (n <= 0) break;
+                nread += n;
+            }
+            close(pfds[k].fd);
+            int status;
+            waitpid(pids[k], &status, 0);
+            int member = members[k];
+            numDone++;
+            
+            // remove the finished job from the list
+            numRunning--;
+            pfds[k] = pfds[numRunning];
+            pids[k] = pids[numRunning];
+            members[k] = members[numRunning];
+            
+            if (nread < nbytes || msg[0] != 0.0) {
+                numFailed++;
+                opserr << "analyzeEnsemble - realisation " << member
+                    << " failed\n";
+                continue;
+            }
+            
+            // update and stream the statistics
+            int n = numDone - numFailed;
+            for (int j = 0; j < numResp; j++) {
+                double x = msg[j + 1];
+                double delta = x - mean[j];
+                mean[j] += delta / n;
+                M2[j] += delta * (x - mean[j]);
+                if (n == 1 || x < minPeak[j]) minPeak[j] = x;
+                if (n == 1 || x > maxPeak[j]) maxPeak[j] = x;
+            }
+            opserr << "realisation " << member << " (" << numDone << "/"
+                << numRuns << "): peak";
+            for (int j = 0; j < numResp; j++)
+                opserr << " " << msg[j + 1];
+            opserr << ", mean";
+            for (int j = 0; j < numResp; j++)
+                opserr << " " << mean[j];
+            opserr << ", std";
+            for (int j = 0; j < numResp; j++)
+                opserr << " " << (n > 1 ? sqrt(M2[j] / (n - 1)) : 0.0);
+            opserr << endln;
+            if (theFile != 0) {
+                fprintf(theFile, "%d", member);
+                for (int j = 0; j < numResp; j++)
+                    fprintf(theFile, " %.10e", msg[j + 1]);
+                fprintf(theFile, "\n");
+                fflush(theFile);
+            }
+        }
+    }
+    if (theFile != 0)
+        fclose(theFile);
+    
+    // summary of the peak responses of all successful realisations
+    int numOK = numDone - numFailed;
+    opserr << "analyzeEnsemble - " << numOK << " of " << numRuns
+        << " realisations completed\n";
+    for (int j = 0; j < numResp; j++) {
+        opserr << "  node " << theNodes[j]->getTag() << " dof "
+            << theDOFs[j] + 1 << ": mean " << mean[j] << ", std "
+            << (numOK > 1 ? sqrt(M2[j] / (numOK - 1)) : 0.0)
+            << ", min " << minPeak[j] << ", max " << maxPeak[j] << endln;
+    }
+    
+    // return the mean peak responses
+    if (OPS_SetDoubleOutput(&numResp, &mean[0], false) < 0) {
+        opserr << "WARNING failed to set output\n";
+        return -1;
+    }
+    
+    return numOK > 0 ? 0 : -1;
+#endif
+}
+
+
 UniaxialMaterial* OPS_GetUniaxialMaterial(int matTag)
 {
     return OPS_getUniaxialMaterial(matTag);
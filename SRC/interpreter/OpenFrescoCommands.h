@@ -36,6 +36,9 @@
 #include <SimulationInformation.h>
 #include <elementAPI.h>
 
+class TransientIntegrator;
+class DirectIntegrationAnalysis;
+
 class OpenFrescoCommands
 {
 public:
@@ -57,6 +60,11 @@ public:
     Timer* getTimer() { return &theTimer; }
     SimulationInformation* getSimulationInformation() { return &theSimulationInfo; }
 
+    void setIntegrator(TransientIntegrator* integrator);
+    TransientIntegrator* getIntegrator() { return theTransientIntegrator; }
+    DirectIntegrationAnalysis* getTransientAnalysis(double dt);
+    void wipeAnalysis();
+
     void wipeExp();
     
 private:
@@ -68,6 +76,10 @@ private:
     //FEM_ObjectBrokerAllClasses theBroker;
     Timer theTimer;
     SimulationInformation theSimulationInfo;
+
+    TransientIntegrator* theTransientIntegrator;
+    DirectIntegrationAnalysis* theTransientAnalysis;
+    double analysisDt;
 };
 
 
@@ -94,6 +106,8 @@ int OPS_FrictionModel();
 int OPS_CrdTransf();
 int OPS_rayleighDamping();
 int OPS_setElementRayleighDampingFactors();
+int OPS_Integrator();
+int OPS_analyze();
 
 // main OpenFresco objects commands
 int OPF_ExperimentalCP();
@@ -113,6 +127,7 @@ int OPF_stepLabServer();
 int OPF_stopLabServer();
 int OPF_startSimAppSiteServer();
 int OPF_startSimAppElemServer();
+int OPF_startLabVIEWMockServer();
 
 // clear OpenFresco object commands
 void OPF_clearExperimentalCPs();
@@ -136,6 +151,7 @@ int OPF_setSizeExperimentalSite();
 int OPF_recordExp();
 int OPF_wipeExp();
 int OPF_removeObject();
+int OPF_analyzeEnsemble();
 
 
 #endif
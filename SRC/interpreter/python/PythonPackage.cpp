@@ -79,6 +79,7 @@ extern int OPF_stepLabServer();
 extern int OPF_stopLabServer();
 extern int OPF_startSimAppSiteServer();
 extern int OPF_startSimAppElemServer();
+extern int OPF_startLabVIEWMockServer();
 
 // clear OpenFresco object commands
 extern void OPF_clearExperimentalCPs();
@@ -631,6 +632,21 @@ static PyObject* Py_opf_startSimAppElemServer(PyObject* self, PyObject* args)
 }
 
 
+// start LabVIEW mock server command
+static PyObject* Py_opf_startLabVIEWMockServer(PyObject* self, PyObject* args)
+{
+    // reset the input args
+    OPS_ResetCommandLine((int)PyTuple_Size(args), 1, (const char**)args);
+    
+    if (OPF_startLabVIEWMockServer() < 0) {
+        opserr << (void*)0;
+        return NULL;
+    }
+    
+    return getResults();
+}
+
+
 // opensees command to analyze a model interactively
 static PyObject* Py_ops_analyzeModelInteractive(PyObject* self, PyObject* args)
 {
@@ -1080,6 +1096,7 @@ OpenFrescoPy(PyObject* self, PyObject* args, PyObject* module, Domain* domain)
     Py_opf_addCommand("stopLabServer", &Py_opf_stopLabServer);
     Py_opf_addCommand("startSimAppSiteServer", &Py_opf_startSimAppSiteServer);
     Py_opf_addCommand("startSimAppElemServer", &Py_opf_startSimAppElemServer);
+    Py_opf_addCommand("startLabVIEWMockServer", &Py_opf_startLabVIEWMockServer);
     Py_opf_addCommand("analyzeInteractive", &Py_ops_analyzeModelInteractive);
     Py_opf_addCommand("wipeExp", &Py_opf_wipeExp);
     Py_opf_addCommand("removeExp", &Py_opf_removeExp);
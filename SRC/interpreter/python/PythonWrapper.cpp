@@ -465,6 +465,19 @@ static PyObject* Py_opf_startSimAppElemServer(PyObject* self, PyObject* args)
 }
 
 
+static PyObject* Py_opf_startLabVIEWMockServer(PyObject* self, PyObject* args)
+{
+    wrapper->resetCommandLine((int)PyTuple_Size(args), 1, args);
+    
+    if (OPF_startLabVIEWMockServer() < 0) {
+        opserr << (void*)0;
+        return NULL;
+    }
+    
+    return wrapper->getResults();
+}
+
+
 static PyObject* Py_opf_wipeExp(PyObject* self, PyObject* args)
 {
     wrapper->resetCommandLine((int)PyTuple_Size(args), 1, args);
@@ -700,6 +713,45 @@ static PyObject* Py_ops_setElementRayleighDampingFactors(PyObject* self, PyObjec
 }
 
 
+static PyObject* Py_ops_integrator(PyObject* self, PyObject* args)
+{
+    wrapper->resetCommandLine((int)PyTuple_Size(args), 1, args);
+    
+    if (OPS_Integrator() < 0) {
+        opserr << (void*)0;
+        return NULL;
+    }
+    
+    return wrapper->getResults();
+}
+
+
+static PyObject* Py_ops_analyze(PyObject* self, PyObject* args)
+{
+    wrapper->resetCommandLine((int)PyTuple_Size(args), 1, args);
+    
+    if (OPS_analyze() < 0) {
+        opserr << (void*)0;
+        return NULL;
+    }
+    
+    return wrapper->getResults();
+}
+
+
+static PyObject* Py_opf_analyzeEnsemble(PyObject* self, PyObject* args)
+{
+    wrapper->resetCommandLine((int)PyTuple_Size(args), 1, args);
+    
+    if (OPF_analyzeEnsemble() < 0) {
+        opserr << (void*)0;
+        return NULL;
+    }
+    
+    return wrapper->getResults();
+}
+
+
 /////////////////////////////////////////////////
 ////////////// Add Python commands //////////////
 /////////////////////////////////////////////////
@@ -722,6 +774,7 @@ void PythonWrapper::addOpenFrescoCommands()
     addCommand("stopLabServer", &Py_opf_stopLabServer);
     addCommand("startSimAppSiteServer", &Py_opf_startSimAppSiteServer);
     addCommand("startSimAppElemServer", &Py_opf_startSimAppElemServer);
+    addCommand("startLabVIEWMockServer", &Py_opf_startLabVIEWMockServer);
     addCommand("wipeExp", &Py_opf_wipeExp);
     addCommand("removeExp", &Py_opf_removeExp);
     addCommand("version", &Py_opf_version);
@@ -742,6 +795,9 @@ void PythonWrapper::addOpenFrescoCommands()
     addCommand("geomTransf", &Py_ops_geomTransf);
     addCommand("rayleigh", &Py_ops_rayleigh);
     addCommand("setElementRayleighDampingFactors", &Py_ops_setElementRayleighDampingFactors);
+    addCommand("integrator", &Py_ops_integrator);
+    addCommand("analyze", &Py_ops_analyze);
+    addCommand("analyzeEnsemble", &Py_opf_analyzeEnsemble);
     
     PyMethodDef method = { NULL,NULL,0,NULL };
     methodsOpenFresco.push_back(method);
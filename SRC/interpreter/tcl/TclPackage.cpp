@@ -68,6 +68,7 @@ extern int OPF_stepLabServer();
 extern int OPF_stopLabServer();
 extern int OPF_startSimAppSiteServer();
 extern int OPF_startSimAppElemServer();
+extern int OPF_startLabVIEWMockServer();
 
 // clear OpenFresco object commands
 extern void OPF_clearExperimentalCPs();
@@ -513,6 +514,19 @@ int Tcl_opf_startSimAppElemServer(ClientData clientData,
 }
 
 
+// start LabVIEW mock server command
+int Tcl_opf_startLabVIEWMockServer(ClientData clientData,
+    Tcl_Interp *interp, int argc, TCL_Char **argv)
+{
+    // reset the input args
+    OPS_ResetCommandLine(argc, 1, argv);
+    
+    if (OPF_startLabVIEWMockServer() < 0) return TCL_ERROR;
+    
+    return TCL_OK;
+}
+
+
 // opensees command to analyze a model interactively
 int Tcl_ops_analyzeModelInteractive(ClientData clientData,
     Tcl_Interp* interp, int argc, TCL_Char** argv)
@@ -1005,6 +1019,9 @@ OpenFrescoTcl(ClientData clientData, Tcl_Interp *interp,
     Tcl_CreateCommand(interp, "startSimAppElemServer", Tcl_opf_startSimAppElemServer,
         (ClientData)NULL, (Tcl_CmdDeleteProc*)NULL);
     
+    Tcl_CreateCommand(interp, "startLabVIEWMockServer", Tcl_opf_startLabVIEWMockServer,
+        (ClientData)NULL, (Tcl_CmdDeleteProc*)NULL);
+    
     Tcl_CreateCommand(interp, "analyzeInteractive", Tcl_ops_analyzeModelInteractive,
         (ClientData)NULL, (Tcl_CmdDeleteProc*)NULL);
     
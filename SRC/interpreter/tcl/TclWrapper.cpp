@@ -499,6 +499,17 @@ static int Tcl_opf_startSimAppElemServer(ClientData clientData,
 }
 
 
+static int Tcl_opf_startLabVIEWMockServer(ClientData clientData,
+    Tcl_Interp *interp, int argc, TCL_Char **argv)
+{
+    wrapper->resetCommandLine(argc, 1, argv);
+    
+    if (OPF_startLabVIEWMockServer() < 0) return TCL_ERROR;
+    
+    return TCL_OK;
+}
+
+
 static int Tcl_opf_wipeExp(ClientData clientData,
     Tcl_Interp *interp, int argc, TCL_Char **argv)
 {
@@ -700,6 +711,39 @@ static int Tcl_ops_setElementRayleighDampingFactors(ClientData clientData,
 }
 
 
+static int Tcl_ops_integrator(ClientData clientData,
+    Tcl_Interp* interp, int argc, TCL_Char** argv)
+{
+    wrapper->resetCommandLine(argc, 1, argv);
+    
+    if (OPS_Integrator() < 0) return TCL_ERROR;
+    
+    return TCL_OK;
+}
+
+
+static int Tcl_ops_analyze(ClientData clientData,
+    Tcl_Interp* interp, int argc, TCL_Char** argv)
+{
+    wrapper->resetCommandLine(argc, 1, argv);
+    
+    if (OPS_analyze() < 0) return TCL_ERROR;
+    
+    return TCL_OK;
+}
+
+
+static int Tcl_opf_analyzeEnsemble(ClientData clientData,
+    Tcl_Interp* interp, int argc, TCL_Char** argv)
+{
+    wrapper->resetCommandLine(argc, 1, argv);
+    
+    if (OPF_analyzeEnsemble() < 0) return TCL_ERROR;
+    
+    return TCL_OK;
+}
+
+
 ////////////////////////////////
 /////// Add Tcl commands ///////
 ////////////////////////////////
@@ -723,6 +767,7 @@ void TclWrapper::addOpenFrescoCommands(Tcl_Interp* interp)
     addCommand(interp, "stopLabServer", &Tcl_opf_stopLabServer);
     addCommand(interp, "startSimAppSiteServer", &Tcl_opf_startSimAppSiteServer);
     addCommand(interp, "startSimAppElemServer", &Tcl_opf_startSimAppElemServer);
+    addCommand(interp, "startLabVIEWMockServer", &Tcl_opf_startLabVIEWMockServer);
     addCommand(interp, "wipeExp", &Tcl_opf_wipeExp);
     addCommand(interp, "removeExp", &Tcl_opf_removeExp);
     addCommand(interp, "version", &Tcl_opf_version);
@@ -743,4 +788,7 @@ void TclWrapper::addOpenFrescoCommands(Tcl_Interp* interp)
     addCommand(interp, "geomTransf", &Tcl_ops_geomTransf);
     addCommand(interp, "rayleigh", &Tcl_ops_rayleigh);
     addCommand(interp, "setElementRayleighDampingFactors", &Tcl_ops_setElementRayleighDampingFactors);
+    addCommand(interp, "integrator", &Tcl_ops_integrator);
+    addCommand(interp, "analyze", &Tcl_ops_analyze);
+    addCommand(interp, "analyzeEnsemble", &Tcl_opf_analyzeEnsemble);
 }
@@ -44,13 +44,31 @@ using std::nothrow;
 
 #include <math.h>
 
-int Matrix::sizeDoubleWork = MATRIX_WORK_AREA;
-int Matrix::sizeIntWork = INT_WORK_AREA;
 double Matrix::MATRIX_NOT_VALID_ENTRY =0.0;
-double *Matrix::matrixWork = 0;
-int    *Matrix::intWork =0;
+thread_local Matrix::WorkArea Matrix::work;
 
-//double *Matrix::matrixWork = (double *)malloc(400*sizeof(double));
+// the work areas of a thread are allocated on its first Solve()
+// or Invert() and freed when the thread exits
+Matrix::WorkArea::WorkArea()
+:matrixWork(0), intWork(0), sizeDoubleWork(0), sizeIntWork(0)
+{
+  matrixWork = new (nothrow) double[MATRIX_WORK_AREA];
+  intWork = new (nothrow) int[INT_WORK_AREA];
+  if (matrixWork == 0 || intWork == 0) {
+    opserr << "WARNING: Matrix::WorkArea() - out of memory creating work area's\n";
+    exit(-1);
+  }
+  sizeDoubleWork = MATRIX_WORK_AREA;
+  sizeIntWork = INT_WORK_AREA;
+}
+
+Matrix::WorkArea::~WorkArea()
+{
+  if (matrixWork != 0)
+    delete [] matrixWork;
+  if (intWork != 0)
+    delete [] intWork;
+}
 
 //
 // CONSTRUCTORS
@@ -59,15 +77,6 @@ int    *Matrix::intWork =0;
 Matrix::Matrix()
 :numRows(0), numCols(0), dataSize(0), data(0), fromFree(0)
 {
-  // allocate work areas if the first
-  if (matrixWork == 0) {
-    matrixWork = new (nothrow) double[sizeDoubleWork];
-    intWork = new (nothrow) int[sizeIntWork];
-    if (matrixWork == 0 || intWork == 0) {
-      opserr << "WARNING: Matrix::Matrix() - out of memory creating work area's\n";
-      exit(-1);
-    }
-  }
 }
 
 
@@ -75,16 +84,6 @@ Matrix::Matrix(int nRows,int nCols)
 :numRows(nRows), numCols(nCols), dataSize(0), data(0), fromFree(0)
 {
 
-  // allocate work areas if the first matrix
-  if (matrixWork == 0) {
-    matrixWork = new (nothrow) double[sizeDoubleWork];
-    intWork = new (nothrow) int[sizeIntWork];
-    if (matrixWork == 0 || intWork == 0) {
-      opserr << "WARNING: Matrix::Matrix() - out of memory creating work area's\n";
-      exit(-1);
-    }
-  }
-
 #ifdef _G3DEBUG
     if (nRows < 0) {
       opserr << "WARNING: Matrix::Matrix(int,int): tried to init matrix ";
@@ -119,15 +118,6 @@ Matrix::Matrix(int nRows,int nCols)
 Matrix::Matrix(double *theData, int row, int col) 
 :numRows(row),numCols(col),dataSize(row*col),data(theData),fromFree(1)
 {
-  // allocate work areas if the first matrix
-  if (matrixWork == 0) {
-    matrixWork = new (nothrow) double[sizeDoubleWork];
-    intWork = new (nothrow) int[sizeIntWork];
-    if (matrixWork == 0 || intWork == 0) {
-      opserr << "WARNING: Matrix::Matrix() - out of memory creating work area's\n";
-      exit(-1);
-    }
-  }
 
 #ifdef _G3DEBUG
     if (row < 0) {
@@ -148,15 +138,6 @@ Matrix::Matrix(double *theData, int row, int col)
 Matrix::Matrix(const Matrix &other)
 :numRows(0), numCols(0), dataSize(0), data(0), fromFree(0)
 {
-  // allocate work areas if the first matrix
-  if (matrixWork == 0) {
-    matrixWork = new (nothrow) double[sizeDoubleWork];
-    intWork = new (nothrow) int[sizeIntWork];
-    if (matrixWork == 0 || intWork == 0) {
-      opserr << "WARNING: Matrix::Matrix() - out of memory creating work area's\n";
-      exit(-1);
-    }
-  }
 
     numRows = other.numRows;
     numCols = other.numCols;
@@ -366,6 +347,12 @@ int
 Matrix::Solve(const Vector &b, Vector &x) const
 {
 
+    // work areas of the calling thread
+    double *&matrixWork = work.matrixWork;
+    int *&intWork = work.intWork;
+    int &sizeDoubleWork = work.sizeDoubleWork;
+    int &sizeIntWork = work.sizeIntWork;
+
     int n = numRows;
 
 #ifdef _G3DEBUG    
@@ -454,6 +441,12 @@ int
 Matrix::Solve(const Matrix &b, Matrix &x) const
 {
 
+    // work areas of the calling thread
+    double *&matrixWork = work.matrixWork;
+    int *&intWork = work.intWork;
+    int &sizeDoubleWork = work.sizeDoubleWork;
+    int &sizeIntWork = work.sizeIntWork;
+
     int n = numRows;
     int nrhs = x.numCols;
 
@@ -560,6 +553,12 @@ int
 Matrix::Invert(Matrix &theInverse) const
 {
 
+    // work areas of the calling thread
+    double *&matrixWork = work.matrixWork;
+    int *&intWork = work.intWork;
+    int &sizeDoubleWork = work.sizeDoubleWork;
+    int &sizeIntWork = work.sizeIntWork;
+
     int n = numRows;
 
 
@@ -953,6 +952,10 @@ Matrix::addMatrixTripleProduct(double thisFact,
     int dimB = B.numCols;
     int sizeWork = dimB * numCols;
 
+    // work area of the calling thread
+    double *matrixWork = work.matrixWork;
+    int sizeDoubleWork = work.sizeDoubleWork;
+
     if (sizeWork > sizeDoubleWork) {
       this->addMatrix(thisFact, T^B*T, otherFact);
       return 0;
@@ -1051,6 +1054,10 @@ Matrix::addMatrixTripleProduct(double thisFact,
     // cheack work area can hold the temporary matrix
     int sizeWork = B.numRows * numCols;
 
+    // work area of the calling thread
+    double *matrixWork = work.matrixWork;
+    int sizeDoubleWork = work.sizeDoubleWork;
+
     if (sizeWork > sizeDoubleWork) {
       this->addMatrix(thisFact, A^B*C, otherFact);
       return 0;
@@ -1815,11 +1822,11 @@ Matrix::Eigen3(const Matrix &M)
   int     rot, its, i, j , k ;
   double  g, h, aij, sm, thresh, t, c, s, tau ;
 
-  static Matrix  v(3,3) ;
-  static Vector  d(3) ;
-  static Vector  a(3) ;
-  static Vector  b(3) ; 
-  static Vector  z(3) ;
+  Matrix  v(3,3) ;
+  Vector  d(3) ;
+  Vector  a(3) ;
+  Vector  b(3) ; 
+  Vector  z(3) ;
 
   static const double tol = 1.0e-08 ;
 
@@ -1939,7 +1946,7 @@ Matrix::Eigen3(const Matrix &M)
     sm = fabs(a(0)) + fabs(a(1)) + fabs(a(2)) ;
 
   } //end while sm
-  static Vector  dd(3) ;
+  Vector  dd(3) ;
   if (d(0)>d(1))
     {
       if (d(0)>d(2))
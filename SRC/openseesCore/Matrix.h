@@ -147,6 +147,7 @@ class Matrix
     friend class UDP_Socket;
     friend class TCP_Socket;
     friend class TCP_SocketSSL;
+    friend class SHM_Channel;
     friend class TCP_SocketNoDelay;
     friend class MPI_Channel;
     friend class MySqlDatastore;
@@ -156,10 +157,18 @@ class Matrix
 
   private:
     static double MATRIX_NOT_VALID_ENTRY;
-    static double *matrixWork;
-    static int *intWork;
-    static int sizeDoubleWork;
-    static int sizeIntWork;
+
+    // work areas for Solve() and Invert(), kept per thread so that
+    // matrices can be solved concurrently
+    struct WorkArea {
+      WorkArea();
+      ~WorkArea();
+      double *matrixWork;
+      int *intWork;
+      int sizeDoubleWork;
+      int sizeIntWork;
+    };
+    static thread_local WorkArea work;
 
     int numRows;
     int numCols;
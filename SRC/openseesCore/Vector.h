@@ -118,6 +118,7 @@ class Vector
     friend class UDP_Socket;
     friend class TCP_Socket;
     friend class TCP_SocketSSL;
+    friend class SHM_Channel;
     friend class TCP_SocketNoDelay;    
     friend class MPI_Channel;
     friend class MySqlDatastore;
@@ -1204,6 +1204,7 @@
 #define OPS_STREAM_TAGS_DataTurbineStream   10
 #define OPS_STREAM_TAGS_DataFileStreamAdd   11
 #define OPS_STREAM_TAGS_SocketStream        12
+#define OPS_STREAM_TAGS_TelemetryStream     13
 
 #define DomDecompALGORITHM_TAGS_DomainDecompAlgo 1
 
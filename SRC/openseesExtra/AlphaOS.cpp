@@ -0,0 +1,491 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation of the
+// AlphaOS class.
+
+#include "AlphaOS.h"
+
+#include <FE_Element.h>
+#include <FE_EleIter.h>
+#include <LinearSOE.h>
+#include <AnalysisModel.h>
+#include <Vector.h>
+#include <DOF_Group.h>
+#include <DOF_GrpIter.h>
+#include <ID.h>
+#include <Channel.h>
+#include <classTags.h>
+#include <elementAPI.h>
+
+
+void* OPS_AlphaOS()
+{
+    int argc = OPS_GetNumRemainingInputArgs();
+    if (argc != 1 && argc != 3)  {
+        opserr << "WARNING - incorrect number of args want AlphaOS $alpha <$beta $gamma>\n";
+        return 0;
+    }
+    
+    double data[3];
+    if (OPS_GetDoubleInput(&argc, data) != 0)  {
+        opserr << "WARNING - invalid args want AlphaOS $alpha <$beta $gamma>\n";
+        return 0;
+    }
+    
+    if (data[0] < 2.0/3.0 || data[0] > 1.0)  {
+        opserr << "WARNING AlphaOS - alpha should be between 2/3 and 1\n";
+        return 0;
+    }
+    
+    if (argc == 1)
+        return new AlphaOS(data[0]);
+    
+    return new AlphaOS(data[0], data[1], data[2]);
+}
+
+
+AlphaOS::AlphaOS()
+    : TransientIntegrator(INTEGRATOR_TAGS_AlphaOS),
+    alpha(1.0), beta(0.25), gamma(0.5), deltaT(0.0),
+    c1(0.0), c2(0.0), c3(0.0),
+    Ut(0), Utdot(0), Utdotdot(0), U(0), Udot(0), Udotdot(0),
+    Upt(0), Ucorr(0), Fn(0), eqnID(0), formCommit(false)
+{
+    
+}
+
+
+AlphaOS::AlphaOS(double _alpha)
+    : TransientIntegrator(INTEGRATOR_TAGS_AlphaOS),
+    alpha(_alpha), beta((2.0-_alpha)*(2.0-_alpha)*0.25),
+    gamma(1.5-_alpha), deltaT(0.0),
+    c1(0.0), c2(0.0), c3(0.0),
+    Ut(0), Utdot(0), Utdotdot(0), U(0), Udot(0), Udotdot(0),
+    Upt(0), Ucorr(0), Fn(0), eqnID(0), formCommit(false)
+{
+    
+}
+
+
+AlphaOS::AlphaOS(double _alpha, double _beta, double _gamma)
+    : TransientIntegrator(INTEGRATOR_TAGS_AlphaOS),
+    alpha(_alpha), beta(_beta), gamma(_gamma), deltaT(0.0),
+    c1(0.0), c2(0.0), c3(0.0),
+    Ut(0), Utdot(0), Utdotdot(0), U(0), Udot(0), Udotdot(0),
+    Upt(0), Ucorr(0), Fn(0), eqnID(0), formCommit(false)
+{
+    
+}
+
+
+AlphaOS::~AlphaOS()
+{
+    // clean up the memory created
+    if (Ut != 0)
+        delete Ut;
+    if (Utdot != 0)
+        delete Utdot;
+    if (Utdotdot != 0)
+        delete Utdotdot;
+    if (U != 0)
+        delete U;
+    if (Udot != 0)
+        delete Udot;
+    if (Udotdot != 0)
+        delete Udotdot;
+    if (Upt != 0)
+        delete Upt;
+    if (Ucorr != 0)
+        delete Ucorr;
+    if (Fn != 0)
+        delete Fn;
+    if (eqnID != 0)
+        delete eqnID;
+}
+
+
+int AlphaOS::newStep(double _deltaT)
+{
+    deltaT = _deltaT;
+    if (beta == 0 || gamma == 0)  {
+        opserr << "AlphaOS::newStep() - error in variable\n";
+        opserr << "gamma = " << gamma << " beta = " << beta << endln;
+        return -1;
+    }
+    
+    if (deltaT <= 0.0)  {
+        opserr << "AlphaOS::newStep() - error in variable\n";
+        opserr << "dT = " << deltaT << endln;
+        return -2;
+    }
+    
+    // get a pointer to the AnalysisModel
+    AnalysisModel *theModel = this->getAnalysisModel();
+    
+    // set the constants
+    c1 = 1.0;
+    c2 = gamma/(beta*deltaT);
+    c3 = 1.0/(beta*deltaT*deltaT);
+    
+    if (U == 0)  {
+        opserr << "AlphaOS::newStep() - domainChange() failed or hasn't been called\n";
+        return -3;
+    }
+    
+    // set response at t to be that at t+deltaT of previous step
+    (*Ut) = *U;
+    (*Utdot) = *Udot;
+    (*Utdotdot) = *Udotdot;
+    
+    // determine the predictor response at time t+deltaT
+    Upt->addVector(0.0, *Ut, 1.0);
+    Upt->addVector(1.0, *Utdot, deltaT);
+    Upt->addVector(1.0, *Utdotdot, (0.5-beta)*deltaT*deltaT);
+    (*U) = *Upt;
+    Ucorr->Zero();
+    
+    Udot->addVector(1.0, *Utdotdot, (1.0-gamma)*deltaT);
+    
+    Udotdot->Zero();
+    
+    // set the trial response quantities
+    theModel->setResponse(*U, *Udot, *Udotdot);
+    
+    // increment the time to t+alpha*deltaT and apply the load
+    // (this sends the single command of this step)
+    double time = theModel->getCurrentDomainTime();
+    time += alpha*deltaT;
+    if (theModel->updateDomain(time, deltaT) < 0)  {
+        opserr << "AlphaOS::newStep() - failed to update the domain\n";
+        return -4;
+    }
+    
+    return 0;
+}
+
+
+int AlphaOS::revertToLastStep()
+{
+    // set response at t+deltaT to be that at t .. for next step
+    if (U != 0)  {
+        (*U) = *Ut;
+        (*Udot) = *Utdot;
+        (*Udotdot) = *Utdotdot;
+    }
+    
+    return 0;
+}
+
+
+int AlphaOS::formEleTangent(FE_Element *theEle)
+{
+    theEle->zeroTangent();
+    
+    theEle->addKiToTang(alpha*c1);
+    theEle->addCtoTang(alpha*c2);
+    theEle->addMtoTang(c3);
+    
+    return 0;
+}
+
+
+int AlphaOS::formNodTangent(DOF_Group *theDof)
+{
+    theDof->zeroTangent();
+    
+    theDof->addCtoTang(alpha*c2);
+    theDof->addMtoTang(c3);
+    
+    return 0;
+}
+
+
+int AlphaOS::formEleResidual(FE_Element *theEle)
+{
+    // the resisting forces at the displacements are obtained
+    // by correcting the ones at the predictor displacements
+    // (getKi_Force zeroes the residual before adding to it)
+    if (formCommit == true)  {
+        theEle->getKi_Force(*Ucorr, -1.0);
+        theEle->addRtoResidual(1.0);
+        theEle->addD_Force(*Udot, -1.0);
+    }
+    else  {
+        theEle->getKi_Force(*Ucorr, -alpha);
+        theEle->addRtoResidual(alpha);
+        theEle->addD_Force(*Udot, -alpha);
+        theEle->addM_Force(*Udotdot, -1.0);
+    }
+    
+    return 0;
+}
+
+
+int AlphaOS::formNodUnbalance(DOF_Group *theDof)
+{
+    theDof->zeroUnbalance();
+    
+    if (formCommit == true)  {
+        theDof->addD_Force(*Udot, -1.0);
+    }
+    else  {
+        theDof->addPtoUnbalance();
+        theDof->addD_Force(*Udot, -alpha);
+        theDof->addM_Force(*Udotdot, -1.0);
+    }
+    
+    return 0;
+}
+
+
+int AlphaOS::formUnbalance()
+{
+    // form the unbalance at t+alpha*deltaT
+    if (this->TransientIntegrator::formUnbalance() < 0)
+        return -1;
+    
+    // and add the contribution of the forces at time t
+    LinearSOE *theLinSOE = this->getLinearSOE();
+    if (theLinSOE->addB(*Fn, *eqnID, 1.0-alpha) < 0)  {
+        opserr << "WARNING AlphaOS::formUnbalance() - ";
+        opserr << "failed to add the forces at time t\n";
+        return -3;
+    }
+    
+    return 0;
+}
+
+
+int AlphaOS::domainChanged()
+{
+    AnalysisModel *myModel = this->getAnalysisModel();
+    LinearSOE *theLinSOE = this->getLinearSOE();
+    const Vector &x = theLinSOE->getX();
+    int size = x.Size();
+    
+    // create the new Vector objects
+    if (Ut == 0 || Ut->Size() != size)  {
+        
+        // delete the old
+        if (Ut != 0)
+            delete Ut;
+        if (Utdot != 0)
+            delete Utdot;
+        if (Utdotdot != 0)
+            delete Utdotdot;
+        if (U != 0)
+            delete U;
+        if (Udot != 0)
+            delete Udot;
+        if (Udotdot != 0)
+            delete Udotdot;
+        if (Upt != 0)
+            delete Upt;
+        if (Ucorr != 0)
+            delete Ucorr;
+        if (Fn != 0)
+            delete Fn;
+        if (eqnID != 0)
+            delete eqnID;
+        
+        // create the new
+        Ut = new Vector(size);
+        Utdot = new Vector(size);
+        Utdotdot = new Vector(size);
+        U = new Vector(size);
+        Udot = new Vector(size);
+        Udotdot = new Vector(size);
+        Upt = new Vector(size);
+        Ucorr = new Vector(size);
+        Fn = new Vector(size);
+        eqnID = new ID(size);
+        for (int i=0; i<size; i++)
+            (*eqnID)(i) = i;
+    }
+    
+    // now go through and populate U, Udot and Udotdot by iterating through
+    // the DOF_Groups and getting the last committed velocity and accel
+    DOF_GrpIter &theDOFs = myModel->getDOFs();
+    DOF_Group *dofPtr;
+    while ((dofPtr = theDOFs()) != 0)  {
+        const ID &id = dofPtr->getID();
+        int idSize = id.Size();
+        
+        const Vector &disp = dofPtr->getCommittedDisp();
+        const Vector &vel = dofPtr->getCommittedVel();
+        const Vector &accel = dofPtr->getCommittedAccel();
+        for (int i=0; i<idSize; i++)  {
+            int loc = id(i);
+            if (loc >= 0)  {
+                (*U)(loc) = disp(i);
+                (*Udot)(loc) = vel(i);
+                (*Udotdot)(loc) = accel(i);
+            }
+        }
+    }
+    (*Upt) = *U;
+    Ucorr->Zero();
+    
+    // get the forces at the committed state
+    return this->formCommittedForce();
+}
+
+
+int AlphaOS::update(const Vector &deltaU)
+{
+    AnalysisModel *theModel = this->getAnalysisModel();
+    if (theModel == 0)  {
+        opserr << "WARNING AlphaOS::update() - no AnalysisModel set\n";
+        return -1;
+    }
+    
+    // check domainChanged() has been called, i.e. Ut will not be zero
+    if (Ut == 0)  {
+        opserr << "WARNING AlphaOS::update() - domainChange() failed or not called\n";
+        return -2;
+    }
+    
+    // check deltaU is of correct size
+    if (deltaU.Size() != U->Size())  {
+        opserr << "WARNING AlphaOS::update() - Vectors of incompatible size ";
+        opserr << " expecting " << U->Size() << " obtained " << deltaU.Size() << endln;
+        return -3;
+    }
+    
+    // determine the response at t+deltaT
+    U->addVector(1.0, deltaU, c1);
+    Ucorr->addVector(1.0, deltaU, c1);
+    Udot->addVector(1.0, deltaU, c2);
+    Udotdot->addVector(1.0, deltaU, c3);
+    
+    // the elements keep the resisting forces at the predictor
+    // displacements, so the domain is not updated again (which
+    // would send a second command)
+    theModel->setResponse(*U, *Udot, *Udotdot);
+    
+    return 0;
+}
+
+
+int AlphaOS::commit(void)
+{
+    AnalysisModel *theModel = this->getAnalysisModel();
+    if (theModel == 0)  {
+        opserr << "WARNING AlphaOS::commit() - no AnalysisModel set\n";
+        return -1;
+    }
+    
+    // save the forces at t+deltaT for the next step
+    if (this->formCommittedForce() < 0)
+        return -2;
+    
+    // set the time to be t+deltaT
+    double time = theModel->getCurrentDomainTime();
+    time += (1.0-alpha)*deltaT;
+    theModel->setCurrentDomainTime(time);
+    
+    return theModel->commitDomain();
+}
+
+
+const Vector& AlphaOS::getVel()
+{
+    return *Udot;
+}
+
+
+int AlphaOS::sendSelf(int cTag, Channel &theChannel)
+{
+    Vector data(3);
+    data(0) = alpha;
+    data(1) = beta;
+    data(2) = gamma;
+    
+    if (theChannel.sendVector(this->getDbTag(), cTag, data) < 0)  {
+        opserr << "WARNING AlphaOS::sendSelf() - could not send data\n";
+        return -1;
+    }
+    
+    return 0;
+}
+
+
+int AlphaOS::recvSelf(int cTag, Channel &theChannel,
+    FEM_ObjectBroker &theBroker)
+{
+    Vector data(3);
+    if (theChannel.recvVector(this->getDbTag(), cTag, data) < 0)  {
+        opserr << "WARNING AlphaOS::recvSelf() - could not receive data\n";
+        return -1;
+    }
+    
+    alpha = data(0);
+    beta  = data(1);
+    gamma = data(2);
+    
+    return 0;
+}
+
+
+void AlphaOS::Print(OPS_Stream &s, int flag)
+{
+    AnalysisModel *theModel = this->getAnalysisModel();
+    if (theModel != 0)  {
+        double currentTime = theModel->getCurrentDomainTime();
+        s << "AlphaOS - currentTime: " << currentTime << endln;
+        s << "  alpha: " << alpha << "  beta: " << beta << "  gamma: " << gamma << endln;
+        s << "  c1: " << c1 << "  c2: " << c2 << "  c3: " << c3 << endln;
+    }
+    else
+        s << "AlphaOS - no associated AnalysisModel\n";
+}
+
+
+int AlphaOS::formCommittedForce()
+{
+    AnalysisModel *theModel = this->getAnalysisModel();
+    
+    // assemble the unbalance of the resisting and damping forces
+    // of the elements and nodes (without the constraint forces)
+    Fn->Zero();
+    formCommit = true;
+    
+    FE_EleIter &theEles = theModel->getFEs();
+    FE_Element *elePtr;
+    while ((elePtr = theEles()) != 0)  {
+        if (elePtr->getElement() != 0)
+            Fn->Assemble(elePtr->getResidual(this), elePtr->getID());
+    }
+    
+    DOF_GrpIter &theDOFs = theModel->getDOFs();
+    DOF_Group *dofPtr;
+    while ((dofPtr = theDOFs()) != 0)
+        Fn->Assemble(dofPtr->getUnbalance(this), dofPtr->getID());
+    
+    formCommit = false;
+    
+    return 0;
+}
@@ -0,0 +1,96 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef AlphaOS_h
+#define AlphaOS_h
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the class definition for AlphaOS.
+// AlphaOS is an algorithmic class for performing a transient analysis
+// using the Alpha-Operator-Splitting integration scheme. The
+// resisting forces are only evaluated once per step at the predictor
+// displacements and then corrected using the initial stiffness, so
+// that the experimental elements receive exactly one command per
+// step. The unknowns of the system of equations are the displacement
+// increments. AlphaOS should be used with the Linear algorithm.
+
+#include <TransientIntegrator.h>
+
+class DOF_Group;
+class FE_Element;
+class Vector;
+class ID;
+
+class AlphaOS : public TransientIntegrator
+{
+public:
+    // constructors
+    AlphaOS();
+    AlphaOS(double alpha);
+    AlphaOS(double alpha, double beta, double gamma);
+    
+    // destructor
+    ~AlphaOS();
+    
+    // methods which define what the FE_Element and DOF_Groups add
+    // to the system of equation object
+    int formEleTangent(FE_Element *theEle);
+    int formNodTangent(DOF_Group *theDof);
+    int formEleResidual(FE_Element *theEle);
+    int formNodUnbalance(DOF_Group *theDof);
+    int formUnbalance(void);
+    
+    int domainChanged(void);
+    int newStep(double deltaT);
+    int revertToLastStep(void);
+    int update(const Vector &deltaU);
+    int commit(void);
+    
+    const Vector &getVel(void);
+    
+    // public methods for output
+    int sendSelf(int commitTag, Channel &theChannel);
+    int recvSelf(int commitTag, Channel &theChannel,
+        FEM_ObjectBroker &theBroker);
+    void Print(OPS_Stream &s, int flag = 0);
+    
+private:
+    int formCommittedForce(void);
+    
+    double alpha;
+    double beta;
+    double gamma;
+    double deltaT;
+    
+    double c1, c2, c3;              // some constants we need to keep
+    Vector *Ut, *Utdot, *Utdotdot;  // response quantities at time t
+    Vector *U, *Udot, *Udotdot;     // response quantities at time t+deltaT
+    Vector *Upt;                    // predictor displacements at time t+deltaT
+    Vector *Ucorr;                  // displacements minus predictor displacements
+    Vector *Fn;                     // unbalance of resisting and damping forces at t
+    ID *eqnID;                      // equation numbers to add Fn to the unbalance
+    bool formCommit;                // flag to form the committed forces
+};
+
+#endif
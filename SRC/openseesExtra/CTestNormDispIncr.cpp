@@ -71,7 +71,7 @@ void* OPS_CTestNormDispIncr()
 CTestNormDispIncr::CTestNormDispIncr()	    	
     : ConvergenceTest(CONVERGENCE_TEST_CTestNormDispIncr),
       theSOE(0), tol(0), maxTol(OPS_MAXTOL), maxNumIter(0), currentIter(0), printFlag(0), 
-      norms(25), nType(2)
+      nType(2), norms(25)
 {
     
 }
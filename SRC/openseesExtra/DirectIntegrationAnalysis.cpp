@@ -127,14 +127,14 @@ DirectIntegrationAnalysis::clearAll(void)
     delete theTest;
 
 
-    theAnalysisModel =0;
-    theConstraintHandler =0;
-    theDOF_Numberer =0;
-    theIntegrator =0;
-    theAlgorithm =0;
-    theSOE =0;
-    theEigenSOE =0;
-    theTest =0;
+  theAnalysisModel =0;
+  theConstraintHandler =0;
+  theDOF_Numberer =0;
+  theIntegrator =0;
+  theAlgorithm =0;
+  theSOE =0;
+  theEigenSOE =0;
+  theTest =0;
 }    
 
 #include <NodeIter.h>
@@ -0,0 +1,43 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+// File: ~/graph/numberer/GraphNumberer.C
+// 
+// Written: fmk 
+// Created: 11/96
+// Revision: A
+//
+// Description: This file contains the class implementation for
+// GraphNumberer. GraphNumberer is an abstract base class.
+//
+// What: "@(#) GraphNumberer.C, revA"
+
+#include <GraphNumberer.h>
+
+GraphNumberer::GraphNumberer(int clsTag)
+:MovableObject(clsTag)
+{
+
+}
+
+GraphNumberer::~GraphNumberer()
+{
+
+}
@@ -0,0 +1,600 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation of the
+// KRAlphaExplicit class.
+//
+// References:
+// Kolay, C. and J. M. Ricles (2014). "Development of a family of
+// unconditionally stable explicit direct integration algorithms with
+// controllable numerical energy dissipation." Earthquake Engineering
+// and Structural Dynamics, 43(9), 1361-1380.
+
+#include "KRAlphaExplicit.h"
+
+#include <FE_Element.h>
+#include <FE_EleIter.h>
+#include <LinearSOE.h>
+#include <AnalysisModel.h>
+#include <Vector.h>
+#include <Matrix.h>
+#include <DOF_Group.h>
+#include <DOF_GrpIter.h>
+#include <ID.h>
+#include <Channel.h>
+#include <classTags.h>
+#include <elementAPI.h>
+
+
+void* OPS_KRAlphaExplicit()
+{
+    if (OPS_GetNumRemainingInputArgs() != 1)  {
+        opserr << "WARNING - incorrect number of args want KRAlphaExplicit $rhoInf\n";
+        return 0;
+    }
+    
+    double rhoInf;
+    int numData = 1;
+    if (OPS_GetDoubleInput(&numData, &rhoInf) != 0)  {
+        opserr << "WARNING - invalid args want KRAlphaExplicit $rhoInf\n";
+        return 0;
+    }
+    
+    if (rhoInf < 0.0 || rhoInf > 1.0)  {
+        opserr << "WARNING KRAlphaExplicit - rhoInf should be between 0 and 1\n";
+        return 0;
+    }
+    
+    return new KRAlphaExplicit(rhoInf);
+}
+
+
+KRAlphaExplicit::KRAlphaExplicit()
+    : TransientIntegrator(INTEGRATOR_TAGS_KRAlphaExplicit),
+    rhoInf(1.0), alphaM(0.5), alphaF(0.5), beta(0.25), gamma(0.5),
+    deltaT(0.0), alpha1(0), alpha3(0), alpha3Hat(0),
+    c1(0.0), c2(0.0), c3(1.0),
+    Ut(0), Utdot(0), Utdotdot(0), U(0), Udot(0), Udotdot(0),
+    Udotdotm(0), Fn(0), eqnID(0), formCommit(false)
+{
+    
+}
+
+
+KRAlphaExplicit::KRAlphaExplicit(double _rhoInf)
+    : TransientIntegrator(INTEGRATOR_TAGS_KRAlphaExplicit),
+    rhoInf(_rhoInf), alphaM(0.0), alphaF(0.0), beta(0.0), gamma(0.0),
+    deltaT(0.0), alpha1(0), alpha3(0), alpha3Hat(0),
+    c1(0.0), c2(0.0), c3(1.0),
+    Ut(0), Utdot(0), Utdotdot(0), U(0), Udot(0), Udotdot(0),
+    Udotdotm(0), Fn(0), eqnID(0), formCommit(false)
+{
+    double rho2 = rhoInf*rhoInf;
+    double rho3 = rho2*rhoInf;
+    alphaM = (2.0*rho3 + rho2 - 1.0)/(rho3 + rho2 + rhoInf + 1.0);
+    alphaF = rhoInf/(1.0 + rhoInf);
+    gamma = 0.5 - alphaM + alphaF;
+    beta = 0.25*(1.0 - alphaM + alphaF)*(1.0 - alphaM + alphaF);
+}
+
+
+KRAlphaExplicit::~KRAlphaExplicit()
+{
+    // clean up the memory created
+    if (alpha1 != 0)
+        delete alpha1;
+    if (alpha3 != 0)
+        delete alpha3;
+    if (alpha3Hat != 0)
+        delete alpha3Hat;
+    if (Ut != 0)
+        delete Ut;
+    if (Utdot != 0)
+        delete Utdot;
+    if (Utdotdot != 0)
+        delete Utdotdot;
+    if (U != 0)
+        delete U;
+    if (Udot != 0)
+        delete Udot;
+    if (Udotdot != 0)
+        delete Udotdot;
+    if (Udotdotm != 0)
+        delete Udotdotm;
+    if (Fn != 0)
+        delete Fn;
+    if (eqnID != 0)
+        delete eqnID;
+}
+
+
+int KRAlphaExplicit::newStep(double _deltaT)
+{
+    if (_deltaT <= 0.0)  {
+        opserr << "KRAlphaExplicit::newStep() - error in variable\n";
+        opserr << "dT = " << _deltaT << endln;
+        return -2;
+    }
+    
+    // get a pointer to the AnalysisModel
+    AnalysisModel *theModel = this->getAnalysisModel();
+    
+    if (U == 0)  {
+        opserr << "KRAlphaExplicit::newStep() - domainChange() failed or hasn't been called\n";
+        return -3;
+    }
+    
+    // the integration parameter matrices depend on the time step
+    if (_deltaT != deltaT)  {
+        deltaT = _deltaT;
+        if (this->formAlphaMatrices() < 0)  {
+            deltaT = 0.0;
+            return -4;
+        }
+    }
+    
+    // set response at t to be that at t+deltaT of previous step
+    (*Ut) = *U;
+    (*Utdot) = *Udot;
+    (*Utdotdot) = *Udotdot;
+    
+    // determine new displacements and velocities at time t+deltaT
+    U->addVector(1.0, *Utdot, deltaT);
+    U->addMatrixVector(1.0, *alpha1, *Utdotdot, (0.5+gamma)*deltaT*deltaT);
+    
+    Udot->addMatrixVector(1.0, *alpha1, *Utdotdot, deltaT);
+    
+    // the weighted accelerations start from alpha3*a(t)
+    Udotdotm->addMatrixVector(0.0, *alpha3, *Utdotdot, 1.0);
+    Udotdot->Zero();
+    
+    // set the trial response quantities
+    theModel->setResponse(*U, *Udot, *Udotdot);
+    
+    // increment the time to t+(1-alphaF)*deltaT and apply the load
+    // (this sends the single command of this step)
+    double time = theModel->getCurrentDomainTime();
+    time += (1.0-alphaF)*deltaT;
+    if (theModel->updateDomain(time, deltaT) < 0)  {
+        opserr << "KRAlphaExplicit::newStep() - failed to update the domain\n";
+        return -5;
+    }
+    
+    return 0;
+}
+
+
+int KRAlphaExplicit::revertToLastStep()
+{
+    // set response at t+deltaT to be that at t .. for next step
+    if (U != 0)  {
+        (*U) = *Ut;
+        (*Udot) = *Utdot;
+        (*Udotdot) = *Utdotdot;
+    }
+    
+    return 0;
+}
+
+
+int KRAlphaExplicit::formEleTangent(FE_Element *theEle)
+{
+    theEle->zeroTangent();
+    
+    theEle->addKiToTang(c1);
+    theEle->addCtoTang(c2);
+    theEle->addMtoTang(c3);
+    
+    return 0;
+}
+
+
+int KRAlphaExplicit::formNodTangent(DOF_Group *theDof)
+{
+    theDof->zeroTangent();
+    
+    theDof->addCtoTang(c2);
+    theDof->addMtoTang(c3);
+    
+    return 0;
+}
+
+
+int KRAlphaExplicit::formEleResidual(FE_Element *theEle)
+{
+    theEle->zeroResidual();
+    
+    if (formCommit == true)  {
+        theEle->addRtoResidual(1.0);
+        theEle->addD_Force(*Udot, -1.0);
+    }
+    else  {
+        theEle->addRtoResidual(1.0-alphaF);
+        theEle->addD_Force(*Udot, -(1.0-alphaF));
+        theEle->addM_Force(*Udotdotm, -1.0);
+    }
+    
+    return 0;
+}
+
+
+int KRAlphaExplicit::formNodUnbalance(DOF_Group *theDof)
+{
+    theDof->zeroUnbalance();
+    
+    if (formCommit == true)  {
+        theDof->addD_Force(*Udot, -1.0);
+    }
+    else  {
+        theDof->addPtoUnbalance();
+        theDof->addD_Force(*Udot, -(1.0-alphaF));
+        theDof->addM_Force(*Udotdotm, -1.0);
+    }
+    
+    return 0;
+}
+
+
+int KRAlphaExplicit::formUnbalance()
+{
+    // form the unbalance at t+(1-alphaF)*deltaT
+    if (this->TransientIntegrator::formUnbalance() < 0)
+        return -1;
+    
+    // and add the contribution of the forces at time t
+    LinearSOE *theLinSOE = this->getLinearSOE();
+    if (theLinSOE->addB(*Fn, *eqnID, alphaF) < 0)  {
+        opserr << "WARNING KRAlphaExplicit::formUnbalance() - ";
+        opserr << "failed to add the forces at time t\n";
+        return -3;
+    }
+    
+    return 0;
+}
+
+
+int KRAlphaExplicit::domainChanged()
+{
+    AnalysisModel *myModel = this->getAnalysisModel();
+    LinearSOE *theLinSOE = this->getLinearSOE();
+    const Vector &x = theLinSOE->getX();
+    int size = x.Size();
+    
+    // create the new Matrix and Vector objects
+    if (Ut == 0 || Ut->Size() != size)  {
+        
+        // delete the old
+        if (alpha1 != 0)
+            delete alpha1;
+        if (alpha3 != 0)
+            delete alpha3;
+        if (alpha3Hat != 0)
+            delete alpha3Hat;
+        if (Ut != 0)
+            delete Ut;
+        if (Utdot != 0)
+            delete Utdot;
+        if (Utdotdot != 0)
+            delete Utdotdot;
+        if (U != 0)
+            delete U;
+        if (Udot != 0)
+            delete Udot;
+        if (Udotdot != 0)
+            delete Udotdot;
+        if (Udotdotm != 0)
+            delete Udotdotm;
+        if (Fn != 0)
+            delete Fn;
+        if (eqnID != 0)
+            delete eqnID;
+        
+        // create the new
+        alpha1 = new Matrix(size, size);
+        alpha3 = new Matrix(size, size);
+        alpha3Hat = new Matrix(size, size);
+        Ut = new Vector(size);
+        Utdot = new Vector(size);
+        Utdotdot = new Vector(size);
+        U = new Vector(size);
+        Udot = new Vector(size);
+        Udotdot = new Vector(size);
+        Udotdotm = new Vector(size);
+        Fn = new Vector(size);
+        eqnID = new ID(size);
+        for (int i=0; i<size; i++)
+            (*eqnID)(i) = i;
+    }
+    
+    // now go through and populate U, Udot and Udotdot by iterating through
+    // the DOF_Groups and getting the last committed velocity and accel
+    DOF_GrpIter &theDOFs = myModel->getDOFs();
+    DOF_Group *dofPtr;
+    while ((dofPtr = theDOFs()) != 0)  {
+        const ID &id = dofPtr->getID();
+        int idSize = id.Size();
+        
+        const Vector &disp = dofPtr->getCommittedDisp();
+        const Vector &vel = dofPtr->getCommittedVel();
+        const Vector &accel = dofPtr->getCommittedAccel();
+        for (int i=0; i<idSize; i++)  {
+            int loc = id(i);
+            if (loc >= 0)  {
+                (*U)(loc) = disp(i);
+                (*Udot)(loc) = vel(i);
+                (*Udotdot)(loc) = accel(i);
+            }
+        }
+    }
+    
+    // the integration parameter matrices need to be formed again
+    deltaT = 0.0;
+    
+    // get the forces at the committed state
+    return this->formCommittedForce();
+}
+
+
+int KRAlphaExplicit::update(const Vector &aiU)
+{
+    AnalysisModel *theModel = this->getAnalysisModel();
+    if (theModel == 0)  {
+        opserr << "WARNING KRAlphaExplicit::update() - no AnalysisModel set\n";
+        return -1;
+    }
+    
+    // check domainChanged() has been called, i.e. Ut will not be zero
+    if (Ut == 0)  {
+        opserr << "WARNING KRAlphaExplicit::update() - domainChange() failed or not called\n";
+        return -2;
+    }
+    
+    // check aiU is of correct size
+    if (aiU.Size() != Udotdot->Size())  {
+        opserr << "WARNING KRAlphaExplicit::update() - Vectors of incompatible size ";
+        opserr << " expecting " << Udotdot->Size() << " obtained " << aiU.Size() << endln;
+        return -3;
+    }
+    
+    // determine the accelerations at t+deltaT
+    Udotdotm->addVector(1.0, aiU, 1.0);
+    Udotdot->addMatrixVector(1.0, *alpha3Hat, aiU, 1.0);
+    
+    // the displacements and velocities are not changed by the
+    // update, so only the nodal accelerations are set and the
+    // domain is not updated again (which would send a second command)
+    theModel->setAccel(*Udotdot);
+    
+    return 0;
+}
+
+
+int KRAlphaExplicit::commit(void)
+{
+    AnalysisModel *theModel = this->getAnalysisModel();
+    if (theModel == 0)  {
+        opserr << "WARNING KRAlphaExplicit::commit() - no AnalysisModel set\n";
+        return -1;
+    }
+    
+    // save the forces at t+deltaT for the next step
+    if (this->formCommittedForce() < 0)
+        return -2;
+    
+    // set the time to be t+deltaT
+    double time = theModel->getCurrentDomainTime();
+    time += alphaF*deltaT;
+    theModel->setCurrentDomainTime(time);
+    
+    return theModel->commitDomain();
+}
+
+
+const Vector& KRAlphaExplicit::getVel()
+{
+    return *Udot;
+}
+
+
+int KRAlphaExplicit::sendSelf(int cTag, Channel &theChannel)
+{
+    Vector data(5);
+    data(0) = rhoInf;
+    data(1) = alphaM;
+    data(2) = alphaF;
+    data(3) = beta;
+    data(4) = gamma;
+    
+    if (theChannel.sendVector(this->getDbTag(), cTag, data) < 0)  {
+        opserr << "WARNING KRAlphaExplicit::sendSelf() - could not send data\n";
+        return -1;
+    }
+    
+    return 0;
+}
+
+
+int KRAlphaExplicit::recvSelf(int cTag, Channel &theChannel,
+    FEM_ObjectBroker &theBroker)
+{
+    Vector data(5);
+    if (theChannel.recvVector(this->getDbTag(), cTag, data) < 0)  {
+        opserr << "WARNING KRAlphaExplicit::recvSelf() - could not receive data\n";
+        return -1;
+    }
+    
+    rhoInf = data(0);
+    alphaM = data(1);
+    alphaF = data(2);
+    beta   = data(3);
+    gamma  = data(4);
+    
+    return 0;
+}
+
+
+void KRAlphaExplicit::Print(OPS_Stream &s, int flag)
+{
+    AnalysisModel *theModel = this->getAnalysisModel();
+    if (theModel != 0)  {
+        double currentTime = theModel->getCurrentDomainTime();
+        s << "KRAlphaExplicit - currentTime: " << currentTime << endln;
+        s << "  rhoInf: " << rhoInf << endln;
+        s << "  alphaM: " << alphaM << "  alphaF: " << alphaF;
+        s << "  beta: " << beta << "  gamma: " << gamma << endln;
+    }
+    else
+        s << "KRAlphaExplicit - no associated AnalysisModel\n";
+}
+
+
+int KRAlphaExplicit::formAlphaMatrices()
+{
+    int size = U->Size();
+    Matrix M(size, size), M1(size, size), M3(size, size);
+    
+    // get the mass matrix M, the matrix M1 = M + gamma*deltaT*C +
+    // beta*deltaT^2*Ki and the matrix M3 = alphaM*M +
+    // alphaF*gamma*deltaT*C + alphaF*beta*deltaT^2*Ki
+    double dT2 = deltaT*deltaT;
+    if (this->formMatrix(M, 0.0, 0.0, 1.0) < 0 ||
+        this->formMatrix(M1, beta*dT2, gamma*deltaT, 1.0) < 0 ||
+        this->formMatrix(M3, alphaF*beta*dT2, alphaF*gamma*deltaT, alphaM) < 0)  {
+        opserr << "WARNING KRAlphaExplicit::formAlphaMatrices() - "
+            << "failed to form the mass, damping and stiffness matrices\n";
+        return -1;
+    }
+    
+    // alpha1 = M1^(-1)*M and alpha3 = M1^(-1)*M3
+    if (M1.Solve(M, *alpha1) < 0 || M1.Solve(M3, *alpha3) < 0)  {
+        opserr << "WARNING KRAlphaExplicit::formAlphaMatrices() - "
+            << "failed to solve for the integration parameter matrices\n";
+        return -2;
+    }
+    
+    // alpha3Hat = (I - alpha3)^(-1)
+    M3 = *alpha3;
+    M3 *= -1.0;
+    for (int i=0; i<size; i++)
+        M3(i,i) += 1.0;
+    if (M3.Invert(*alpha3Hat) < 0)  {
+        opserr << "WARNING KRAlphaExplicit::formAlphaMatrices() - "
+            << "failed to invert (I - alpha3)\n";
+        return -3;
+    }
+    
+    return 0;
+}
+
+
+int KRAlphaExplicit::formMatrix(Matrix &A, double cK, double cC, double cM)
+{
+    AnalysisModel *theModel = this->getAnalysisModel();
+    int result = 0;
+    
+    A.Zero();
+    c1 = cK;
+    c2 = cC;
+    c3 = cM;
+    
+    // loop through the FE_Elements and DOF_Groups and add their
+    // tangents, the constraint objects only add to the stiffness
+    FE_EleIter &theEles = theModel->getFEs();
+    FE_Element *elePtr;
+    while ((elePtr = theEles()) != 0)  {
+        double fact = (elePtr->getElement() != 0) ? 1.0 : cK;
+        if (fact == 0.0)
+            continue;
+        const Matrix &eleTang = elePtr->getTangent(this);
+        const ID &id = elePtr->getID();
+        int idSize = id.Size();
+        if (eleTang.noRows() != idSize)  {
+            result = -1;
+            continue;
+        }
+        for (int j=0; j<idSize; j++)  {
+            int col = id(j);
+            if (col < 0)
+                continue;
+            for (int i=0; i<idSize; i++)  {
+                int row = id(i);
+                if (row >= 0)
+                    A(row,col) += fact*eleTang(i,j);
+            }
+        }
+    }
+    
+    DOF_GrpIter &theDOFs = theModel->getDOFs();
+    DOF_Group *dofPtr;
+    while ((dofPtr = theDOFs()) != 0)  {
+        const Matrix &dofTang = dofPtr->getTangent(this);
+        const ID &id = dofPtr->getID();
+        int idSize = id.Size();
+        for (int j=0; j<idSize; j++)  {
+            int col = id(j);
+            if (col < 0)
+                continue;
+            for (int i=0; i<idSize; i++)  {
+                int row = id(i);
+                if (row >= 0)
+                    A(row,col) += dofTang(i,j);
+            }
+        }
+    }
+    
+    // reset the constants to form the tangent M
+    c1 = 0.0;
+    c2 = 0.0;
+    c3 = 1.0;
+    
+    return result;
+}
+
+
+int KRAlphaExplicit::formCommittedForce()
+{
+    AnalysisModel *theModel = this->getAnalysisModel();
+    
+    // assemble the unbalance of the resisting and damping forces
+    // of the elements and nodes (without the constraint forces)
+    Fn->Zero();
+    formCommit = true;
+    
+    FE_EleIter &theEles = theModel->getFEs();
+    FE_Element *elePtr;
+    while ((elePtr = theEles()) != 0)  {
+        if (elePtr->getElement() != 0)
+            Fn->Assemble(elePtr->getResidual(this), elePtr->getID());
+    }
+    
+    DOF_GrpIter &theDOFs = theModel->getDOFs();
+    DOF_Group *dofPtr;
+    while ((dofPtr = theDOFs()) != 0)
+        Fn->Assemble(dofPtr->getUnbalance(this), dofPtr->getID());
+    
+    formCommit = false;
+    
+    return 0;
+}
@@ -0,0 +1,106 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef KRAlphaExplicit_h
+#define KRAlphaExplicit_h
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the class definition for
+// KRAlphaExplicit. KRAlphaExplicit is an algorithmic class for
+// performing a transient analysis using the explicit KR-alpha
+// integration scheme by Kolay and Ricles. The displacements and
+// velocities at t+deltaT are obtained from the committed response
+// using the model dependent integration parameter matrices, so that
+// the experimental elements receive exactly one command per step.
+// The integration parameter matrices are formed from the mass,
+// damping and initial stiffness matrices and are stored dense, which
+// limits the scheme to small models. The unknowns of the system of
+// equations are the weighted accelerations (I-alpha3)*a(t+deltaT).
+
+#include <TransientIntegrator.h>
+
+class DOF_Group;
+class FE_Element;
+class Vector;
+class Matrix;
+class ID;
+
+class KRAlphaExplicit : public TransientIntegrator
+{
+public:
+    // constructors
+    KRAlphaExplicit();
+    KRAlphaExplicit(double rhoInf);
+    
+    // destructor
+    ~KRAlphaExplicit();
+    
+    // methods which define what the FE_Element and DOF_Groups add
+    // to the system of equation object
+    int formEleTangent(FE_Element *theEle);
+    int formNodTangent(DOF_Group *theDof);
+    int formEleResidual(FE_Element *theEle);
+    int formNodUnbalance(DOF_Group *theDof);
+    int formUnbalance(void);
+    
+    int domainChanged(void);
+    int newStep(double deltaT);
+    int revertToLastStep(void);
+    int update(const Vector &aiU);
+    int commit(void);
+    
+    const Vector &getVel(void);
+    
+    // public methods for output
+    int sendSelf(int commitTag, Channel &theChannel);
+    int recvSelf(int commitTag, Channel &theChannel,
+        FEM_ObjectBroker &theBroker);
+    void Print(OPS_Stream &s, int flag = 0);
+    
+private:
+    int formAlphaMatrices(void);
+    int formMatrix(Matrix &A, double cK, double cC, double cM);
+    int formCommittedForce(void);
+    
+    double rhoInf;
+    double alphaM;
+    double alphaF;
+    double beta;
+    double gamma;
+    double deltaT;
+    
+    Matrix *alpha1;                 // integration parameter matrices
+    Matrix *alpha3;
+    Matrix *alpha3Hat;              // inverse of (I - alpha3)
+    
+    double c1, c2, c3;              // some constants we need to keep
+    Vector *Ut, *Utdot, *Utdotdot;  // response quantities at time t
+    Vector *U, *Udot, *Udotdot;     // response quantities at time t+deltaT
+    Vector *Udotdotm;               // weighted accelerations at time t+deltaT
+    Vector *Fn;                     // unbalance of resisting and damping forces at t
+    ID *eqnID;                      // equation numbers to add Fn to the unbalance
+    bool formCommit;                // flag to form the committed forces
+};
+
+#endif
@@ -0,0 +1,183 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+// File: ~/OOP/analysis/algorithm/Linear.C 
+// 
+// Written: fmk 
+// Created: Sun Sept 15 15:06:47: 1996 
+// Revision: A 
+//
+
+// Description: This file contains the class definition for 
+// Linear. Linear is a class which performs a linear solution algorihm
+// to solve the equations. 
+// 
+// What: "@(#)Linear.C, revA"
+
+#include <Linear.h>
+#include <AnalysisModel.h>
+#include <LinearSOE.h>
+#include <IncrementalIntegrator.h>
+#include <Vector.h>
+#include <Channel.h>
+#include <elementAPI.h>
+#include <string.h>
+
+
+void* OPS_LinearAlgorithm()
+{
+    int formTangent = CURRENT_TANGENT;
+    int factorOnce = 0;
+    
+    while (OPS_GetNumRemainingInputArgs() > 0) {
+	const char* type = OPS_GetString();
+	if (strcmp(type,"-secant")==0 || strcmp(type,"-Secant")==0) {
+	    formTangent = CURRENT_SECANT;
+	} else if (strcmp(type,"-initial")==0 || strcmp(type,"-Initial")==0) {
+	    formTangent = INITIAL_TANGENT;
+	} else if (strcmp(type,"-factorOnce")==0 || strcmp(type,"-FactorOnce")==0) {
+	    factorOnce = 1;
+	}
+    }
+    
+    return new Linear(formTangent, factorOnce);
+}
+
+// Constructor
+Linear::Linear(int theTangent, int Fact)
+:EquiSolnAlgo(EquiALGORITHM_TAGS_Linear),
+ incrTangent(theTangent), factorOnce(Fact), numFactorizations(0)
+{
+
+}
+
+// Destructor
+Linear::~Linear()
+{
+
+}
+
+
+// int solveCurrentStep(void)
+//	Performs the linear solution algorithm.
+
+int 
+Linear::solveCurrentStep(void)
+{
+    // set up some pointers and check they are valid
+    // NOTE this could be taken away if we set Ptrs as protecetd in superclass
+
+    AnalysisModel *theAnalysisModel = this->getAnalysisModelPtr(); 
+    LinearSOE  *theSOE = this->getLinearSOEptr();
+    IncrementalIntegrator  *theIncIntegrator = 
+	this->getIncrementalIntegratorPtr(); 
+
+    if ((theAnalysisModel == 0) || (theIncIntegrator ==0 ) || (theSOE == 0)){
+	opserr << "WARNING Linear::solveCurrentStep() -";
+	opserr << "setLinks() has not been called\n";
+	return -5;
+    }
+
+    if (factorOnce != 2) {
+	if (theIncIntegrator->formTangent(incrTangent) < 0) {
+	    opserr << "WARNING Linear::solveCurrentStep() -";
+	    opserr << "the Integrator failed in formTangent()\n";
+	    return -1;
+	}
+	numFactorizations++;
+	if (factorOnce == 1)
+	    factorOnce = 2;
+    }
+    
+    if (theIncIntegrator->formUnbalance() < 0) {
+	opserr << "WARNING Linear::solveCurrentStep() -";
+	opserr << "the Integrator failed in formUnbalance()\n";	
+	return -2;
+    }
+
+    // the SOE only refactors if the tangent was formed above
+    if (theSOE->solve() < 0) {
+	opserr << "WARNING Linear::solveCurrentStep() -";
+	opserr << "the LinearSOE failed in solve()\n";	
+	return -3;
+    }
+
+    const Vector &deltaU = theSOE->getX();
+
+    if (theIncIntegrator->update(deltaU) < 0) {
+	opserr << "WARNING Linear::solveCurrentStep() -";
+	opserr << "the Integrator failed in update()\n";	
+	return -4;
+    }
+
+    return 0;
+}
+
+
+int
+Linear::setConvergenceTest(ConvergenceTest *theNewTest)
+{
+    return 0;
+}
+
+
+int
+Linear::domainChanged(void)
+{
+    // the equation numbering and the SOE have been reset,
+    // so the tangent needs to be formed and factored again
+    if (factorOnce == 2)
+	factorOnce = 1;
+    
+    return 0;
+}
+
+
+int
+Linear::getNumFactorizations(void)
+{
+    return numFactorizations;
+}
+
+
+int
+Linear::sendSelf(int cTag, Channel &theChannel)
+{
+    return 0;
+}
+
+
+int
+Linear::recvSelf(int cTag, 
+		 Channel &theChannel, 
+		 FEM_ObjectBroker &theBroker)
+{
+    return 0;
+}
+
+
+void
+Linear::Print(OPS_Stream &s, int flag)
+{
+    s << "\t Linear algorithm";
+    if (factorOnce != 0)
+	s << " (factorOnce)";
+    s << endln;
+}
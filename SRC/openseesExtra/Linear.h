@@ -0,0 +1,67 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+#ifndef Linear_h
+#define Linear_h
+
+// File: ~/OOP/analysis/algorithm/Linear.h 
+// 
+// Written: fmk 
+// Created: Sun Sept 15 15:06:47: 1996 
+// Revision: A 
+//
+
+// Description: This file contains the class definition for 
+// Linear. Linear is a class which performs a linear solution algorihm
+// to solve the equations. If factorOnce is set, the tangent is only
+// formed and factored in the first step after the domain has changed
+// and the factorization is reused in all subsequent steps.
+// 
+// What: "@(#)Linear.h, revA"
+
+#include <EquiSolnAlgo.h>
+
+class Linear: public EquiSolnAlgo
+{
+  public:
+    Linear(int tangent = CURRENT_TANGENT, int factorOnce = 0);    
+    ~Linear();
+
+    int solveCurrentStep(void);    
+    int setConvergenceTest(ConvergenceTest *theNewTest);
+    int domainChanged(void);
+
+    int getNumFactorizations(void);
+    
+    virtual int sendSelf(int commitTag, Channel &theChannel);
+    virtual int recvSelf(int commitTag, Channel &theChannel, 
+			 FEM_ObjectBroker &theBroker);
+
+    void Print(OPS_Stream &s, int flag =0);    
+    
+  protected:
+    
+  private:
+    int incrTangent;
+    int factorOnce;
+    int numFactorizations;
+};
+
+#endif
@@ -0,0 +1,322 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation of the
+// NewmarkExplicit class.
+
+#include "NewmarkExplicit.h"
+
+#include <FE_Element.h>
+#include <LinearSOE.h>
+#include <AnalysisModel.h>
+#include <Vector.h>
+#include <DOF_Group.h>
+#include <DOF_GrpIter.h>
+#include <ID.h>
+#include <Channel.h>
+#include <classTags.h>
+#include <elementAPI.h>
+
+
+void* OPS_NewmarkExplicit()
+{
+    if (OPS_GetNumRemainingInputArgs() != 1) {
+        opserr << "WARNING - incorrect number of args want NewmarkExplicit $gamma\n";
+        return 0;
+    }
+    
+    double gamma;
+    int numData = 1;
+    if (OPS_GetDoubleInput(&numData, &gamma) != 0) {
+        opserr << "WARNING - invalid args want NewmarkExplicit $gamma\n";
+        return 0;
+    }
+    
+    return new NewmarkExplicit(gamma);
+}
+
+
+NewmarkExplicit::NewmarkExplicit()
+    : TransientIntegrator(INTEGRATOR_TAGS_NewmarkExplicit),
+    gamma(0.5), deltaT(0.0), c2(0.0), c3(0.0),
+    Ut(0), Utdot(0), Utdotdot(0), U(0), Udot(0), Udotdot(0)
+{
+    
+}
+
+
+NewmarkExplicit::NewmarkExplicit(double _gamma)
+    : TransientIntegrator(INTEGRATOR_TAGS_NewmarkExplicit),
+    gamma(_gamma), deltaT(0.0), c2(0.0), c3(0.0),
+    Ut(0), Utdot(0), Utdotdot(0), U(0), Udot(0), Udotdot(0)
+{
+    
+}
+
+
+NewmarkExplicit::~NewmarkExplicit()
+{
+    // clean up the memory created
+    if (Ut != 0)
+        delete Ut;
+    if (Utdot != 0)
+        delete Utdot;
+    if (Utdotdot != 0)
+        delete Utdotdot;
+    if (U != 0)
+        delete U;
+    if (Udot != 0)
+        delete Udot;
+    if (Udotdot != 0)
+        delete Udotdot;
+}
+
+
+int NewmarkExplicit::newStep(double _deltaT)
+{
+    deltaT = _deltaT;
+    if (deltaT <= 0.0)  {
+        opserr << "NewmarkExplicit::newStep() - error in variable\n";
+        opserr << "dT = " << deltaT << endln;
+        return -2;
+    }
+    
+    // get a pointer to the AnalysisModel
+    AnalysisModel *theModel = this->getAnalysisModel();
+    
+    // set the constants
+    c2 = gamma*deltaT;
+    c3 = 1.0;
+    
+    if (U == 0)  {
+        opserr << "NewmarkExplicit::newStep() - domainChange() failed or hasn't been called\n";
+        return -3;
+    }
+    
+    // set response at t to be that at t+deltaT of previous step
+    (*Ut) = *U;
+    (*Utdot) = *Udot;
+    (*Utdotdot) = *Udotdot;
+    
+    // determine new response at time t+deltaT
+    U->addVector(1.0, *Utdot, deltaT);
+    U->addVector(1.0, *Utdotdot, 0.5*deltaT*deltaT);
+    
+    Udot->addVector(1.0, *Utdotdot, (1.0-gamma)*deltaT);
+    
+    Udotdot->Zero();
+    
+    // set the trial response quantities
+    theModel->setResponse(*U, *Udot, *Udotdot);
+    
+    // increment the time to t+deltaT and apply the load
+    // (this sends the single command of this step)
+    double time = theModel->getCurrentDomainTime();
+    time += deltaT;
+    if (theModel->updateDomain(time, deltaT) < 0)  {
+        opserr << "NewmarkExplicit::newStep() - failed to update the domain\n";
+        return -4;
+    }
+    
+    return 0;
+}
+
+
+int NewmarkExplicit::revertToLastStep()
+{
+    // set response at t+deltaT to be that at t .. for next step
+    if (U != 0)  {
+        (*U) = *Ut;
+        (*Udot) = *Utdot;
+        (*Udotdot) = *Utdotdot;
+    }
+    
+    return 0;
+}
+
+
+int NewmarkExplicit::formEleTangent(FE_Element *theEle)
+{
+    theEle->zeroTangent();
+    
+    theEle->addCtoTang(c2);
+    theEle->addMtoTang(c3);
+    
+    return 0;
+}
+
+
+int NewmarkExplicit::formNodTangent(DOF_Group *theDof)
+{
+    theDof->zeroTangent();
+    
+    theDof->addCtoTang(c2);
+    theDof->addMtoTang(c3);
+    
+    return 0;
+}
+
+
+int NewmarkExplicit::domainChanged()
+{
+    AnalysisModel *myModel = this->getAnalysisModel();
+    LinearSOE *theLinSOE = this->getLinearSOE();
+    const Vector &x = theLinSOE->getX();
+    int size = x.Size();
+    
+    // create the new Vector objects
+    if (Ut == 0 || Ut->Size() != size)  {
+        
+        // delete the old
+        if (Ut != 0)
+            delete Ut;
+        if (Utdot != 0)
+            delete Utdot;
+        if (Utdotdot != 0)
+            delete Utdotdot;
+        if (U != 0)
+            delete U;
+        if (Udot != 0)
+            delete Udot;
+        if (Udotdot != 0)
+            delete Udotdot;
+        
+        // create the new
+        Ut = new Vector(size);
+        Utdot = new Vector(size);
+        Utdotdot = new Vector(size);
+        U = new Vector(size);
+        Udot = new Vector(size);
+        Udotdot = new Vector(size);
+    }
+    
+    // now go through and populate U, Udot and Udotdot by iterating through
+    // the DOF_Groups and getting the last committed velocity and accel
+    DOF_GrpIter &theDOFs = myModel->getDOFs();
+    DOF_Group *dofPtr;
+    while ((dofPtr = theDOFs()) != 0)  {
+        const ID &id = dofPtr->getID();
+        int idSize = id.Size();
+        
+        const Vector &disp = dofPtr->getCommittedDisp();
+        const Vector &vel = dofPtr->getCommittedVel();
+        const Vector &accel = dofPtr->getCommittedAccel();
+        for (int i=0; i<idSize; i++)  {
+            int loc = id(i);
+            if (loc >= 0)  {
+                (*U)(loc) = disp(i);
+                (*Udot)(loc) = vel(i);
+                (*Udotdot)(loc) = accel(i);
+            }
+        }
+    }
+    
+    return 0;
+}
+
+
+int NewmarkExplicit::update(const Vector &aiU)
+{
+    AnalysisModel *theModel = this->getAnalysisModel();
+    if (theModel == 0)  {
+        opserr << "WARNING NewmarkExplicit::update() - no AnalysisModel set\n";
+        return -1;
+    }
+    
+    // check domainChanged() has been called, i.e. Ut will not be zero
+    if (Ut == 0)  {
+        opserr << "WARNING NewmarkExplicit::update() - domainChange() failed or not called\n";
+        return -2;
+    }
+    
+    // check aiU is of correct size
+    if (aiU.Size() != Udotdot->Size())  {
+        opserr << "WARNING NewmarkExplicit::update() - Vectors of incompatible size ";
+        opserr << " expecting " << Udotdot->Size() << " obtained " << aiU.Size() << endln;
+        return -3;
+    }
+    
+    // determine the response at t+deltaT
+    Udot->addVector(1.0, aiU, c2);
+    Udotdot->addVector(1.0, aiU, c3);
+    
+    // the displacements are not changed by the update, so only the
+    // nodal velocities and accelerations are set and the domain is
+    // not updated again (which would send a second command)
+    theModel->setVel(*Udot);
+    theModel->setAccel(*Udotdot);
+    
+    return 0;
+}
+
+
+const Vector& NewmarkExplicit::getVel()
+{
+    return *Udot;
+}
+
+
+int NewmarkExplicit::sendSelf(int cTag, Channel &theChannel)
+{
+    Vector data(1);
+    data(0) = gamma;
+    
+    if (theChannel.sendVector(this->getDbTag(), cTag, data) < 0)  {
+        opserr << "WARNING NewmarkExplicit::sendSelf() - could not send data\n";
+        return -1;
+    }
+    
+    return 0;
+}
+
+
+int NewmarkExplicit::recvSelf(int cTag, Channel &theChannel,
+    FEM_ObjectBroker &theBroker)
+{
+    Vector data(1);
+    if (theChannel.recvVector(this->getDbTag(), cTag, data) < 0)  {
+        opserr << "WARNING NewmarkExplicit::recvSelf() - could not receive data\n";
+        gamma = 0.5;
+        return -1;
+    }
+    
+    gamma = data(0);
+    
+    return 0;
+}
+
+
+void NewmarkExplicit::Print(OPS_Stream &s, int flag)
+{
+    AnalysisModel *theModel = this->getAnalysisModel();
+    if (theModel != 0)  {
+        double currentTime = theModel->getCurrentDomainTime();
+        s << "NewmarkExplicit - currentTime: " << currentTime << endln;
+        s << "  gamma: " << gamma << endln;
+        s << "  c2: " << c2 << "  c3: " << c3 << endln;
+    }
+    else
+        s << "NewmarkExplicit - no associated AnalysisModel\n";
+}
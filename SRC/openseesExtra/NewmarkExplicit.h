@@ -0,0 +1,80 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef NewmarkExplicit_h
+#define NewmarkExplicit_h
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the class definition for
+// NewmarkExplicit. NewmarkExplicit is an algorithmic class for
+// performing a transient analysis using the explicit Newmark
+// integration scheme (beta = 0). The displacements at t+deltaT only
+// depend on the committed response at t, so that the experimental
+// elements receive exactly one command per step. The unknowns of
+// the system of equations are the accelerations.
+
+#include <TransientIntegrator.h>
+
+class DOF_Group;
+class FE_Element;
+class Vector;
+
+class NewmarkExplicit : public TransientIntegrator
+{
+public:
+    // constructors
+    NewmarkExplicit();
+    NewmarkExplicit(double gamma);
+    
+    // destructor
+    ~NewmarkExplicit();
+    
+    // methods which define what the FE_Element and DOF_Groups add
+    // to the system of equation object
+    int formEleTangent(FE_Element *theEle);
+    int formNodTangent(DOF_Group *theDof);
+    
+    int domainChanged(void);
+    int newStep(double deltaT);
+    int revertToLastStep(void);
+    int update(const Vector &aiU);
+    
+    const Vector &getVel(void);
+    
+    // public methods for output
+    int sendSelf(int commitTag, Channel &theChannel);
+    int recvSelf(int commitTag, Channel &theChannel,
+        FEM_ObjectBroker &theBroker);
+    void Print(OPS_Stream &s, int flag = 0);
+    
+private:
+    double gamma;
+    double deltaT;
+    
+    double c2, c3;                  // some constants we need to keep
+    Vector *Ut, *Utdot, *Utdotdot;  // response quantities at time t
+    Vector *U, *Udot, *Udotdot;     // response quantities at time t+deltaT
+};
+
+#endif
@@ -0,0 +1,249 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+// File: ~/system_of_eqn/linearSOE/profileSPD/ProfileSPDLinDirectSolver.C
+//
+// Written: fmk 
+// Created: Febuary 1997
+// Revision: A
+//
+// Description: This file contains the implementation for ProfileSPDLinDirectSolver
+//
+// What: "@(#) ProfileSPDLinDirectSolver.C, revA"
+
+#include <stdlib.h>
+
+#include <ProfileSPDLinDirectSolver.h>
+#include <ProfileSPDLinSOE.h>
+#include <math.h>
+#include <Channel.h>
+#include <FEM_ObjectBroker.h>
+#include <Vector.h>
+
+ProfileSPDLinDirectSolver::ProfileSPDLinDirectSolver(double tol)
+:ProfileSPDLinSolver(SOLVER_TAGS_ProfileSPDLinDirectSolver),
+ minDiagTol(tol), size(0), RowTop(0), topRowPtr(0), invD(0)
+{
+
+}
+
+    
+ProfileSPDLinDirectSolver::~ProfileSPDLinDirectSolver()
+{
+    if (RowTop != 0) delete [] RowTop;
+    if (topRowPtr != 0) free((void *)topRowPtr);
+    if (invD != 0) delete [] invD;
+}
+
+
+int
+ProfileSPDLinDirectSolver::setSize(void)
+{
+    if (theSOE == 0) {
+	opserr << "ProfileSPDLinDirectSolver::setSize()";
+	opserr << " No system has been set\n";
+	return -1;
+    }
+
+    // check for quick return 
+    if (theSOE->size == 0)
+	return 0;
+    if (size != theSOE->size) {    
+	size = theSOE->size;
+    
+	if (RowTop != 0) delete [] RowTop;
+	if (topRowPtr != 0) free((void *)topRowPtr);
+	if (invD != 0) delete [] invD;
+
+	RowTop = new int[size];
+
+	// we cannot use topRowPtr = new (double *)[size] with the cxx compiler
+	topRowPtr = (double **)malloc(size *sizeof(double *));
+
+	invD = new double[size]; 
+	
+	if (RowTop == 0 || topRowPtr == 0 || invD == 0) {
+	    opserr << "Warning :ProfileSPDLinDirectSolver::ProfileSPDLinDirectSolver :";
+	    opserr << " ran out of memory for work areas \n";
+	    return -1;
+	}
+    }
+
+    // set some pointers
+    double *A = theSOE->A;
+    int *iDiagLoc = theSOE->iDiagLoc;
+
+    // set RowTop and topRowPtr info
+    RowTop[0] = 0;
+    topRowPtr[0] = A;
+    for (int j=1; j<size; j++) {
+	int icolsz = iDiagLoc[j] - iDiagLoc[j-1];
+	RowTop[j] = j - icolsz +  1;
+	topRowPtr[j] = &A[iDiagLoc[j-1]]; // FORTRAN array indexing in iDiagLoc
+    }
+
+    return 0;
+}
+
+
+int 
+ProfileSPDLinDirectSolver::solve(void)
+{
+    // check for quick returns
+    if (theSOE == 0) {
+	opserr << "ProfileSPDLinDirectSolver::solve(void): ";
+	opserr << " - No ProfileSPDSOE has been assigned\n";
+	return -1;
+    }
+    
+    if (theSOE->size == 0)
+	return 0;
+
+    // copy B into X
+    double *B = theSOE->B;
+    double *X = theSOE->X;
+    int n = theSOE->size;
+    for (int ii=0; ii<n; ii++)
+	X[ii] = B[ii];
+
+    // factor the matrix only if it has changed since the last solve
+    if (theSOE->isAfactored == false)  {
+	int result = this->factor(n);
+	if (result < 0)
+	    return result;
+    }
+
+    // forward substitution L y = b
+    for (int j=1; j<n; j++) {
+	int rowjTop = RowTop[j];
+	double *ajiPtr = topRowPtr[j];
+	double *XPtr = &X[rowjTop];
+	double sum = 0.0;
+	for (int k=rowjTop; k<j; k++) 
+	    sum += *ajiPtr++ * *XPtr++;
+	X[j] -= sum;
+    }
+
+    // diagonal scaling D z = y
+    for (int k=0; k<n; k++)
+	X[k] *= invD[k];
+
+    // back substitution L^t x = z
+    for (int i=n-1; i>0; i--) {
+	int rowiTop = RowTop[i];
+	double *ajiPtr = topRowPtr[i];
+	double *XPtr = &X[rowiTop];
+	double Xi = X[i];
+	for (int k=rowiTop; k<i; k++) 
+	    *XPtr++ -= *ajiPtr++ * Xi;
+    }
+
+    return 0;
+}
+
+
+// int factor(int n)
+// Method to perform the LDL^t (Crout) factorization of the profile
+// stored matrix in place. After the factorization the entries above
+// the diagonal of each column contain L^t and the diagonal contains D.
+
+int
+ProfileSPDLinDirectSolver::factor(int n)
+{
+    if (n > size) {
+	opserr << "ProfileSPDLinDirectSolver::factor() - ";
+	opserr << " setSize() has not been called\n";
+	return -1;
+    }
+
+    for (int j=0; j<n; j++) {
+	int rowjTop = RowTop[j];
+	double *coljPtr = topRowPtr[j];
+
+	// reduce the column entries above the diagonal
+	for (int i=rowjTop+1; i<j; i++) {
+	    int rowiTop = RowTop[i];
+	    int kTop = (rowiTop > rowjTop) ? rowiTop : rowjTop;
+	    double *akiPtr = topRowPtr[i] + (kTop - rowiTop);
+	    double *akjPtr = coljPtr + (kTop - rowjTop);
+	    double sum = 0.0;
+	    for (int k=kTop; k<i; k++)
+		sum += *akiPtr++ * *akjPtr++;
+	    coljPtr[i-rowjTop] -= sum;
+	}
+
+	// determine the factors L and the diagonal D
+	double ajj = coljPtr[j-rowjTop];
+	double *aijPtr = coljPtr;
+	for (int i=rowjTop; i<j; i++) {
+	    double tmp = *aijPtr;
+	    *aijPtr = tmp * invD[i];
+	    ajj -= tmp * *aijPtr++;
+	}
+
+	if (ajj <= 0.0) {
+	    opserr << "ProfileSPDLinDirectSolver::factor() - ";
+	    opserr << " aii < 0 (i, aii): (" << j << ", " << ajj << ")\n"; 
+	    return -2;
+	}
+	if (ajj <= minDiagTol) {
+	    opserr << "ProfileSPDLinDirectSolver::factor() - ";
+	    opserr << " aii < minDiagTol (i, aii): (" << j;
+	    opserr << ", " << ajj << ")\n"; 
+	    return -2;
+	}		
+	coljPtr[j-rowjTop] = ajj;
+	invD[j] = 1.0/ajj;
+    }
+
+    theSOE->isAfactored = true;
+
+    return 0;
+}
+
+
+double
+ProfileSPDLinDirectSolver::getDeterminant(void) 
+{
+    int n = theSOE->size;
+    double determinant = 1.0;
+    for (int i=0; i<n; i++)
+	determinant *= 1.0/invD[i];
+    return determinant;
+}
+
+
+int
+ProfileSPDLinDirectSolver::sendSelf(int cTag,
+				    Channel &theChannel)
+{
+    // nothing to do
+    return 0;
+}
+
+
+int
+ProfileSPDLinDirectSolver::recvSelf(int ctag,
+				    Channel &theChannel, 
+				    FEM_ObjectBroker &theBroker)
+{
+    // nothing to do
+    return 0;
+}
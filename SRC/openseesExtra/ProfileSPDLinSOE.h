@@ -0,0 +1,89 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+// File: ~/system_of_eqn/linearSOE/profileSPD/ProfileSPDLinSOE.h
+//
+// Written: fmk 
+// Created: Febuary 1997
+// Revision: A
+//
+// Description: This file contains the class definition for ProfileSPDLinSOE
+// ProfileSPDLinSOE is a subclass of LinearSOE. It uses the profile (skyline)
+// storage scheme to store the upper triangular part of a symmetric
+// positive definite matrix column by column. The diagonal location of
+// each column is stored in iDiagLoc (1-based) so that element (row,col)
+// of the upper triangle is found at A[iDiagLoc[col]-(col-row)-1].
+//
+// What: "@(#) ProfileSPDLinSOE.h, revA"
+
+#ifndef ProfileSPDLinSOE_h
+#define ProfileSPDLinSOE_h
+
+#include <LinearSOE.h>
+#include <Vector.h>
+
+class ProfileSPDLinSolver;
+
+class ProfileSPDLinSOE : public LinearSOE
+{
+  public:
+    ProfileSPDLinSOE(ProfileSPDLinSolver &theSolver);        
+    ProfileSPDLinSOE(ProfileSPDLinSolver &theSolver, int classTag);        
+
+    virtual ~ProfileSPDLinSOE();
+
+    virtual int getNumEqn(void) const;
+    virtual int setSize(Graph &theGraph);
+    
+    virtual int addA(const Matrix &, const ID &, double fact = 1.0);
+    virtual int addB(const Vector &, const ID &, double fact = 1.0);    
+    virtual int setB(const Vector &, double fact = 1.0);        
+    
+    virtual void zeroA(void);
+    virtual void zeroB(void);
+
+    virtual const Vector &getX(void);
+    virtual const Vector &getB(void);
+    virtual double normRHS(void);
+
+    virtual void setX(int loc, double value);        
+    virtual void setX(const Vector &x);        
+    
+    virtual int setProfileSPDSolver(ProfileSPDLinSolver &newSolver);    
+
+    virtual int sendSelf(int commitTag, Channel &theChannel);
+    virtual int recvSelf(int commitTag, Channel &theChannel, 
+			 FEM_ObjectBroker &theBroker);    
+    
+    friend class ProfileSPDLinDirectSolver;
+
+  protected:
+    int size, profileSize;    
+    double *A, *B, *X;
+    Vector *vectX;
+    Vector *vectB;    
+    int *iDiagLoc;
+    int Asize, Bsize;
+    bool isAfactored;
+    
+  private:
+};
+
+#endif
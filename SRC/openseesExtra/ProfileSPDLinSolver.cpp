@@ -0,0 +1,51 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+// File: ~/system_of_eqn/linearSOE/profileSPD/ProfileSPDLinSolver.C
+//
+// Written: fmk 
+// Created: Febuary 1997
+// Revision: A
+//
+// Description: This file contains the implementation for ProfileSPDLinSolver.
+//
+// What: "@(#) ProfileSPDLinSolver.C, revA"
+
+#include <ProfileSPDLinSolver.h>
+#include <ProfileSPDLinSOE.h>
+
+ProfileSPDLinSolver::ProfileSPDLinSolver(int clsTag)    
+:LinearSOESolver(clsTag),
+ theSOE(0)
+{
+
+}    
+
+ProfileSPDLinSolver::~ProfileSPDLinSolver()    
+{
+
+}    
+
+int 
+ProfileSPDLinSolver::setLinearSOE(ProfileSPDLinSOE &theProfileSPDSOE)
+{
+    theSOE = &theProfileSPDSOE;
+    return 0;
+}
@@ -0,0 +1,233 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+// File: ~/graph/numberer/RCM.C
+// 
+// Written: fmk 
+// Created: 11/96
+// Revision: A
+//
+// Description: This file contains the class definition for RCM.
+// RCM is an object to perform the Reverse Cuthill-McKee numbering
+// scheme on the vertices of a graph. For each connected component
+// the search starts at the vertex of minimum degree (or the last
+// vertex requested by the caller), visits the adjacent vertices in
+// order of increasing degree and finally reverses the resulting order.
+//
+// What: "@(#) RCM.C, revA"
+
+#include <RCM.h>
+#include <Graph.h>
+#include <Vertex.h>
+#include <VertexIter.h>
+#include <ID.h>
+#include <Channel.h>
+#include <FEM_ObjectBroker.h>
+
+void* OPS_RCM()
+{
+    return new RCM();
+}
+
+// Constructor
+RCM::RCM()
+:GraphNumberer(GraphNUMBERER_TAG_RCM),
+ numVertex(-1), theRefResult(0)
+{
+
+}
+
+// Destructor
+RCM::~RCM()
+{
+    if (theRefResult != 0)
+	delete theRefResult;
+}
+
+
+// const ID &number(Graph &theGraph,int startVertexTag = -1)
+// Method to perform the Reverse Cuthill-mcKenn numbering scheme. The
+// user can supply a starting vertex, if none is provided the vertex
+// of minimum degree in each connected component is used.
+
+const ID &
+RCM::number(Graph &theGraph, int startVertex)
+{
+    // first check our size, if not same make new
+    if (numVertex != theGraph.getNumVertex()) {
+
+	if (theRefResult != 0)
+	    delete theRefResult;
+	
+	numVertex = theGraph.getNumVertex();
+	theRefResult = new ID(numVertex);
+
+	if (theRefResult == 0) {
+	    opserr << "ERROR:  RCM::number - Out of Memory\n";
+	    theRefResult = new ID(0);
+	    numVertex = 0;
+	    return *theRefResult;
+	}
+    }
+
+    // see if we can do quick return
+    if (numVertex == 0) 
+	return *theRefResult;
+	    
+
+    // we first set the Tmp of all vertices to -1, indicating
+    // they have not yet been added.
+    Vertex *vertexPtr;
+    VertexIter &vertexIter = theGraph.getVertices();
+    
+    while ((vertexPtr = vertexIter()) != 0)
+	vertexPtr->setTmp(-1);
+
+    // loop over the connected components of the graph
+    int numFound = 0;
+    while (numFound < numVertex) {
+
+	// use the start vertex requested by the caller for the
+	// first component, otherwise the vertex of minimum degree
+	Vertex *start = 0;
+	if (numFound == 0 && startVertex != -1) {
+	    start = theGraph.getVertexPtr(startVertex);
+	    if (start == 0)
+		opserr << "WARNING:  RCM::number - No vertex with tag "
+		       << startVertex << " exists - using minimum degree vertex\n";
+	}
+	if (start == 0) {
+	    int minDegree = 0;
+	    VertexIter &vertexIter2 = theGraph.getVertices();
+	    while ((vertexPtr = vertexIter2()) != 0) {
+		if (vertexPtr->getTmp() == -1) {
+		    int degree = vertexPtr->getDegree();
+		    if (start == 0 || degree < minDegree) {
+			start = vertexPtr;
+			minDegree = degree;
+		    }
+		}
+	    }
+	}
+	
+	numFound = this->cuthillMcKee(theGraph, start, numFound);
+	if (numFound < 0) {
+	    opserr << "ERROR:  RCM::number - graph is inconsistent\n";
+	    theRefResult->Zero();
+	    return *theRefResult;
+	}
+    }
+
+    // now reverse the order, the tmp of each vertex is set to the new
+    // number and the tags are left in the result
+    for (int i=0; i<numVertex/2; i++) {
+	int swap = (*theRefResult)(i);
+	(*theRefResult)(i) = (*theRefResult)(numVertex-1-i);
+	(*theRefResult)(numVertex-1-i) = swap;
+    }
+    for (int j=0; j<numVertex; j++) {
+	vertexPtr = theGraph.getVertexPtr((*theRefResult)(j));
+	vertexPtr->setTmp(j+1); // 1 through numVertex
+    }
+
+    return *theRefResult;
+}
+
+
+// int cuthillMcKee(Graph &theGraph, Vertex *start, int numFound)
+// Method to add the vertices of the component containing start to
+// the result in Cuthill-McKee order, i.e. level by level with the
+// adjacent vertices of each vertex ordered by increasing degree.
+// Returns the total number of vertices added so far.
+
+int
+RCM::cuthillMcKee(Graph &theGraph, Vertex *start, int numFound)
+{
+    start->setTmp(numFound);
+    (*theRefResult)(numFound++) = start->getTag();
+
+    int nxtToNumber = numFound - 1;
+    ID adjOrdered(0, 16);
+    
+    while (nxtToNumber < numFound) {
+	Vertex *vertexPtr = theGraph.getVertexPtr((*theRefResult)(nxtToNumber++));
+	if (vertexPtr == 0)
+	    return -1;
+	
+	// collect the not yet numbered adjacent vertices, kept
+	// sorted by increasing degree using an insertion sort
+	const ID &adjacency = vertexPtr->getAdjacency();
+	int numAdj = 0;
+	for (int i=0; i<adjacency.Size(); i++) {
+	    Vertex *otherPtr = theGraph.getVertexPtr(adjacency(i));
+	    if (otherPtr == 0)
+		return -1;
+	    if (otherPtr->getTmp() != -1)
+		continue;
+	    
+	    // mark as found so it is not added twice
+	    otherPtr->setTmp(numFound + numAdj);
+	    int degree = otherPtr->getDegree();
+	    int loc = numAdj++;
+	    adjOrdered[loc] = adjacency(i);
+	    while (loc > 0 && 
+		   theGraph.getVertexPtr(adjOrdered(loc-1))->getDegree() > degree) {
+		adjOrdered(loc) = adjOrdered(loc-1);
+		adjOrdered(loc-1) = adjacency(i);
+		loc--;
+	    }
+	}
+	
+	for (int j=0; j<numAdj; j++)
+	    (*theRefResult)(numFound++) = adjOrdered(j);
+    }
+
+    return numFound;
+}
+
+
+// const ID &number(Graph &theGraph, const ID &startVertices)
+// Method to perform the Reverse Cuthill-mcKenn numbering scheme
+// starting from the first vertex in startVertices that is in the graph.
+
+const ID &
+RCM::number(Graph &theGraph, const ID &startVertices)
+{
+    for (int i=0; i<startVertices.Size(); i++) {
+	if (theGraph.getVertexPtr(startVertices(i)) != 0)
+	    return this->number(theGraph, startVertices(i));
+    }
+
+    return this->number(theGraph, -1);
+}
+
+
+int
+RCM::sendSelf(int commitTag, Channel &theChannel)
+{
+    return 0;
+}
+
+
+int
+RCM::recvSelf(int commitTag, Channel &theChannel, FEM_ObjectBroker &theBroker)
+{
+    return 0;
+}
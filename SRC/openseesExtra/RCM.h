@@ -0,0 +1,62 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+// File: ~/graph/numberer/RCM.h
+// 
+// Written: fmk 
+// Created: 11/96
+// Revision: A
+//
+// Description: This file contains the class definition for RCM.
+// RCM is an object to perform the Reverse Cuthill-McKee numbering
+// scheme on the vertices of a graph. This is done by invoking the
+// number() method with the Graph.
+//
+// What: "@(#) RCM.h, revA"
+
+#ifndef RCM_h
+#define RCM_h
+
+#include <GraphNumberer.h>
+class Vertex;
+
+class RCM: public GraphNumberer
+{
+  public:
+    RCM();
+    ~RCM();
+
+    const ID &number(Graph &theGraph, int lastVertex = -1);
+    const ID &number(Graph &theGraph, const ID &lastVertices);
+
+    int sendSelf(int commitTag, Channel &theChannel);
+    int recvSelf(int commitTag, Channel &theChannel, 
+		 FEM_ObjectBroker &theBroker);
+    
+  protected:
+    
+  private:
+    int cuthillMcKee(Graph &theGraph, Vertex *start, int numFound);
+
+    int numVertex;
+    ID *theRefResult;
+};
+
+#endif
@@ -0,0 +1,587 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Purpose: This file contains the implementation of the methods needed
+// to define the SHM_Channel class interface.
+
+#include "SHM_Channel.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <new>
+#include <atomic>
+#include <thread>
+#include <chrono>
+
+#include <OPS_Stream.h>
+#include <Matrix.h>
+#include <Vector.h>
+#include <ID.h>
+#include <Message.h>
+#include <MovableObject.h>
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+#if defined(_LINUX)
+#include <time.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#endif
+
+// number of polls before a waiting process goes to sleep
+#define SHM_SPIN_COUNT 4000
+
+// states of the connection
+#define SHM_STATE_INIT      0
+#define SHM_STATE_READY     1
+#define SHM_STATE_CONNECTED 2
+#define SHM_STATE_CLOSED    3
+
+static const unsigned int SHM_Magic = 0x4F46534D;  // "OFSM"
+
+// one direction of the channel, the head is only advanced by the
+// writer and the tail only by the reader, each on its own cache line
+struct SHM_ChannelRing
+{
+    std::atomic<unsigned int> head;     // total number of bytes written
+    char pad1[64 - sizeof(std::atomic<unsigned int>)];
+    std::atomic<unsigned int> tail;     // total number of bytes read
+    char pad2[64 - sizeof(std::atomic<unsigned int>)];
+    std::atomic<int> readerWaiting;     // reader sleeps on head
+    std::atomic<int> writerWaiting;     // writer sleeps on tail
+    char pad3[64 - 2 * sizeof(std::atomic<int>)];
+};
+
+// control block at the start of the shared memory segment,
+// ring 0 is used from client to server and ring 1 from server to client
+struct SHM_ChannelHeader
+{
+    unsigned int magic;
+    unsigned int capacity;
+    std::atomic<unsigned int> state;
+    char pad[64 - 2 * sizeof(unsigned int) - sizeof(std::atomic<unsigned int>)];
+    SHM_ChannelRing ring[2];
+};
+
+
+// puts the calling process to sleep while *addr == expected, but
+// at most for about 100 ms so that a closed peer can be detected
+static void shmWait(std::atomic<unsigned int>* addr, unsigned int expected)
+{
+#if defined(_LINUX)
+    struct timespec timeout;
+    timeout.tv_sec = 0;
+    timeout.tv_nsec = 100000000;
+    syscall(SYS_futex, (unsigned int*)addr, FUTEX_WAIT, expected,
+        &timeout, 0, 0);
+#else
+    if (addr->load() == expected)
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+#endif
+}
+
+
+// wakes up all processes sleeping on addr
+static void shmWake(std::atomic<unsigned int>* addr)
+{
+#if defined(_LINUX)
+    syscall(SYS_futex, (unsigned int*)addr, FUTEX_WAKE, INT_MAX, 0, 0, 0);
+#endif
+}
+
+
+// waits until var differs from observed, first by polling and
+// then by sleeping with the waiting flag raised for the other side
+static void shmWaitForChange(std::atomic<unsigned int>& var,
+    unsigned int observed, std::atomic<int>& waiting)
+{
+    for (int i = 0; i < SHM_SPIN_COUNT; i++) {
+        if (var.load(std::memory_order_acquire) != observed)
+            return;
+    }
+    waiting.store(1);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (var.load() == observed)
+        shmWait(&var, observed);
+    waiting.store(0);
+}
+
+
+// SHM_Channel(unsigned int port):
+// constructor to create a shared memory segment named after the port
+// number which a client in another process can then connect to.
+SHM_Channel::SHM_Channel(unsigned int port, unsigned int cap)
+    : myPort(port), capacity(0), connectType(0),
+    shmfd(-1), shmAddr(0), shmSize(0), unlinked(false),
+    header(0), sendRing(0), recvRing(0), sendBuffer(0), recvBuffer(0)
+{
+    sprintf(shmName, "/OpenFresco_%u", port);
+    
+    // the ring capacity needs to be a power of two so that the
+    // byte counters can wrap around without corrupting the index
+    capacity = 4096;
+    while (capacity < cap && capacity < 0x40000000)
+        capacity *= 2;
+    
+    // a failure is reported again by setUpConnection()
+    if (this->mapSegment(true) != 0) {
+        opserr << "SHM_Channel::SHM_Channel() - could not create "
+            << "shared memory segment " << shmName << endln;
+#ifndef _WIN32
+        if (shmfd >= 0)
+            shm_unlink(shmName);
+#endif
+        this->unmapSegment();
+        unlinked = true;
+    }
+}
+
+
+// SHM_Channel(unsigned int other_Port, char *other_InetAddr):
+// constructor to connect to the shared memory segment created by a
+// server with the given port number. The address is ignored, since
+// both processes need to run on the same machine.
+SHM_Channel::SHM_Channel(unsigned int other_Port, const char* other_InetAddr)
+    : myPort(other_Port), capacity(0), connectType(1),
+    shmfd(-1), shmAddr(0), shmSize(0), unlinked(true),
+    header(0), sendRing(0), recvRing(0), sendBuffer(0), recvBuffer(0)
+{
+    sprintf(shmName, "/OpenFresco_%u", other_Port);
+    
+    if (other_InetAddr != 0 && strcmp(other_InetAddr, "127.0.0.1") != 0 &&
+        strcmp(other_InetAddr, "localhost") != 0) {
+        opserr << "SHM_Channel::SHM_Channel() - WARNING address "
+            << other_InetAddr << " ignored, shared memory channels "
+            << "only connect processes on the same machine\n";
+    }
+}
+
+
+// ~SHM_Channel():
+//	destructor
+SHM_Channel::~SHM_Channel()
+{
+#ifndef _WIN32
+    if (header != 0) {
+        // tell the other side that the channel is closed
+        header->state.store(SHM_STATE_CLOSED);
+        shmWake(&header->state);
+        for (int i = 0; i < 2; i++) {
+            shmWake(&header->ring[i].head);
+            shmWake(&header->ring[i].tail);
+        }
+    }
+    if (shmAddr != 0)
+        munmap(shmAddr, shmSize);
+    if (shmfd >= 0)
+        close(shmfd);
+    if (!unlinked)
+        shm_unlink(shmName);
+#endif
+}
+
+
+int
+SHM_Channel::mapSegment(bool create)
+{
+#ifdef _WIN32
+    opserr << "SHM_Channel::mapSegment() - shared memory "
+        << "channels are not supported on Windows\n";
+    return -1;
+#else
+    if (create) {
+        // remove a segment left behind by a previous run
+        shm_unlink(shmName);
+        shmfd = shm_open(shmName, O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (shmfd < 0)
+            return -1;
+        shmSize = sizeof(SHM_ChannelHeader) + 2 * (unsigned long)capacity;
+        if (ftruncate(shmfd, shmSize) != 0)
+            return -2;
+    }
+    else {
+        shmfd = shm_open(shmName, O_RDWR, 0600);
+        if (shmfd < 0)
+            return -1;
+        struct stat shmStat;
+        if (fstat(shmfd, &shmStat) != 0 ||
+            shmStat.st_size < (off_t)sizeof(SHM_ChannelHeader)) {
+            close(shmfd);
+            shmfd = -1;
+            return -2;
+        }
+        shmSize = shmStat.st_size;
+    }
+    
+    shmAddr = mmap(0, shmSize, PROT_READ | PROT_WRITE, MAP_SHARED, shmfd, 0);
+    if (shmAddr == MAP_FAILED) {
+        shmAddr = 0;
+        return -3;
+    }
+    
+    if (create) {
+        header = new (shmAddr) SHM_ChannelHeader();
+        header->magic = SHM_Magic;
+        header->capacity = capacity;
+        for (int i = 0; i < 2; i++) {
+            header->ring[i].head.store(0);
+            header->ring[i].tail.store(0);
+            header->ring[i].readerWaiting.store(0);
+            header->ring[i].writerWaiting.store(0);
+        }
+        header->state.store(SHM_STATE_READY);
+        sendRing = &header->ring[1];
+        recvRing = &header->ring[0];
+    }
+    else {
+        header = (SHM_ChannelHeader*)shmAddr;
+        capacity = header->capacity;
+        if (header->magic != SHM_Magic ||
+            shmSize < sizeof(SHM_ChannelHeader) + 2 * (unsigned long)capacity)
+            return -4;
+        sendRing = &header->ring[0];
+        recvRing = &header->ring[1];
+    }
+    
+    char* data = (char*)shmAddr + sizeof(SHM_ChannelHeader);
+    sendBuffer = (sendRing == &header->ring[0]) ? data : data + capacity;
+    recvBuffer = (recvRing == &header->ring[0]) ? data : data + capacity;
+    
+    return 0;
+#endif
+}
+
+
+void
+SHM_Channel::unmapSegment()
+{
+#ifndef _WIN32
+    if (shmAddr != 0)
+        munmap(shmAddr, shmSize);
+    if (shmfd >= 0)
+        close(shmfd);
+#endif
+    shmAddr = 0;
+    shmfd = -1;
+    header = 0;
+    sendRing = recvRing = 0;
+    sendBuffer = recvBuffer = 0;
+}
+
+
+int
+SHM_Channel::setUpConnection()
+{
+    if (connectType == 1) {
+        
+        // wait for the server to create the segment
+        int trial = 0;
+        while (this->mapSegment(false) != 0) {
+            this->unmapSegment();
+#ifdef _WIN32
+            return -1;
+#endif
+            if (++trial % 500 == 0) {
+                opserr << "SHM_Channel::setUpConnection() - "
+                    << "still waiting for server on " << shmName << endln;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        
+        // wait until the server has initialized the segment
+        unsigned int state;
+        while ((state = header->state.load()) == SHM_STATE_INIT)
+            shmWait(&header->state, state);
+        if (state != SHM_STATE_READY) {
+            opserr << "SHM_Channel::setUpConnection() - "
+                << "server on " << shmName << " not ready\n";
+            return -2;
+        }
+        
+        // tell the server that the client is connected
+        header->state.store(SHM_STATE_CONNECTED);
+        shmWake(&header->state);
+    }
+    else {
+        
+        // the segment could not be created by the constructor
+        if (header == 0) {
+            opserr << "SHM_Channel::setUpConnection() - "
+                << "no shared memory segment " << shmName << endln;
+            return -1;
+        }
+        
+        // wait for a client to connect
+        unsigned int state;
+        while ((state = header->state.load()) == SHM_STATE_READY)
+            shmWait(&header->state, state);
+        if (state != SHM_STATE_CONNECTED) {
+            opserr << "SHM_Channel::setUpConnection() - "
+                << "client on " << shmName << " did not connect\n";
+            return -1;
+        }
+        
+        // the name is not needed anymore once both sides are mapped
+#ifndef _WIN32
+        shm_unlink(shmName);
+#endif
+        unlinked = true;
+    }
+    
+    return 0;
+}
+
+
+int
+SHM_Channel::writeData(const char* data, int size)
+{
+    if (header == 0)
+        return -1;
+    
+    const unsigned int mask = capacity - 1;
+    while (size > 0) {
+        unsigned int head = sendRing->head.load(std::memory_order_relaxed);
+        unsigned int tail = sendRing->tail.load(std::memory_order_acquire);
+        unsigned int space = capacity - (head - tail);
+        
+        // wait for the reader if the ring is full
+        if (space == 0) {
+            if (header->state.load() == SHM_STATE_CLOSED) {
+                opserr << "SHM_Channel::writeData() - channel closed\n";
+                return -1;
+            }
+            shmWaitForChange(sendRing->tail, tail, sendRing->writerWaiting);
+            continue;
+        }
+        
+        // copy as much as fits, wrapping around the end of the ring
+        unsigned int n = ((unsigned int)size < space) ? size : space;
+        unsigned int pos = head & mask;
+        unsigned int first = (n < capacity - pos) ? n : capacity - pos;
+        memcpy(sendBuffer + pos, data, first);
+        if (n > first)
+            memcpy(sendBuffer, data + first, n - first);
+        
+        // publish the data and wake the reader if it is sleeping
+        sendRing->head.store(head + n, std::memory_order_release);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sendRing->readerWaiting.load() != 0)
+            shmWake(&sendRing->head);
+        
+        data += n;
+        size -= n;
+    }
+    
+    return 0;
+}
+
+
+int
+SHM_Channel::readData(char* data, int size)
+{
+    if (header == 0)
+        return -1;
+    
+    const unsigned int mask = capacity - 1;
+    while (size > 0) {
+        unsigned int tail = recvRing->tail.load(std::memory_order_relaxed);
+        unsigned int head = recvRing->head.load(std::memory_order_acquire);
+        unsigned int avail = head - tail;
+        
+        // wait for the writer if the ring is empty
+        if (avail == 0) {
+            if (header->state.load() == SHM_STATE_CLOSED) {
+                opserr << "SHM_Channel::readData() - channel closed\n";
+                return -1;
+            }
+            shmWaitForChange(recvRing->head, head, recvRing->readerWaiting);
+            continue;
+        }
+        
+        // copy as much as is available, wrapping around the end of the ring
+        unsigned int n = ((unsigned int)size < avail) ? size : avail;
+        unsigned int pos = tail & mask;
+        unsigned int first = (n < capacity - pos) ? n : capacity - pos;
+        memcpy(data, recvBuffer + pos, first);
+        if (n > first)
+            memcpy(data + first, recvBuffer, n - first);
+        
+        // release the space and wake the writer if it is sleeping
+        recvRing->tail.store(tail + n, std::memory_order_release);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (recvRing->writerWaiting.load() != 0)
+            shmWake(&recvRing->tail);
+        
+        data += n;
+        size -= n;
+    }
+    
+    return 0;
+}
+
+
+int
+SHM_Channel::setNextAddress(const ChannelAddress& theAddress)
+{
+    // the other side of a shared memory channel is fixed
+    return 0;
+}
+
+
+int
+SHM_Channel::sendObj(int commitTag,
+    MovableObject& theObject, ChannelAddress* theAddress)
+{
+    return theObject.sendSelf(commitTag, *this);
+}
+
+
+int
+SHM_Channel::recvObj(int commitTag,
+    MovableObject& theObject, FEM_ObjectBroker& theBroker,
+    ChannelAddress* theAddress)
+{
+    return theObject.recvSelf(commitTag, *this, theBroker);
+}
+
+
+int
+SHM_Channel::sendMsg(int dbTag, int commitTag,
+    const Message& msg, ChannelAddress* theAddress)
+{
+    return this->writeData(msg.data, msg.length);
+}
+
+
+int
+SHM_Channel::recvMsg(int dbTag, int commitTag,
+    Message& msg, ChannelAddress* theAddress)
+{
+    return this->readData(msg.data, msg.length);
+}
+
+
+int
+SHM_Channel::recvMsgUnknownSize(int dbTag, int commitTag,
+    Message& msg, ChannelAddress* theAddress)
+{
+    // read up to and including the end of line or the terminating
+    // '\0' byte by byte, so that no data of the next message is
+    // consumed, and leave room for the '\0'
+    char* gMsg = msg.data;
+    int nleft = msg.length - 1;
+    
+    while (true) {
+        if (nleft <= 0) {
+            opserr << "SHM_Channel::recvMsgUnknownSize() - "
+                << "message does not fit into buffer\n";
+            return -1;
+        }
+        if (this->readData(gMsg, 1) != 0) {
+            opserr << "SHM_Channel::recvMsgUnknownSize() - "
+                << "could not read data\n";
+            return -2;
+        }
+        nleft--;
+        gMsg++;
+        if (*(gMsg-1) == '\0')
+            break;
+        if (*(gMsg-1) == '\n') {
+            *gMsg = '\0';
+            break;
+        }
+    }
+    
+    return 0;
+}
+
+
+int
+SHM_Channel::sendMatrix(int dbTag, int commitTag,
+    const Matrix& theMatrix, ChannelAddress* theAddress)
+{
+    return this->writeData((const char*)theMatrix.data,
+        theMatrix.dataSize * sizeof(double));
+}
+
+
+int
+SHM_Channel::recvMatrix(int dbTag, int commitTag,
+    Matrix& theMatrix, ChannelAddress* theAddress)
+{
+    return this->readData((char*)theMatrix.data,
+        theMatrix.dataSize * sizeof(double));
+}
+
+
+int
+SHM_Channel::sendVector(int dbTag, int commitTag,
+    const Vector& theVector, ChannelAddress* theAddress)
+{
+    return this->writeData((const char*)theVector.theData,
+        theVector.sz * sizeof(double));
+}
+
+
+int
+SHM_Channel::recvVector(int dbTag, int commitTag,
+    Vector& theVector, ChannelAddress* theAddress)
+{
+    return this->readData((char*)theVector.theData,
+        theVector.sz * sizeof(double));
+}
+
+
+int
+SHM_Channel::sendID(int dbTag, int commitTag,
+    const ID& theID, ChannelAddress* theAddress)
+{
+    return this->writeData((const char*)theID.data,
+        theID.sz * sizeof(int));
+}
+
+
+int
+SHM_Channel::recvID(int dbTag, int commitTag,
+    ID& theID, ChannelAddress* theAddress)
+{
+    return this->readData((char*)theID.data,
+        theID.sz * sizeof(int));
+}
+
+
+char*
+SHM_Channel::addToProgram()
+{
+    char* newStuff = (char*)malloc(100 * sizeof(char));
+    sprintf(newStuff, " 4 %s ", shmName);
+    
+    return newStuff;
+}
@@ -0,0 +1,122 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Purpose: This file contains the class definition for SHM_Channel.
+// SHM_Channel is a sub-class of channel. It is implemented with two
+// single-producer/single-consumer ring buffers in POSIX shared memory,
+// one for each direction, and can therefore only connect two processes
+// running on the same machine. Waiting processes are put to sleep with
+// futexes on Linux instead of busy polling. Message delivery is
+// guaranteed and in order. Shared memory channels are not available
+// on Windows, where setUpConnection() always fails.
+
+#ifndef SHM_Channel_h
+#define SHM_Channel_h
+
+#include <bool.h>
+#include <Channel.h>
+
+struct SHM_ChannelHeader;
+struct SHM_ChannelRing;
+
+#define SHM_DEFAULT_CAPACITY 1048576
+
+class SHM_Channel : public Channel
+{
+public:
+    SHM_Channel(unsigned int port,
+        unsigned int capacity = SHM_DEFAULT_CAPACITY);
+    SHM_Channel(unsigned int other_Port, const char* other_InetAddr);
+    ~SHM_Channel();
+    
+    char* addToProgram();
+    
+    virtual int setUpConnection();
+    
+    int setNextAddress(const ChannelAddress& otherChannelAddress);
+    virtual ChannelAddress* getLastSendersAddress() { return 0; };
+    
+    int sendObj(int commitTag,
+        MovableObject& theObject,
+        ChannelAddress* theAddress = 0);
+    int recvObj(int commitTag,
+        MovableObject& theObject,
+        FEM_ObjectBroker& theBroker,
+        ChannelAddress* theAddress = 0);
+    
+    int sendMsg(int dbTag, int commitTag,
+        const Message&,
+        ChannelAddress* theAddress = 0);
+    int recvMsg(int dbTag, int commitTag,
+        Message&,
+        ChannelAddress* theAddress = 0);
+    int recvMsgUnknownSize(int dbTag, int commitTag,
+        Message&,
+        ChannelAddress* theAddress = 0);
+    
+    int sendMatrix(int dbTag, int commitTag,
+        const Matrix& theMatrix,
+        ChannelAddress* theAddress = 0);
+    int recvMatrix(int dbTag, int commitTag,
+        Matrix& theMatrix,
+        ChannelAddress* theAddress = 0);
+    
+    int sendVector(int dbTag, int commitTag,
+        const Vector& theVector,
+        ChannelAddress* theAddress = 0);
+    int recvVector(int dbTag, int commitTag,
+        Vector& theVector,
+        ChannelAddress* theAddress = 0);
+    
+    int sendID(int dbTag, int commitTag,
+        const ID& theID,
+        ChannelAddress* theAddress = 0);
+    int recvID(int dbTag, int commitTag,
+        ID& theID,
+        ChannelAddress* theAddress = 0);
+
+private:
+    int mapSegment(bool create);
+    void unmapSegment();
+    int writeData(const char* data, int size);
+    int readData(char* data, int size);
+    
+    char shmName[64];               // name of the shared memory segment
+    unsigned int myPort;
+    unsigned int capacity;          // size of each ring buffer in bytes
+    int connectType;                // 0 = server (creates), 1 = client
+    
+    int shmfd;                      // file descriptor of the segment
+    void* shmAddr;                  // start of the mapped segment
+    unsigned long shmSize;          // size of the mapped segment
+    bool unlinked;                  // true once the name was removed
+    
+    SHM_ChannelHeader* header;      // control block at start of segment
+    SHM_ChannelRing* sendRing;      // ring this process writes to
+    SHM_ChannelRing* recvRing;      // ring this process reads from
+    char* sendBuffer;               // data of the send ring
+    char* recvBuffer;               // data of the recv ring
+};
+
+#endif
@@ -490,24 +490,33 @@ TCP_Socket::recvMsgUnknownSize(int dbTag, int commitTag,
     }
 
     // if o.k. get a pointer to the data in the message and 
-    // place the incoming data there
+    // place the incoming data there, block in recv instead of
+    // polling for available bytes and leave room for the '\0'
     int nleft, nread;
     bool eol = false;
     char *gMsg;
     gMsg = msg.data;
+    nleft = msg.length - 1;
 
     while (!eol) {
-        nleft = this->getBytesAvailable();
-        while (nleft > 0) {
-            nread = recv(sockfd,gMsg,nleft,0);
-            nleft -= nread;
-            gMsg  += nread;
-            if (*(gMsg-1) == '\0')
-                eol = true;
-            else if (*(gMsg-1) == '\n') {
-                eol = true;
-                *gMsg = '\0';
-            }
+        if (nleft <= 0) {
+            opserr << "TCP_Socket::recvMsgUnknownSize() - "
+                << "message does not fit into buffer\n";
+            return -1;
+        }
+        nread = recv(sockfd,gMsg,nleft,0);
+        if (nread <= 0) {
+            opserr << "TCP_Socket::recvMsgUnknownSize() - "
+                << "could not read data\n";
+            return -2;
+        }
+        nleft -= nread;
+        gMsg  += nread;
+        if (*(gMsg-1) == '\0')
+            eol = true;
+        else if (*(gMsg-1) == '\n') {
+            eol = true;
+            *gMsg = '\0';
         }
     }
 
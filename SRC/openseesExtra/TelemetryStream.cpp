@@ -0,0 +1,583 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation of
+// TelemetryStream.
+
+#include "TelemetryStream.h"
+
+#include <classTags.h>
+
+#include <chrono>
+
+#ifdef _WIN32
+  #define CLOSE_SOCKET closesocket
+#else
+  #define CLOSE_SOCKET ::close
+#endif
+
+#ifdef MSG_NOSIGNAL
+  #define SEND_FLAGS MSG_NOSIGNAL
+#else
+  #define SEND_FLAGS 0
+#endif
+
+// size of frame header in bytes
+static const int headerSize = 40;
+
+// max time a partial batch is held back before it is published
+static const std::chrono::milliseconds flushInterval(20);
+
+
+TelemetryStream::TelemetryStream(unsigned int _port,
+    const char *bindAddr, int batchsize, int queuesize,
+    bool blockwhenfull)
+    : OPS_Stream(OPS_STREAM_TAGS_TelemetryStream),
+    listening(false), port(0),
+    subscribers(0), needSchema(0), numSubscribers(0), maxSubscribers(4),
+    schema(0), schemaSize(0), schemaCapacity(256),
+    numCols(0), batchSize(batchsize), queueSize(queuesize),
+    blockWhenFull(blockwhenfull), queue(0), head(0), count(0),
+    seqHead(0), numDropped(0), frame(0), exitFlag(false)
+{
+    if (batchSize < 1)
+        batchSize = 1;
+    if (queueSize < batchSize)
+        queueSize = batchSize;
+    
+    subscribers = new socket_type [maxSubscribers];
+    needSchema = new bool [maxSubscribers];
+    schema = new char [schemaCapacity];
+    
+    // open the listening socket, by default only local
+    // subscribers are accepted
+    startup_sockets();
+    listenfd = socket(AF_INET, SOCK_STREAM, 0);
+#ifdef _WIN32
+    if (listenfd == INVALID_SOCKET) {
+#else
+    if (listenfd < 0) {
+#endif
+        opserr << "TelemetryStream::TelemetryStream() - "
+            << "could not open socket\n";
+        return;
+    }
+    int optval = 1;
+    setsockopt(listenfd, SOL_SOCKET, SO_REUSEADDR,
+        (const char*)&optval, sizeof(optval));
+    
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(_port);
+    if (bindAddr != 0)
+        addr.sin_addr.s_addr = inet_addr(bindAddr);
+    else
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (addr.sin_addr.s_addr == INADDR_NONE) {
+        opserr << "TelemetryStream::TelemetryStream() - "
+            << "invalid bind address " << bindAddr << endln;
+        CLOSE_SOCKET(listenfd);
+        return;
+    }
+    
+    if (bind(listenfd, (struct sockaddr*)&addr, sizeof(addr)) < 0 ||
+        listen(listenfd, 8) < 0) {
+        opserr << "TelemetryStream::TelemetryStream() - "
+            << "could not listen on port " << int(_port) << endln;
+        CLOSE_SOCKET(listenfd);
+        return;
+    }
+    socklen_type addrLength = sizeof(addr);
+    getsockname(listenfd, (struct sockaddr*)&addr, &addrLength);
+    port = ntohs(addr.sin_port);
+    listening = true;
+    
+    // start the publisher thread
+    worker = std::thread(&TelemetryStream::run, this);
+}
+
+
+TelemetryStream::~TelemetryStream()
+{
+    // let the publisher drain the queue and exit
+    if (worker.joinable())  {
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            exitFlag = true;
+        }
+        notEmpty.notify_all();
+        notFull.notify_all();
+        worker.join();
+    }
+    
+    // send end of stream to and disconnect the subscribers
+    char buf[headerSize];
+    this->setHeader(buf, 3, 0, seqHead, 0);
+    for (int i=0; i<numSubscribers; i++)  {
+        this->sendAll(subscribers[i], buf, headerSize);
+        CLOSE_SOCKET(subscribers[i]);
+    }
+    if (listening)  {
+        CLOSE_SOCKET(listenfd);
+        cleanup_sockets();
+    }
+    
+    if (subscribers != 0)
+        delete [] subscribers;
+    if (needSchema != 0)
+        delete [] needSchema;
+    if (schema != 0)
+        delete [] schema;
+    if (queue != 0)
+        delete [] queue;
+    if (frame != 0)
+        delete [] frame;
+}
+
+
+int TelemetryStream::setFile(const char *fileName, openMode mode, bool echo)
+{
+    return 0;
+}
+
+
+int TelemetryStream::open(void)
+{
+    return 0;
+}
+
+
+int TelemetryStream::close(openMode nextOpen)
+{
+    return 0;
+}
+
+
+int TelemetryStream::tag(const char *tagName)
+{
+    return 0;
+}
+
+
+int TelemetryStream::tag(const char *tagName, const char *value)
+{
+    // the response types make up the schema, which is
+    // frozen once the first record has been written
+    if (strcmp(tagName, "ResponseType") != 0 || numCols > 0)
+        return 0;
+    
+    int length = (int)strlen(value) + 1;
+    if (schemaSize + length > schemaCapacity)  {
+        while (schemaSize + length > schemaCapacity)
+            schemaCapacity *= 2;
+        char *newSchema = new char [schemaCapacity];
+        memcpy(newSchema, schema, schemaSize);
+        delete [] schema;
+        schema = newSchema;
+    }
+    memcpy(&schema[schemaSize], value, length-1);
+    schema[schemaSize+length-1] = '\n';
+    schemaSize += length;
+    
+    return 0;
+}
+
+
+int TelemetryStream::endTag()
+{
+    return 0;
+}
+
+
+int TelemetryStream::attr(const char *name, int value)
+{
+    return 0;
+}
+
+
+int TelemetryStream::attr(const char *name, double value)
+{
+    return 0;
+}
+
+
+int TelemetryStream::attr(const char *name, const char *value)
+{
+    return 0;
+}
+
+
+int TelemetryStream::write(Vector &data)
+{
+    int size = data.Size();
+    if (size == 0 || !listening)
+        return 0;
+    
+    std::unique_lock<std::mutex> lock(queueMutex);
+    
+    // allocate the queue with the first record
+    if (numCols == 0)  {
+        numCols = size;
+        queue = new double [queueSize*numCols];
+        frame = new char [headerSize + batchSize*numCols*sizeof(double)];
+    }
+    else if (size != numCols)  {
+        opserr << "TelemetryStream::write() - record size changed from "
+            << numCols << " to " << size << endln;
+        return -1;
+    }
+    
+    // apply the back-pressure policy if the queue is full
+    if (count == queueSize)  {
+        if (blockWhenFull)  {
+            notFull.wait(lock, [this] {return count < queueSize || exitFlag;});
+            if (exitFlag)
+                return -1;
+        } else  {
+            head = (head + 1) % queueSize;
+            count--;
+            seqHead++;
+            numDropped++;
+        }
+    }
+    
+    int tail = (head + count) % queueSize;
+    const double *src = &data(0);
+    double *dst = &queue[tail*numCols];
+    for (int i=0; i<numCols; i++)
+        dst[i] = src[i];
+    count++;
+    
+    if (count >= batchSize)  {
+        lock.unlock();
+        notEmpty.notify_one();
+    }
+    
+    return 0;
+}
+
+
+OPS_Stream& TelemetryStream::write(const char *s, int n)
+{
+    return *this;
+}
+
+
+OPS_Stream& TelemetryStream::write(const unsigned char *s, int n)
+{
+    return *this;
+}
+
+
+OPS_Stream& TelemetryStream::write(const signed char *s, int n)
+{
+    return *this;
+}
+
+
+OPS_Stream& TelemetryStream::write(const void *s, int n)
+{
+    return *this;
+}
+
+
+OPS_Stream& TelemetryStream::operator<<(char c)
+{
+    return *this;
+}
+
+
+OPS_Stream& TelemetryStream::operator<<(unsigned char c)
+{
+    return *this;
+}
+
+
+OPS_Stream& TelemetryStream::operator<<(signed char c)
+{
+    return *this;
+}
+
+
+OPS_Stream& TelemetryStream::operator<<(const char *s)
+{
+    return *this;
+}
+
+
+OPS_Stream& TelemetryStream::operator<<(const unsigned char *s)
+{
+    return *this;
+}
+
+
+OPS_Stream& TelemetryStream::operator<<(const signed char *s)
+{
+    return *this;
+}
+
+
+OPS_Stream& TelemetryStream::operator<<(const void *p)
+{
+    return *this;
+}
+
+
+OPS_Stream& TelemetryStream::operator<<(int n)
+{
+    return *this;
+}
+
+
+OPS_Stream& TelemetryStream::operator<<(unsigned int n)
+{
+    return *this;
+}
+
+
+OPS_Stream& TelemetryStream::operator<<(long n)
+{
+    return *this;
+}
+
+
+OPS_Stream& TelemetryStream::operator<<(unsigned long n)
+{
+    return *this;
+}
+
+
+OPS_Stream& TelemetryStream::operator<<(short n)
+{
+    return *this;
+}
+
+
+OPS_Stream& TelemetryStream::operator<<(unsigned short n)
+{
+    return *this;
+}
+
+
+OPS_Stream& TelemetryStream::operator<<(bool b)
+{
+    return *this;
+}
+
+
+OPS_Stream& TelemetryStream::operator<<(double n)
+{
+    return *this;
+}
+
+
+OPS_Stream& TelemetryStream::operator<<(float n)
+{
+    return *this;
+}
+
+
+int TelemetryStream::sendSelf(int commitTag, Channel &theChannel)
+{
+    return -1;
+}
+
+
+int TelemetryStream::recvSelf(int commitTag, Channel &theChannel,
+    FEM_ObjectBroker &theBroker)
+{
+    return -1;
+}
+
+
+unsigned int TelemetryStream::getPort() const
+{
+    return port;
+}
+
+
+int TelemetryStream::getNumSubscribers()
+{
+    std::lock_guard<std::mutex> lock(queueMutex);
+    return numSubscribers;
+}
+
+
+unsigned long long TelemetryStream::getNumDropped()
+{
+    std::lock_guard<std::mutex> lock(queueMutex);
+    return numDropped;
+}
+
+
+void TelemetryStream::run()
+{
+    std::unique_lock<std::mutex> lock(queueMutex);
+    while (true)  {
+        // wait for a full batch or until the flush interval expired
+        notEmpty.wait_for(lock, flushInterval,
+            [this] {return count >= batchSize || exitFlag;});
+        
+        // pick up new subscribers
+        lock.unlock();
+        this->acceptSubscribers();
+        lock.lock();
+        
+        if (count == 0)  {
+            if (exitFlag)
+                break;
+            continue;
+        }
+        
+        // move the next batch out of the queue
+        int numRecs = (count < batchSize) ? count : batchSize;
+        unsigned long long seq = seqHead;
+        double *dst = (double*)&frame[headerSize];
+        for (int j=0; j<numRecs; j++)  {
+            const double *src = &queue[((head + j) % queueSize)*numCols];
+            for (int i=0; i<numCols; i++)
+                dst[i] = src[i];
+            dst += numCols;
+        }
+        head = (head + numRecs) % queueSize;
+        count -= numRecs;
+        seqHead += numRecs;
+        int numBytes = numRecs*numCols*sizeof(double);
+        char schemaHeader[headerSize];
+        this->setHeader(schemaHeader, 1, 0, seq, schemaSize);
+        this->setHeader(frame, 2, numRecs, seq, numBytes);
+        lock.unlock();
+        notFull.notify_all();
+        
+        // publish the batch to all the subscribers
+        for (int i=0; i<numSubscribers; )  {
+            int rValue = 0;
+            if (needSchema[i])  {
+                rValue = this->sendAll(subscribers[i], schemaHeader, headerSize);
+                if (rValue == 0)
+                    rValue = this->sendAll(subscribers[i], schema, schemaSize);
+                needSchema[i] = false;
+            }
+            if (rValue == 0)
+                rValue = this->sendAll(subscribers[i], frame, headerSize + numBytes);
+            if (rValue < 0)
+                this->removeSubscriber(i);
+            else
+                i++;
+        }
+        lock.lock();
+    }
+}
+
+
+void TelemetryStream::acceptSubscribers()
+{
+    while (true)  {
+        // poll the listening socket without blocking
+        fd_set readSet;
+        FD_ZERO(&readSet);
+        FD_SET(listenfd, &readSet);
+        struct timeval timeOut = {0, 0};
+        if (select((int)listenfd+1, &readSet, 0, 0, &timeOut) <= 0)
+            return;
+        
+        struct sockaddr_in addr;
+        socklen_type addrLength = sizeof(addr);
+        socket_type sockfd = accept(listenfd, (struct sockaddr*)&addr, &addrLength);
+#ifdef _WIN32
+        if (sockfd == INVALID_SOCKET)
+#else
+        if (sockfd < 0)
+#endif
+            return;
+        int optval = 1;
+        setsockopt(sockfd, IPPROTO_TCP, TCP_NODELAY,
+            (const char*)&optval, sizeof(optval));
+        
+        std::lock_guard<std::mutex> lock(queueMutex);
+        if (numSubscribers == maxSubscribers)  {
+            maxSubscribers *= 2;
+            socket_type *newSubscribers = new socket_type [maxSubscribers];
+            bool *newNeedSchema = new bool [maxSubscribers];
+            for (int i=0; i<numSubscribers; i++)  {
+                newSubscribers[i] = subscribers[i];
+                newNeedSchema[i] = needSchema[i];
+            }
+            delete [] subscribers;
+            delete [] needSchema;
+            subscribers = newSubscribers;
+            needSchema = newNeedSchema;
+        }
+        subscribers[numSubscribers] = sockfd;
+        needSchema[numSubscribers] = true;
+        numSubscribers++;
+    }
+}
+
+
+void TelemetryStream::removeSubscriber(int i)
+{
+    CLOSE_SOCKET(subscribers[i]);
+    
+    std::lock_guard<std::mutex> lock(queueMutex);
+    numSubscribers--;
+    subscribers[i] = subscribers[numSubscribers];
+    needSchema[i] = needSchema[numSubscribers];
+}
+
+
+void TelemetryStream::setHeader(char *buf, int type, int numRecs,
+    unsigned long long seq, int numBytes)
+{
+    unsigned short version = 1, frameType = (unsigned short)type;
+    unsigned int cols = numCols, recs = numRecs;
+    unsigned int bytes = numBytes, reserved = 0;
+    unsigned long long dropped = numDropped;
+    
+    memcpy(&buf[0], "OFTS", 4);
+    memcpy(&buf[4], &version, 2);
+    memcpy(&buf[6], &frameType, 2);
+    memcpy(&buf[8], &cols, 4);
+    memcpy(&buf[12], &recs, 4);
+    memcpy(&buf[16], &seq, 8);
+    memcpy(&buf[24], &dropped, 8);
+    memcpy(&buf[32], &bytes, 4);
+    memcpy(&buf[36], &reserved, 4);
+}
+
+
+int TelemetryStream::sendAll(socket_type sockfd, const char *buf, int numBytes)
+{
+    while (numBytes > 0)  {
+        int numSent = send(sockfd, buf, numBytes, SEND_FLAGS);
+        if (numSent <= 0)
+            return -1;
+        buf += numSent;
+        numBytes -= numSent;
+    }
+    
+    return 0;
+}
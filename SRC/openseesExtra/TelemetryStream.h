@@ -0,0 +1,153 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef TelemetryStream_h
+#define TelemetryStream_h
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the class definition for
+// TelemetryStream. A TelemetryStream publishes the records written
+// by a recorder to any number of subscribers that connect to a TCP
+// port. The write method only copies a record into a preallocated
+// queue, a background thread coalesces the queued records into
+// batches and sends them to all the subscribers. If the queue is
+// full, either the oldest record is dropped or the writer blocks
+// until the subscribers have caught up.
+//
+// Every frame starts with a 40 byte header (host byte order):
+//   char   magic[4]     "OFTS"
+//   uint16 version      1
+//   uint16 type         1 = schema, 2 = data, 3 = end of stream
+//   uint32 numCols      number of columns per record
+//   uint32 numRecs      number of records in frame
+//   uint64 seq          sequence number of first record in frame
+//   uint64 numDropped   number of records dropped so far
+//   uint32 numBytes     number of payload bytes following header
+//   uint32 reserved
+// The payload of a schema frame are the '\n' separated column names,
+// the payload of a data frame are numRecs x numCols doubles.
+
+#include <OPS_Stream.h>
+#include <Vector.h>
+#include <Socket.h>
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+class TelemetryStream : public OPS_Stream
+{
+public:
+    // constructor
+    TelemetryStream(unsigned int port,
+        const char *bindAddr = 0,
+        int batchSize = 32,
+        int queueSize = 1024,
+        bool blockWhenFull = false);
+    
+    // destructor
+    ~TelemetryStream();
+    
+    int setFile(const char *fileName, openMode mode = OVERWRITE, bool echo = false);
+    int open(void);
+    int close(openMode nextOpen = APPEND);
+    
+    // xml stuff
+    int tag(const char *);
+    int tag(const char *, const char *);
+    int endTag();
+    int attr(const char *name, int value);
+    int attr(const char *name, double value);
+    int attr(const char *name, const char *value);
+    int write(Vector &data);
+    
+    // regular stuff
+    OPS_Stream& write(const char *s, int n);
+    OPS_Stream& write(const unsigned char *s, int n);
+    OPS_Stream& write(const signed char *s, int n);
+    OPS_Stream& write(const void *s, int n);
+    OPS_Stream& operator<<(char c);
+    OPS_Stream& operator<<(unsigned char c);
+    OPS_Stream& operator<<(signed char c);
+    OPS_Stream& operator<<(const char *s);
+    OPS_Stream& operator<<(const unsigned char *s);
+    OPS_Stream& operator<<(const signed char *s);
+    OPS_Stream& operator<<(const void *p);
+    OPS_Stream& operator<<(int n);
+    OPS_Stream& operator<<(unsigned int n);
+    OPS_Stream& operator<<(long n);
+    OPS_Stream& operator<<(unsigned long n);
+    OPS_Stream& operator<<(short n);
+    OPS_Stream& operator<<(unsigned short n);
+    OPS_Stream& operator<<(bool b);
+    OPS_Stream& operator<<(double n);
+    OPS_Stream& operator<<(float n);
+    
+    int sendSelf(int commitTag, Channel &theChannel);
+    int recvSelf(int commitTag, Channel &theChannel,
+        FEM_ObjectBroker &theBroker);
+    
+    // methods to query the publisher, the port is
+    // zero if the listening socket could not be opened
+    unsigned int getPort() const;
+    int getNumSubscribers();
+    unsigned long long getNumDropped();
+    
+private:
+    void run();
+    void acceptSubscribers();
+    void setHeader(char *buf, int type, int numRecs,
+        unsigned long long seq, int numBytes);
+    int sendAll(socket_type sockfd, const char *buf, int numBytes);
+    void removeSubscriber(int i);
+    
+    socket_type listenfd;       // listening socket
+    bool listening;             // flag if listening socket is open
+    unsigned int port;          // port the subscribers connect to
+    socket_type *subscribers;   // connected subscriber sockets
+    bool *needSchema;           // flags if subscribers need the schema
+    int numSubscribers;         // number of connected subscribers
+    int maxSubscribers;         // capacity of subscriber arrays
+    
+    char *schema;               // '\n' separated column names
+    int schemaSize;             // number of bytes in schema
+    int schemaCapacity;         // capacity of schema buffer
+    
+    int numCols;                // number of columns per record
+    int batchSize;              // max number of records per frame
+    int queueSize;              // max number of queued records
+    bool blockWhenFull;         // back-pressure policy
+    double *queue;              // ring buffer of queued records
+    int head, count;            // first queued record and their number
+    unsigned long long seqHead; // sequence number of head record
+    unsigned long long numDropped;
+    char *frame;                // header and payload of a data frame
+    
+    std::thread worker;
+    std::mutex queueMutex;
+    std::condition_variable notEmpty, notFull;
+    bool exitFlag;
+};
+
+#endif
@@ -39,6 +39,29 @@
 #include <MovableObject.h>
 #include <SocketAddress.h>
 
+#if defined(_LINUX)
+#include <errno.h>
+#endif
+
+// header preceding the payload of each datagram if fragmentation
+// is enabled, all entries are in network byte order
+struct UDP_FragHeader
+{
+    unsigned int magic;         // identifies a fragment
+    unsigned int msgSeq;        // sequence number of the message
+    unsigned int msgSize;       // total size of the message in bytes
+    unsigned short fragIdx;     // index of this fragment
+    unsigned short numFrags;    // number of fragments of the message
+};
+
+static const unsigned int UDP_FragMagic = 0x4F465246;  // "OFRF"
+static const int UDP_FragPayload = MAX_UDP_DATAGRAM - sizeof(UDP_FragHeader);
+
+// socket buffers need to hold a couple of messages, because
+// datagrams that do not fit into the buffer are dropped silently
+static const int UDP_FragMinBuffer = 1048576;
+static void setSocketBufferSize(socket_type sockfd, int size);
+
 static int GetHostAddr(char* host, char* IntAddr);
 static void inttoa(unsigned int no, char* string, int* cnt);
 
@@ -52,7 +75,12 @@ static void byte_swap(void* array, long long nArray, int size);
 // assigned by the OS from the available free port numbers.
 UDP_Socket::UDP_Socket()
     : myPort(0), connectType(0), initialHandshake(false),
-    checkEndianness(false), endiannessProblem(false)
+    checkEndianness(false), endiannessProblem(false),
+    fragmentation(false), sendSeq(0), recvSeq(0), maxFrags(0),
+    fragBuffer(0), fragHeaders(0), fragReceived(0)
+#if defined(_LINUX)
+    , fragMsgs(0), fragIov(0)
+#endif
 {
     // initialize sockets
     startup_sockets();
@@ -89,15 +117,24 @@ UDP_Socket::UDP_Socket()
     // get my_address info
     addrLength = sizeof(my_Addr.addr);
     myPort = ntohs(my_Addr.addr_in.sin_port);
+    
+    // enlarge socket buffers for fragmented messages
+    if (fragmentation)
+        setSocketBufferSize(sockfd, UDP_FragMinBuffer);
 }
 
 
 // UDP_Socket(unsigned int port):
 // constructor to open a socket with my inet_addr and with a port number port.
 UDP_Socket::UDP_Socket(unsigned int port,
-    bool inithandshake, bool checkendianness)
+    bool inithandshake, bool checkendianness, bool fragment)
     : myPort(0), connectType(0), initialHandshake(inithandshake),
-    checkEndianness(checkendianness), endiannessProblem(false)
+    checkEndianness(checkendianness), endiannessProblem(false),
+    fragmentation(fragment), sendSeq(0), recvSeq(0), maxFrags(0),
+    fragBuffer(0), fragHeaders(0), fragReceived(0)
+#if defined(_LINUX)
+    , fragMsgs(0), fragIov(0)
+#endif
 {
     // initialize sockets
     startup_sockets();
@@ -137,6 +174,10 @@ UDP_Socket::UDP_Socket(unsigned int port,
     // get my_address info
     addrLength = sizeof(my_Addr.addr);
     myPort = ntohs(my_Addr.addr_in.sin_port);
+    
+    // enlarge socket buffers for fragmented messages
+    if (fragmentation)
+        setSocketBufferSize(sockfd, UDP_FragMinBuffer);
 }
 
 
@@ -146,9 +187,15 @@ UDP_Socket::UDP_Socket(unsigned int port,
 // to an address given by other_InetAddr and other_Port. This is to allow
 // a shadow object to find address of the actor it initiatites.
 UDP_Socket::UDP_Socket(unsigned int other_Port,
-    const char* other_InetAddr, bool inithandshake, bool checkendianness)
+    const char* other_InetAddr, bool inithandshake, bool checkendianness,
+    bool fragment)
     : myPort(0), connectType(1), initialHandshake(inithandshake),
-    checkEndianness(checkendianness), endiannessProblem(false)
+    checkEndianness(checkendianness), endiannessProblem(false),
+    fragmentation(fragment), sendSeq(0), recvSeq(0), maxFrags(0),
+    fragBuffer(0), fragHeaders(0), fragReceived(0)
+#if defined(_LINUX)
+    , fragMsgs(0), fragIov(0)
+#endif
 {
     // initialize sockets
     startup_sockets();
@@ -196,6 +243,10 @@ UDP_Socket::UDP_Socket(unsigned int other_Port,
     addrLength = sizeof(my_Addr.addr);
     getsockname(sockfd, &my_Addr.addr, &addrLength);
     myPort = ntohs(my_Addr.addr_in.sin_port);
+    
+    // enlarge socket buffers for fragmented messages
+    if (fragmentation)
+        setSocketBufferSize(sockfd, UDP_FragMinBuffer);
 }
 
 
@@ -212,6 +263,20 @@ UDP_Socket::~UDP_Socket()
     
     // cleanup sockets
     cleanup_sockets();
+    
+    // free the fragment buffers
+    if (fragBuffer != 0)
+        delete[] fragBuffer;
+    if (fragHeaders != 0)
+        delete[] fragHeaders;
+    if (fragReceived != 0)
+        delete[] fragReceived;
+#if defined(_LINUX)
+    if (fragMsgs != 0)
+        delete[] fragMsgs;
+    if (fragIov != 0)
+        delete[] fragIov;
+#endif
 }
 
 
@@ -221,6 +286,10 @@ UDP_Socket::setUpConnection()
     int ierr, trial;
     char data;
     
+    // a new connection starts a new sequence of fragmented messages
+    sendSeq = 0;
+    recvSeq = 0;
+    
     if (connectType == 1) {
         
         // perform initial handshake if requested
@@ -452,17 +521,8 @@ UDP_Socket::recvMsg(int dbTag, int commitTag,
     gMsg = msg.data;
     size = msg.length;
     
-    while (size > 0) {
-        if (size <= MAX_UDP_DATAGRAM) {
-            recvfrom(sockfd, gMsg, size, 0, &other_Addr.addr, &addrLength);
-            size = 0;
-        }
-        else {
-            recvfrom(sockfd, gMsg, MAX_UDP_DATAGRAM, 0, &other_Addr.addr, &addrLength);
-            gMsg += MAX_UDP_DATAGRAM;
-            size -= MAX_UDP_DATAGRAM;
-        }
-    }
+    if (this->recvData(gMsg, size) < 0)
+        return -1;
     
     // check the address that message came from was correct
     if (theAddress != 0) {
@@ -529,19 +589,9 @@ UDP_Socket::sendMsg(int dbTag, int commitTag,
     gMsg = msg.data;
     size = msg.length;
     
-    while (size > 0) {
-        if (size <= MAX_UDP_DATAGRAM) {
-            sendto(sockfd, gMsg, size, 0, &other_Addr.addr, addrLength);
-            size = 0;
-        }
-        else {
-            sendto(sockfd, gMsg, MAX_UDP_DATAGRAM, 0, &other_Addr.addr, addrLength);
-            gMsg += MAX_UDP_DATAGRAM;
-            size -= MAX_UDP_DATAGRAM;
-        }
-    }
+    int res = this->sendData(gMsg, size);
     
-    return 0;
+    return res;
 }
 
 
@@ -556,17 +606,8 @@ UDP_Socket::recvMatrix(int dbTag, int commitTag,
     char* gMsg = (char*)data;
     size = theMatrix.dataSize * sizeof(double);
     
-    while (size > 0) {
-        if (size <= MAX_UDP_DATAGRAM) {
-            recvfrom(sockfd, gMsg, size, 0, &other_Addr.addr, &addrLength);
-            size = 0;
-        }
-        else {
-            recvfrom(sockfd, gMsg, MAX_UDP_DATAGRAM, 0, &other_Addr.addr, &addrLength);
-            gMsg += MAX_UDP_DATAGRAM;
-            size -= MAX_UDP_DATAGRAM;
-        }
-    }
+    if (this->recvData(gMsg, size) < 0)
+        return -1;
     
 #ifndef _WIN32
     if (endiannessProblem) {
@@ -638,17 +679,7 @@ UDP_Socket::sendMatrix(int dbTag, int commitTag,
     }
 #endif
     
-    while (size > 0) {
-        if (size <= MAX_UDP_DATAGRAM) {
-            sendto(sockfd, gMsg, size, 0, &other_Addr.addr, addrLength);
-            size = 0;
-        }
-        else {
-            sendto(sockfd, gMsg, MAX_UDP_DATAGRAM, 0, &other_Addr.addr, addrLength);
-            gMsg += MAX_UDP_DATAGRAM;
-            size -= MAX_UDP_DATAGRAM;
-        }
-    }
+    int res = this->sendData(gMsg, size);
     
 #ifndef _WIN32
     if (endiannessProblem) {
@@ -657,7 +688,7 @@ UDP_Socket::sendMatrix(int dbTag, int commitTag,
     }
 #endif
     
-    return 0;
+    return res;
 }
 
 
@@ -672,17 +703,8 @@ UDP_Socket::recvVector(int dbTag, int commitTag,
     char* gMsg = (char*)data;
     size = theVector.sz * sizeof(double);
     
-    while (size > 0) {
-        if (size <= MAX_UDP_DATAGRAM) {
-            recvfrom(sockfd, gMsg, size, 0, &other_Addr.addr, &addrLength);
-            size = 0;
-        }
-        else {
-            recvfrom(sockfd, gMsg, MAX_UDP_DATAGRAM, 0, &other_Addr.addr, &addrLength);
-            gMsg += MAX_UDP_DATAGRAM;
-            size -= MAX_UDP_DATAGRAM;
-        }
-    }
+    if (this->recvData(gMsg, size) < 0)
+        return -1;
     
 #ifndef _WIN32
     if (endiannessProblem) {
@@ -754,17 +776,7 @@ UDP_Socket::sendVector(int dbTag, int commitTag,
     }
 #endif
     
-    while (size > 0) {
-        if (size <= MAX_UDP_DATAGRAM) {
-            sendto(sockfd, gMsg, size, 0, &other_Addr.addr, addrLength);
-            size = 0;
-        }
-        else {
-            sendto(sockfd, gMsg, MAX_UDP_DATAGRAM, 0, &other_Addr.addr, addrLength);
-            gMsg += MAX_UDP_DATAGRAM;
-            size -= MAX_UDP_DATAGRAM;
-        }
-    }
+    int res = this->sendData(gMsg, size);
     
 #ifndef _WIN32
     if (endiannessProblem) {
@@ -773,7 +785,7 @@ UDP_Socket::sendVector(int dbTag, int commitTag,
     }
 #endif
     
-    return 0;
+    return res;
 }
 
 
@@ -788,17 +800,8 @@ UDP_Socket::recvID(int dbTag, int commitTag,
     char* gMsg = (char*)data;
     size = theID.sz * sizeof(int);
     
-    while (size > 0) {
-        if (size <= MAX_UDP_DATAGRAM) {
-            recvfrom(sockfd, gMsg, size, 0, &other_Addr.addr, &addrLength);
-            size = 0;
-        }
-        else {
-            recvfrom(sockfd, gMsg, MAX_UDP_DATAGRAM, 0, &other_Addr.addr, &addrLength);
-            gMsg += MAX_UDP_DATAGRAM;
-            size -= MAX_UDP_DATAGRAM;
-        }
-    }
+    if (this->recvData(gMsg, size) < 0)
+        return -1;
     
 #ifndef _WIN32
     if (endiannessProblem) {
@@ -870,6 +873,25 @@ UDP_Socket::sendID(int dbTag, int commitTag,
     }
 #endif
     
+    int res = this->sendData(gMsg, size);
+    
+#ifndef _WIN32
+    if (endiannessProblem) {
+        void* array = (void*)data;
+        byte_swap(array, theID.sz, sizeof(int));
+    }
+#endif
+    
+    return res;
+}
+
+
+int
+UDP_Socket::sendData(char* gMsg, int size)
+{
+    if (fragmentation)
+        return this->sendFragments(gMsg, size);
+    
     while (size > 0) {
         if (size <= MAX_UDP_DATAGRAM) {
             sendto(sockfd, gMsg, size, 0, &other_Addr.addr, addrLength);
@@ -882,12 +904,239 @@ UDP_Socket::sendID(int dbTag, int commitTag,
         }
     }
     
-#ifndef _WIN32
-    if (endiannessProblem) {
-        void* array = (void*)data;
-        byte_swap(array, theID.sz, sizeof(int));
+    return 0;
+}
+
+
+int
+UDP_Socket::recvData(char* gMsg, int size)
+{
+    if (fragmentation)
+        return this->recvFragments(gMsg, size);
+    
+    while (size > 0) {
+        if (size <= MAX_UDP_DATAGRAM) {
+            recvfrom(sockfd, gMsg, size, 0, &other_Addr.addr, &addrLength);
+            size = 0;
+        }
+        else {
+            recvfrom(sockfd, gMsg, MAX_UDP_DATAGRAM, 0, &other_Addr.addr, &addrLength);
+            gMsg += MAX_UDP_DATAGRAM;
+            size -= MAX_UDP_DATAGRAM;
+        }
+    }
+    
+    return 0;
+}
+
+
+int
+UDP_Socket::setNumFragments(int numFrags)
+{
+    if (numFrags > 65535) {
+        opserr << "UDP_Socket::setNumFragments() - message "
+            << "requires too many fragments\n";
+        return -1;
+    }
+    if (numFrags <= maxFrags)
+        return 0;
+    
+    // the buffers only ever grow, so that they are allocated
+    // once for the largest message exchanged over the channel
+    if (fragBuffer != 0)
+        delete[] fragBuffer;
+    if (fragHeaders != 0)
+        delete[] fragHeaders;
+    if (fragReceived != 0)
+        delete[] fragReceived;
+    fragBuffer = new char[numFrags * MAX_UDP_DATAGRAM];
+    fragHeaders = new char[numFrags * sizeof(UDP_FragHeader)];
+    fragReceived = new char[numFrags];
+    setSocketBufferSize(sockfd, 4 * numFrags * MAX_UDP_DATAGRAM);
+#if defined(_LINUX)
+    if (fragMsgs != 0)
+        delete[] fragMsgs;
+    if (fragIov != 0)
+        delete[] fragIov;
+    fragMsgs = new struct mmsghdr[numFrags];
+    fragIov = new struct iovec[2 * numFrags];
+#endif
+    maxFrags = numFrags;
+    
+    return 0;
+}
+
+
+int
+UDP_Socket::sendFragments(const char* gMsg, int size)
+{
+    int numFrags = (size + UDP_FragPayload - 1) / UDP_FragPayload;
+    if (numFrags < 1)
+        numFrags = 1;
+    if (this->setNumFragments(numFrags) < 0)
+        return -1;
+    
+    unsigned int seq = sendSeq++;
+    UDP_FragHeader* header = (UDP_FragHeader*)fragHeaders;
+    for (int i = 0; i < numFrags; i++) {
+        header[i].magic = htonl(UDP_FragMagic);
+        header[i].msgSeq = htonl(seq);
+        header[i].msgSize = htonl(size);
+        header[i].fragIdx = htons(i);
+        header[i].numFrags = htons(numFrags);
     }
+    
+#if defined(_LINUX)
+    // gather header and payload of each fragment without copying
+    // and hand all the fragments to the kernel in one call
+    for (int i = 0; i < numFrags; i++) {
+        int offset = i * UDP_FragPayload;
+        int length = size - offset;
+        if (length > UDP_FragPayload)
+            length = UDP_FragPayload;
+        fragIov[2 * i].iov_base = &header[i];
+        fragIov[2 * i].iov_len = sizeof(UDP_FragHeader);
+        fragIov[2 * i + 1].iov_base = (void*)(gMsg + offset);
+        fragIov[2 * i + 1].iov_len = length;
+        memset(&fragMsgs[i], 0, sizeof(struct mmsghdr));
+        fragMsgs[i].msg_hdr.msg_name = &other_Addr.addr;
+        fragMsgs[i].msg_hdr.msg_namelen = addrLength;
+        fragMsgs[i].msg_hdr.msg_iov = &fragIov[2 * i];
+        fragMsgs[i].msg_hdr.msg_iovlen = 2;
+    }
+    int numSent = 0;
+    while (numSent < numFrags) {
+        int n = sendmmsg(sockfd, &fragMsgs[numSent], numFrags - numSent, 0);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            opserr << "UDP_Socket::sendFragments() - could not send fragments\n";
+            return -1;
+        }
+        numSent += n;
+    }
+#else
+    for (int i = 0; i < numFrags; i++) {
+        int offset = i * UDP_FragPayload;
+        int length = size - offset;
+        if (length > UDP_FragPayload)
+            length = UDP_FragPayload;
+        memcpy(fragBuffer, &header[i], sizeof(UDP_FragHeader));
+        memcpy(fragBuffer + sizeof(UDP_FragHeader), gMsg + offset, length);
+        if (sendto(sockfd, fragBuffer, sizeof(UDP_FragHeader) + length, 0,
+            &other_Addr.addr, addrLength) < 0) {
+            opserr << "UDP_Socket::sendFragments() - could not send fragments\n";
+            return -1;
+        }
+    }
+#endif
+    
+    return 0;
+}
+
+
+int
+UDP_Socket::recvFragments(char* gMsg, int size)
+{
+    int numFrags = (size + UDP_FragPayload - 1) / UDP_FragPayload;
+    if (numFrags < 1)
+        numFrags = 1;
+    if (this->setNumFragments(numFrags) < 0)
+        return -1;
+    
+    unsigned int curSeq = 0;
+    bool started = false;
+    int numMissing = numFrags;
+    memset(fragReceived, 0, numFrags);
+    
+    while (numMissing > 0) {
+        
+        // receive at most as many datagrams as are still missing, so
+        // that no datagram of a following message is consumed
+        int numRecv = 0;
+#if defined(_LINUX)
+        for (int k = 0; k < numMissing; k++) {
+            fragIov[k].iov_base = fragBuffer + k * MAX_UDP_DATAGRAM;
+            fragIov[k].iov_len = MAX_UDP_DATAGRAM;
+            memset(&fragMsgs[k], 0, sizeof(struct mmsghdr));
+            fragMsgs[k].msg_hdr.msg_name = &other_Addr.addr;
+            fragMsgs[k].msg_hdr.msg_namelen = sizeof(other_Addr);
+            fragMsgs[k].msg_hdr.msg_iov = &fragIov[k];
+            fragMsgs[k].msg_hdr.msg_iovlen = 1;
+        }
+        numRecv = recvmmsg(sockfd, fragMsgs, numMissing, MSG_WAITFORONE, 0);
+        if (numRecv < 0) {
+            if (errno == EINTR)
+                continue;
+            opserr << "UDP_Socket::recvFragments() - could not receive fragments\n";
+            return -1;
+        }
+        if (numRecv > 0)
+            addrLength = fragMsgs[numRecv - 1].msg_hdr.msg_namelen;
+#else
+        int length = recvfrom(sockfd, fragBuffer, MAX_UDP_DATAGRAM, 0,
+            &other_Addr.addr, &addrLength);
+        if (length < 0) {
+            opserr << "UDP_Socket::recvFragments() - could not receive fragments\n";
+            return -1;
+        }
+        numRecv = 1;
+#endif
+        
+        for (int k = 0; k < numRecv; k++) {
+            char* datagram = fragBuffer + k * MAX_UDP_DATAGRAM;
+#if defined(_LINUX)
+            int length = fragMsgs[k].msg_len;
 #endif
+            if (length < (int)sizeof(UDP_FragHeader))
+                continue;
+            
+            UDP_FragHeader header;
+            memcpy(&header, datagram, sizeof(UDP_FragHeader));
+            if (ntohl(header.magic) != UDP_FragMagic)
+                continue;
+            
+            // discard datagrams of messages older than the last one
+            // received or older than the one being reassembled
+            unsigned int seq = ntohl(header.msgSeq);
+            if ((int)(seq - recvSeq) < 0)
+                continue;
+            if (started && (int)(seq - curSeq) < 0)
+                continue;
+            
+            // a current message of another size means that sender
+            // and receiver disagree on the message sequence
+            if ((int)ntohl(header.msgSize) != size ||
+                ntohs(header.numFrags) != numFrags) {
+                opserr << "UDP_Socket::recvFragments() - received message of size "
+                    << (int)ntohl(header.msgSize) << " but expected size "
+                    << size << endln;
+                return -1;
+            }
+            
+            // a newer message supersedes an incomplete older one
+            if (!started || seq != curSeq) {
+                curSeq = seq;
+                started = true;
+                numMissing = numFrags;
+                memset(fragReceived, 0, numFrags);
+            }
+            
+            int idx = ntohs(header.fragIdx);
+            int offset = idx * UDP_FragPayload;
+            int payload = size - offset;
+            if (payload > UDP_FragPayload)
+                payload = UDP_FragPayload;
+            if (idx >= numFrags || fragReceived[idx] != 0 ||
+                length - (int)sizeof(UDP_FragHeader) != payload)
+                continue;
+            
+            memcpy(gMsg + offset, datagram + sizeof(UDP_FragHeader), payload);
+            fragReceived[idx] = 1;
+            numMissing--;
+        }
+    }
+    recvSeq = curSeq + 1;
     
     return 0;
 }
@@ -965,6 +1214,23 @@ GetHostAddr(char* host, char* IntAddr)
 }
 
 
+static void
+setSocketBufferSize(socket_type sockfd, int size)
+{
+    int current = 0;
+    socklen_type length = sizeof(current);
+    
+    if (getsockopt(sockfd, SOL_SOCKET, SO_RCVBUF, (char*)&current, &length) != 0 ||
+        current < size)
+        setsockopt(sockfd, SOL_SOCKET, SO_RCVBUF, (const char*)&size, sizeof(size));
+    
+    length = sizeof(current);
+    if (getsockopt(sockfd, SOL_SOCKET, SO_SNDBUF, (char*)&current, &length) != 0 ||
+        current < size)
+        setsockopt(sockfd, SOL_SOCKET, SO_SNDBUF, (const char*)&size, sizeof(size));
+}
+
+
 static void
 inttoa(unsigned int no, char* string, int* cnt) {
     if (no / 10) {
@@ -29,7 +29,10 @@
 // Purpose: This file contains the class definition for UDP_Socket.
 // UDP_Socket is a sub-class of channel. It is implemented with
 // Berkeley datagram sockets using the UDP protocol. Messages delivery
-// is thus unreliable.
+// is thus unreliable. If fragmentation is enabled, every datagram
+// carries a small header with a message sequence number and fragment
+// index, so that large messages are reassembled independent of the
+// datagram order and stale datagrams of older messages are discarded.
 
 #ifndef UDP_Socket_h
 #define UDP_Socket_h
@@ -38,14 +41,21 @@
 #include <Socket.h>
 #include <Channel.h>
 
+#if defined(_LINUX)
+struct mmsghdr;
+struct iovec;
+#endif
+
 class UDP_Socket : public Channel
 {
 public:
     UDP_Socket();
     UDP_Socket(unsigned int port,
-        bool initialHandshake = false, bool checkEndianness = false);
+        bool initialHandshake = false, bool checkEndianness = false,
+        bool fragmentation = false);
     UDP_Socket(unsigned int other_Port, const char* other_InetAddr,
-        bool initialHandshake = false, bool checkEndianness = false);
+        bool initialHandshake = false, bool checkEndianness = false,
+        bool fragmentation = false);
     ~UDP_Socket();
     
     char* addToProgram();
@@ -98,6 +108,12 @@ protected:
     unsigned int getBytesAvailable();
 
 private:
+    int sendData(char* gMsg, int size);
+    int recvData(char* gMsg, int size);
+    int sendFragments(const char* gMsg, int size);
+    int recvFragments(char* gMsg, int size);
+    int setNumFragments(int numFrags);
+    
     socket_type sockfd;
     
     union {
@@ -116,6 +132,19 @@ private:
     bool initialHandshake;
     bool checkEndianness;
     bool endiannessProblem;
+    
+    // fragmentation and reassembly
+    bool fragmentation;
+    unsigned int sendSeq;       // sequence number of next message sent
+    unsigned int recvSeq;       // oldest sequence number still accepted
+    int maxFrags;               // number of preallocated fragment slots
+    char* fragBuffer;           // datagram slots (maxFrags*MAX_UDP_DATAGRAM)
+    char* fragHeaders;          // headers of the fragments sent
+    char* fragReceived;         // flags of the fragments received
+#if defined(_LINUX)
+    struct mmsghdr* fragMsgs;   // batched send/recv descriptors
+    struct iovec* fragIov;
+#endif
 };
 
 #endif 
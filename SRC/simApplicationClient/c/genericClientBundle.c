@@ -0,0 +1,282 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation of
+// genericClientBundle. genericClientBundle connects a bundle of generic
+// elements to an OpenFresco SimAppElemServer that was started with the
+// tags of all the corresponding experimental elements
+// (startSimAppElemServer eleTag1 eleTag2 ... ipPort). The trial
+// responses of all the elements are collected first and then sent in a
+// single message, after which the resisting forces of all the elements
+// are received in a single message as well. Hence, there is only one
+// round trip per iteration instead of one per element. The vectors of
+// the bundle are the element vectors in the order of the element tags
+// and the matrices are the element matrices stored one after the other.
+// All the state of a bundle is kept in its context, so that different
+// threads can drive different bundles at the same time.
+
+#include "ofClient.h"
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <string.h>
+
+typedef struct genericClientBundle {
+    OFClient *theClient;
+    int numElements;
+    int numDOF;
+    int matSize;
+    int *eleDOF;
+    int *vecOffset;
+} GenericClientBundle;
+
+
+/*
+* genericClientBundle_setup() - connects a bundle of elements to the server
+*
+* input: int numEle - the number of elements in the bundle
+*        const int *nst - the number of DOF of each element
+*        int transport - OFC_TRANSPORT_TCP or OFC_TRANSPORT_SHM
+*        unsigned int port - the port number of the server
+*        const char *inetAddr - the machine inet address of the server
+*
+* return: GenericClientBundle * - the new bundle, null if failed
+*/
+GenericClientBundle *genericClientBundle_setup(int numEle, const int *nst,
+    int transport, unsigned int port, const char *inetAddr)
+{
+    GenericClientBundle *theBundle;
+    int i, ierr;
+    int sizeCtrl[OFC_Resp_All] = {0, 0, 0, 0, 0};
+    int sizeDaq[OFC_Resp_All] = {0, 0, 0, 0, 0};
+
+    if (numEle < 1)
+        return 0;
+
+    // get the offsets of the element vectors and matrices
+    theBundle = (GenericClientBundle *)calloc(1, sizeof(GenericClientBundle));
+    theBundle->eleDOF = (int *)calloc(numEle, sizeof(int));
+    theBundle->vecOffset = (int *)calloc(numEle, sizeof(int));
+    theBundle->numElements = numEle;
+    for (i=0; i<numEle; i++) {
+        if (nst[i] < 1) {
+            free(theBundle->eleDOF);
+            free(theBundle->vecOffset);
+            free(theBundle);
+            return 0;
+        }
+        theBundle->eleDOF[i] = nst[i];
+        theBundle->vecOffset[i] = theBundle->numDOF;
+        theBundle->numDOF += nst[i];
+        theBundle->matSize += nst[i]*nst[i];
+    }
+
+    // setup the connection with the data sizes of the bundle
+    sizeCtrl[OFC_Resp_Disp] = theBundle->numDOF;
+    sizeCtrl[OFC_Resp_Vel] = theBundle->numDOF;
+    sizeCtrl[OFC_Resp_Accel] = theBundle->numDOF;
+    sizeDaq[OFC_Resp_Force] = theBundle->numDOF;
+    theBundle->theClient = ofClient_connect(transport, inetAddr, port,
+        sizeCtrl, sizeDaq, theBundle->matSize, &ierr);
+    if (theBundle->theClient == 0) {
+        free(theBundle->eleDOF);
+        free(theBundle->vecOffset);
+        free(theBundle);
+        return 0;
+    }
+
+    return theBundle;
+}
+
+
+/*
+* genericClientBundle_setTrialResponse() - sets the trial response of
+* one element of the bundle without communicating with the server
+*
+* input: int ele - the index of the element in the bundle
+*        const double *ul - the trial displacements
+*        const double *uldot - the trial velocities
+*        const double *uldotdot - the trial accelerations
+*/
+int genericClientBundle_setTrialResponse(GenericClientBundle *theBundle,
+    int ele, const double *ul, const double *uldot, const double *uldotdot)
+{
+    double *sData;
+    int i, nst, id, numDOF;
+
+    if (ele < 0 || ele >= theBundle->numElements)
+        return -1;
+
+    // a previous update may still be sending the buffer
+    if (ofClient_complete(theBundle->theClient) != 0)
+        return -2;
+
+    sData = ofClient_getSendBuffer(theBundle->theClient);
+    numDOF = theBundle->numDOF;
+    nst = theBundle->eleDOF[ele];
+    id = 1+theBundle->vecOffset[ele];
+    for (i=0; i<nst; i++) {
+        sData[id+i] = ul[i];
+        sData[id+numDOF+i] = uldot[i];
+        sData[id+2*numDOF+i] = uldotdot[i];
+    }
+
+    return 0;
+}
+
+
+/*
+* genericClientBundle_update() - sends the trial responses of all the
+* elements in one message and receives the resisting forces of all
+* the elements in one message
+*/
+int genericClientBundle_update(GenericClientBundle *theBundle)
+{
+    OFClient *theClient = theBundle->theClient;
+    int ierr;
+
+    if ((ierr = ofClient_send(theClient, OFC_setTrialResponse)) != 0)
+        return ierr;
+    if ((ierr = ofClient_send(theClient, OFC_getForce)) != 0)
+        return ierr;
+
+    return ofClient_recv(theClient);
+}
+
+
+/*
+* genericClientBundle_getForce() - copies the resisting forces of one
+* element of the bundle that were received by the last update
+*/
+int genericClientBundle_getForce(GenericClientBundle *theBundle,
+    int ele, double *r)
+{
+    const double *rData;
+    int i;
+
+    if (ele < 0 || ele >= theBundle->numElements)
+        return -1;
+
+    rData = ofClient_getRecvBuffer(theBundle->theClient);
+    for (i=0; i<theBundle->eleDOF[ele]; i++)
+        r[i] = rData[theBundle->vecOffset[ele]+i];
+
+    return 0;
+}
+
+
+/*
+* genericClientBundle_getMatrices() - requests the stiffness or the mass
+* matrices of all the elements in one message and copies them into the
+* given array, one matrix after the other
+*/
+int genericClientBundle_getMatrices(GenericClientBundle *theBundle,
+    int action, double *s)
+{
+    return ofClient_getMatrix(theBundle->theClient, action,
+        s, theBundle->matSize);
+}
+
+
+/*
+* genericClientBundle_commitState() - commits the state of all the elements
+*/
+int genericClientBundle_commitState(GenericClientBundle *theBundle)
+{
+    return ofClient_commitState(theBundle->theClient);
+}
+
+
+/*
+* genericClientBundle_close() - disconnects the bundle from the server
+*/
+int genericClientBundle_close(GenericClientBundle *theBundle)
+{
+    int ierr;
+
+    ierr = ofClient_disconnect(theBundle->theClient);
+
+    // clean up allocated memory
+    free(theBundle->eleDOF);
+    free(theBundle->vecOffset);
+    free(theBundle);
+
+    return ierr;
+}
+
+
+int main(int argc, char **argv) {
+
+    int numEle = 3;
+    int nst[3] = {4, 4, 4};
+
+    int i, j;
+    double disp[4];
+    double vel[4];
+    double accel[4];
+    double s[48];  // three 4x4 stiffness matrices
+    double r[4];
+    GenericClientBundle *theBundle;
+
+    // setup
+    theBundle = genericClientBundle_setup(numEle, nst,
+        OFC_TRANSPORT_TCP, 8090, "127.0.0.1");
+    if (theBundle == 0) {
+        fprintf(stderr, "could not setup connection\n");
+        return -1;
+    }
+
+    // initial stiffness matrices of all the elements
+    genericClientBundle_getMatrices(theBundle, OFC_getInitialStiff, s);
+
+    // collect the trial responses of all the elements
+    for (j=0; j<numEle; j++) {
+        for (i=0; i<4; i++) {
+            disp[i] = 0.0;
+            vel[i] = 0.0;
+            accel[i] = 0.0;
+        }
+        disp[2] = 0.1*(j+1); disp[3] = -0.05*(j+1);
+        genericClientBundle_setTrialResponse(theBundle, j, disp, vel, accel);
+    }
+
+    // one round trip for all the elements
+    genericClientBundle_update(theBundle);
+
+    fprintf(stderr, "\nFORCES:\n");
+    for (j=0; j<numEle; j++) {
+        genericClientBundle_getForce(theBundle, j, r);
+        for (i=0; i<4; i++)
+            fprintf(stderr, "%f ", r[i]);
+        fprintf(stderr, "\n");
+    }
+    genericClientBundle_commitState(theBundle);
+
+    // shutdown
+    genericClientBundle_close(theBundle);
+
+    return 0;
+}
@@ -0,0 +1,853 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation of ofClient.
+// There is no global state, every function only works on the context
+// it is given. The sockets are kept in non-blocking mode, so that the
+// blocking functions are the non-blocking ones followed by a wait.
+
+#include "ofClient.h"
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#else
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <poll.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <stdatomic.h>
+#endif
+#if defined(__linux__)
+#include <limits.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#endif
+
+#ifdef _WIN32
+typedef SOCKET socket_type;
+#define INVALID_SOCKFD INVALID_SOCKET
+#else
+typedef int socket_type;
+#define INVALID_SOCKFD -1
+#endif
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+#ifndef _WIN32
+// number of polls before a waiting client goes to sleep
+#define SHM_SPIN_COUNT 4000
+
+// states of a shared memory connection
+#define SHM_STATE_INIT      0
+#define SHM_STATE_READY     1
+#define SHM_STATE_CONNECTED 2
+#define SHM_STATE_CLOSED    3
+
+#define SHM_MAGIC 0x4F46534D
+
+// layout of the shared memory segment, which needs
+// to be identical to the one used by SHM_Channel
+typedef struct shmRing {
+    atomic_uint head;               // total number of bytes written
+    char pad1[64 - sizeof(atomic_uint)];
+    atomic_uint tail;               // total number of bytes read
+    char pad2[64 - sizeof(atomic_uint)];
+    atomic_int readerWaiting;       // reader sleeps on head
+    atomic_int writerWaiting;       // writer sleeps on tail
+    char pad3[64 - 2 * sizeof(atomic_int)];
+} ShmRing;
+
+typedef struct shmHeader {
+    unsigned int magic;
+    unsigned int capacity;
+    atomic_uint state;
+    char pad[64 - 2 * sizeof(unsigned int) - sizeof(atomic_uint)];
+    ShmRing ring[2];
+} ShmHeader;
+#endif
+
+struct OFClient {
+    int transport;
+    int sizeCtrl[OFC_Resp_All];
+    int sizeDaq[OFC_Resp_All];
+    int ctrlOffset[OFC_Resp_All];   // offsets in send buffer
+    int daqOffset[OFC_Resp_All];    // offsets in receive buffer
+    int dataSize;
+    double *sData;
+    double *rData;
+
+    // pending operations
+    const char *sendPtr;
+    int sendLeft;
+    char *recvPtr;
+    int recvLeft;
+
+    // tcp transport
+    socket_type sockfd;
+
+#ifndef _WIN32
+    // shared memory transport
+    int shmfd;
+    void *shmAddr;
+    size_t shmSize;
+    unsigned int capacity;
+    ShmHeader *header;
+    ShmRing *sendRing;              // ring this client writes to
+    ShmRing *recvRing;              // ring this client reads from
+    char *sendBuffer;
+    char *recvBuffer;
+#endif
+};
+
+
+static void closeSocket(socket_type sockfd)
+{
+#ifdef _WIN32
+    closesocket(sockfd);
+    WSACleanup();
+#else
+    close(sockfd);
+#endif
+}
+
+
+/*
+* tcpConnect() - opens a non-blocking tcp/ip connection to the server
+*
+* return: int - 0 if successful, negative number if not
+*/
+static int tcpConnect(OFClient *theClient, const char *inetAddr,
+    unsigned int port)
+{
+    struct sockaddr_in other_Addr;
+    int noDelay = 1;
+#ifdef _WIN32
+    WSADATA wsaData;
+    unsigned long nbMode = 1;
+
+    // WSAStartup keeps its own reference count
+    if (WSAStartup(0x0002, &wsaData) != 0)
+        return -1;
+#endif
+
+    memset(&other_Addr, 0, sizeof(other_Addr));
+    other_Addr.sin_family = AF_INET;
+    other_Addr.sin_port = htons(port);
+    other_Addr.sin_addr.s_addr = inet_addr(inetAddr);
+
+    theClient->sockfd = socket(AF_INET, SOCK_STREAM, 0);
+    if (theClient->sockfd == INVALID_SOCKFD) {
+        fprintf(stderr, "ofClient::tcpConnect() - could not open socket\n");
+#ifdef _WIN32
+        WSACleanup();
+#endif
+        return -2;
+    }
+    if (connect(theClient->sockfd, (struct sockaddr *)&other_Addr,
+        sizeof(other_Addr)) != 0) {
+        fprintf(stderr, "ofClient::tcpConnect() - could not connect to server\n");
+        closeSocket(theClient->sockfd);
+        theClient->sockfd = INVALID_SOCKFD;
+        return -3;
+    }
+
+    // send small messages right away and never block in send or recv
+    setsockopt(theClient->sockfd, IPPROTO_TCP, TCP_NODELAY,
+        (char *)&noDelay, sizeof(int));
+#ifdef _WIN32
+    ioctlsocket(theClient->sockfd, FIONBIO, &nbMode);
+#else
+    fcntl(theClient->sockfd, F_SETFL,
+        fcntl(theClient->sockfd, F_GETFL, 0) | O_NONBLOCK);
+#endif
+
+    return 0;
+}
+
+
+static int wouldBlock()
+{
+#ifdef _WIN32
+    return WSAGetLastError() == WSAEWOULDBLOCK;
+#else
+    return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+#endif
+}
+
+
+/*
+* tcpProgress() - sends and receives as much of the pending
+* data as possible without blocking
+*
+* return: int - 0 if successful, negative number if not
+*/
+static int tcpProgress(OFClient *theClient)
+{
+    int n;
+
+    while (theClient->sendLeft > 0) {
+        n = send(theClient->sockfd, theClient->sendPtr,
+            theClient->sendLeft, MSG_NOSIGNAL);
+        if (n > 0) {
+            theClient->sendPtr += n;
+            theClient->sendLeft -= n;
+        }
+        else if (n < 0 && wouldBlock())
+            break;
+        else {
+            fprintf(stderr, "ofClient::tcpProgress() - could not send data\n");
+            return -1;
+        }
+    }
+    while (theClient->recvLeft > 0) {
+        n = recv(theClient->sockfd, theClient->recvPtr,
+            theClient->recvLeft, 0);
+        if (n > 0) {
+            theClient->recvPtr += n;
+            theClient->recvLeft -= n;
+        }
+        else if (n < 0 && wouldBlock())
+            break;
+        else {
+            fprintf(stderr, "ofClient::tcpProgress() - could not receive data\n");
+            return -2;
+        }
+    }
+
+    return 0;
+}
+
+
+// waits until the socket is ready for the pending operations
+static void tcpWait(OFClient *theClient)
+{
+#ifdef _WIN32
+    fd_set readSet, writeSet;
+    FD_ZERO(&readSet);
+    FD_ZERO(&writeSet);
+    if (theClient->sendLeft > 0)
+        FD_SET(theClient->sockfd, &writeSet);
+    if (theClient->recvLeft > 0)
+        FD_SET(theClient->sockfd, &readSet);
+    select(0, &readSet, &writeSet, 0, 0);
+#else
+    struct pollfd pfd;
+    pfd.fd = theClient->sockfd;
+    pfd.events = 0;
+    pfd.revents = 0;
+    if (theClient->sendLeft > 0)
+        pfd.events |= POLLOUT;
+    if (theClient->recvLeft > 0)
+        pfd.events |= POLLIN;
+    poll(&pfd, 1, -1);
+#endif
+}
+
+
+#ifndef _WIN32
+// puts the calling thread to sleep while *addr == expected, but
+// at most for about 100 ms so that a closed server can be detected
+static void shmSleep(atomic_uint *addr, unsigned int expected)
+{
+#if defined(__linux__)
+    struct timespec timeout;
+    timeout.tv_sec = 0;
+    timeout.tv_nsec = 100000000;
+    syscall(SYS_futex, (unsigned int *)addr, FUTEX_WAIT, expected,
+        &timeout, 0, 0);
+#else
+    struct timespec pause;
+    pause.tv_sec = 0;
+    pause.tv_nsec = 50000;
+    if (atomic_load(addr) == expected)
+        nanosleep(&pause, 0);
+#endif
+}
+
+
+// wakes up the server if it is sleeping on addr
+static void shmWake(atomic_uint *addr)
+{
+#if defined(__linux__)
+    syscall(SYS_futex, (unsigned int *)addr, FUTEX_WAKE, INT_MAX, 0, 0, 0);
+#endif
+}
+
+
+/*
+* shmConnect() - maps the shared memory segment that a server
+* started with -shm created for the given port
+*
+* return: int - 0 if successful, negative number if not
+*/
+static int shmConnect(OFClient *theClient, unsigned int port)
+{
+    char shmName[64];
+    struct stat shmStat;
+    struct timespec pause;
+    unsigned int state;
+    int trial = 0;
+    char *data;
+
+    sprintf(shmName, "/OpenFresco_%u", port);
+    pause.tv_sec = 0;
+    pause.tv_nsec = 10000000;
+
+    // wait for the server to create the segment
+    while ((theClient->shmfd = shm_open(shmName, O_RDWR, 0600)) < 0 ||
+        fstat(theClient->shmfd, &shmStat) != 0 ||
+        shmStat.st_size < (off_t)sizeof(ShmHeader)) {
+        if (theClient->shmfd >= 0)
+            close(theClient->shmfd);
+        theClient->shmfd = -1;
+        if (++trial % 500 == 0) {
+            fprintf(stderr, "ofClient::shmConnect() - still waiting "
+                "for server on %s\n", shmName);
+        }
+        nanosleep(&pause, 0);
+    }
+    theClient->shmSize = shmStat.st_size;
+    theClient->shmAddr = mmap(0, theClient->shmSize, PROT_READ | PROT_WRITE,
+        MAP_SHARED, theClient->shmfd, 0);
+    if (theClient->shmAddr == MAP_FAILED) {
+        theClient->shmAddr = 0;
+        return -1;
+    }
+
+    theClient->header = (ShmHeader *)theClient->shmAddr;
+    theClient->capacity = theClient->header->capacity;
+    if (theClient->header->magic != SHM_MAGIC || theClient->shmSize <
+        sizeof(ShmHeader) + 2 * (size_t)theClient->capacity) {
+        fprintf(stderr, "ofClient::shmConnect() - invalid segment %s\n", shmName);
+        return -2;
+    }
+
+    // ring 0 is used from client to server and ring 1 from server to client
+    theClient->sendRing = &theClient->header->ring[0];
+    theClient->recvRing = &theClient->header->ring[1];
+    data = (char *)theClient->shmAddr + sizeof(ShmHeader);
+    theClient->sendBuffer = data;
+    theClient->recvBuffer = data + theClient->capacity;
+
+    // wait until the server has initialized the segment
+    while ((state = atomic_load(&theClient->header->state)) == SHM_STATE_INIT)
+        shmSleep(&theClient->header->state, state);
+    if (state != SHM_STATE_READY) {
+        fprintf(stderr, "ofClient::shmConnect() - server on %s not ready\n", shmName);
+        return -3;
+    }
+
+    // tell the server that the client is connected
+    atomic_store(&theClient->header->state, SHM_STATE_CONNECTED);
+    shmWake(&theClient->header->state);
+
+    return 0;
+}
+
+
+/*
+* shmProgress() - copies as much of the pending data as possible
+* to and from the ring buffers without blocking
+*
+* return: int - 0 if successful, negative number if not
+*/
+static int shmProgress(OFClient *theClient)
+{
+    const unsigned int capacity = theClient->capacity;
+    const unsigned int mask = capacity - 1;
+    unsigned int head, tail, n, pos, first;
+
+    if (theClient->sendLeft > 0) {
+        ShmRing *ring = theClient->sendRing;
+        head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+        tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+        n = capacity - (head - tail);
+        if (n > (unsigned int)theClient->sendLeft)
+            n = theClient->sendLeft;
+        if (n > 0) {
+            pos = head & mask;
+            first = (n < capacity - pos) ? n : capacity - pos;
+            memcpy(theClient->sendBuffer + pos, theClient->sendPtr, first);
+            if (n > first)
+                memcpy(theClient->sendBuffer, theClient->sendPtr + first, n - first);
+            atomic_store_explicit(&ring->head, head + n, memory_order_release);
+            atomic_thread_fence(memory_order_seq_cst);
+            if (atomic_load(&ring->readerWaiting) != 0)
+                shmWake(&ring->head);
+            theClient->sendPtr += n;
+            theClient->sendLeft -= n;
+        }
+    }
+    if (theClient->recvLeft > 0) {
+        ShmRing *ring = theClient->recvRing;
+        tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+        head = atomic_load_explicit(&ring->head, memory_order_acquire);
+        n = head - tail;
+        if (n > (unsigned int)theClient->recvLeft)
+            n = theClient->recvLeft;
+        if (n > 0) {
+            pos = tail & mask;
+            first = (n < capacity - pos) ? n : capacity - pos;
+            memcpy(theClient->recvPtr, theClient->recvBuffer + pos, first);
+            if (n > first)
+                memcpy(theClient->recvPtr + first, theClient->recvBuffer, n - first);
+            atomic_store_explicit(&ring->tail, tail + n, memory_order_release);
+            atomic_thread_fence(memory_order_seq_cst);
+            if (atomic_load(&ring->writerWaiting) != 0)
+                shmWake(&ring->tail);
+            theClient->recvPtr += n;
+            theClient->recvLeft -= n;
+        }
+    }
+    if ((theClient->sendLeft > 0 || theClient->recvLeft > 0) &&
+        atomic_load(&theClient->header->state) == SHM_STATE_CLOSED) {
+        fprintf(stderr, "ofClient::shmProgress() - channel closed\n");
+        return -1;
+    }
+
+    return 0;
+}
+
+
+// waits until the ring of the first pending operation changes,
+// first by polling and then by sleeping with the waiting flag raised
+static void shmWait(OFClient *theClient)
+{
+    atomic_uint *var;
+    atomic_int *waiting;
+    unsigned int observed;
+    int i;
+
+    if (theClient->sendLeft > 0) {
+        var = &theClient->sendRing->tail;
+        waiting = &theClient->sendRing->writerWaiting;
+    }
+    else {
+        var = &theClient->recvRing->head;
+        waiting = &theClient->recvRing->readerWaiting;
+    }
+    observed = atomic_load_explicit(var, memory_order_acquire);
+    if (theClient->sendLeft > 0) {
+        // the ring is only full if no space was freed in the meantime
+        if (observed + theClient->capacity != atomic_load(&theClient->sendRing->head))
+            return;
+    }
+    else if (observed != atomic_load(&theClient->recvRing->tail))
+        return;
+
+    for (i = 0; i < SHM_SPIN_COUNT; i++) {
+        if (atomic_load_explicit(var, memory_order_acquire) != observed)
+            return;
+    }
+    atomic_store(waiting, 1);
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load(var) == observed)
+        shmSleep(var, observed);
+    atomic_store(waiting, 0);
+}
+#endif
+
+
+/*
+* ofClient_connect() - connects to a server and sends the data sizes
+*
+* input: int transport - OFC_TRANSPORT_TCP or OFC_TRANSPORT_SHM
+*        const char *inetAddr - the machine inet address of the server
+*        unsigned int port - the port number of the server
+*        const int *sizeCtrl - sizes of the trial response vectors
+*        const int *sizeDaq - sizes of the daq response vectors
+*        int dataSize - the minimum message size in doubles
+*
+* return: OFClient * - the new context, null if failed
+*         int *ierr - 0 if successful, negative number if not
+*/
+OFClient *ofClient_connect(int transport, const char *inetAddr,
+    unsigned int port, const int sizeCtrl[OFC_Resp_All],
+    const int sizeDaq[OFC_Resp_All], int dataSize, int *ierr)
+{
+    OFClient *theClient;
+    int i, id, iData[2*OFC_Resp_All+1];
+
+    theClient = (OFClient *)calloc(1, sizeof(OFClient));
+    if (theClient == 0) {
+        *ierr = -1;
+        return 0;
+    }
+    theClient->transport = transport;
+    theClient->sockfd = INVALID_SOCKFD;
+#ifndef _WIN32
+    theClient->shmfd = -1;
+#endif
+
+    // get the offsets of the response vectors in the messages
+    id = 1;
+    for (i=0; i<OFC_Resp_All; i++) {
+        theClient->sizeCtrl[i] = sizeCtrl[i];
+        theClient->ctrlOffset[i] = id;
+        id += sizeCtrl[i];
+    }
+    dataSize = (id>dataSize) ? id : dataSize;
+    id = 0;
+    for (i=0; i<OFC_Resp_All; i++) {
+        theClient->sizeDaq[i] = sizeDaq[i];
+        theClient->daqOffset[i] = id;
+        id += sizeDaq[i];
+    }
+    dataSize = (id>dataSize) ? id : dataSize;
+
+    // allocate memory for the send and receive buffers once
+    theClient->dataSize = dataSize;
+    theClient->sData = (double *)calloc(dataSize, sizeof(double));
+    theClient->rData = (double *)calloc(dataSize, sizeof(double));
+    if (theClient->sData == 0 || theClient->rData == 0) {
+        ofClient_disconnect(theClient);
+        *ierr = -1;
+        return 0;
+    }
+
+    // setup the connection
+    if (transport == OFC_TRANSPORT_TCP) {
+        *ierr = tcpConnect(theClient, inetAddr, port);
+    }
+    else if (transport == OFC_TRANSPORT_SHM) {
+#ifdef _WIN32
+        fprintf(stderr, "ofClient_connect() - shared memory "
+            "transport is not supported on Windows\n");
+        *ierr = -2;
+#else
+        *ierr = shmConnect(theClient, port);
+#endif
+    }
+    else {
+        fprintf(stderr, "ofClient_connect() - unknown transport %d\n", transport);
+        *ierr = -2;
+    }
+    if (*ierr != 0) {
+        theClient->transport = 0;
+        ofClient_disconnect(theClient);
+        return 0;
+    }
+
+    // send the data sizes
+    for (i=0; i<OFC_Resp_All; i++) {
+        iData[i] = sizeCtrl[i];
+        iData[OFC_Resp_All+i] = sizeDaq[i];
+    }
+    iData[2*OFC_Resp_All] = dataSize;
+    theClient->sendPtr = (const char *)iData;
+    theClient->sendLeft = sizeof(iData);
+    *ierr = ofClient_complete(theClient);
+    if (*ierr != 0) {
+        ofClient_disconnect(theClient);
+        return 0;
+    }
+
+    return theClient;
+}
+
+
+/*
+* ofClient_disconnect() - tells the server to shut down, closes the
+* connection and frees the context
+*/
+int ofClient_disconnect(OFClient *theClient)
+{
+    int ierr = 0;
+
+    if (theClient == 0)
+        return -1;
+
+    if (theClient->transport != 0 && theClient->sData != 0) {
+        theClient->sendLeft = theClient->recvLeft = 0;
+        ierr = ofClient_send(theClient, OFC_DIE);
+    }
+    if (theClient->sockfd != INVALID_SOCKFD)
+        closeSocket(theClient->sockfd);
+#ifndef _WIN32
+    if (theClient->header != 0) {
+        atomic_store(&theClient->header->state, SHM_STATE_CLOSED);
+        shmWake(&theClient->header->state);
+        shmWake(&theClient->header->ring[0].head);
+        shmWake(&theClient->header->ring[1].tail);
+    }
+    if (theClient->shmAddr != 0)
+        munmap(theClient->shmAddr, theClient->shmSize);
+    if (theClient->shmfd >= 0)
+        close(theClient->shmfd);
+#endif
+
+    free(theClient->sData);
+    free(theClient->rData);
+    free(theClient);
+
+    return ierr;
+}
+
+
+double *ofClient_getSendBuffer(OFClient *theClient)
+{
+    return theClient->sData;
+}
+
+
+const double *ofClient_getRecvBuffer(OFClient *theClient)
+{
+    return theClient->rData;
+}
+
+
+int ofClient_getDataSize(OFClient *theClient)
+{
+    return theClient->dataSize;
+}
+
+
+/*
+* ofClient_isend() - starts sending the send buffer with the given
+* action, a send that is still pending is completed first
+*/
+int ofClient_isend(OFClient *theClient, int action)
+{
+    int ierr;
+
+    while (theClient->sendLeft > 0) {
+        if ((ierr = ofClient_test(theClient)) < 0)
+            return ierr;
+        if (theClient->sendLeft > 0) {
+#ifdef _WIN32
+            tcpWait(theClient);
+#else
+            if (theClient->transport == OFC_TRANSPORT_SHM)
+                shmWait(theClient);
+            else
+                tcpWait(theClient);
+#endif
+        }
+    }
+
+    theClient->sData[0] = action;
+    theClient->sendPtr = (const char *)theClient->sData;
+    theClient->sendLeft = theClient->dataSize * sizeof(double);
+
+    ierr = ofClient_test(theClient);
+
+    return (ierr < 0) ? ierr : 0;
+}
+
+
+/*
+* ofClient_irecv() - starts receiving a message into the receive buffer
+*/
+int ofClient_irecv(OFClient *theClient)
+{
+    int ierr;
+
+    if (theClient->recvLeft > 0) {
+        fprintf(stderr, "ofClient_irecv() - receive already pending\n");
+        return -1;
+    }
+    theClient->recvPtr = (char *)theClient->rData;
+    theClient->recvLeft = theClient->dataSize * sizeof(double);
+
+    ierr = ofClient_test(theClient);
+
+    return (ierr < 0) ? ierr : 0;
+}
+
+
+/*
+* ofClient_test() - advances the pending operations without blocking
+*
+* return: int - 1 if all operations have completed, 0 if some are
+*               still pending, negative number if failed
+*/
+int ofClient_test(OFClient *theClient)
+{
+    int ierr;
+
+#ifdef _WIN32
+    ierr = tcpProgress(theClient);
+#else
+    if (theClient->transport == OFC_TRANSPORT_SHM)
+        ierr = shmProgress(theClient);
+    else
+        ierr = tcpProgress(theClient);
+#endif
+    if (ierr < 0)
+        return ierr;
+
+    return (theClient->sendLeft == 0 && theClient->recvLeft == 0);
+}
+
+
+/*
+* ofClient_complete() - waits until the pending operations have completed
+*/
+int ofClient_complete(OFClient *theClient)
+{
+    int ierr;
+
+    while ((ierr = ofClient_test(theClient)) == 0) {
+#ifdef _WIN32
+        tcpWait(theClient);
+#else
+        if (theClient->transport == OFC_TRANSPORT_SHM)
+            shmWait(theClient);
+        else
+            tcpWait(theClient);
+#endif
+    }
+
+    return (ierr < 0) ? ierr : 0;
+}
+
+
+int ofClient_send(OFClient *theClient, int action)
+{
+    int ierr = ofClient_isend(theClient, action);
+    if (ierr != 0)
+        return ierr;
+
+    return ofClient_complete(theClient);
+}
+
+
+int ofClient_recv(OFClient *theClient)
+{
+    int ierr = ofClient_irecv(theClient);
+    if (ierr != 0)
+        return ierr;
+
+    return ofClient_complete(theClient);
+}
+
+
+/*
+* ofClient_setTrialResponse() - sends the trial response, where
+* the vectors that are null pointers or have size zero are skipped
+*/
+int ofClient_setTrialResponse(OFClient *theClient,
+    const double *disp, const double *vel, const double *accel,
+    const double *force, const double *time)
+{
+    const double *resp[OFC_Resp_All];
+    int i, ierr;
+
+    // the send buffer may still be in use by a pending send
+    if (theClient->sendLeft > 0 && (ierr = ofClient_complete(theClient)) != 0)
+        return ierr;
+
+    resp[OFC_Resp_Disp] = disp;
+    resp[OFC_Resp_Vel] = vel;
+    resp[OFC_Resp_Accel] = accel;
+    resp[OFC_Resp_Force] = force;
+    resp[OFC_Resp_Time] = time;
+    for (i=0; i<OFC_Resp_All; i++) {
+        if (resp[i] != 0 && theClient->sizeCtrl[i] > 0) {
+            memcpy(&theClient->sData[theClient->ctrlOffset[i]], resp[i],
+                theClient->sizeCtrl[i] * sizeof(double));
+        }
+    }
+
+    return ofClient_send(theClient, OFC_setTrialResponse);
+}
+
+
+/*
+* ofClient_getDaqResponse() - requests and receives the daq response,
+* where the vectors that are null pointers or have size zero are skipped
+*/
+int ofClient_getDaqResponse(OFClient *theClient,
+    double *disp, double *vel, double *accel,
+    double *force, double *time)
+{
+    double *resp[OFC_Resp_All];
+    int i, ierr;
+
+    if ((ierr = ofClient_send(theClient, OFC_getDaqResponse)) != 0)
+        return ierr;
+    if ((ierr = ofClient_recv(theClient)) != 0)
+        return ierr;
+
+    resp[OFC_Resp_Disp] = disp;
+    resp[OFC_Resp_Vel] = vel;
+    resp[OFC_Resp_Accel] = accel;
+    resp[OFC_Resp_Force] = force;
+    resp[OFC_Resp_Time] = time;
+    for (i=0; i<OFC_Resp_All; i++) {
+        if (resp[i] != 0 && theClient->sizeDaq[i] > 0) {
+            memcpy(resp[i], &theClient->rData[theClient->daqOffset[i]],
+                theClient->sizeDaq[i] * sizeof(double));
+        }
+    }
+
+    return 0;
+}
+
+
+/*
+* ofClient_getMatrix() - requests and receives a matrix with the given
+* number of entries, where action is one of OFC_getInitialStiff,
+* OFC_getTangentStiff, OFC_getDamp or OFC_getMass
+*/
+int ofClient_getMatrix(OFClient *theClient, int action,
+    double *theMatrix, int size)
+{
+    int ierr;
+
+    if (size > theClient->dataSize) {
+        fprintf(stderr, "ofClient_getMatrix() - matrix with %d entries "
+            "does not fit into data size %d\n", size, theClient->dataSize);
+        return -1;
+    }
+    if ((ierr = ofClient_send(theClient, action)) != 0)
+        return ierr;
+    if ((ierr = ofClient_recv(theClient)) != 0)
+        return ierr;
+
+    memcpy(theMatrix, theClient->rData, size * sizeof(double));
+
+    return 0;
+}
+
+
+int ofClient_commitState(OFClient *theClient)
+{
+    return ofClient_send(theClient, OFC_commitState);
+}
@@ -0,0 +1,110 @@
+/* ****************************************************************** **
+**    OpenFRESCO - Open Framework                                     **
+**                 for Experimental Setup and Control                 **
+**                                                                    **
+**                                                                    **
+** Copyright (c) 2006, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited. See    **
+** file 'COPYRIGHT_UCB' in main directory for information on usage    **
+** and redistribution, and for a DISCLAIMER OF ALL WARRANTIES.        **
+**                                                                    **
+** Developed by:                                                      **
+**   Andreas Schellenberg (andreas.schellenberg@gmail.com)            **
+**   Yoshikazu Takahashi (yos@catfish.dpri.kyoto-u.ac.jp)             **
+**   Gregory L. Fenves (fenves@berkeley.edu)                          **
+**   Stephen A. Mahin (mahin@berkeley.edu)                            **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef ofClient_h
+#define ofClient_h
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the interface of ofClient, a
+// reentrant client library for simulation applications that connect
+// to an OpenFresco SimAppElemServer or SimAppSiteServer. All the state
+// of a connection is kept in an opaque OFClient context, so that
+// several threads can each drive their own connections without any
+// locking. The send and receive buffers are allocated once when the
+// connection is set up, and messages can be sent and received either
+// blocking or non-blocking, where a non-blocking operation is started
+// with ofClient_isend/ofClient_irecv and finished with
+// ofClient_test/ofClient_complete. The transport is either a tcp/ip
+// socket or, for servers on the same machine started with -shm, the
+// shared memory ring buffers of the SHM_Channel.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// transports
+#define OFC_TRANSPORT_TCP 1
+#define OFC_TRANSPORT_SHM 2
+
+// actions understood by the servers
+#define OFC_setTrialResponse 3
+#define OFC_commitState      5
+#define OFC_getDaqResponse   6
+#define OFC_getForce        10
+#define OFC_getInitialStiff 12
+#define OFC_getTangentStiff 13
+#define OFC_getDamp         14
+#define OFC_getMass         15
+#define OFC_DIE             99
+
+// response types in the size arrays
+#define OFC_Resp_Disp  0
+#define OFC_Resp_Vel   1
+#define OFC_Resp_Accel 2
+#define OFC_Resp_Force 3
+#define OFC_Resp_Time  4
+#define OFC_Resp_All   5
+
+typedef struct OFClient OFClient;
+
+// connection setup and shutdown
+OFClient *ofClient_connect(int transport, const char *inetAddr,
+    unsigned int port, const int sizeCtrl[OFC_Resp_All],
+    const int sizeDaq[OFC_Resp_All], int dataSize, int *ierr);
+int ofClient_disconnect(OFClient *theClient);
+
+// preallocated message buffers, the first entry of
+// the send buffer holds the action of the message
+double *ofClient_getSendBuffer(OFClient *theClient);
+const double *ofClient_getRecvBuffer(OFClient *theClient);
+int ofClient_getDataSize(OFClient *theClient);
+
+// blocking message exchange
+int ofClient_send(OFClient *theClient, int action);
+int ofClient_recv(OFClient *theClient);
+
+// non-blocking message exchange, the send buffer must not be
+// modified and the receive buffer must not be read until the
+// pending operations have completed
+int ofClient_isend(OFClient *theClient, int action);
+int ofClient_irecv(OFClient *theClient);
+int ofClient_test(OFClient *theClient);
+int ofClient_complete(OFClient *theClient);
+
+// element level methods, null pointers are skipped
+int ofClient_setTrialResponse(OFClient *theClient,
+    const double *disp, const double *vel, const double *accel,
+    const double *force, const double *time);
+int ofClient_getDaqResponse(OFClient *theClient,
+    double *disp, double *vel, double *accel,
+    double *force, double *time);
+int ofClient_getMatrix(OFClient *theClient, int action,
+    double *theMatrix, int size);
+int ofClient_commitState(OFClient *theClient);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif